@@ -0,0 +1,86 @@
+// Copyright 2016-2023 Francesco Biscani (bluescarni@gmail.com)
+//
+// This file is part of the mp++ library.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <fmt/core.h>
+#include <fmt/ostream.h>
+
+#include <mp++/config.hpp>
+#include <mp++/integer.hpp>
+#include <mp++/integer_batch_gcd.hpp>
+
+#include "utils.hpp"
+
+namespace
+{
+
+std::mt19937 rng;
+
+constexpr auto size = 1000000ul;
+
+// Random 1-limb moduli.
+std::vector<mppp::integer<1>> get_init_vector()
+{
+    rng.seed(1);
+    std::uniform_int_distribution<std::uint_least64_t> dist(1ull << 32, 1ull << 62);
+    std::vector<mppp::integer<1>> retval(size);
+    std::generate(retval.begin(), retval.end(), [&dist]() { return mppp::integer<1>{dist(rng) | 1u}; });
+    return retval;
+}
+
+const auto benchmark_name = mppp_benchmark_name();
+
+} // namespace
+
+int main()
+{
+    fmt::print("Benchmark name: {}\n", benchmark_name);
+
+    // Warm up.
+    mppp_benchmark::warmup();
+
+    // Prepare the benchmark result data.
+    mppp_benchmark::data_t bdata;
+
+    const auto v = get_init_vector();
+
+    for (auto nthreads : {1u, 0u}) {
+        std::vector<mppp::integer<1>> out;
+        const auto name = nthreads == 1u ? "mppp::batch_gcd (1 thread)" : "mppp::batch_gcd (all threads)";
+
+        mppp_benchmark::simple_timer st;
+
+        mppp::batch_gcd(out, v.data(), v.size(), nthreads);
+
+        const auto runtime = st.elapsed();
+        bdata.emplace_back(name, runtime);
+        const auto ret = std::count_if(out.begin(), out.end(), [](const mppp::integer<1> &n) { return !n.is_one(); });
+        fmt::print(mppp_benchmark::res_print_format, name, runtime, ret);
+    }
+
+    {
+        constexpr auto name = "mppp::gcd_range";
+
+        mppp::integer<1> ret;
+
+        mppp_benchmark::simple_timer st;
+
+        mppp::gcd_range(ret, v.data(), v.size());
+
+        const auto runtime = st.elapsed();
+        bdata.emplace_back(name, runtime);
+        fmt::print(mppp_benchmark::res_print_format, name, runtime, ret);
+    }
+
+    // Write out the .py and .rst files.
+    mppp_benchmark::write_out(bdata, benchmark_name);
+}
@@ -10,6 +10,7 @@
 
 #include <boost/multiprecision/mpfr.hpp>
 
+#include <mp++/lazy.hpp>
 #include <mp++/real.hpp>
 
 #include "track_malloc.hpp"
@@ -31,6 +32,19 @@ T test_function(const T &x, bool move = false)
     }
 }
 
+// The same function, using lazy evaluation.
+real test_function_lazy(const real &x, bool move = false)
+{
+    real a[7] = {real{1.}, real{2.}, real{3.}, real{4.}, real{5.}, real{6.}, real{7.}};
+
+    if (move) {
+        return (((((mppp::lazy(std::move(a[6])) * x + a[5]) * x + a[4]) * x + a[3]) * x + a[2]) * x + a[1]) * x
+               + a[0];
+    } else {
+        return (((((mppp::lazy(a[6]) * x + a[5]) * x + a[4]) * x + a[3]) * x + a[2]) * x + a[1]) * x + a[0];
+    }
+}
+
 int main()
 {
     real arg1{42.};
@@ -52,6 +66,14 @@ int main()
         mppp_bench::malloc_tracker t{"mppp::real + move"};
         test_function(arg1, true);
     }
+    {
+        mppp_bench::malloc_tracker t{"mppp::real + lazy"};
+        test_function_lazy(arg1);
+    }
+    {
+        mppp_bench::malloc_tracker t{"mppp::real + lazy + move"};
+        test_function_lazy(arg1, true);
+    }
 
     return 0;
 }
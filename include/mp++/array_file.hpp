@@ -0,0 +1,341 @@
+// Copyright 2016-2023 Francesco Biscani (bluescarni@gmail.com)
+//
+// This file is part of the mp++ library.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef MPPP_ARRAY_FILE_HPP
+#define MPPP_ARRAY_FILE_HPP
+
+#include <mp++/config.hpp>
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include <mp++/detail/gmp.hpp>
+#include <mp++/detail/utils.hpp>
+#include <mp++/detail/visibility.hpp>
+#include <mp++/integer.hpp>
+#include <mp++/rational.hpp>
+
+#if defined(MPPP_WITH_MPFR)
+#include <mp++/detail/mpfr.hpp>
+#include <mp++/real.hpp>
+#endif
+
+MPPP_BEGIN_NAMESPACE
+
+// The kinds of objects which can be stored in an array file.
+enum class array_file_kind : std::uint32_t { integer = 0, rational = 1, real = 2 };
+
+namespace detail
+{
+
+// The header of an array file.
+//
+// The header is followed by the columns of the size/offset table, each
+// one stored as a contiguous array of 64-bit values:
+//
+// - for integer and rational arrays, the signed limb sizes and the limb offsets
+//   of the GMP integers (for rationals, numerators and denominators are interleaved);
+// - for real arrays, the precisions, the signs, the exponents and the limb offsets.
+//
+// The limbs of all the objects are stored in a single blob at the end
+// of the file, aligned to array_file_align bytes.
+struct array_file_header {
+    std::array<char, 8> magic;
+    std::uint32_t version;
+    // Endianness marker, equal to array_file_endian
+    // in the native byte order.
+    std::uint32_t endian;
+    std::uint32_t kind;
+    std::uint32_t limb_size;
+    std::uint32_t numb_bits;
+    std::uint32_t reserved;
+    // Number of objects.
+    std::uint64_t n;
+    // Total number of limbs.
+    std::uint64_t nlimbs;
+    // Byte offsets of the columns of the size/offset table
+    // (zero if unused).
+    std::array<std::uint64_t, 4> columns;
+    // Byte offset of the limb blob.
+    std::uint64_t limbs_offset;
+    // Total size of the file in bytes.
+    std::uint64_t file_size;
+};
+
+static_assert(sizeof(array_file_header) == 96u, "Invalid size for array_file_header.");
+static_assert(std::is_standard_layout<array_file_header>::value, "Invalid layout for array_file_header.");
+
+constexpr std::uint32_t array_file_version = 1;
+constexpr std::uint32_t array_file_endian = 0x01020304ul;
+constexpr std::size_t array_file_align = 64;
+
+// Init the header for an array file containing n objects of kind kind,
+// with ncols columns of nentries entries each and nlimbs total limbs.
+MPPP_DLL_PUBLIC array_file_header array_file_make_header(array_file_kind, std::size_t, std::size_t, std::size_t,
+                                                         std::size_t);
+
+// Write the header and the zero padding up to the limb blob.
+MPPP_DLL_PUBLIC void array_file_write_header(std::ofstream &, const array_file_header &);
+MPPP_DLL_PUBLIC void array_file_write_padding(std::ofstream &, const array_file_header &);
+
+// Open the file at path for writing, and close it checking for errors.
+MPPP_DLL_PUBLIC std::ofstream array_file_open(const std::string &);
+MPPP_DLL_PUBLIC void array_file_close(std::ofstream &, const std::string &);
+
+// Buffered writer of a column of 64-bit values.
+class array_file_column_writer
+{
+public:
+    explicit array_file_column_writer(std::ofstream &os) : m_os(os) {}
+    array_file_column_writer(const array_file_column_writer &) = delete;
+    array_file_column_writer(array_file_column_writer &&) = delete;
+    array_file_column_writer &operator=(const array_file_column_writer &) = delete;
+    array_file_column_writer &operator=(array_file_column_writer &&) = delete;
+    ~array_file_column_writer()
+    {
+        // NOTE: flush() must be invoked explicitly.
+        assert(m_size == 0u);
+    }
+    template <typename T>
+    void push(T x)
+    {
+        static_assert(sizeof(T) == 8u, "Invalid column value type.");
+        if (m_size == m_buffer.size()) {
+            flush();
+        }
+        m_buffer[m_size++] = static_cast<std::uint64_t>(x);
+    }
+    void flush()
+    {
+        m_os.write(reinterpret_cast<const char *>(m_buffer.data()),
+                   static_cast<std::streamsize>(m_size * sizeof(std::uint64_t)));
+        m_size = 0;
+    }
+
+private:
+    std::ofstream &m_os;
+    std::array<std::uint64_t, 1024> m_buffer;
+    std::size_t m_size = 0;
+};
+
+// Save n objects of kind kind made of nmpz GMP integers in total. get(i) must return
+// a pair containing the signed size and a pointer to the limbs of the i-th GMP integer.
+template <typename F>
+inline void array_file_save_mpz(const std::string &path, array_file_kind kind, std::size_t n, std::size_t nmpz,
+                                const F &get)
+{
+    std::size_t nlimbs = 0;
+    for (std::size_t i = 0; i < nmpz; ++i) {
+        nlimbs += static_cast<std::size_t>(std::abs(get(i).first));
+    }
+    const auto header = array_file_make_header(kind, n, 2, nmpz, nlimbs);
+
+    auto os = array_file_open(path);
+    array_file_write_header(os, header);
+    {
+        // The sizes.
+        array_file_column_writer w(os);
+        for (std::size_t i = 0; i < nmpz; ++i) {
+            w.push(static_cast<std::int64_t>(get(i).first));
+        }
+        w.flush();
+    }
+    {
+        // The offsets.
+        array_file_column_writer w(os);
+        std::uint64_t offset = 0;
+        for (std::size_t i = 0; i < nmpz; ++i) {
+            w.push(offset);
+            offset += static_cast<std::uint64_t>(std::abs(get(i).first));
+        }
+        w.flush();
+    }
+    array_file_write_padding(os, header);
+    // The limbs.
+    for (std::size_t i = 0; i < nmpz; ++i) {
+        const auto p = get(i);
+        os.write(reinterpret_cast<const char *>(p.second),
+                 static_cast<std::streamsize>(static_cast<std::size_t>(std::abs(p.first)) * sizeof(::mp_limb_t)));
+    }
+    array_file_close(os, path);
+}
+
+// Fetch the signed size and the limbs pointer of an integer.
+template <std::size_t SSize>
+inline std::pair<mpz_size_t, const ::mp_limb_t *> array_file_mpz_data(const integer<SSize> &n)
+{
+    const auto &u = n._get_union();
+    if (u.is_static()) {
+        return std::make_pair(u.g_st()._mp_size, u.g_st().m_limbs.data());
+    } else {
+        return std::make_pair(u.g_dy()._mp_size, static_cast<const ::mp_limb_t *>(u.g_dy()._mp_d));
+    }
+}
+
+} // namespace detail
+
+// Save an array of integers into an array file.
+template <std::size_t SSize>
+inline void save_array_file(const std::string &path, const integer<SSize> *data, std::size_t n)
+{
+    detail::array_file_save_mpz(path, array_file_kind::integer, n, n,
+                                [data](std::size_t i) { return detail::array_file_mpz_data(data[i]); });
+}
+
+// Save an array of rationals into an array file.
+template <std::size_t SSize>
+inline void save_array_file(const std::string &path, const rational<SSize> *data, std::size_t n)
+{
+    // LCOV_EXCL_START
+    if (mppp_unlikely(n > detail::nl_max<std::size_t>() / 2u)) {
+        throw std::overflow_error("Overflow in the computation of the size of an array file");
+    }
+    // LCOV_EXCL_STOP
+
+    detail::array_file_save_mpz(path, array_file_kind::rational, n, n * 2u, [data](std::size_t i) {
+        return detail::array_file_mpz_data(i % 2u == 0u ? data[i / 2u].get_num() : data[i / 2u].get_den());
+    });
+}
+
+#if defined(MPPP_WITH_MPFR)
+
+// Save an array of reals into an array file.
+MPPP_DLL_PUBLIC void save_array_file(const std::string &, const real *, std::size_t);
+
+#endif
+
+// Read-only view on an integer stored in a mapped array file.
+class integer_cview
+{
+    friend class mapped_array_file;
+
+    explicit integer_cview(const detail::mpz_struct_t &m) : m_mpz(m) {}
+
+public:
+    // Getter for the GMP integer.
+    MPPP_NODISCARD const detail::mpz_struct_t *get() const
+    {
+        return &m_mpz;
+    }
+    // Implicit conversion operator to a const pointer to the GMP integer.
+    // NOLINTNEXTLINE(hicpp-explicit-conversions, google-explicit-constructor)
+    operator const detail::mpz_struct_t *() const
+    {
+        return get();
+    }
+
+private:
+    detail::mpz_struct_t m_mpz;
+};
+
+// Read-only view on a rational stored in a mapped array file.
+class rational_cview
+{
+    friend class mapped_array_file;
+
+    explicit rational_cview(const detail::mpz_struct_t &num, const detail::mpz_struct_t &den)
+    {
+        *mpq_numref(&m_mpq) = num;
+        *mpq_denref(&m_mpq) = den;
+    }
+
+public:
+    MPPP_NODISCARD const detail::mpq_struct_t *get() const
+    {
+        return &m_mpq;
+    }
+    // NOLINTNEXTLINE(hicpp-explicit-conversions, google-explicit-constructor)
+    operator const detail::mpq_struct_t *() const
+    {
+        return get();
+    }
+
+private:
+    detail::mpq_struct_t m_mpq;
+};
+
+#if defined(MPPP_WITH_MPFR)
+
+// Read-only view on a real stored in a mapped array file.
+class real_cview
+{
+    friend class mapped_array_file;
+
+    explicit real_cview(const mpfr_struct_t &r) : m_mpfr(r) {}
+
+public:
+    MPPP_NODISCARD const mpfr_struct_t *get() const
+    {
+        return &m_mpfr;
+    }
+    // NOLINTNEXTLINE(hicpp-explicit-conversions, google-explicit-constructor)
+    operator const mpfr_struct_t *() const
+    {
+        return get();
+    }
+
+private:
+    mpfr_struct_t m_mpfr;
+};
+
+#endif
+
+// Read-only memory mapping of an array file.
+class MPPP_DLL_PUBLIC mapped_array_file
+{
+public:
+    explicit mapped_array_file(const std::string &);
+    mapped_array_file(const mapped_array_file &) = delete;
+    mapped_array_file(mapped_array_file &&) noexcept;
+    mapped_array_file &operator=(const mapped_array_file &) = delete;
+    mapped_array_file &operator=(mapped_array_file &&) noexcept;
+    ~mapped_array_file();
+
+    // The kind of objects stored in the file.
+    MPPP_NODISCARD array_file_kind kind() const
+    {
+        return static_cast<array_file_kind>(m_header->kind);
+    }
+    // The number of objects stored in the file.
+    MPPP_NODISCARD std::size_t size() const
+    {
+        return static_cast<std::size_t>(m_header->n);
+    }
+
+    // Views on the stored objects.
+    MPPP_NODISCARD integer_cview get_integer(std::size_t) const;
+    MPPP_NODISCARD rational_cview get_rational(std::size_t) const;
+#if defined(MPPP_WITH_MPFR)
+    MPPP_NODISCARD real_cview get_real(std::size_t) const;
+#endif
+
+private:
+    void check_access(array_file_kind, std::size_t) const;
+    MPPP_NODISCARD detail::mpz_struct_t mpz_at(std::size_t) const;
+    void unmap() noexcept;
+
+    // The mapped memory area and its size.
+    void *m_addr = nullptr;
+    std::size_t m_size = 0;
+    // Pointers into the mapped memory area.
+    const detail::array_file_header *m_header = nullptr;
+    std::array<const std::int64_t *, 4> m_columns{};
+    const ::mp_limb_t *m_limbs = nullptr;
+};
+
+MPPP_END_NAMESPACE
+
+#endif
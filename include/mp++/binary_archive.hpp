@@ -0,0 +1,458 @@
+// Copyright 2016-2023 Francesco Biscani (bluescarni@gmail.com)
+//
+// This file is part of the mp++ library.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef MPPP_BINARY_ARCHIVE_HPP
+#define MPPP_BINARY_ARCHIVE_HPP
+
+#include <mp++/config.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <istream>
+#include <iterator>
+#include <limits>
+#include <ostream>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <mp++/detail/gmp.hpp>
+#include <mp++/detail/type_traits.hpp>
+#include <mp++/detail/utils.hpp>
+#include <mp++/integer.hpp>
+#include <mp++/rational.hpp>
+
+#if defined(MPPP_WITH_MPFR)
+#include <mp++/detail/mpfr.hpp>
+#include <mp++/real.hpp>
+#endif
+
+MPPP_BEGIN_NAMESPACE
+
+namespace detail
+{
+
+// A contiguous region of memory in the binary
+// representation of an object.
+struct bin_segment {
+    const char *ptr;
+    std::size_t size;
+};
+
+// The binary representation of an object, as a list of segments.
+struct bin_segments {
+    std::array<bin_segment, 4> segs;
+    std::size_t n;
+};
+
+// NOTE: the binary representation of an integer is the
+// mpz_size_t size followed by the limbs (see integer::binary_save()).
+template <std::size_t SSize>
+inline void bin_append_segments(bin_segments &s, const integer<SSize> &n)
+{
+    const auto &u = n._get_union();
+    const auto &size = u.is_static() ? u.g_st()._mp_size : u.g_dy()._mp_size;
+    const auto limbs = u.is_static() ? u.g_st().m_limbs.data() : u.g_dy()._mp_d;
+    s.segs[s.n++] = bin_segment{reinterpret_cast<const char *>(&size), sizeof(mpz_size_t)};
+    s.segs[s.n++] = bin_segment{reinterpret_cast<const char *>(limbs), n.size() * sizeof(::mp_limb_t)};
+}
+
+template <std::size_t SSize>
+inline bin_segments bin_get_segments(const integer<SSize> &n)
+{
+    bin_segments retval{};
+    bin_append_segments(retval, n);
+    return retval;
+}
+
+// NOTE: the binary representation of a rational is the
+// representation of the numerator followed by the representation
+// of the denominator.
+template <std::size_t SSize>
+inline bin_segments bin_get_segments(const rational<SSize> &q)
+{
+    bin_segments retval{};
+    bin_append_segments(retval, q.get_num());
+    bin_append_segments(retval, q.get_den());
+    return retval;
+}
+
+#if defined(MPPP_WITH_MPFR)
+
+// NOTE: the binary representation of a real is the precision,
+// the sign and the exponent followed by the limbs (see real::binary_save()).
+inline bin_segments bin_get_segments(const real &x)
+{
+    const auto &m = *x.get_mpfr_t();
+    constexpr auto base_size = sizeof(::mpfr_prec_t) + sizeof(::mpfr_sign_t) + sizeof(::mpfr_exp_t);
+
+    bin_segments retval{};
+    retval.segs[0] = bin_segment{reinterpret_cast<const char *>(&m._mpfr_prec), sizeof(::mpfr_prec_t)};
+    retval.segs[1] = bin_segment{reinterpret_cast<const char *>(&m._mpfr_sign), sizeof(::mpfr_sign_t)};
+    retval.segs[2] = bin_segment{reinterpret_cast<const char *>(&m._mpfr_exp), sizeof(::mpfr_exp_t)};
+    retval.segs[3] = bin_segment{reinterpret_cast<const char *>(m._mpfr_d), x.binary_size() - base_size};
+    retval.n = 4;
+    return retval;
+}
+
+#endif
+
+// Probe the binary size of a serialised object from the first avail bytes
+// of its binary representation, starting at src. If the return value is not greater
+// than avail, it is the binary size of the object. Otherwise, it is the number of bytes
+// which must be available in order to make progress.
+inline std::size_t bin_probe_mpz(const char *src, std::size_t avail)
+{
+    if (avail < sizeof(mpz_size_t)) {
+        return sizeof(mpz_size_t);
+    }
+    // NOLINTNEXTLINE(cppcoreguidelines-init-variables)
+    mpz_size_t size;
+    std::copy(src, src + sizeof(mpz_size_t), make_uai(reinterpret_cast<char *>(&size)));
+    const auto asize = size >= 0 ? make_unsigned(size) : nint_abs(size);
+    // LCOV_EXCL_START
+    if (mppp_unlikely(asize > (nl_max<std::size_t>() - sizeof(mpz_size_t)) / sizeof(::mp_limb_t))) {
+        throw std::overflow_error("Overflow in the computation of the binary size of an integer");
+    }
+    // LCOV_EXCL_STOP
+    return sizeof(mpz_size_t) + static_cast<std::size_t>(asize) * sizeof(::mp_limb_t);
+}
+
+template <std::size_t SSize>
+inline std::size_t bin_probe(const char *src, std::size_t avail, const integer<SSize> *)
+{
+    return bin_probe_mpz(src, avail);
+}
+
+template <std::size_t SSize>
+inline std::size_t bin_probe(const char *src, std::size_t avail, const rational<SSize> *)
+{
+    const auto nsize = bin_probe_mpz(src, avail);
+    if (nsize > avail) {
+        return nsize;
+    }
+    const auto dsize = bin_probe_mpz(src + nsize, avail - nsize);
+    // LCOV_EXCL_START
+    if (mppp_unlikely(dsize > nl_max<std::size_t>() - nsize)) {
+        throw std::overflow_error("Overflow in the computation of the binary size of a rational");
+    }
+    // LCOV_EXCL_STOP
+    return nsize + dsize;
+}
+
+#if defined(MPPP_WITH_MPFR)
+
+inline std::size_t bin_probe(const char *src, std::size_t avail, const real *)
+{
+    if (avail < sizeof(::mpfr_prec_t)) {
+        return sizeof(::mpfr_prec_t);
+    }
+    // NOLINTNEXTLINE(cppcoreguidelines-init-variables)
+    ::mpfr_prec_t p;
+    std::copy(src, src + sizeof(::mpfr_prec_t), make_uai(reinterpret_cast<char *>(&p)));
+    return real_binary_size_from_prec(p);
+}
+
+#endif
+
+// Load an object from the complete binary representation starting at src.
+template <std::size_t SSize>
+inline void bin_load(integer<SSize> &n, const char *src)
+{
+    n.binary_load(src);
+}
+
+template <std::size_t SSize>
+inline void bin_load(rational<SSize> &q, const char *src)
+{
+    const auto nsize = q._get_num().binary_load(src);
+    q._get_den().binary_load(src + nsize);
+    if (mppp_unlikely(q.get_den().sgn() <= 0 || !q.is_canonical())) {
+        // Reset to zero before throwing.
+        q = rational<SSize>{};
+        throw std::invalid_argument("Invalid data detected in the binary deserialisation of a rational: the "
+                                    "rational is not in canonical form");
+    }
+}
+
+#if defined(MPPP_WITH_MPFR)
+
+inline void bin_load(real &x, const char *src)
+{
+    x.binary_load(src);
+}
+
+#endif
+
+// Detect the types supported by the binary archive classes.
+template <typename>
+struct is_bin_archivable : std::false_type {
+};
+
+template <std::size_t SSize>
+struct is_bin_archivable<integer<SSize>> : std::true_type {
+};
+
+template <std::size_t SSize>
+struct is_bin_archivable<rational<SSize>> : std::true_type {
+};
+
+#if defined(MPPP_WITH_MPFR)
+
+template <>
+struct is_bin_archivable<real> : std::true_type {
+};
+
+#endif
+
+// Default size of the chunks used in the bulk functions.
+constexpr std::size_t bin_archive_chunk_size = 1u << 16;
+
+} // namespace detail
+
+// Chunked writer of the binary representation of a sequence of objects.
+template <typename It>
+class binary_archive_writer
+{
+    using value_t = detail::uncvref_t<decltype(*std::declval<const It &>())>;
+    static_assert(detail::is_bin_archivable<value_t>::value,
+                  "The binary archive writer supports only integers, rationals and reals.");
+
+public:
+    explicit binary_archive_writer(It begin, It end) : m_cur(std::move(begin)), m_end(std::move(end)) {}
+
+    // Write up to size bytes into dest.
+    std::size_t write(char *dest, std::size_t size)
+    {
+        std::size_t written = 0;
+        while (m_cur != m_end && written < size) {
+            // NOTE: bind the current object to a reference before fetching the
+            // segments, so that the segments remain valid if the iterator
+            // returns by value.
+            const auto &obj = *m_cur;
+            const auto s = detail::bin_get_segments(obj);
+            // NOTE: empty segments (e.g., the limbs of a zero integer)
+            // are consumed even if dest is full, so that done() becomes true
+            // as soon as the last byte of the sequence has been written.
+            while (m_seg < s.n && (written < size || s.segs[m_seg].size == 0u)) {
+                const auto &seg = s.segs[m_seg];
+                const auto n = std::min(seg.size - m_off, size - written);
+                std::copy(seg.ptr + m_off, seg.ptr + m_off + n, detail::make_uai(dest + written));
+                written += n;
+                m_off += n;
+                if (m_off == seg.size) {
+                    ++m_seg;
+                    m_off = 0;
+                }
+            }
+            if (m_seg == s.n) {
+                // The current object has been written completely,
+                // move to the next one.
+                ++m_cur;
+                ++m_count;
+                m_seg = 0;
+            }
+        }
+        return written;
+    }
+    // Check if the whole sequence has been written.
+    MPPP_NODISCARD bool done() const
+    {
+        return m_cur == m_end;
+    }
+    // Number of objects written completely.
+    MPPP_NODISCARD std::size_t count() const
+    {
+        return m_count;
+    }
+
+private:
+    It m_cur;
+    It m_end;
+    // Position within the binary representation of
+    // the current object: segment index and offset
+    // within the segment.
+    std::size_t m_seg = 0;
+    std::size_t m_off = 0;
+    std::size_t m_count = 0;
+};
+
+// Helper to create a binary_archive_writer.
+template <typename It>
+inline binary_archive_writer<It> make_binary_archive_writer(It begin, It end)
+{
+    return binary_archive_writer<It>(std::move(begin), std::move(end));
+}
+
+// Chunked reader of the binary representation of a sequence of objects.
+template <typename T>
+class binary_archive_reader
+{
+    static_assert(detail::is_bin_archivable<T>::value,
+                  "The binary archive reader supports only integers, rationals and reals.");
+
+    // Load an object from src into the location pointed to by out.
+    // NOTE: if out yields references to T, load in-place in order
+    // to re-use the storage of the existing objects.
+    // NOTE: otherwise, load into a fresh object each time, as
+    // a moved-from object may not be a valid target for bin_load()
+    // (e.g., a moved-from real has no limb storage).
+    template <typename OutIt>
+    static void load_one(const char *src, OutIt &out, const std::true_type &)
+    {
+        detail::bin_load(*out, src);
+    }
+    template <typename OutIt>
+    static void load_one(const char *src, OutIt &out, const std::false_type &)
+    {
+        T tmp;
+        detail::bin_load(tmp, src);
+        *out = std::move(tmp);
+    }
+    template <typename OutIt>
+    void load_one(const char *src, OutIt &out)
+    {
+        load_one(src, out, std::is_same<decltype(*out), T &>{});
+        ++out;
+        ++m_count;
+    }
+
+    template <typename OutIt>
+    OutIt read_impl(const char *src, std::size_t size, OutIt out)
+    {
+        // Complete the object whose representation
+        // straddles the previous chunk, if any.
+        while (!m_buffer.empty() && size != 0u) {
+            const auto need = detail::bin_probe(m_buffer.data(), m_buffer.size(), static_cast<const T *>(nullptr));
+            if (need <= m_buffer.size()) {
+                break;
+            }
+            const auto n = std::min(need - m_buffer.size(), size);
+            m_buffer.insert(m_buffer.end(), src, src + n);
+            src += n;
+            size -= n;
+        }
+        if (!m_buffer.empty()) {
+            if (detail::bin_probe(m_buffer.data(), m_buffer.size(), static_cast<const T *>(nullptr))
+                > m_buffer.size()) {
+                // src was consumed completely without
+                // completing the pending object.
+                return out;
+            }
+            load_one(m_buffer.data(), out);
+            m_buffer.clear();
+        }
+
+        // Load the objects whose representation is fully
+        // contained in src directly from src.
+        while (size != 0u) {
+            const auto need = detail::bin_probe(src, size, static_cast<const T *>(nullptr));
+            if (need > size) {
+                // Stash the incomplete representation for the next call.
+                m_buffer.assign(src, src + size);
+                break;
+            }
+            load_one(src, out);
+            src += need;
+            size -= need;
+        }
+
+        return out;
+    }
+
+public:
+    // Consume size bytes from src, writing the completely
+    // deserialised objects into out.
+    template <typename OutIt>
+    OutIt read(const char *src, std::size_t size, OutIt out)
+    {
+        try {
+            return read_impl(src, size, std::move(out));
+        } catch (...) {
+            // NOTE: in case of errors, discard the
+            // incomplete representation and rethrow.
+            m_buffer.clear();
+            throw;
+        }
+    }
+    // Check if the representation of an object
+    // has been read only partially.
+    MPPP_NODISCARD bool pending() const
+    {
+        return !m_buffer.empty();
+    }
+    // Number of objects read completely.
+    MPPP_NODISCARD std::size_t count() const
+    {
+        return m_count;
+    }
+
+private:
+    std::vector<char> m_buffer;
+    std::size_t m_count = 0;
+};
+
+// Serialise a sequence of objects into a stream.
+template <typename It>
+inline std::size_t binary_save_range(std::ostream &dest, It begin, It end)
+{
+    MPPP_MAYBE_TLS std::vector<char> buffer;
+    buffer.resize(detail::bin_archive_chunk_size);
+
+    binary_archive_writer<It> w(std::move(begin), std::move(end));
+    std::size_t retval = 0;
+    while (!w.done()) {
+        const auto n = w.write(buffer.data(), buffer.size());
+        dest.write(buffer.data(), detail::safe_cast<std::streamsize>(n));
+        if (!dest.good()) {
+            // NOTE: like in binary_save(), return 0
+            // if an error occurred while writing.
+            return 0;
+        }
+        // LCOV_EXCL_START
+        if (mppp_unlikely(n > detail::nl_max<std::size_t>() - retval)) {
+            throw std::overflow_error("Overflow in the computation of the size of a binary archive");
+        }
+        // LCOV_EXCL_STOP
+        retval += n;
+    }
+    return retval;
+}
+
+// Deserialise from a stream a sequence of objects of type T,
+// until the end of the stream is reached.
+template <typename T, typename OutIt>
+inline OutIt binary_load_range(std::istream &src, OutIt out)
+{
+    MPPP_MAYBE_TLS std::vector<char> buffer;
+    buffer.resize(detail::bin_archive_chunk_size);
+
+    binary_archive_reader<T> r;
+    while (true) {
+        src.read(buffer.data(), detail::safe_cast<std::streamsize>(buffer.size()));
+        const auto n = static_cast<std::size_t>(src.gcount());
+        if (n == 0u) {
+            break;
+        }
+        out = r.read(buffer.data(), n, std::move(out));
+    }
+    if (mppp_unlikely(src.bad())) {
+        throw std::runtime_error("An error occurred while reading a binary archive from a stream");
+    }
+    if (mppp_unlikely(r.pending())) {
+        throw std::invalid_argument("Truncated binary archive: the end of the stream was reached while "
+                                    "reading the representation of an object");
+    }
+    return out;
+}
+
+MPPP_END_NAMESPACE
+
+#endif
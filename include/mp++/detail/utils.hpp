@@ -87,6 +87,31 @@ MPPP_DLL_PUBLIC std::string to_string(__int128_t);
 
 #endif
 
+// Number of chunks into which parallel_for_chunks() will split a range of
+// n elements when using nthreads threads. A value of zero for nthreads
+// means the number of hardware threads.
+MPPP_DLL_PUBLIC std::size_t parallel_nchunks(std::size_t, unsigned);
+
+// Split the index range [0, n) into parallel_nchunks(n, nthreads) contiguous chunks,
+// and invoke f(data, chunk_idx, begin, end) on each chunk in a separate thread
+// (the first chunk is processed by the calling thread). If any invocation of f
+// throws, the exception thrown by the chunk with the lowest index is re-thrown
+// after all threads have been joined.
+MPPP_DLL_PUBLIC void parallel_for_chunks(std::size_t, unsigned, void (*)(void *, std::size_t, std::size_t, std::size_t),
+                                         void *);
+
+// Convenience wrapper for the above, invoking f(chunk_idx, begin, end).
+template <typename F>
+inline void parallel_for_chunks(std::size_t n, unsigned nthreads, F &f)
+{
+    parallel_for_chunks(
+        n, nthreads,
+        [](void *data, std::size_t chunk_idx, std::size_t begin, std::size_t end) {
+            (*static_cast<F *>(data))(chunk_idx, begin, end);
+        },
+        &f);
+}
+
 // Compute the absolute value of a negative integer, returning the result as an instance
 // of the corresponding unsigned type. Requires T to be a signed integral type and n
 // to be negative.
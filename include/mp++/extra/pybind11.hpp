@@ -35,7 +35,9 @@
 
 #include <mp++/mp++.hpp>
 
+#include <algorithm>
 #include <cassert>
+#include <climits>
 #include <cstddef>
 #include <exception>
 #include <iostream>
@@ -46,6 +48,7 @@
 #include <string>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 namespace mppp_pybind11
 {
@@ -202,48 +205,94 @@ inline void init()
 namespace detail
 {
 
-// Convert a Python long object to an mppp integer.
-template <std::size_t SSize>
-inline mppp::integer<SSize> py_long_to_mppp_int(const ::PyLongObject *nptr)
+static_assert(PyLong_SHIFT < GMP_NUMB_BITS, "The size of a Python digit is too large.");
+
+// Fetch the signed size of a Python long object.
+inline ::Py_ssize_t py_long_size(const ::PyLongObject *nptr)
 {
-    // Get its signed size.
-    const auto ob_size =
 #if PY_MAJOR_VERSION == 2
-        nptr->ob_size;
+    return nptr->ob_size;
 #else
-        nptr->ob_base.ob_size;
+    return nptr->ob_base.ob_size;
 #endif
+}
+
+// Pack the n Python digits starting at dp into the limb array rp,
+// which must have room for the result. The number of limbs written is returned.
+inline std::size_t py_digits_to_limbs(::mp_limb_t *rp, const ::digit *dp, std::size_t n)
+{
+    std::size_t rn = 0;
+    ::mp_limb_t acc = 0;
+    unsigned acc_bits = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        const auto d = static_cast<::mp_limb_t>(dp[i]);
+        acc |= d << acc_bits;
+        acc_bits += PyLong_SHIFT;
+        if (acc_bits >= unsigned(GMP_NUMB_BITS)) {
+            // The current limb is complete. The bits of d which
+            // did not fit in it go into the next limb.
+            rp[rn++] = acc & GMP_NUMB_MASK;
+            acc_bits -= unsigned(GMP_NUMB_BITS);
+            acc = acc_bits ? d >> (PyLong_SHIFT - acc_bits) : 0u;
+        }
+    }
+    // NOTE: the last limb is written only if nonzero, so
+    // that the result is normalised.
+    if (acc) {
+        rp[rn++] = acc;
+    }
+    return rn;
+}
+
+// Convert a Python long object to an mppp integer.
+// NOTE: the digits of the Python integer are packed directly
+// into the limbs of rop, thus the conversion is linear in the
+// number of digits. If rop is static and the result fits in static
+// storage, no memory allocation takes place.
+template <std::size_t SSize>
+inline void py_long_to_mppp_int(mppp::integer<SSize> &rop, const ::PyLongObject *nptr)
+{
+    const auto ob_size = py_long_size(nptr);
     if (!ob_size) {
-        // The Python integer is zero, return a def cted value.
-        return mppp::integer<SSize>{};
+        rop.set_zero();
+        return;
     }
-    // Get the limbs array.
     const auto ob_digit = nptr->ob_digit;
     const bool neg = ob_size < 0;
-    using size_type = typename std::make_unsigned<typename std::remove_const<decltype(ob_size)>::type>::type;
-    auto abs_ob_size = neg ? mppp::detail::nint_abs(ob_size) : static_cast<size_type>(ob_size);
-    static_assert(PyLong_SHIFT <= std::numeric_limits<::mp_bitcnt_t>::max(), "Overflow error.");
-    if (mppp_unlikely(static_cast<::mp_bitcnt_t>(PyLong_SHIFT)
-                      > std::numeric_limits<::mp_bitcnt_t>::max() / abs_ob_size)) {
+    const auto abs_ob_size = mppp::detail::safe_cast<std::size_t>(neg ? mppp::detail::nint_abs(ob_size)
+                                                                      : mppp::detail::make_unsigned(ob_size));
+    // Compute the exact number of bits of the Python integer.
+    // NOTE: the top digit of a Python integer is nonzero.
+    assert(ob_digit[abs_ob_size - 1u]);
+    if (mppp_unlikely(abs_ob_size - 1u > std::numeric_limits<::mp_bitcnt_t>::max() / unsigned(PyLong_SHIFT))) {
         throw std::overflow_error("Overflow in the computation of the size of a Python integer");
     }
-    const auto nbits = static_cast<::mp_bitcnt_t>(static_cast<::mp_bitcnt_t>(PyLong_SHIFT) * abs_ob_size);
-    // Construct the retval with the necessary number of bits.
-    mppp::integer<SSize> retval{mppp::integer_bitcnt_t(nbits)};
-    // Init it with the first digit. The Python integer is nonzero, so this is safe.
-    retval = ob_digit[--abs_ob_size];
-    // Add the remaining limbs.
-    while (abs_ob_size) {
-        // NOTE: a possible optimisation here is to unroll the shifting in order to
-        // reduce the loop iterations.
-        retval <<= PyLong_SHIFT;
-        retval += ob_digit[--abs_ob_size];
-    }
-    // Negate if necessary.
-    if (neg) {
-        retval.neg();
+    const auto nbits = static_cast<::mp_bitcnt_t>(static_cast<::mp_bitcnt_t>(abs_ob_size - 1u) * unsigned(PyLong_SHIFT)
+                                                  + mppp::detail::limb_size_nbits(ob_digit[abs_ob_size - 1u]));
+    const auto nlimbs = mppp::detail::safe_cast<std::size_t>(mppp::detail::nbits_to_nlimbs(nbits));
+
+    auto &u = rop._get_union();
+    if (u.is_static() && nlimbs <= SSize) {
+        // Static fast path.
+        auto &st = u.g_st();
+        const auto rn = py_digits_to_limbs(st.m_limbs.data(), ob_digit, abs_ob_size);
+        assert(rn == nlimbs);
+        st.zero_upper_limbs(rn);
+        st._mp_size = static_cast<mppp::detail::mpz_size_t>(neg ? -static_cast<mppp::detail::mpz_size_t>(rn)
+                                                                 : static_cast<mppp::detail::mpz_size_t>(rn));
+        return;
     }
-    return retval;
+    if (u.is_static() || static_cast<std::size_t>(u.g_dy()._mp_alloc) < nlimbs) {
+        // NOTE: here rop is static and the result does not fit in static storage,
+        // or rop is dynamic without enough storage. Create a dynamic integer
+        // with enough storage.
+        rop = mppp::integer<SSize>{mppp::integer_bitcnt_t(std::max(nbits, ::mp_bitcnt_t(SSize * GMP_NUMB_BITS + 1u)))};
+    }
+    auto &dy = u.g_dy();
+    const auto rn = py_digits_to_limbs(dy._mp_d, ob_digit, abs_ob_size);
+    assert(rn == nlimbs);
+    dy._mp_size = static_cast<mppp::detail::mpz_size_t>(neg ? -static_cast<mppp::detail::mpz_size_t>(rn)
+                                                            : static_cast<mppp::detail::mpz_size_t>(rn));
 }
 
 // Convert a python integer to an mppp integer.
@@ -257,7 +306,7 @@ inline bool py_integer_to_mppp_int(mppp::integer<SSize> &rop, const ::PyObject *
     }
     if (is_long) {
         assert(!is_int);
-        rop = py_long_to_mppp_int<SSize>((const ::PyLongObject *)source);
+        py_long_to_mppp_int(rop, (const ::PyLongObject *)source);
         return true;
     }
     assert(is_int);
@@ -267,38 +316,71 @@ inline bool py_integer_to_mppp_int(mppp::integer<SSize> &rop, const ::PyObject *
     if (!PyLong_Check(source)) {
         return false;
     }
-    rop = py_long_to_mppp_int<SSize>((const ::PyLongObject *)source);
+    py_long_to_mppp_int(rop, (const ::PyLongObject *)source);
     return true;
 #endif
 }
 
 // Convert mppp integer to a python integer.
-// NOTE: this can be improved via the direct C API at least in the following ways:
-// - pybind11 always stores long ints in int_, for Python 2 this is suboptimal,
-// - using the number protocol, https://docs.python.org/3.6/c-api/number.html,
-//   may be more efficient that calling int_ methods via pybind11.
+// NOTE: the limbs of src are exported into a little-endian byte
+// array, from which the Python integer is then built in a single
+// pass, thus the conversion is linear in the number of limbs.
 template <std::size_t SSize>
 inline py::int_ mppp_int_to_py(const mppp::integer<SSize> &src)
 {
-    if (src.is_zero()) {
-        // Just return a def-cted int for zero.
-        return py::int_();
-    }
-    // Get a pointer to the limbs.
-    const ::mp_limb_t *ptr = src.is_static() ? src._get_union().g_st().m_limbs.data() : src._get_union().g_dy()._mp_d;
-    // Get the size.
-    auto size = src.size();
-    assert(size);
-    // Init the retval.
-    py::int_ retval(ptr[--size] & GMP_NUMB_MASK);
-    // Add the rest of the limbs arithmetically.
-    while (size) {
-        retval = retval.attr("__lshift__")(*mppp_pybind11::detail::globals::gmp_numb_bits)
-                     .attr("__add__")(py::int_(ptr[--size] & GMP_NUMB_MASK));
-    }
-    // Negate if needed.
-    if (src.sgn() < 0) {
-        retval = retval.attr("__neg__")();
+    const auto &u = src._get_union();
+    const ::mp_limb_t *ptr = u.is_static() ? u.g_st().m_limbs.data() : u.g_dy()._mp_d;
+    const auto size = src.size();
+    const bool neg = src.sgn() < 0;
+
+    if (size <= 1u) {
+        // Fast path for zero and single-limb values.
+        const auto l = size ? static_cast<unsigned long long>(ptr[0] & GMP_NUMB_MASK) : 0ull;
+        if (!neg || l <= static_cast<unsigned long long>(std::numeric_limits<long long>::max())) {
+            const auto retptr
+                = neg ? ::PyLong_FromLongLong(-static_cast<long long>(l)) : ::PyLong_FromUnsignedLongLong(l);
+            if (mppp_unlikely(!retptr)) {
+                throw py::error_already_set();
+            }
+            return py::reinterpret_steal<py::int_>(retptr);
+        }
+    }
+
+    const auto nbits = src.nbits();
+    MPPP_MAYBE_TLS std::vector<unsigned char> buffer;
+    buffer.resize(
+        mppp::detail::safe_cast<std::size_t>(nbits / CHAR_BIT + static_cast<unsigned>(nbits % CHAR_BIT != 0u)));
+    std::size_t count = 0;
+    mpz_export(buffer.data(), &count, -1, 1, 0, 0, src.get_mpz_view());
+    assert(count == buffer.size());
+#if PY_MAJOR_VERSION == 2
+    // NOTE: Python 2 does not have int.from_bytes(). Its C API
+    // is frozen, hence relying on a private function is safe here.
+    auto retptr = ::_PyLong_FromByteArray(buffer.data(), count, 1, 0);
+    if (mppp_unlikely(!retptr)) {
+        throw py::error_already_set();
+    }
+    auto retval = py::reinterpret_steal<py::int_>(retptr);
+#elif PY_VERSION_HEX >= 0x030D0000
+    auto retptr = ::PyLong_FromNativeBytes(buffer.data(), count,
+                                           Py_ASNATIVEBYTES_LITTLE_ENDIAN | Py_ASNATIVEBYTES_UNSIGNED_BUFFER);
+    if (mppp_unlikely(!retptr)) {
+        throw py::error_already_set();
+    }
+    auto retval = py::reinterpret_steal<py::int_>(retptr);
+#else
+    // NOTE: before Python 3.13 there is no public C function to build an integer
+    // from a byte array, thus we go through int.from_bytes(), which also runs in linear time.
+    const auto int_type = py::reinterpret_borrow<py::object>(reinterpret_cast<::PyObject *>(&::PyLong_Type));
+    const py::bytes bytes(reinterpret_cast<const char *>(buffer.data()), count);
+    py::int_ retval(int_type.attr("from_bytes")(bytes, "little"));
+#endif
+    if (neg) {
+        const auto negptr = ::PyNumber_Negative(retval.ptr());
+        if (mppp_unlikely(!negptr)) {
+            throw py::error_already_set();
+        }
+        retval = py::reinterpret_steal<py::int_>(negptr);
     }
     return retval;
 }
@@ -539,6 +621,48 @@ inline py::handle complex_to_py_handle(const mppp::complex &src)
 
 } // namespace detail
 
+// Batch conversion of a Python list or tuple of integers into a vector of integers.
+template <std::size_t SSize>
+inline void py_to_integers(std::vector<mppp::integer<SSize>> &out, py::handle src)
+{
+    if (!PyList_Check(src.ptr()) && !PyTuple_Check(src.ptr())) {
+        throw py::type_error("The batch conversion of Python integers requires a list or a tuple as input");
+    }
+    const auto size = mppp::detail::safe_cast<std::size_t>(PySequence_Fast_GET_SIZE(src.ptr()));
+    const auto items = PySequence_Fast_ITEMS(src.ptr());
+    // NOTE: the existing elements of out are re-used,
+    // so that their storage can be recycled.
+    out.resize(size);
+    for (std::size_t i = 0; i < size; ++i) {
+        if (!detail::py_integer_to_mppp_int(out[i], items[i])) {
+            throw py::type_error("The element at index " + std::to_string(i)
+                                 + " of the input sequence is not an integer");
+        }
+    }
+}
+
+// Batch conversion of an array of integers into a Python list.
+template <std::size_t SSize>
+inline py::list integers_to_py_list(const mppp::integer<SSize> *data, std::size_t n)
+{
+    py::list retval(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        PyList_SET_ITEM(retval.ptr(), static_cast<::Py_ssize_t>(i), detail::mppp_int_to_py(data[i]).release().ptr());
+    }
+    return retval;
+}
+
+// Batch conversion of an array of integers into a Python tuple.
+template <std::size_t SSize>
+inline py::tuple integers_to_py_tuple(const mppp::integer<SSize> *data, std::size_t n)
+{
+    py::tuple retval(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        PyTuple_SET_ITEM(retval.ptr(), static_cast<::Py_ssize_t>(i), detail::mppp_int_to_py(data[i]).release().ptr());
+    }
+    return retval;
+}
+
 } // namespace mppp_pybind11
 
 namespace pybind11
@@ -16,6 +16,7 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <cassert>
 #include <cinttypes>
 #include <cmath>
@@ -23,6 +24,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <cstdlib>
+#include <cstring>
 #include <functional>
 #include <initializer_list>
 #include <ios>
@@ -117,6 +119,10 @@ MPPP_BEGIN_NAMESPACE
 // of integer from number of bits.
 enum class integer_bitcnt_t : ::mp_bitcnt_t {};
 
+// Rounding modes for the conversion of integer
+// and rational to double.
+enum class fp_rounding { nearest, toward_zero, upward, downward };
+
 namespace detail
 {
 
@@ -167,20 +173,32 @@ struct MPPP_DLL_PUBLIC mpz_alloc_cache {
     std::array<std::array<::mp_limb_t *, max_entries>, max_size> caches;
     // The number of arrays actually stored in each cache entry.
     std::array<std::size_t, max_size> sizes;
+    // Statistics. They are written only by the thread owning
+    // the cache, but they may be read by other threads.
+    std::atomic<std::uint64_t> hits;
+    std::atomic<std::uint64_t> misses;
+    std::atomic<std::uint64_t> evictions;
+    // Mirror of sizes, for the benefit of other threads.
+    std::array<std::atomic<std::size_t>, max_size> held;
+    // Registration status in the global registry of caches:
+    // 0 -> not registered, 1 -> registered, 2 -> destroyed.
+    unsigned char reg_status;
     // NOTE: use round brackets init for the usual GCC 4.8 workaround.
-    // NOTE: this will zero initialise recursively both members: we will
+    // NOTE: this will zero initialise recursively the array members: we will
     // have all nullptrs in the caches, and all cache sizes will be zeroes.
-    constexpr mpz_alloc_cache() noexcept : caches(), sizes() {}
+    constexpr mpz_alloc_cache() noexcept
+        : caches(), sizes(), hits(0), misses(0), evictions(0), held(), reg_status(0)
+    {
+    }
     mpz_alloc_cache(const mpz_alloc_cache &) = delete;
     mpz_alloc_cache(mpz_alloc_cache &&) = delete;
     mpz_alloc_cache &operator=(const mpz_alloc_cache &) = delete;
     mpz_alloc_cache &operator=(mpz_alloc_cache &&) = delete;
     // Clear the cache, deallocating all the data in the arrays.
     void clear() noexcept;
-    ~mpz_alloc_cache()
-    {
-        clear();
-    }
+    // Free the arrays exceeding the runtime limits.
+    void trim(std::size_t, std::size_t) noexcept;
+    ~mpz_alloc_cache();
 };
 
 #if defined(_MSC_VER) && defined(__clang__)
@@ -197,6 +215,10 @@ MPPP_DLL_PUBLIC mpz_alloc_cache &get_thread_local_mpz_cache();
 
 #endif
 
+// Check if any thread has ever used its mpz allocation cache, that is,
+// if mp++ has allocated the storage of a dynamic integer via GMP.
+MPPP_DLL_PUBLIC bool mpz_alloc_cache_used();
+
 // Helper function to init an mpz to zero with nlimbs preallocated limbs.
 MPPP_DLL_PUBLIC void mpz_init_nlimbs(mpz_struct_t &, std::size_t);
 
@@ -290,6 +312,51 @@ inline unsigned builtin_clz(T n)
     return static_cast<unsigned>(builtin_clz_impl(n));
 }
 
+// Same as above, for the number of trailing zeroes.
+inline int builtin_ctz_impl(unsigned n)
+{
+    return __builtin_ctz(n);
+}
+
+inline int builtin_ctz_impl(unsigned long n)
+{
+    return __builtin_ctzl(n);
+}
+
+inline int builtin_ctz_impl(unsigned long long n)
+{
+    return __builtin_ctzll(n);
+}
+
+template <typename T>
+inline unsigned builtin_ctz(T n)
+{
+    assert(n != 0u);
+    return static_cast<unsigned>(builtin_ctz_impl(n));
+}
+
+// Same as above, for the population count.
+inline int builtin_popcount_impl(unsigned n)
+{
+    return __builtin_popcount(n);
+}
+
+inline int builtin_popcount_impl(unsigned long n)
+{
+    return __builtin_popcountl(n);
+}
+
+inline int builtin_popcount_impl(unsigned long long n)
+{
+    return __builtin_popcountll(n);
+}
+
+template <typename T>
+inline unsigned builtin_popcount(T n)
+{
+    return static_cast<unsigned>(builtin_popcount_impl(n));
+}
+
 #endif
 
 // Determine the size in (numeric) bits of limb l.
@@ -320,6 +387,180 @@ inline unsigned limb_size_nbits(::mp_limb_t l)
 #endif
 }
 
+// GCD of two nonzero limbs.
+inline ::mp_limb_t limb_gcd(::mp_limb_t a, ::mp_limb_t b)
+{
+    assert(a != 0u && b != 0u);
+#if (defined(__clang__) || defined(__GNUC__)) && !GMP_NAIL_BITS
+    // Binary GCD using the ctz builtin. This is faster than mpn_gcd_1()
+    // when the result is consumed by short inline sequences of operations
+    // (e.g., in the rational fast paths), as it avoids the function call.
+    // NOTE: the loop body is written so that it compiles
+    // to branchless code on the common architectures.
+    const auto za = builtin_ctz(a), zb = builtin_ctz(b);
+    const auto shift = c_min(za, zb);
+    a >>= za;
+    b >>= zb;
+    while (a != b) {
+        const auto m = c_min(a, b);
+        const auto d = (a > b) ? a - b : b - a;
+        a = m;
+        b = d >> builtin_ctz(d);
+    }
+    return a << shift;
+#else
+    return mpn_gcd_1(&a, static_cast<::mp_size_t>(1), b);
+#endif
+}
+
+// Round to double the value (w + f) * 2**e, where w is a 64-bit window whose
+// most significant bit is set, and f is a fraction in [0, 1) which is nonzero
+// if and only if sticky is true. neg is the sign of the value.
+inline double round_window_to_double(std::uint_least64_t w, bool sticky, long long e, bool neg, fp_rounding rnd)
+{
+    using lim = std::numeric_limits<double>;
+    static_assert(lim::radix == 2 && lim::digits < 64, "Unsupported floating-point format.");
+
+    assert((w >> 63) == 1u);
+
+    // Exponent of the most significant bit of the value,
+    // and the min/max exponents of the normal doubles.
+    const auto emsb = e + 63, emin = static_cast<long long>(lim::min_exponent - 1),
+               emax = static_cast<long long>(lim::max_exponent - 1);
+
+    // Number of bits of the window to be rounded off. In the subnormal
+    // range, this increases as the value gets smaller.
+    // NOTE: when sh would be greater than 64, all the bits of the window are rounded off
+    // and the value is smaller than half the smallest subnormal. We represent
+    // this situation with sh == 65.
+    unsigned sh = 64u - static_cast<unsigned>(lim::digits);
+    if (emsb < emin) {
+        sh = emin - emsb > lim::digits ? 65u : sh + static_cast<unsigned>(emin - emsb);
+    }
+
+    // Split the window into the retained mantissa m and the rounded-off
+    // bits rb, and compute the value of half a unit in the last place.
+    std::uint_least64_t m, rb, half;
+    if (sh == 65u) {
+        m = 0;
+        rb = 1;
+        half = 2;
+    } else if (sh == 64u) {
+        m = 0;
+        rb = w;
+        half = std::uint_least64_t(1) << 63;
+    } else {
+        m = w >> sh;
+        rb = w & ((std::uint_least64_t(1) << sh) - 1u);
+        half = std::uint_least64_t(1) << (sh - 1u);
+    }
+
+    const auto inexact = rb != 0u || sticky;
+    bool away;
+    switch (rnd) {
+        case fp_rounding::nearest:
+            // NOTE: round to nearest, ties to even.
+            away = rb > half || (rb == half && (sticky || (m & 1u) != 0u));
+            break;
+        case fp_rounding::toward_zero:
+            away = false;
+            break;
+        case fp_rounding::upward:
+            away = inexact && !neg;
+            break;
+        default:
+            away = inexact && neg;
+    }
+    m += static_cast<std::uint_least64_t>(away);
+
+    // Exponent of the least significant bit of m. In the subnormal
+    // range, this is the exponent of the smallest subnormal.
+    const auto elsb = sh == 65u ? emin - lim::digits + 1 : e + static_cast<long long>(sh);
+
+    // Overflow check. The rounding might have carried m over to 2**digits.
+    const auto top = std::uint_least64_t(1) << lim::digits;
+    if (elsb + lim::digits - 1 > emax || (elsb + lim::digits - 1 == emax && m == top)) {
+        // NOTE: the result is infinity if we are rounding away from zero,
+        // the largest finite value otherwise.
+        const auto inf_result = rnd == fp_rounding::nearest || (rnd == fp_rounding::upward && !neg)
+                                || (rnd == fp_rounding::downward && neg);
+        const auto ret = inf_result ? lim::infinity() : lim::max();
+        return neg ? -ret : ret;
+    }
+
+    double ret;
+    if (lim::is_iec559 && lim::digits == 53 && lim::min_exponent == -1021) {
+        // Assemble directly the bit pattern of the IEEE double. For normal values, m
+        // is in [2**52, 2**53] and the implicit bit adds 1 to the biased exponent
+        // (thus the rounding carry to 2**53 propagates correctly into the exponent).
+        // For subnormal values, elsb == -1074 and the biased exponent is zero.
+        const auto bits = (static_cast<std::uint_least64_t>(elsb + 1074) << 52) + m;
+        static_assert(sizeof(double) == sizeof(bits), "Invalid size.");
+        std::memcpy(&ret, &bits, sizeof(double));
+    } else {
+        // NOTE: m has at most digits + 1 bits, thus its conversion
+        // to double is exact, as is the scaling via ldexp() (the carry case
+        // has a zero in the lowest bit).
+        ret = std::ldexp(static_cast<double>(m), static_cast<int>(elsb));
+    }
+    return neg ? -ret : ret;
+}
+
+// Round to double the value (n + f) * 2**e, where n is the nonzero unsigned
+// value represented by the size limbs in ptr, and f is a fraction in [0, 1)
+// which is nonzero if and only if sticky is true. neg is the sign of the value.
+inline double limbs_to_double(const ::mp_limb_t *ptr, std::size_t size, bool neg, bool sticky, long long e,
+                              fp_rounding rnd)
+{
+    assert(size > 0u && (ptr[size - 1u] & GMP_NUMB_MASK) != 0u);
+
+    constexpr unsigned nbits = GMP_NUMB_BITS;
+    static_assert(nbits <= 64u, "Invalid number of bits.");
+
+    // Fill the 64-bit window w with the top bits of the value,
+    // starting from the most significant limb.
+    std::uint_least64_t w = 0;
+    unsigned filled = 0, avail = limb_size_nbits(ptr[size - 1u]);
+    const auto tot_nbits = static_cast<long long>(size - 1u) * nbits + avail;
+    auto i = size;
+    if (nbits == 64u && size >= 2u) {
+        // Fast path for full 64-bit limbs: the window is made of
+        // the top limb and of the high bits of the limb below.
+        const auto hi = static_cast<std::uint_least64_t>(ptr[size - 1u]),
+                   lo = static_cast<std::uint_least64_t>(ptr[size - 2u]);
+        const auto sh = 64u - avail;
+        w = sh == 0u ? hi : ((hi << sh) | (lo >> avail));
+        sticky = sticky || (sh == 0u ? lo : (lo << sh)) != 0u;
+        filled = 64;
+        i = size - 2u;
+    }
+    while (i != 0u && filled < 64u) {
+        --i;
+        const auto l = static_cast<std::uint_least64_t>(ptr[i] & GMP_NUMB_MASK);
+        const auto take = c_min(avail, 64u - filled);
+        if (take == 64u) {
+            w = l;
+        } else {
+            w = (w << take) | ((l >> (avail - take)) & ((std::uint_least64_t(1) << take) - 1u));
+            // The bits of the limb which do not fit in the window are folded into the sticky flag.
+            sticky = sticky || (l & ((std::uint_least64_t(1) << (avail - take)) - 1u)) != 0u;
+        }
+        filled += take;
+        avail = nbits;
+    }
+    // Fold the remaining limbs into the sticky flag.
+    while (!sticky && i != 0u) {
+        --i;
+        sticky = (ptr[i] & GMP_NUMB_MASK) != 0u;
+    }
+    // Normalise the window.
+    if (filled < 64u) {
+        w <<= 64u - filled;
+    }
+
+    return round_window_to_double(w, sticky, e + tot_nbits - 64, neg, rnd);
+}
+
 // Machinery for the conversion of a large uint to a limb array.
 
 // Definition of the limb array type.
@@ -384,6 +625,29 @@ inline std::size_t uint_to_limb_array(limb_array_t<T> &rop, T n)
     return size;
 }
 
+// Helpers to split a C++ integral into its absolute value and its sign.
+template <typename T, enable_if_t<conjunction<is_integral<T>, is_unsigned<T>>::value, int> = 0>
+inline T integral_abs_neg(const T &n, bool &neg)
+{
+    neg = false;
+    return n;
+}
+
+// NOTE: special-case bool in order to avoid spurious compiler warnings when
+// mixing up bool and other integral types.
+inline unsigned integral_abs_neg(bool n, bool &neg)
+{
+    neg = false;
+    return static_cast<unsigned>(n);
+}
+
+template <typename T, enable_if_t<conjunction<is_integral<T>, is_signed<T>>::value, int> = 0>
+inline make_unsigned_t<T> integral_abs_neg(const T &n, bool &neg)
+{
+    neg = n < T(0);
+    return neg ? nint_abs(n) : make_unsigned(n);
+}
+
 // Small utility to check that no nail bits are set.
 inline bool check_no_nails(const ::mp_limb_t &l)
 {
@@ -407,6 +671,18 @@ inline mpz_size_t size_from_lohi(const ::mp_limb_t &lo, const ::mp_limb_t &hi)
     return static_cast<mpz_size_t>(hinz * 2u + (static_cast<unsigned>(!hinz) & lonz));
 }
 
+// Small utility to compute the absolute value of the size of an N-limbs number
+// from its limbs. Requires no nail bits.
+template <std::size_t N>
+inline mpz_size_t size_from_limbs(const ::mp_limb_t *data)
+{
+    auto asize = static_cast<mpz_size_t>(N);
+    while (asize != 0 && data[asize - 1] == 0u) {
+        --asize;
+    }
+    return asize;
+}
+
 // Branchless sign function for C++ integrals:
 // https://stackoverflow.com/questions/1903954/is-there-a-standard-sign-function-signum-sgn-in-c-c
 template <typename T>
@@ -452,7 +728,7 @@ struct static_int {
     // being zero, thus whenever we use mpn functions on a static int we need to
     // take care of ensuring that this invariant is respected (see dtor_checks() and
     // zero_unused_limbs(), for instance).
-    static const std::size_t opt_size = 2;
+    static const std::size_t opt_size = 4;
     // Zero the limbs from index idx up to the end of the limbs array, but only
     // if the static size is a target for special optimisations.
     void zero_upper_limbs(std::size_t idx)
@@ -639,6 +915,308 @@ struct static_int {
     limbs_type m_limbs;
 };
 
+// The limb representation of a C++ integral. This is used in the mixed-mode
+// operations between integer and C++ integrals, in order to avoid
+// the construction of a temporary integer.
+template <typename T>
+class integral_limbs
+{
+    using uint_t = decltype(integral_abs_neg(std::declval<const T &>(), std::declval<bool &>()));
+
+public:
+    explicit integral_limbs(const T &n)
+    {
+        bool neg = false;
+        const auto un = integral_abs_neg(n, neg);
+        if (un <= GMP_NUMB_MAX) {
+            // NOTE: no need for masking, as we know un <= GMP_NUMB_MAX.
+            m_limbs[0] = static_cast<::mp_limb_t>(un);
+            m_size = static_cast<mpz_size_t>(un != 0u);
+        } else {
+            m_size = static_cast<mpz_size_t>(uint_to_limb_array(m_limbs, un));
+        }
+        if (neg) {
+            m_size = -m_size;
+        }
+    }
+    integral_limbs(const integral_limbs &) = delete;
+    integral_limbs(integral_limbs &&) = delete;
+    integral_limbs &operator=(const integral_limbs &) = delete;
+    integral_limbs &operator=(integral_limbs &&) = delete;
+    ~integral_limbs() = default;
+
+    MPPP_NODISCARD std::size_t abs_size() const
+    {
+        return static_cast<std::size_t>(m_size >= 0 ? m_size : -m_size);
+    }
+    // Construct a static int from this, provided that it fits in SSize limbs.
+    template <std::size_t SSize>
+    MPPP_NODISCARD static_int<SSize> to_static() const
+    {
+        assert(abs_size() <= SSize);
+        return static_int<SSize>(m_size, m_limbs.data(), abs_size());
+    }
+    // Read-only mpz view.
+    MPPP_NODISCARD mpz_struct_t get_mpz_view() const
+    {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+        auto *ptr = const_cast<::mp_limb_t *>(m_limbs.data());
+        return mpz_struct_t{static_cast<mpz_alloc_t>(m_limbs.size()), m_size, ptr};
+    }
+
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-member-init, hicpp-member-init)
+    limb_array_t<uint_t> m_limbs;
+    mpz_size_t m_size;
+};
+
+// 10**k, as a limb.
+constexpr ::mp_limb_t dec_pow10(unsigned k)
+{
+    return k == 0u ? ::mp_limb_t(1) : ::mp_limb_t(10u * dec_pow10(k - 1u));
+}
+
+// The number of decimal digits which can be accumulated in a single limb,
+// that is, the largest k such that 10**k <= GMP_NUMB_MAX.
+constexpr unsigned dec_limb_ndigits(unsigned k = 1)
+{
+    return dec_pow10(k) > GMP_NUMB_MAX / 10u ? k : dec_limb_ndigits(k + 1u);
+}
+
+// The max number of chars (including the sign, excluding the terminator)
+// in the decimal representation of a static_int<SSize>.
+// NOTE: 30103 / 100000 is an upper bound for log10(2).
+template <std::size_t SSize>
+constexpr std::size_t static_int_dec_max_size()
+{
+    return SSize * unsigned(GMP_NUMB_BITS) * 30103u / 100000u + 2u;
+}
+
+// Parse the n decimal digits starting at begin into out.
+// n must not be greater than dec_limb_ndigits(). Return false
+// if a non-digit char is encountered.
+inline bool dec_parse_block(::mp_limb_t &out, const char *begin, std::size_t n)
+{
+    ::mp_limb_t block = 0;
+    for (const auto end = begin + n; begin != end; ++begin) {
+        if (mppp_unlikely(*begin < '0' || *begin > '9')) {
+            return false;
+        }
+        block = static_cast<::mp_limb_t>(block * 10u + static_cast<::mp_limb_t>(*begin - '0'));
+    }
+    out = block;
+    return true;
+}
+
+// Write backwards the decimal digits of x into the
+// range ending at out, and return a pointer to the first written digit.
+// If Pad is true, exactly dec_limb_ndigits() digits are written
+// (x must be less than 10**dec_limb_ndigits()), otherwise leading zeroes are not
+// written (but at least one digit is written).
+template <bool Pad>
+inline char *dec_write_limb(char *out, ::mp_limb_t x)
+{
+    // Sequence of text representations of integers from 0 to 99 (2 digits per number).
+    static constexpr char d2_text[] = "000102030405060708091011121314151617181920212223242526272829303132333435363738394041"
+                                      "424344454647484950515253545556575859606162636465666768697071727374757677787980818283"
+                                      "84858687888990919293949596979899";
+    const auto end = out;
+
+    while (x >= 100u) {
+        const auto r = static_cast<std::size_t>(x % 100u);
+        x /= 100u;
+        *--out = d2_text[r * 2u + 1u];
+        *--out = d2_text[r * 2u];
+    }
+    if (x >= 10u) {
+        *--out = d2_text[x * 2u + 1u];
+        *--out = d2_text[x * 2u];
+    } else {
+        *--out = static_cast<char>('0' + static_cast<int>(x));
+    }
+
+    if (Pad) {
+        // NOTE: compute the beginning of the padded range only here, as in the
+        // unpadded case it might point before the beginning of the buffer.
+        const auto begin = end - dec_limb_ndigits();
+        while (out != begin) {
+            *--out = '0';
+        }
+    }
+
+    return out;
+}
+
+// Try to parse the decimal string [begin, end) directly into st, without
+// going through an mpz. The accepted format is an optional minus sign followed by
+// one or more decimal digits. If the string is not in this format, or its value
+// does not fit in SSize limbs, false will be returned and st will not be modified.
+// NOTE: values fitting in 2 limbs are parsed with double-limb arithmetic, if available,
+// without invoking any GMP function.
+template <std::size_t SSize>
+inline bool static_int_from_dec(static_int<SSize> &st, const char *begin, const char *end)
+{
+    constexpr auto nd = dec_limb_ndigits();
+
+    const bool neg = begin != end && *begin == '-';
+    begin += neg;
+    if (begin == end) {
+        return false;
+    }
+
+    // NOTE: make room for at least 3 limbs, which
+    // we may need when switching from the double-limb
+    // arithmetic to the mpn functions.
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-member-init, hicpp-member-init)
+    std::array<::mp_limb_t, c_max(SSize, std::size_t(3))> limbs;
+    std::size_t asize = 0;
+    ::mp_limb_t block = 0;
+    // NOTE: we consume the digits in blocks of nd digits, except for the first
+    // block which contains the leftover digits.
+    auto blen = static_cast<std::size_t>(end - begin) % nd;
+    blen = blen ? blen : nd;
+
+#if defined(MPPP_HAVE_DLIMB_T)
+    // Accumulate the value in two limbs, as long as it fits.
+    ::mp_limb_t lo = 0, hi = 0;
+    for (; begin != end; begin += blen, blen = nd) {
+        if (!dec_parse_block(block, begin, blen)) {
+            return false;
+        }
+        const auto p = blen == nd ? dec_pow10(nd) : dec_pow10(static_cast<unsigned>(blen));
+        // (hi, lo) = (hi, lo) * p + block.
+        const auto l = dlimb_t(lo) * p + block;
+        const auto h = dlimb_t(hi) * p + (l >> GMP_NUMB_BITS);
+        lo = static_cast<::mp_limb_t>(l);
+        hi = static_cast<::mp_limb_t>(h);
+        if (mppp_unlikely((h >> GMP_NUMB_BITS) != 0u)) {
+            // The value does not fit in 2 limbs any more: switch
+            // to the mpn functions, if possible.
+            if (SSize < 3u) {
+                return false;
+            }
+            limbs[0] = lo;
+            limbs[1] = hi;
+            limbs[2] = static_cast<::mp_limb_t>(h >> GMP_NUMB_BITS);
+            asize = 3;
+            begin += blen;
+            blen = nd;
+            break;
+        }
+    }
+    if (asize == 0u) {
+        if (SSize == 1u && hi != 0u) {
+            return false;
+        }
+        limbs[0] = lo;
+        limbs[1] = hi;
+        asize = hi != 0u ? 2u : static_cast<std::size_t>(lo != 0u);
+    }
+#endif
+
+    for (; begin != end; begin += blen, blen = nd) {
+        if (!dec_parse_block(block, begin, blen)) {
+            return false;
+        }
+        if (asize == 0u) {
+            limbs[0] = block;
+            asize = block != 0u;
+            continue;
+        }
+        // limbs = limbs * 10**blen + block.
+        // NOTE: cy < 10**blen, thus adding the carry of the addition
+        // cannot overflow.
+        auto cy = mpn_mul_1(limbs.data(), limbs.data(), static_cast<::mp_size_t>(asize),
+                            blen == nd ? dec_pow10(nd) : dec_pow10(static_cast<unsigned>(blen)));
+        cy += mpn_add_1(limbs.data(), limbs.data(), static_cast<::mp_size_t>(asize), block);
+        if (cy != 0u) {
+            if (asize == SSize) {
+                return false;
+            }
+            limbs[asize++] = cy;
+        }
+    }
+
+    const auto size = static_cast<mpz_size_t>(asize);
+    st = static_int<SSize>{neg ? -size : size, limbs.data(), asize};
+    return true;
+}
+
+#if defined(MPPP_HAVE_DLIMB_T)
+
+// Write backwards the decimal digits of the double-limb value (hi, lo) into
+// the range ending at out, and return a pointer to the first written digit.
+inline char *dec_write_dlimb(char *out, ::mp_limb_t lo, ::mp_limb_t hi)
+{
+    constexpr auto p = dec_pow10(dec_limb_ndigits());
+
+    auto x = (dlimb_t(hi) << GMP_NUMB_BITS) + lo;
+    while ((x >> GMP_NUMB_BITS) != 0u) {
+        const auto q = x / p;
+        out = dec_write_limb<true>(out, static_cast<::mp_limb_t>(x - q * p));
+        x = q;
+    }
+
+    return dec_write_limb<false>(out, static_cast<::mp_limb_t>(x));
+}
+
+#endif
+
+// Write the decimal representation of st into out, which must be able to
+// hold at least static_int_dec_max_size<SSize>() chars. No terminator is
+// written. The return value is a pointer past the last written char.
+// NOTE: values fitting in 2 limbs are printed with double-limb arithmetic, if available,
+// without invoking any GMP function.
+template <std::size_t SSize>
+inline char *static_int_to_dec(char *out, const static_int<SSize> &st)
+{
+    constexpr auto nd = dec_limb_ndigits();
+    constexpr auto p = dec_pow10(nd);
+
+    // NOTE: the representation is built backwards in a local buffer,
+    // starting from the least significant block of nd digits.
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-member-init, hicpp-member-init)
+    std::array<char, static_int_dec_max_size<SSize>()> buffer;
+    auto ptr = buffer.data() + buffer.size();
+
+    auto asize = static_cast<std::size_t>(st.abs_size());
+
+#if defined(MPPP_HAVE_DLIMB_T)
+    if (asize > 2u) {
+#else
+    if (asize > 1u) {
+#endif
+        // NOTE: this branch is never taken if SSize < 3, but make sure that
+        // q has at least 2 limbs in order to avoid compiler warnings.
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-member-init, hicpp-member-init)
+        std::array<::mp_limb_t, c_max(SSize, std::size_t(2))> q;
+        copy_limbs_no(st.m_limbs.data(), st.m_limbs.data() + asize, q.data());
+        do {
+            ptr = dec_write_limb<true>(
+                ptr, mpn_divrem_1(q.data(), ::mp_size_t(0), q.data(), static_cast<::mp_size_t>(asize), p));
+            asize -= q[asize - 1u] == 0u;
+#if defined(MPPP_HAVE_DLIMB_T)
+        } while (asize > 2u);
+        ptr = dec_write_dlimb(ptr, q[0], asize == 2u ? q[1] : ::mp_limb_t(0));
+#else
+        } while (asize > 1u);
+        ptr = dec_write_limb<false>(ptr, q[0]);
+#endif
+    } else {
+#if defined(MPPP_HAVE_DLIMB_T)
+        ptr = dec_write_dlimb(ptr, asize != 0u ? st.m_limbs[0] : ::mp_limb_t(0),
+                              asize == 2u ? st.m_limbs[asize - 1u] : ::mp_limb_t(0));
+#else
+        ptr = dec_write_limb<false>(ptr, asize == 1u ? st.m_limbs[0] : ::mp_limb_t(0));
+#endif
+    }
+
+    if (st._mp_size < 0) {
+        *--ptr = '-';
+    }
+
+    return std::copy(ptr, buffer.data() + buffer.size(), out);
+}
+
 // {static_int,mpz} union.
 template <std::size_t SSize>
 union integer_union {
@@ -747,6 +1325,17 @@ union integer_union {
     {
         dispatch_generic_ctor(x);
     }
+    // Try to construct directly into static storage from the decimal string [begin, end).
+    // Return false (and leave this uninited) on failure.
+    bool dispatch_dec_ctor(const char *begin, const char *end)
+    {
+        ::new (static_cast<void *>(&m_st)) s_storage;
+        if (static_int_from_dec(m_st, begin, end)) {
+            return true;
+        }
+        m_st.~s_storage();
+        return false;
+    }
     // Implementation of the constructor from string. Abstracted into separate function because it is re-used.
     void dispatch_c_string_ctor(const char *s, int base)
     {
@@ -755,6 +1344,9 @@ union integer_union {
                 "In the constructor of integer from string, a base of " + to_string(base)
                 + " was specified, but the only valid values are 0 and any value in the [2,62] range");
         }
+        if (base == 10 && dispatch_dec_ctor(s, s + std::strlen(s))) {
+            return;
+        }
         MPPP_MAYBE_TLS mpz_raii mpz;
         if (mppp_unlikely(mpz_set_str(&mpz.m_mpz, s, base))) {
             if (base != 0) {
@@ -777,6 +1369,10 @@ union integer_union {
     // NOLINTNEXTLINE(cppcoreguidelines-pro-type-member-init, hicpp-member-init)
     explicit integer_union(const char *begin, const char *end, int base)
     {
+        // NOTE: in base 10, try first to avoid the copy.
+        if (base == 10 && dispatch_dec_ctor(begin, end)) {
+            return;
+        }
         // Copy the range into a local buffer.
         MPPP_MAYBE_TLS std::vector<char> buffer;
         buffer.assign(begin, end);
@@ -1062,6 +1658,9 @@ namespace detail
 template <std::size_t SSize>
 void nextprime_impl(integer<SSize> &, const integer<SSize> &);
 
+template <std::size_t SSize>
+int probab_prime_p_impl(const integer<SSize> &, int);
+
 } // namespace detail
 
 // Detect C++ arithmetic types compatible with integer.
@@ -1119,17 +1718,10 @@ using is_integer_cpp_floating_point = detail::conjunction<is_cpp_floating_point<
 // - it seems like it might be possible to re-implement a bare-bone mpz api on top of the mpn primitives,
 //   with the goal of providing some form of error recovery in case of memory errors (e.g., throw instead
 //   of aborting). This is probably not an immediate concern though.
-// - pow() can probably benefit for some specialised static implementation, especially in conjunction with
-//   mpn_sqr().
 // - functions still to be de-branched: all the mpn implementations, if worth it.
 //   Probably better to wait for benchmarks before moving.
-// - for s11n, we could consider implementing binary_save/load overloads based on iterators. These could return
-//   the iterator at the end of the serialised representation, and maybe the original iterator if errors
-//   occurred? Probably some code could be refactored/shared with the char * interface, taking advantage
-//   of the fact that std::copy() actually returns something. Longer term, we probably should add optional
-//   support for boost.serialization, cereal, etc.
-// - for the comparison operators, we should consider using lower level primitives for comparisons with
-//   both C++ integrals and FP, instead of going through type conversions (same as done for add_ui() etc.).
+// - for s11n, the chunked streaming of sequences of objects is implemented in binary_archive.hpp.
+//   Longer term, we probably should add optional support for boost.serialization, cereal, etc.
 // - perhaps we should consider adding new overloads to functions which return more than one value
 //   (e.g., tdiv_qr(), sqrtrem(), etc.). At this time we have only the GMP-style overload, perhaps
 //   we could have an overload that returns the two values as tuple/pair/array.
@@ -1721,6 +2313,11 @@ public:
                                         "2 and 62, but a value of "
                                         + detail::to_string(base) + " was provided instead");
         }
+        if (base == 10 && is_static()) {
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-type-member-init, hicpp-member-init)
+            std::array<char, detail::static_int_dec_max_size<SSize>()> buffer;
+            return std::string(buffer.data(), detail::static_int_to_dec(buffer.data(), m_int.g_st()));
+        }
         return detail::mpz_to_str(get_mpz_view(), base);
     }
     // NOTE: maybe provide a member function to access the lower-level str conversion that writes to
@@ -1936,6 +2533,16 @@ private:
             if (m_int.m_st._mp_size == -1) {
                 return std::make_pair(true, -static_cast<T>(ptr[0] & GMP_NUMB_MASK));
             }
+            // Optimization for two-limb integers, operating directly on the limbs.
+            // NOTE: mpz_get_d() truncates, thus we round towards zero in order
+            // to produce the same result as the GMP routine.
+            if (std::is_same<T, float>::value || std::is_same<T, double>::value) {
+                if (m_int.m_st._mp_size == 2 || m_int.m_st._mp_size == -2) {
+                    return std::make_pair(true, static_cast<T>(detail::limbs_to_double(
+                                                    ptr, 2, m_int.m_st._mp_size < 0, false, 0,
+                                                    fp_rounding::toward_zero)));
+                }
+            }
         }
         // For all the other cases, just delegate to the GMP/MPFR routines.
         return mpz_float_conversion<T>(*static_cast<const detail::mpz_struct_t *>(get_mpz_view()));
@@ -2096,7 +2703,7 @@ public:
         if (mppp_unlikely(sgn() < 0)) {
             throw std::invalid_argument("Cannot run primality tests on the negative number " + to_string());
         }
-        return mpz_probab_prime_p(get_mpz_view(), reps);
+        return detail::probab_prime_p_impl(*this, reps);
     }
     // Integer square root (in-place version).
     integer &sqrt()
@@ -2613,6 +3220,30 @@ inline bool get(T &rop, const integer<SSize> &n)
     return n.get(rop);
 }
 
+// Conversion to double with the rounding mode rnd.
+template <std::size_t SSize>
+inline double to_double(const integer<SSize> &n, fp_rounding rnd = fp_rounding::nearest)
+{
+    const auto size = n.size();
+    if (size == 0u) {
+        return 0.;
+    }
+    const auto &u = n._get_union();
+    const ::mp_limb_t *ptr = u.is_static() ? u.g_st().m_limbs.data() : u.g_dy()._mp_d;
+    if (size == 1u) {
+        const auto l = ptr[0] & GMP_NUMB_MASK;
+        // NOTE: the hardware conversion is exact if l has no more bits than
+        // the mantissa of double, and it rounds to nearest otherwise
+        // (in the default floating-point environment).
+        if (rnd == fp_rounding::nearest
+            || (static_cast<std::uint_least64_t>(l) >> std::numeric_limits<double>::digits) == 0u) {
+            const auto ret = static_cast<double>(l);
+            return n.sgn() < 0 ? -ret : ret;
+        }
+    }
+    return detail::limbs_to_double(ptr, size, n.sgn() < 0, false, 0, rnd);
+}
+
 namespace detail
 {
 
@@ -2709,14 +3340,24 @@ MPPP_CONCEPT_DECL integer_integral_op_types = are_integer_integral_op_types<T, U
 namespace detail
 {
 
+// The types which, combined with an rvalue integer<SSize> in the binary operators,
+// allow to compute the result directly into the storage of the rvalue.
+template <typename T, std::size_t SSize>
+using is_integer_rvalue_op_type = disjunction<std::is_same<T, integer<SSize>>, is_cpp_integral<T>>;
+
 // Metaprogramming for selecting the algorithm for static addition. The selection happens via
-// an std::integral_constant with 3 possible values:
+// an std::integral_constant with 4 possible values:
 // - 0 (default case): use the GMP mpn functions,
 // - 1: selected when there are no nail bits and the static size is 1,
-// - 2: selected when there are no nail bits and the static size is 2.
+// - 2: selected when there are no nail bits and the static size is 2,
+// - 3: selected when there are no nail bits and the static size is 3 or 4.
 template <typename SInt>
 using integer_static_add_algo = std::integral_constant<
-    int, (!GMP_NAIL_BITS && SInt::s_size == 1) ? 1 : ((!GMP_NAIL_BITS && SInt::s_size == 2) ? 2 : 0)>;
+    int, (!GMP_NAIL_BITS && SInt::s_size == 1)
+             ? 1
+             : ((!GMP_NAIL_BITS && SInt::s_size == 2)
+                    ? 2
+                    : ((!GMP_NAIL_BITS && (SInt::s_size == 3 || SInt::s_size == 4)) ? 3 : 0))>;
 
 // General implementation via mpn.
 // Small helper to compute the size after subtraction via mpn. s is a strictly positive size.
@@ -3004,6 +3645,77 @@ inline bool static_add_impl(static_int<SSize> &rop, const static_int<SSize> &op1
     return true;
 }
 
+// Small helper to compare two statics of equal asize, with asize at most 4.
+inline int integer_compare_limbs_4(const ::mp_limb_t *data1, const ::mp_limb_t *data2, mpz_size_t asize)
+{
+    // NOTE: this requires no nail bits.
+    // NOLINTNEXTLINE(cert-dcl03-c, hicpp-static-assert, misc-static-assert)
+    assert(!GMP_NAIL_BITS);
+    assert(asize >= 0 && asize <= 4);
+    while (asize != 0) {
+        --asize;
+        if (data1[asize] != data2[asize]) {
+            return data1[asize] > data2[asize] ? 1 : -1;
+        }
+    }
+    return 0;
+}
+
+// Optimization for three/four-limbs statics with no nails.
+template <std::size_t SSize>
+inline bool static_add_impl(static_int<SSize> &rop, const static_int<SSize> &op1, const static_int<SSize> &op2,
+                            mpz_size_t asize1, mpz_size_t asize2, int sign1, int sign2,
+                            const std::integral_constant<int, 3> &)
+{
+    auto rdata = rop.m_limbs.data();
+    auto data1 = op1.m_limbs.data(), data2 = op2.m_limbs.data();
+    if (sign1 == sign2) {
+        // NOTE: as in the 2-limb implementation, we operate on all the SSize limbs
+        // of the operands, relying on the unused limbs being zero. The loops
+        // have a fixed trip count and they are fully unrolled by the compiler.
+        //
+        // NOTE: the result is computed into temporary storage, as rop may overlap
+        // with op1/op2 and we must not touch rop if the addition overflows.
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-member-init, hicpp-member-init)
+        std::array<::mp_limb_t, SSize> res;
+        ::mp_limb_t cy = 0;
+        for (std::size_t i = 0; i < SSize; ++i) {
+            // NOLINTNEXTLINE(cppcoreguidelines-init-variables)
+            ::mp_limb_t tmp;
+            const auto cy1 = limb_add_overflow(data1[i], data2[i], &tmp);
+            const auto cy2 = limb_add_overflow(tmp, cy, &res[i]);
+            cy = cy1 | cy2;
+        }
+        // The result will overflow if we have a carry out of the top limb.
+        if (mppp_unlikely(cy)) {
+            return false;
+        }
+        // NOTE: if sign1 == 0, both operands are zero and so is the result.
+        rop._mp_size = sign1 * size_from_limbs<SSize>(res.data());
+        rop.m_limbs = res;
+    } else {
+        // When the signs differ, we need to implement addition as a subtraction.
+        // NOTE: this also includes the case in which only one of the operands is zero.
+        // NOTE: the subtraction cannot fail, and each limb of the result depends only
+        // on the limbs of the operands with the same index, thus we can write
+        // directly into rop.
+        const bool op1_larger
+            = asize1 > asize2 || (asize1 == asize2 && integer_compare_limbs_4(data1, data2, asize1) >= 0);
+        const auto a = op1_larger ? data1 : data2, b = op1_larger ? data2 : data1;
+        ::mp_limb_t br = 0;
+        for (std::size_t i = 0; i < SSize; ++i) {
+            const auto ai = a[i], bi = b[i];
+            const auto diff = ai - bi;
+            const auto br1 = static_cast<::mp_limb_t>(ai < bi), br2 = static_cast<::mp_limb_t>(diff < br);
+            rdata[i] = diff - br;
+            br = br1 | br2;
+        }
+        assert(br == 0u);
+        rop._mp_size = (op1_larger ? sign1 : sign2) * size_from_limbs<SSize>(rdata);
+    }
+    return true;
+}
+
 template <bool AddOrSub, std::size_t SSize>
 inline bool static_addsub(static_int<SSize> &rop, const static_int<SSize> &op1, const static_int<SSize> &op2)
 {
@@ -3253,39 +3965,66 @@ inline bool static_addsub_1(static_int<SSize> &rop, const static_int<SSize> &op1
     return retval;
 }
 
-// Implementation of add_ui().
-template <std::size_t SSize, typename T>
-inline integer<SSize> &add_ui_impl(integer<SSize> &rop, const integer<SSize> &op1, const T &op2)
+// Addition/subtraction between an integer and the limb representation of a C++ integral.
+template <bool AddOrSub, std::size_t SSize, typename T>
+inline integer<SSize> &addsub_integral_limbs(integer<SSize> &rop, const integer<SSize> &op1,
+                                             const integral_limbs<T> &nl)
 {
-    if (op2 > GMP_NUMB_MAX) {
-        // For the optimised version below to kick in we need to be sure we can safely convert
-        // op2 to an ::mp_limb_t, modulo nail bits. Otherwise, we just call add() after converting
-        // op2 to an integer.
-        MPPP_MAYBE_TLS integer<SSize> tmp;
-        tmp = op2;
-        return add(rop, op1, tmp);
-    }
     const bool s1 = op1.is_static();
     bool sr = rop.is_static();
-    if (mppp_likely(s1)) {
+    if (mppp_likely(s1 && nl.abs_size() <= SSize)) {
         if (!sr) {
             rop.set_zero();
             sr = true;
         }
-        if (mppp_likely(static_addsub_1<true>(rop._get_union().g_st(), op1._get_union().g_st(),
-                                              static_cast<::mp_limb_t>(op2)))) {
+        if (mppp_likely(static_addsub<AddOrSub>(rop._get_union().g_st(), op1._get_union().g_st(),
+                                                nl.template to_static<SSize>()))) {
             return rop;
         }
     }
     if (sr) {
         rop._get_union().promote(SSize + 1u);
     }
-    // NOTE: at this point we know that:
-    // - op2 fits in a limb (accounting for nail bits as well),
-    // - op2 may overflow unsigned long, which is the unsigned integral data type
-    //   the GMP API expects.
-    if (op2 <= std::numeric_limits<unsigned long>::max()) {
-        // op2 actually fits in unsigned long, let's just invoke the mpz_add_ui() function directly.
+    const auto nl_view = nl.get_mpz_view();
+    if (AddOrSub) {
+        mpz_add(&rop._get_union().g_dy(), op1.get_mpz_view(), &nl_view);
+    } else {
+        mpz_sub(&rop._get_union().g_dy(), op1.get_mpz_view(), &nl_view);
+    }
+    return rop;
+}
+
+// Implementation of add_ui().
+template <std::size_t SSize, typename T>
+inline integer<SSize> &add_ui_impl(integer<SSize> &rop, const integer<SSize> &op1, const T &op2)
+{
+    if (op2 > GMP_NUMB_MAX) {
+        // For the optimised version below to kick in we need to be sure we can safely convert
+        // op2 to an ::mp_limb_t, modulo nail bits. Otherwise, we go through the limb
+        // representation of op2.
+        return addsub_integral_limbs<true>(rop, op1, integral_limbs<T>(op2));
+    }
+    const bool s1 = op1.is_static();
+    bool sr = rop.is_static();
+    if (mppp_likely(s1)) {
+        if (!sr) {
+            rop.set_zero();
+            sr = true;
+        }
+        if (mppp_likely(static_addsub_1<true>(rop._get_union().g_st(), op1._get_union().g_st(),
+                                              static_cast<::mp_limb_t>(op2)))) {
+            return rop;
+        }
+    }
+    if (sr) {
+        rop._get_union().promote(SSize + 1u);
+    }
+    // NOTE: at this point we know that:
+    // - op2 fits in a limb (accounting for nail bits as well),
+    // - op2 may overflow unsigned long, which is the unsigned integral data type
+    //   the GMP API expects.
+    if (op2 <= std::numeric_limits<unsigned long>::max()) {
+        // op2 actually fits in unsigned long, let's just invoke the mpz_add_ui() function directly.
         mpz_add_ui(&rop._get_union().g_dy(), op1.get_mpz_view(), static_cast<unsigned long>(op2));
     } else {
         // LCOV_EXCL_START
@@ -3371,9 +4110,7 @@ template <std::size_t SSize, typename T>
 inline integer<SSize> &sub_ui_impl(integer<SSize> &rop, const integer<SSize> &op1, const T &op2)
 {
     if (op2 > GMP_NUMB_MASK) {
-        MPPP_MAYBE_TLS integer<SSize> tmp;
-        tmp = op2;
-        return sub(rop, op1, tmp);
+        return addsub_integral_limbs<false>(rop, op1, integral_limbs<T>(op2));
     }
     const bool s1 = op1.is_static();
     bool sr = rop.is_static();
@@ -3452,10 +4189,12 @@ using integer_have_dlimb_mul = std::integral_constant<bool,
                                                       >;
 
 template <typename SInt>
-using integer_static_mul_algo
-    = std::integral_constant<int, (SInt::s_size == 1 && integer_have_dlimb_mul::value)
-                                      ? 1
-                                      : ((SInt::s_size == 2 && integer_have_dlimb_mul::value) ? 2 : 0)>;
+using integer_static_mul_algo = std::integral_constant<
+    int, (SInt::s_size == 1 && integer_have_dlimb_mul::value)
+             ? 1
+             : ((SInt::s_size == 2 && integer_have_dlimb_mul::value)
+                    ? 2
+                    : (((SInt::s_size == 3 || SInt::s_size == 4) && integer_have_dlimb_mul::value) ? 3 : 0))>;
 
 // mpn implementation.
 // NOTE: this function (and the other overloads) returns 0 in case of success, otherwise it returns a hint
@@ -3609,6 +4348,56 @@ inline std::size_t static_mul_impl(static_int<SSize> &rop, const static_int<SSiz
     return 4u;
 }
 
+// 3/4-limb optimization via dlimb.
+template <std::size_t SSize>
+inline std::size_t static_mul_impl(static_int<SSize> &rop, const static_int<SSize> &op1, const static_int<SSize> &op2,
+                                   mpz_size_t asize1, mpz_size_t asize2, int sign1, int sign2,
+                                   const std::integral_constant<int, 3> &)
+{
+    // Handle zeroes.
+    if (mppp_unlikely(!sign1 || !sign2)) {
+        rop._mp_size = 0;
+        rop.m_limbs.fill(0u);
+        return 0u;
+    }
+    // NOLINTNEXTLINE(bugprone-misplaced-widening-cast)
+    const auto max_asize = static_cast<std::size_t>(asize1 + asize2);
+    // The product has at least max_asize - 1 limbs: if that does not fit
+    // in static storage, the operation cannot succeed.
+    if (max_asize > SSize + 1u) {
+        return max_asize;
+    }
+    auto data1 = op1.m_limbs.data(), data2 = op2.m_limbs.data();
+    // Schoolbook multiplication into temporary storage (rop may
+    // overlap with op1/op2). The max_asize <= SSize + 1 check above
+    // ensures that res is large enough.
+    std::array<::mp_limb_t, SSize + 1u> res{};
+    for (std::size_t i = 0; i < static_cast<std::size_t>(asize1); ++i) {
+        ::mp_limb_t cy = 0;
+        for (std::size_t j = 0; j < static_cast<std::size_t>(asize2); ++j) {
+            // NOLINTNEXTLINE(cppcoreguidelines-init-variables)
+            ::mp_limb_t hi, tmp;
+            const auto lo = dlimb_mul(data1[i], data2[j], &hi);
+            // NOTE: (hi, lo) + res[i + j] + cy cannot overflow two limbs.
+            hi += limb_add_overflow(lo, res[i + j], &tmp);
+            hi += limb_add_overflow(tmp, cy, &res[i + j]);
+            cy = hi;
+        }
+        res[i + static_cast<std::size_t>(asize2)] = cy;
+    }
+    const std::size_t asize = max_asize - static_cast<std::size_t>(res[max_asize - 1u] == 0u);
+    if (asize > SSize) {
+        // Return max_asize as a size hint, as in the mpn implementation.
+        return max_asize;
+    }
+    rop._mp_size = static_cast<mpz_size_t>(asize);
+    if (sign1 != sign2) {
+        rop._mp_size = -rop._mp_size;
+    }
+    copy_limbs_no(res.data(), res.data() + SSize, rop.m_limbs.data());
+    return 0u;
+}
+
 template <std::size_t SSize>
 inline std::size_t static_mul(static_int<SSize> &rop, const static_int<SSize> &op1, const static_int<SSize> &op2)
 {
@@ -3663,9 +4452,12 @@ namespace detail
 // optimised addmul algos. Otherwise, use the mpn one.
 template <typename SInt>
 using integer_static_addmul_algo = std::integral_constant<
-    int, (integer_static_add_algo<SInt>::value == 2 && integer_static_mul_algo<SInt>::value == 2)
-             ? 2
-             : ((integer_static_add_algo<SInt>::value == 1 && integer_static_mul_algo<SInt>::value == 1) ? 1 : 0)>;
+    int, (integer_static_add_algo<SInt>::value == 3 && integer_static_mul_algo<SInt>::value == 3)
+             ? 3
+             : ((integer_static_add_algo<SInt>::value == 2 && integer_static_mul_algo<SInt>::value == 2)
+                    ? 2
+                    : ((integer_static_add_algo<SInt>::value == 1 && integer_static_mul_algo<SInt>::value == 1) ? 1
+                                                                                                                : 0))>;
 
 // NOTE: same return value as mul: 0 for success, otherwise a hint for the size of the result.
 template <std::size_t SSize>
@@ -3857,6 +4649,29 @@ inline std::size_t static_addmul_impl(static_int<SSize> &rop, const static_int<S
     return 0u;
 }
 
+// 3/4-limb optimisation.
+template <std::size_t SSize>
+inline std::size_t static_addmul_impl(static_int<SSize> &rop, const static_int<SSize> &op1,
+                                      const static_int<SSize> &op2, mpz_size_t asizer, mpz_size_t asize1,
+                                      mpz_size_t asize2, int signr, int sign1, int sign2,
+                                      const std::integral_constant<int, 3> &)
+{
+    // NOTE: same as the mpn implementation, but using the 3/4-limb
+    // kernels for the multiplication and the addition.
+    static_int<SSize> prod;
+    if (mppp_unlikely(
+            static_mul_impl(prod, op1, op2, asize1, asize2, sign1, sign2, std::integral_constant<int, 3>{}))) {
+        return SSize * 2u + 1u;
+    }
+    const mpz_size_t asize_prod = std::abs(prod._mp_size);
+    const int sign_prod = integral_sign(prod._mp_size);
+    if (mppp_unlikely(
+            !static_add_impl(rop, rop, prod, asizer, asize_prod, signr, sign_prod, std::integral_constant<int, 3>{}))) {
+        return SSize + 1u;
+    }
+    return 0u;
+}
+
 template <bool AddOrSub, std::size_t SSize>
 inline std::size_t static_addsubmul(static_int<SSize> &rop, const static_int<SSize> &op1, const static_int<SSize> &op2)
 {
@@ -4095,6 +4910,61 @@ inline std::size_t static_mul_2exp(static_int<2> &rop, const static_int<2> &n, s
     rop._mp_size = sign * (1 + (hi != 0u));
     return 0u;
 }
+
+// Optimisation for 3 and 4 limbs.
+template <std::size_t SSize>
+inline std::size_t static_mul_2exp_small(static_int<SSize> &rop, const static_int<SSize> &n, std::size_t s)
+{
+    const mpz_size_t asize = std::abs(n._mp_size);
+    if (s == 0u || asize == 0) {
+        rop = n;
+        return 0u;
+    }
+    const int sign = integral_sign(n._mp_size);
+    // ls: number of entire limbs shifted.
+    // rs: residual bit shift.
+    const std::size_t ls = s / unsigned(GMP_NUMB_BITS), rs = s % unsigned(GMP_NUMB_BITS);
+    if (mppp_unlikely(ls > SSize - static_cast<std::size_t>(asize))) {
+        // The shift is too large, this can never work on a nonzero value.
+        // NOTE: this is the generic formula to estimate the final size.
+        return ls + 1u + static_cast<std::size_t>(asize);
+    }
+    const auto new_asize = static_cast<std::size_t>(asize) + ls;
+    // NOTE: copy the limbs of n, as rop and n may overlap.
+    const auto src = n.m_limbs;
+    // The bits spilling out of the top limb of n.
+    const ::mp_limb_t spill
+        = rs != 0u ? (src[static_cast<std::size_t>(asize - 1)] & GMP_NUMB_MASK) >> (unsigned(GMP_NUMB_BITS) - rs) : 0u;
+    if (mppp_unlikely(spill != 0u && new_asize == SSize)) {
+        return SSize + 1u;
+    }
+    // NOTE: the unused limbs of n are zero, thus we can
+    // operate on all the limbs of rop.
+    for (std::size_t i = 0; i < SSize; ++i) {
+        if (i < ls) {
+            rop.m_limbs[i] = 0u;
+        } else if (rs == 0u) {
+            rop.m_limbs[i] = src[i - ls];
+        } else {
+            const auto lo = i > ls ? ((src[i - ls - 1u] & GMP_NUMB_MASK) >> (unsigned(GMP_NUMB_BITS) - rs)) : 0u;
+            rop.m_limbs[i] = (((src[i - ls] & GMP_NUMB_MASK) << rs) & GMP_NUMB_MASK) + lo;
+        }
+    }
+    rop._mp_size = sign * (static_cast<mpz_size_t>(new_asize) + static_cast<mpz_size_t>(spill != 0u));
+    return 0u;
+}
+
+// 3-limb optimisation.
+inline std::size_t static_mul_2exp(static_int<3> &rop, const static_int<3> &n, std::size_t s)
+{
+    return static_mul_2exp_small(rop, n, s);
+}
+
+// 4-limb optimisation.
+inline std::size_t static_mul_2exp(static_int<4> &rop, const static_int<4> &n, std::size_t s)
+{
+    return static_mul_2exp_small(rop, n, s);
+}
 } // namespace detail
 
 // Ternary left shift.
@@ -4132,10 +5002,12 @@ namespace detail
 // static squaring. We'll be using the
 // double-limb mul primitives if available.
 template <typename SInt>
-using integer_static_sqr_algo
-    = std::integral_constant<int, (SInt::s_size == 1 && integer_have_dlimb_mul::value)
-                                      ? 1
-                                      : ((SInt::s_size == 2 && integer_have_dlimb_mul::value) ? 2 : 0)>;
+using integer_static_sqr_algo = std::integral_constant<
+    int, (SInt::s_size == 1 && integer_have_dlimb_mul::value)
+             ? 1
+             : ((SInt::s_size == 2 && integer_have_dlimb_mul::value)
+                    ? 2
+                    : (((SInt::s_size == 3 || SInt::s_size == 4) && integer_have_dlimb_mul::value) ? 3 : 0))>;
 
 // mpn implementation.
 // NOTE: this function (and the other overloads) returns 0 in case of success, otherwise it returns a hint
@@ -4230,6 +5102,18 @@ inline std::size_t static_sqr_impl(static_int<SSize> &rop, const static_int<SSiz
     return 0;
 }
 
+// 3/4-limb optimization via dlimb.
+template <std::size_t SSize>
+inline std::size_t static_sqr_impl(static_int<SSize> &rop, const static_int<SSize> &op,
+                                   const std::integral_constant<int, 3> &)
+{
+    // NOTE: just use the schoolbook multiplication. rop is written
+    // only in case of success, thus overlap is fine.
+    const auto asize = std::abs(op._mp_size);
+    const auto sign = integral_sign(op._mp_size);
+    return static_mul_impl(rop, op, op, asize, asize, sign, sign, std::integral_constant<int, 3>{});
+}
+
 template <std::size_t SSize>
 inline std::size_t static_sqr(static_int<SSize> &rop, const static_int<SSize> &op)
 {
@@ -4472,6 +5356,145 @@ inline integer<SSize> sqrm(const integer<SSize> &op, const integer<SSize> &mod)
     return retval;
 }
 
+// Ternary modular inversion.
+template <std::size_t SSize>
+inline integer<SSize> &invert(integer<SSize> &rop, const integer<SSize> &op, const integer<SSize> &mod)
+{
+    if (mppp_unlikely(mod.sgn() == 0)) {
+        throw zero_division_error("Integer division by zero");
+    }
+
+    // NOTE: modulo 1 every value is invertible. Handle this case
+    // explicitly, as older GMP versions report failure.
+    if (mod.is_one() || mod.is_negative_one()) {
+        return rop.set_zero();
+    }
+
+    // NOTE: use temp storage to avoid issues with overlapping
+    // arguments. The result is then assigned to rop, which
+    // thus stays in static storage if possible.
+    MPPP_MAYBE_TLS detail::mpz_raii tmp;
+    if (mppp_unlikely(!mpz_invert(&tmp.m_mpz, op.get_mpz_view(), mod.get_mpz_view()))) {
+        throw std::domain_error("Cannot compute the inverse of " + op.to_string() + " modulo " + mod.to_string()
+                                + ": the inverse does not exist");
+    }
+
+    return rop = &tmp.m_mpz;
+}
+
+// Binary modular inversion.
+template <std::size_t SSize>
+inline integer<SSize> invert(const integer<SSize> &op, const integer<SSize> &mod)
+{
+    integer<SSize> retval;
+    invert(retval, op, mod);
+    return retval;
+}
+
+namespace detail
+{
+
+#if defined(MPPP_HAVE_DLIMB_T)
+
+// 1-limb modular exponentiation via dlimb, using left-to-right
+// binary exponentiation. The exponent must be nonzero and normalised.
+inline ::mp_limb_t static_powm_impl_1(::mp_limb_t base, const ::mp_limb_t *exp, std::size_t exp_size,
+                                      ::mp_limb_t mod)
+{
+    assert(exp_size != 0u);
+
+    base %= mod;
+
+    // NOTE: the most significant bit of the exponent is accounted
+    // for by the initialisation of ret.
+    auto ret = base;
+    auto nbits = limb_size_nbits(exp[exp_size - 1u]) - 1u;
+    for (auto i = exp_size; i-- > 0u; nbits = unsigned(GMP_NUMB_BITS)) {
+        const auto l = exp[i];
+        while (nbits-- > 0u) {
+            ret = static_cast<::mp_limb_t>((dlimb_t(ret) * ret) % mod);
+            if ((l >> nbits) & 1u) {
+                ret = static_cast<::mp_limb_t>((dlimb_t(ret) * base) % mod);
+            }
+        }
+    }
+
+    return ret;
+}
+
+#endif
+
+} // namespace detail
+
+// Quaternary modular exponentiation.
+template <std::size_t SSize>
+inline integer<SSize> &powm(integer<SSize> &rop, const integer<SSize> &base, const integer<SSize> &exp,
+                            const integer<SSize> &mod)
+{
+    if (mppp_unlikely(mod.sgn() == 0)) {
+        throw zero_division_error("Integer division by zero");
+    }
+
+    if (mppp_unlikely(exp.sgn() < 0)) {
+        // Negative exponent: raise the inverse of base
+        // to the absolute value of exp.
+        integer<SSize> inv;
+        invert(inv, base, mod);
+        return powm(rop, inv, abs(exp), mod);
+    }
+
+    if (exp.sgn() == 0) {
+        // NOTE: x**0 == 1, unless we are working modulo 1.
+        return (mod.is_one() || mod.is_negative_one()) ? rop.set_zero() : rop.set_one();
+    }
+
+#if defined(MPPP_HAVE_DLIMB_T)
+    const auto &bu = base._get_union(), &eu = exp._get_union(), &mu = mod._get_union();
+    if (bu.is_static() && eu.is_static() && mu.is_static() && bu.g_st().abs_size() <= 1
+        && mu.g_st().abs_size() == 1) {
+        const auto &bst = bu.g_st(), &est = eu.g_st();
+        const auto m = mu.g_st().m_limbs[0];
+        // NOTE: the limbs of a zero base may not be zeroed out.
+        auto ret = detail::static_powm_impl_1(bst._mp_size != 0 ? bst.m_limbs[0] : ::mp_limb_t(0), est.m_limbs.data(),
+                                              static_cast<std::size_t>(est._mp_size), m);
+        // A negative base raised to an odd power yields a negative power,
+        // which needs to be brought into the [0, |mod|) range.
+        if (ret != 0u && bst._mp_size < 0 && (est.m_limbs[0] & 1u)) {
+            ret = m - ret;
+        }
+
+        // NOTE: we computed everything we needed from the operands,
+        // we can now safely write into rop.
+        if (!rop.is_static()) {
+            rop.set_zero();
+        }
+        auto &rst = rop._get_union().g_st();
+        rst._mp_size = static_cast<detail::mpz_size_t>(ret != 0u);
+        rst.m_limbs[0] = ret;
+        rst.zero_upper_limbs(1);
+
+        return rop;
+    }
+#endif
+
+    // NOTE: use temp storage to avoid issues with overlapping
+    // arguments. The result is then assigned to rop, which
+    // thus stays in static storage if possible.
+    MPPP_MAYBE_TLS detail::mpz_raii tmp;
+    mpz_powm(&tmp.m_mpz, base.get_mpz_view(), exp.get_mpz_view(), mod.get_mpz_view());
+
+    return rop = &tmp.m_mpz;
+}
+
+// Ternary modular exponentiation.
+template <std::size_t SSize>
+inline integer<SSize> powm(const integer<SSize> &base, const integer<SSize> &exp, const integer<SSize> &mod)
+{
+    integer<SSize> retval;
+    powm(retval, base, exp, mod);
+    return retval;
+}
+
 // Binary negation.
 template <std::size_t SSize>
 inline integer<SSize> &neg(integer<SSize> &rop, const integer<SSize> &n)
@@ -4512,11 +5535,16 @@ namespace detail
 // Selection of the algorithm for static division:
 // - for 1 limb, we can always do static division,
 // - for 2 limbs, we need the dual limb division if avaiable,
+// - for 3 and 4 limbs, we use the dual limb division (if available)
+//   when both operands have at most 2 limbs, and the mpn functions otherwise,
 // - otherwise we just use the mpn functions.
 template <typename SInt>
-using integer_static_div_algo
-    = std::integral_constant<int,
-                             SInt::s_size == 1 ? 1 : ((SInt::s_size == 2 && integer_have_dlimb_div::value) ? 2 : 0)>;
+using integer_static_div_algo = std::integral_constant<
+    int, SInt::s_size == 1
+             ? 1
+             : ((SInt::s_size == 2 && integer_have_dlimb_div::value)
+                    ? 2
+                    : (((SInt::s_size == 3 || SInt::s_size == 4) && integer_have_dlimb_div::value) ? 3 : 0))>;
 
 // mpn implementation.
 template <std::size_t SSize>
@@ -4668,6 +5696,32 @@ inline void static_tdiv_qr_impl(static_int<SSize> &q, static_int<SSize> &r, cons
     r.m_limbs[1] = r2;
 }
 
+// 3/4-limbs optimisation.
+template <std::size_t SSize>
+inline void static_tdiv_qr_impl(static_int<SSize> &q, static_int<SSize> &r, const static_int<SSize> &op1,
+                                const static_int<SSize> &op2, mpz_size_t asize1, mpz_size_t asize2, int sign1,
+                                int sign2, const std::integral_constant<int, 3> &)
+{
+    if (asize1 <= 2 && asize2 <= 2) {
+        // Both operands fit in 2 limbs: use the dlimb division.
+        // NOLINTNEXTLINE(cppcoreguidelines-init-variables)
+        ::mp_limb_t q1, q2, r1, r2;
+        dlimb_tdiv_qr(op1.m_limbs[0], op1.m_limbs[1], op2.m_limbs[0], op2.m_limbs[1], &q1, &q2, &r1, &r2);
+        q._mp_size = sign1 * sign2 * size_from_lohi(q1, q2);
+        q.m_limbs[0] = q1;
+        q.m_limbs[1] = q2;
+        q.zero_upper_limbs(2);
+        r._mp_size = sign1 * size_from_lohi(r1, r2);
+        r.m_limbs[0] = r1;
+        r.m_limbs[1] = r2;
+        r.zero_upper_limbs(2);
+        return;
+    }
+    static_tdiv_qr_impl(q, r, op1, op2, asize1, asize2, sign1, sign2, std::integral_constant<int, 0>{});
+    q.zero_unused_limbs();
+    r.zero_unused_limbs();
+}
+
 template <std::size_t SSize>
 inline void static_tdiv_qr(static_int<SSize> &q, static_int<SSize> &r, const static_int<SSize> &op1,
                            const static_int<SSize> &op2)
@@ -4818,6 +5872,26 @@ inline void static_tdiv_q_impl(static_int<SSize> &q, const static_int<SSize> &op
     q.m_limbs[1] = q2;
 }
 
+// 3/4-limbs optimisation.
+template <std::size_t SSize>
+inline void static_tdiv_q_impl(static_int<SSize> &q, const static_int<SSize> &op1, const static_int<SSize> &op2,
+                               mpz_size_t asize1, mpz_size_t asize2, int sign1, int sign2,
+                               const std::integral_constant<int, 3> &)
+{
+    if (asize1 <= 2 && asize2 <= 2) {
+        // NOLINTNEXTLINE(cppcoreguidelines-init-variables)
+        ::mp_limb_t q1, q2;
+        dlimb_tdiv_q(op1.m_limbs[0], op1.m_limbs[1], op2.m_limbs[0], op2.m_limbs[1], &q1, &q2);
+        q._mp_size = sign1 * sign2 * size_from_lohi(q1, q2);
+        q.m_limbs[0] = q1;
+        q.m_limbs[1] = q2;
+        q.zero_upper_limbs(2);
+        return;
+    }
+    static_tdiv_q_impl(q, op1, op2, asize1, asize2, sign1, sign2, std::integral_constant<int, 0>{});
+    q.zero_unused_limbs();
+}
+
 template <std::size_t SSize>
 inline void static_tdiv_q(static_int<SSize> &q, const static_int<SSize> &op1, const static_int<SSize> &op2)
 {
@@ -4938,6 +6012,27 @@ inline void static_divexact_impl(static_int<SSize> &q, const static_int<SSize> &
     q.m_limbs[1] = q2;
 }
 
+// 3/4-limbs optimisation.
+template <bool Gcd, std::size_t SSize>
+inline void static_divexact_impl(static_int<SSize> &q, const static_int<SSize> &op1, const static_int<SSize> &op2,
+                                 mpz_size_t asize1, mpz_size_t asize2, int sign1, int sign2,
+                                 const std::integral_constant<int, 3> &)
+{
+    assert(!Gcd || sign2 == 1);
+    if (asize1 <= 2 && asize2 <= 2) {
+        // NOLINTNEXTLINE(cppcoreguidelines-init-variables)
+        ::mp_limb_t q1, q2;
+        dlimb_tdiv_q(op1.m_limbs[0], op1.m_limbs[1], op2.m_limbs[0], op2.m_limbs[1], &q1, &q2);
+        q._mp_size = sign1 * (Gcd ? 1 : sign2) * size_from_lohi(q1, q2);
+        q.m_limbs[0] = q1;
+        q.m_limbs[1] = q2;
+        q.zero_upper_limbs(2);
+        return;
+    }
+    static_divexact_impl<Gcd>(q, op1, op2, asize1, asize2, sign1, sign2, std::integral_constant<int, 0>{});
+    q.zero_unused_limbs();
+}
+
 template <std::size_t SSize>
 inline void static_divexact(static_int<SSize> &q, const static_int<SSize> &op1, const static_int<SSize> &op2)
 {
@@ -5155,6 +6250,61 @@ inline void static_tdiv_q_2exp(static_int<2> &rop, const static_int<2> &n, ::mp_
     // NOLINTNEXTLINE(readability-implicit-bool-conversion)
     rop._mp_size = sign * (asize - ((rop.m_limbs[std::size_t(asize - 1)] & GMP_NUMB_MASK) == 0u));
 }
+
+// Optimisation for 3 and 4 limbs.
+template <std::size_t SSize>
+inline void static_tdiv_q_2exp_small(static_int<SSize> &rop, const static_int<SSize> &n, ::mp_bitcnt_t s)
+{
+    const mpz_size_t asize = std::abs(n._mp_size);
+    if (s == 0u || asize == 0) {
+        rop = n;
+        return;
+    }
+    const int sign = integral_sign(n._mp_size);
+    const auto ls = s / unsigned(GMP_NUMB_BITS), rs = s % unsigned(GMP_NUMB_BITS);
+    if (ls >= static_cast<::mp_bitcnt_t>(asize)) {
+        // If we shift by a number of entire limbs equal to or larger than the asize,
+        // the result will be zero.
+        rop._mp_size = 0;
+        rop.m_limbs.fill(0u);
+        return;
+    }
+    const auto sls = static_cast<std::size_t>(ls);
+    const auto srs = static_cast<unsigned>(rs);
+    // NOTE: copy the limbs of n, as rop and n may overlap.
+    const auto src = n.m_limbs;
+    // NOTE: the unused limbs of n are zero, thus we can
+    // operate on all the limbs of rop.
+    for (std::size_t i = 0; i < SSize; ++i) {
+        if (i + sls >= SSize) {
+            rop.m_limbs[i] = 0u;
+        } else if (srs == 0u) {
+            rop.m_limbs[i] = src[i + sls];
+        } else {
+            const auto hi
+                = i + sls + 1u < SSize
+                      ? (((src[i + sls + 1u] & GMP_NUMB_MASK) << (unsigned(GMP_NUMB_BITS) - srs)) & GMP_NUMB_MASK)
+                      : 0u;
+            rop.m_limbs[i] = ((src[i + sls] & GMP_NUMB_MASK) >> srs) + hi;
+        }
+    }
+    // The new asize is the old one minus ls, or one less than that.
+    const auto new_asize = asize - static_cast<mpz_size_t>(sls);
+    // NOLINTNEXTLINE(readability-implicit-bool-conversion)
+    rop._mp_size = sign * (new_asize - ((rop.m_limbs[std::size_t(new_asize - 1)] & GMP_NUMB_MASK) == 0u));
+}
+
+// 3-limb optimisation.
+inline void static_tdiv_q_2exp(static_int<3> &rop, const static_int<3> &n, ::mp_bitcnt_t s)
+{
+    static_tdiv_q_2exp_small(rop, n, s);
+}
+
+// 4-limb optimisation.
+inline void static_tdiv_q_2exp(static_int<4> &rop, const static_int<4> &n, ::mp_bitcnt_t s)
+{
+    static_tdiv_q_2exp_small(rop, n, s);
+}
 } // namespace detail
 
 // Ternary right shift.
@@ -5222,8 +6372,9 @@ inline int static_cmp(const static_int<1> &n1, const static_int<1> &n2)
     return (n1._mp_size >= 0) ? cmp_abs : -cmp_abs;
 }
 
-// 2-limb optimisation.
-inline int static_cmp(const static_int<2> &n1, const static_int<2> &n2)
+// Optimisation for 2 to 4 limbs.
+template <std::size_t SSize>
+inline int static_cmp_small(const static_int<SSize> &n1, const static_int<SSize> &n2)
 {
     if (n1._mp_size < n2._mp_size) {
         return -1;
@@ -5243,6 +6394,24 @@ inline int static_cmp(const static_int<2> &n1, const static_int<2> &n2)
     }
     return 0;
 }
+
+// 2-limb optimisation.
+inline int static_cmp(const static_int<2> &n1, const static_int<2> &n2)
+{
+    return static_cmp_small(n1, n2);
+}
+
+// 3-limb optimisation.
+inline int static_cmp(const static_int<3> &n1, const static_int<3> &n2)
+{
+    return static_cmp_small(n1, n2);
+}
+
+// 4-limb optimisation.
+inline int static_cmp(const static_int<4> &n1, const static_int<4> &n2)
+{
+    return static_cmp_small(n1, n2);
+}
 } // namespace detail
 
 // Comparison function.
@@ -5392,9 +6561,14 @@ inline bool static_not(static_int<SSize> &rop, const static_int<SSize> &op)
         asize = -asize;
         sign = -1;
     }
-    // NOTE: currently the implementation dispatches only on the static size: there's no need to
-    // zero upper limbs as mpn functions are never used in case of optimised size.
-    return static_not_impl(rop, op, asize, sign);
+    // NOTE: the implementation dispatches only on the static size, and the mpn
+    // implementation is used also for the optimised sizes 3 and 4. In such case, we
+    // need to zero the upper limbs.
+    const bool retval = static_not_impl(rop, op, asize, sign);
+    if (SSize > 2u && retval) {
+        rop.zero_unused_limbs();
+    }
+    return retval;
 }
 } // namespace detail
 
@@ -5656,9 +6830,13 @@ inline void static_ior(static_int<SSize> &rop, const static_int<SSize> &op1, con
         asize2 = -asize2;
         sign2 = -1;
     }
-    // NOTE: currently the implementation dispatches only on the static size: there's no need to
-    // zero upper limbs as mpn functions are never used in case of optimised size.
+    // NOTE: the implementation dispatches only on the static size, and the mpn
+    // implementation is used also for the optimised sizes 3 and 4. In such case, we
+    // need to zero the upper limbs.
     static_ior_impl(rop, op1, op2, asize1, asize2, sign1, sign2);
+    if (SSize > 2u) {
+        rop.zero_unused_limbs();
+    }
 }
 } // namespace detail
 
@@ -5906,9 +7084,14 @@ inline bool static_and(static_int<SSize> &rop, const static_int<SSize> &op1, con
         asize2 = -asize2;
         sign2 = -1;
     }
-    // NOTE: currently the implementation dispatches only on the static size: there's no need to
-    // zero upper limbs as mpn functions are never used in case of optimised size.
-    return static_and_impl(rop, op1, op2, asize1, asize2, sign1, sign2);
+    // NOTE: the implementation dispatches only on the static size, and the mpn
+    // implementation is used also for the optimised sizes 3 and 4. In such case, we
+    // need to zero the upper limbs.
+    const bool retval = static_and_impl(rop, op1, op2, asize1, asize2, sign1, sign2);
+    if (SSize > 2u && retval) {
+        rop.zero_unused_limbs();
+    }
+    return retval;
 }
 } // namespace detail
 
@@ -5950,7 +7133,7 @@ inline bool static_xor_impl(static_int<1> &rop, const static_int<1> &op1, const
         // NOLINTNEXTLINE(readability-implicit-bool-conversion)
         rop._mp_size = ret != 0u;
         rop.m_limbs[0] = ret;
-        return false;
+        return true;
     }
     const unsigned sign_mask = unsigned(sign1 < 0) + (unsigned(sign2 < 0) << 1);
     // NOLINTNEXTLINE(hicpp-multiway-paths-covered)
@@ -6167,9 +7350,14 @@ inline bool static_xor(static_int<SSize> &rop, const static_int<SSize> &op1, con
         asize2 = -asize2;
         sign2 = -1;
     }
-    // NOTE: currently the implementation dispatches only on the static size: there's no need to
-    // zero upper limbs as mpn functions are never used in case of optimised size.
-    return static_xor_impl(rop, op1, op2, asize1, asize2, sign1, sign2);
+    // NOTE: the implementation dispatches only on the static size, and the mpn
+    // implementation is used also for the optimised sizes 3 and 4. In such case, we
+    // need to zero the upper limbs.
+    const bool retval = static_xor_impl(rop, op1, op2, asize1, asize2, sign1, sign2);
+    if (SSize > 2u && retval) {
+        rop.zero_unused_limbs();
+    }
+    return retval;
 }
 } // namespace detail
 
@@ -6198,12 +7386,309 @@ inline integer<SSize> &bitwise_xor(integer<SSize> &rop, const integer<SSize> &op
 namespace detail
 {
 
-// mpn/mpz implementation.
-template <std::size_t SSize>
-inline void static_gcd_impl(static_int<SSize> &rop, const static_int<SSize> &op1, const static_int<SSize> &op2,
-                            mpz_size_t asize1, mpz_size_t asize2)
+// Population count of a limb.
+inline unsigned limb_popcount(::mp_limb_t l)
 {
-    // NOTE: performance testing indicates that, even if mpz_gcd() does special casing
+#if defined(__clang__) || defined(__GNUC__)
+    return builtin_popcount(l & GMP_NUMB_MASK);
+#else
+    return static_cast<unsigned>(mpn_popcount(&l, 1));
+#endif
+}
+
+// Index of the least significant set bit of the nonzero limb l.
+inline unsigned limb_scan1(::mp_limb_t l)
+{
+    assert((l & GMP_NUMB_MASK) != 0u);
+#if (defined(__clang__) || defined(__GNUC__)) && !GMP_NAIL_BITS
+    return builtin_ctz(l);
+#else
+    return static_cast<unsigned>(mpn_scan1(&l, 0));
+#endif
+}
+
+// Implementation of scan0()/scan1() for nonnegative static integers.
+template <bool Scan1, std::size_t SSize>
+inline ::mp_bitcnt_t static_scan(const static_int<SSize> &ns, ::mp_bitcnt_t start)
+{
+    assert(ns._mp_size >= 0);
+    const auto size = static_cast<std::size_t>(ns._mp_size);
+    // NOTE: past the most significant limb all bits are zero, thus
+    // scan1() finds nothing and scan0() stops at the first bit examined.
+    const auto q = start / unsigned(GMP_NUMB_BITS);
+    if (q >= size) {
+        return Scan1 ? nl_max<::mp_bitcnt_t>() : start;
+    }
+    auto lidx = static_cast<std::size_t>(q);
+    // Examine the limbs starting from the one containing the start bit, masking
+    // out the bits below start. When looking for zeroes, complement the limbs.
+    auto l = (Scan1 ? ns.m_limbs[lidx] : ~ns.m_limbs[lidx]) & (GMP_NUMB_MASK << (start % unsigned(GMP_NUMB_BITS)))
+             & GMP_NUMB_MASK;
+    while (l == 0u) {
+        if (++lidx == size) {
+            return Scan1 ? nl_max<::mp_bitcnt_t>() : static_cast<::mp_bitcnt_t>(size) * unsigned(GMP_NUMB_BITS);
+        }
+        l = (Scan1 ? ns.m_limbs[lidx] : ~ns.m_limbs[lidx]) & GMP_NUMB_MASK;
+    }
+    return static_cast<::mp_bitcnt_t>(lidx) * unsigned(GMP_NUMB_BITS) + limb_scan1(l);
+}
+
+// Helper to apply an mpz bit manipulation function
+// to an integer in static storage.
+template <std::size_t SSize, typename F>
+inline void static_mpz_bit_op(integer<SSize> &n, ::mp_bitcnt_t idx, const F &f)
+{
+    assert(n.is_static());
+    MPPP_MAYBE_TLS mpz_raii tmp;
+    mpz_set(&tmp.m_mpz, n.get_mpz_view());
+    f(&tmp.m_mpz, idx);
+    n = &tmp.m_mpz;
+}
+
+// Implementation of setbit()/clrbit()/combit() for a nonnegative static integer.
+// Op is 0 for setbit(), 1 for clrbit() and 2 for combit(). Returns false if
+// the result does not fit in static storage.
+template <int Op, std::size_t SSize>
+inline bool static_bit_op(static_int<SSize> &ns, ::mp_bitcnt_t idx)
+{
+    assert(ns._mp_size >= 0);
+    const auto lidx = idx / unsigned(GMP_NUMB_BITS);
+    const auto bit = ::mp_limb_t(1) << (idx % unsigned(GMP_NUMB_BITS));
+    const auto size = static_cast<std::size_t>(ns._mp_size);
+    if (lidx >= SSize) {
+        // NOTE: clearing a bit past the most significant limb is a no-op,
+        // the other operations require more limbs.
+        return Op == 1;
+    }
+    const auto i = static_cast<std::size_t>(lidx);
+    if (i >= size) {
+        if (Op == 1) {
+            return true;
+        }
+        // NOTE: the limbs above the size are guaranteed to be zero
+        // only if SSize <= opt_size (see zero_upper_limbs()).
+        if (SSize > static_int<SSize>::opt_size) {
+            std::fill(ns.m_limbs.data() + size, ns.m_limbs.data() + i, ::mp_limb_t(0));
+        }
+        assert(std::all_of(ns.m_limbs.data() + size, ns.m_limbs.data() + i, [](::mp_limb_t l) { return l == 0u; }));
+        ns.m_limbs[i] = bit;
+        ns._mp_size = static_cast<mpz_size_t>(i + 1u);
+        return true;
+    }
+    if (Op == 0) {
+        ns.m_limbs[i] |= bit;
+    } else if (Op == 1) {
+        ns.m_limbs[i] &= ~bit;
+    } else {
+        ns.m_limbs[i] ^= bit;
+    }
+    if (i + 1u == size) {
+        // Normalise, as we might have cleared the most significant limb.
+        auto new_size = size;
+        while (new_size != 0u && !(ns.m_limbs[new_size - 1u] & GMP_NUMB_MASK)) {
+            --new_size;
+        }
+        ns._mp_size = static_cast<mpz_size_t>(new_size);
+    }
+    return true;
+}
+
+template <int Op, std::size_t SSize>
+inline integer<SSize> &bit_op_impl(integer<SSize> &n, ::mp_bitcnt_t idx)
+{
+    using f_ptr = void (*)(::mpz_t, ::mp_bitcnt_t);
+    constexpr f_ptr fs[] = {mpz_setbit, mpz_clrbit, mpz_combit};
+
+    if (mppp_likely(n.is_static())) {
+        if (mppp_likely(n.sgn() >= 0 && static_bit_op<Op>(n._get_union().g_st(), idx))) {
+            return n;
+        }
+        // NOTE: negative values, or results which do not fit in static storage.
+        static_mpz_bit_op(n, idx, fs[Op]);
+    } else {
+        fs[Op](&n._get_union().g_dy(), idx);
+    }
+    return n;
+}
+
+} // namespace detail
+
+// Population count.
+template <std::size_t SSize>
+inline ::mp_bitcnt_t popcount(const integer<SSize> &n)
+{
+    if (mppp_unlikely(n.sgn() == -1)) {
+        throw std::domain_error("Cannot compute the population count of the negative number " + n.to_string());
+    }
+    if (mppp_likely(n.is_static())) {
+        const auto &ns = n._get_union().g_st();
+        ::mp_bitcnt_t retval = 0;
+        for (std::size_t i = 0; i < static_cast<std::size_t>(ns._mp_size); ++i) {
+            retval += detail::limb_popcount(ns.m_limbs[i]);
+        }
+        return retval;
+    }
+    return mpz_popcount(n.get_mpz_view());
+}
+
+// Hamming distance.
+template <std::size_t SSize>
+inline ::mp_bitcnt_t hamdist(const integer<SSize> &op1, const integer<SSize> &op2)
+{
+    const auto sgn1 = op1.sgn(), sgn2 = op2.sgn();
+    if (mppp_unlikely((sgn1 == -1) != (sgn2 == -1))) {
+        throw std::domain_error("Cannot compute the Hamming distance between the integers " + op1.to_string()
+                                + " and " + op2.to_string() + ", which have different signs");
+    }
+    if (mppp_likely(op1.is_static() && op2.is_static() && sgn1 >= 0)) {
+        const auto &s1 = op1._get_union().g_st(), &s2 = op2._get_union().g_st();
+        const auto size1 = static_cast<std::size_t>(s1._mp_size), size2 = static_cast<std::size_t>(s2._mp_size);
+        const auto min_size = detail::c_min(size1, size2);
+        ::mp_bitcnt_t retval = 0;
+        std::size_t i = 0;
+        for (; i < min_size; ++i) {
+            retval += detail::limb_popcount(s1.m_limbs[i] ^ s2.m_limbs[i]);
+        }
+        const auto &sl = size1 > size2 ? s1 : s2;
+        for (; i < detail::c_max(size1, size2); ++i) {
+            retval += detail::limb_popcount(sl.m_limbs[i]);
+        }
+        return retval;
+    }
+    return mpz_hamdist(op1.get_mpz_view(), op2.get_mpz_view());
+}
+
+// Scan for the first zero bit.
+template <std::size_t SSize>
+inline ::mp_bitcnt_t scan0(const integer<SSize> &n, ::mp_bitcnt_t start)
+{
+    if (mppp_likely(n.is_static() && n.sgn() >= 0)) {
+        return detail::static_scan<false>(n._get_union().g_st(), start);
+    }
+    return mpz_scan0(n.get_mpz_view(), start);
+}
+
+// Scan for the first one bit.
+template <std::size_t SSize>
+inline ::mp_bitcnt_t scan1(const integer<SSize> &n, ::mp_bitcnt_t start)
+{
+    if (mppp_likely(n.is_static() && n.sgn() >= 0)) {
+        return detail::static_scan<true>(n._get_union().g_st(), start);
+    }
+    return mpz_scan1(n.get_mpz_view(), start);
+}
+
+// Test bit.
+template <std::size_t SSize>
+inline bool tstbit(const integer<SSize> &n, ::mp_bitcnt_t idx)
+{
+    if (mppp_likely(n.is_static() && n.sgn() >= 0)) {
+        const auto &ns = n._get_union().g_st();
+        const auto lidx = idx / unsigned(GMP_NUMB_BITS);
+        return lidx < static_cast<::mp_bitcnt_t>(ns._mp_size)
+               && ((ns.m_limbs[static_cast<std::size_t>(lidx)] >> (idx % unsigned(GMP_NUMB_BITS))) & 1u);
+    }
+    return mpz_tstbit(n.get_mpz_view(), idx) != 0;
+}
+
+// Set bit.
+template <std::size_t SSize>
+inline integer<SSize> &setbit(integer<SSize> &n, ::mp_bitcnt_t idx)
+{
+    return detail::bit_op_impl<0>(n, idx);
+}
+
+// Clear bit.
+template <std::size_t SSize>
+inline integer<SSize> &clrbit(integer<SSize> &n, ::mp_bitcnt_t idx)
+{
+    return detail::bit_op_impl<1>(n, idx);
+}
+
+// Complement bit.
+template <std::size_t SSize>
+inline integer<SSize> &combit(integer<SSize> &n, ::mp_bitcnt_t idx)
+{
+    return detail::bit_op_impl<2>(n, idx);
+}
+
+namespace detail
+{
+
+// Implementation of extract_bits() for a nonnegative static integer.
+// NOTE: rops and ns can coincide.
+template <std::size_t SSize>
+inline void static_extract_bits(static_int<SSize> &rops, const static_int<SSize> &ns, ::mp_bitcnt_t begin,
+                                ::mp_bitcnt_t len)
+{
+    assert(ns._mp_size >= 0);
+    const auto size = static_cast<std::size_t>(ns._mp_size);
+    const auto q = begin / unsigned(GMP_NUMB_BITS);
+    const auto r = static_cast<unsigned>(begin % unsigned(GMP_NUMB_BITS));
+    // Number of limbs needed to represent len bits.
+    const auto len_limbs = len / unsigned(GMP_NUMB_BITS) + static_cast<unsigned>(len % unsigned(GMP_NUMB_BITS) != 0u);
+
+    // Compute the result in a temporary array, as rops and ns might coincide.
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-member-init, hicpp-member-init)
+    std::array<::mp_limb_t, SSize> tmp;
+    std::size_t new_size = 0;
+    if (q < size) {
+        const auto qs = static_cast<std::size_t>(q);
+        new_size = static_cast<std::size_t>(c_min(static_cast<::mp_bitcnt_t>(size - qs), len_limbs));
+        for (std::size_t i = 0; i < new_size; ++i) {
+            auto l = ns.m_limbs[qs + i] >> r;
+            if (r != 0u && qs + i + 1u < size) {
+                l |= ns.m_limbs[qs + i + 1u] << (unsigned(GMP_NUMB_BITS) - r);
+            }
+            tmp[i] = l & GMP_NUMB_MASK;
+        }
+        if (new_size != 0u && new_size == len_limbs && len % unsigned(GMP_NUMB_BITS) != 0u) {
+            // Mask the most significant limb.
+            tmp[new_size - 1u] &= (::mp_limb_t(1) << (len % unsigned(GMP_NUMB_BITS))) - 1u;
+        }
+        while (new_size != 0u && tmp[new_size - 1u] == 0u) {
+            --new_size;
+        }
+    }
+
+    rops._mp_size = static_cast<mpz_size_t>(new_size);
+    copy_limbs_no(tmp.data(), tmp.data() + new_size, rops.m_limbs.data());
+    rops.zero_upper_limbs(new_size);
+}
+
+} // namespace detail
+
+// Extract a range of bits.
+template <std::size_t SSize>
+inline integer<SSize> &extract_bits(integer<SSize> &rop, const integer<SSize> &n, ::mp_bitcnt_t begin,
+                                    ::mp_bitcnt_t len)
+{
+    if (mppp_likely(n.is_static() && n.sgn() >= 0)) {
+        if (!rop.is_static()) {
+            // NOTE: rop and n are distinct, as n is static.
+            rop.set_zero();
+        }
+        detail::static_extract_bits(rop._get_union().g_st(), n._get_union().g_st(), begin, len);
+        return rop;
+    }
+    // NOTE: the floor division and the remainder of the floor division
+    // by powers of two implement the two's complement semantics.
+    MPPP_MAYBE_TLS detail::mpz_raii tmp;
+    mpz_fdiv_q_2exp(&tmp.m_mpz, n.get_mpz_view(), begin);
+    mpz_fdiv_r_2exp(&tmp.m_mpz, &tmp.m_mpz, len);
+    rop = &tmp.m_mpz;
+    return rop;
+}
+
+namespace detail
+{
+
+// mpn/mpz implementation.
+template <std::size_t SSize>
+inline void static_gcd_impl(static_int<SSize> &rop, const static_int<SSize> &op1, const static_int<SSize> &op2,
+                            mpz_size_t asize1, mpz_size_t asize2)
+{
+    // NOTE: performance testing indicates that, even if mpz_gcd() does special casing
     // for zeroes and 1-limb values, it is still worth it to repeat the special casing
     // here. This is probably because if we manage to actually call mpn_gcd_1() here,
     // we avoid interacting with dynamically allocated memory below in the thread-local
@@ -6472,10 +7957,76 @@ inline integer<SSize> lcm(const integer<SSize> &op1, const integer<SSize> &op2)
     }
 }
 
+namespace detail
+{
+
+// The largest n whose factorial fits in 64 bits.
+constexpr unsigned long max_small_fac = 20;
+
+#if defined(MPPP_HAVE_DLIMB_T)
+
+// Try to compute the binomial coefficient (n, k) via the multiplicative
+// formula in limb arithmetic. Returns false if the result does not fit
+// in a single limb.
+inline bool limb_bin_ui(::mp_limb_t &rop, ::mp_limb_t n, unsigned long k)
+{
+    if (k > n) {
+        rop = 0;
+        return true;
+    }
+    // NOTE: use the symmetry of the binomial coefficient
+    // to minimise the number of iterations.
+    const auto kk = c_min(static_cast<::mp_limb_t>(k), static_cast<::mp_limb_t>(n - k));
+    ::mp_limb_t r = 1;
+    for (::mp_limb_t i = 1; i <= kk; ++i) {
+        // NOTE: the new value of r is the binomial coefficient (n - kk + i, i),
+        // thus the division is exact. The intermediate values increase
+        // monotonically, so we can stop as soon as one of them overflows.
+        const auto q = static_cast<dlimb_t>(static_cast<dlimb_t>(r) * (n - kk + i)) / i;
+        if (q > GMP_NUMB_MAX) {
+            return false;
+        }
+        r = static_cast<::mp_limb_t>(q);
+    }
+    rop = r;
+    return true;
+}
+
+#endif
+
+} // namespace detail
+
 // Factorial.
 template <std::size_t SSize>
 inline integer<SSize> &fac_ui(integer<SSize> &rop, unsigned long n)
 {
+    // NOTE: small factorials are read from a table, without calling into GMP.
+    static constexpr unsigned long long small_facs[] = {1ull,
+                                                        1ull,
+                                                        2ull,
+                                                        6ull,
+                                                        24ull,
+                                                        120ull,
+                                                        720ull,
+                                                        5040ull,
+                                                        40320ull,
+                                                        362880ull,
+                                                        3628800ull,
+                                                        39916800ull,
+                                                        479001600ull,
+                                                        6227020800ull,
+                                                        87178291200ull,
+                                                        1307674368000ull,
+                                                        20922789888000ull,
+                                                        355687428096000ull,
+                                                        6402373705728000ull,
+                                                        121645100408832000ull,
+                                                        2432902008176640000ull};
+    static_assert(sizeof(small_facs) / sizeof(small_facs[0]) == detail::max_small_fac + 1u,
+                  "Invalid size for the table of small factorials.");
+    if (n <= detail::max_small_fac) {
+        return rop = small_facs[n];
+    }
     // NOTE: we put a limit here because the GMP function just crashes and burns
     // if n is too large, and n does not even need to be that large.
     constexpr auto max_fac = 1000000ull;
@@ -6485,6 +8036,21 @@ inline integer<SSize> &fac_ui(integer<SSize> &rop, unsigned long n)
             + " is too large to be used as input for the factorial function (the maximum allowed value is "
             + detail::to_string(max_fac) + ")");
     }
+    // NOTE: past the end of the table, keep on multiplying in static
+    // storage for as long as the result fits.
+    integer<SSize> acc{small_facs[detail::max_small_fac]};
+    if (acc.is_static()) {
+        auto &st = acc._get_union().g_st();
+        auto i = detail::max_small_fac + 1u;
+        for (; i <= n; ++i) {
+            if (detail::static_mul(st, st, detail::static_int<SSize>(1, static_cast<::mp_limb_t>(i))) != 0u) {
+                break;
+            }
+        }
+        if (i > n) {
+            return rop = std::move(acc);
+        }
+    }
     // NOTE: let's get through a static temporary and then assign it to the rop,
     // so that rop will be static/dynamic according to the size of tmp.
     MPPP_MAYBE_TLS detail::mpz_raii tmp;
@@ -6496,6 +8062,18 @@ inline integer<SSize> &fac_ui(integer<SSize> &rop, unsigned long n)
 template <std::size_t SSize>
 inline integer<SSize> &bin_ui(integer<SSize> &rop, const integer<SSize> &n, unsigned long k)
 {
+#if defined(MPPP_HAVE_DLIMB_T)
+    // Fast path for a static nonnegative n with at most one limb,
+    // if the result fits in a single limb.
+    const auto &nu = n._get_union();
+    if (nu.is_static() && (nu.g_st()._mp_size == 0 || nu.g_st()._mp_size == 1)) {
+        // NOLINTNEXTLINE(cppcoreguidelines-init-variables)
+        ::mp_limb_t r;
+        if (detail::limb_bin_ui(r, nu.g_st()._mp_size == 0 ? ::mp_limb_t(0) : nu.g_st().m_limbs[0], k)) {
+            return rop = r;
+        }
+    }
+#endif
     MPPP_MAYBE_TLS detail::mpz_raii tmp;
     mpz_bin_ui(&tmp.m_mpz, n.get_mpz_view(), k);
     return rop = &tmp.m_mpz;
@@ -6606,13 +8184,267 @@ binomial(const T &n, const U &k)
 namespace detail
 {
 
+// The single-limb primality test requires double-limb
+// multiplication (which also implies no nail bits).
+#if (defined(_MSC_VER) && defined(_WIN64) && GMP_NUMB_BITS == 64 && !GMP_NAIL_BITS) || defined(MPPP_HAVE_DLIMB_T)
+
+#define MPPP_INTEGER_HAVE_LIMB_PRIME_TEST
+
+// Compute -m**-1 modulo 2**GMP_NUMB_BITS for odd m.
+inline ::mp_limb_t mont_minv(::mp_limb_t m)
+{
+    assert((m & 1u) != 0u);
+
+    // NOTE: m is its own inverse modulo 2**3, and each
+    // Newton iteration doubles the number of correct bits.
+    auto inv = m;
+    for (unsigned nbits = 3; nbits < unsigned(GMP_NUMB_BITS); nbits *= 2u) {
+        inv = static_cast<::mp_limb_t>(inv * (2u - m * inv));
+    }
+
+    return static_cast<::mp_limb_t>(~inv + 1u);
+}
+
+// Montgomery multiplication modulo the odd limb n:
+// a * b * 2**(-GMP_NUMB_BITS) mod n. a and b must be less than n,
+// and ninv must be -n**-1 modulo 2**GMP_NUMB_BITS.
+inline ::mp_limb_t limb_mont_mul(::mp_limb_t a, ::mp_limb_t b, ::mp_limb_t n, ::mp_limb_t ninv)
+{
+    // NOLINTNEXTLINE(cppcoreguidelines-init-variables)
+    ::mp_limb_t hi, mhi;
+    const auto lo = dlimb_mul(a, b, &hi);
+    dlimb_mul(static_cast<::mp_limb_t>(lo * ninv), n, &mhi);
+    // NOTE: the low limb of a * b + m * n is zero by construction,
+    // with a carry into the high limb if and only if lo is nonzero.
+    // The high limb is less than 2 * n, but it might not fit in a limb.
+    auto r = static_cast<::mp_limb_t>(hi + mhi);
+    bool ovf = r < hi;
+    const auto carry = static_cast<::mp_limb_t>(lo != 0u);
+    r = static_cast<::mp_limb_t>(r + carry);
+    ovf = ovf || r < carry;
+    if (ovf || r >= n) {
+        r = static_cast<::mp_limb_t>(r - n);
+    }
+    return r;
+}
+
+// Modular addition, subtraction and halving modulo
+// the odd limb n. The operands must be less than n.
+inline ::mp_limb_t limb_add_mod(::mp_limb_t a, ::mp_limb_t b, ::mp_limb_t n)
+{
+    return a >= n - b ? a - (n - b) : a + b;
+}
+
+inline ::mp_limb_t limb_sub_mod(::mp_limb_t a, ::mp_limb_t b, ::mp_limb_t n)
+{
+    return a >= b ? a - b : a + (n - b);
+}
+
+inline ::mp_limb_t limb_half_mod(::mp_limb_t a, ::mp_limb_t n)
+{
+    // NOTE: if a is odd, (a + n) / 2 is computed
+    // in a way which avoids overflow.
+    return (a & 1u) ? (a >> 1) + (n >> 1) + 1u : a >> 1;
+}
+
+// Jacobi symbol (a/n), for odd n and a < n.
+inline int limb_jacobi(::mp_limb_t a, ::mp_limb_t n)
+{
+    assert((n & 1u) != 0u && a < n);
+
+    int retval = 1;
+    while (a != 0u) {
+        while ((a & 1u) == 0u) {
+            a >>= 1;
+            const auto r = n % 8u;
+            if (r == 3u || r == 5u) {
+                retval = -retval;
+            }
+        }
+        std::swap(a, n);
+        if (a % 4u == 3u && n % 4u == 3u) {
+            retval = -retval;
+        }
+        a %= n;
+    }
+
+    return n == 1u ? retval : 0;
+}
+
+// Deterministic primality test for a single limb, via the Baillie-PSW test
+// (a strong probable prime test to base 2 followed by a strong Lucas probable
+// prime test with the parameters chosen via Selfridge's method). It has been
+// verified that there are no Baillie-PSW pseudoprimes below 2**64.
+inline bool limb_is_prime(::mp_limb_t n)
+{
+    // Trial division by the small primes.
+    static constexpr unsigned char small_primes[] = {2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37, 41, 43, 47, 53};
+    if (n < 2u) {
+        return false;
+    }
+    for (auto p : small_primes) {
+        if (n % p == 0u) {
+            return n == p;
+        }
+    }
+    // NOTE: n has no prime factors up to 53, thus
+    // it is a prime if it is less than 59**2.
+    if (n < 59u * 59u) {
+        return true;
+    }
+    // NOTE: 2**GMP_NUMB_BITS - 1 is divisible by 3.
+    assert(n != GMP_NUMB_MAX);
+
+    // Montgomery form of 1 and -1.
+    const auto ninv = mont_minv(n);
+    const auto one = static_cast<::mp_limb_t>(static_cast<::mp_limb_t>(~n + 1u) % n);
+    const auto mone = n - one;
+
+    // Strong probable prime test to base 2, with n - 1 = d * 2**s.
+    auto d = n - 1u;
+    unsigned s = 0;
+    while ((d & 1u) == 0u) {
+        d >>= 1;
+        ++s;
+    }
+    // NOTE: in the computation of 2**d, the multiplications
+    // by 2 are just modular additions.
+    auto x = one;
+    for (auto k = static_cast<int>(limb_size_nbits(d)) - 1; k >= 0; --k) {
+        x = limb_mont_mul(x, x, n, ninv);
+        if ((d >> k) & 1u) {
+            x = limb_add_mod(x, x, n);
+        }
+    }
+    if (x != one && x != mone) {
+        unsigned r = 1;
+        for (; r < s; ++r) {
+            x = limb_mont_mul(x, x, n, ninv);
+            if (x == mone) {
+                break;
+            }
+        }
+        if (r == s) {
+            return false;
+        }
+    }
+
+    // Strong Lucas probable prime test. The first step is to find the first D
+    // in the sequence 5, -7, 9, -11, ... for which the Jacobi symbol (D/n) is -1.
+    // NOTE: if n is a perfect square, such a D does not exist.
+    if (mpn_perfect_square_p(&n, 1) != 0) {
+        return false;
+    }
+    ::mp_limb_t dabs = 5;
+    bool dneg = false;
+    while (true) {
+        // NOTE: dabs is always much smaller than n.
+        assert(dabs < n);
+        const auto j = limb_jacobi(dneg ? n - dabs : dabs, n);
+        if (j == -1) {
+            break;
+        }
+        if (j == 0) {
+            // D and n have a common factor.
+            return false;
+        }
+        dabs += 2u;
+        dneg = !dneg;
+    }
+
+    // Montgomery form of D and of Q = (1 - D) / 4 (with P = 1). The conversion
+    // multiplies by 2**(2 * GMP_NUMB_BITS) mod n, computed via modular doublings.
+    auto r2 = one;
+    for (unsigned i = 0; i < unsigned(GMP_NUMB_BITS); ++i) {
+        r2 = limb_add_mod(r2, r2, n);
+    }
+    auto to_mont = [n, ninv, r2](::mp_limb_t v, bool neg) {
+        const auto r = limb_mont_mul(v, r2, n, ninv);
+        return (neg && r != 0u) ? n - r : r;
+    };
+    const auto dm = to_mont(dabs, dneg);
+    // NOTE: D is 1 modulo 4, thus Q is negative if D is positive, and vice versa.
+    const auto qm = dneg ? to_mont((dabs + 1u) / 4u, false) : to_mont((dabs - 1u) / 4u, true);
+
+    // Compute U_d, V_d and Q**d via left-to-right binary exponentiation,
+    // with n + 1 = d * 2**s.
+    d = n + 1u;
+    s = 0;
+    while ((d & 1u) == 0u) {
+        d >>= 1;
+        ++s;
+    }
+    auto u = one, v = one, qk = qm;
+    for (auto k = static_cast<int>(limb_size_nbits(d)) - 2; k >= 0; --k) {
+        // U_2k = U_k * V_k, V_2k = V_k**2 - 2 * Q**k.
+        u = limb_mont_mul(u, v, n, ninv);
+        v = limb_sub_mod(limb_mont_mul(v, v, n, ninv), limb_add_mod(qk, qk, n), n);
+        qk = limb_mont_mul(qk, qk, n, ninv);
+        if ((d >> k) & 1u) {
+            // U_k+1 = (U_k + V_k) / 2, V_k+1 = (D * U_k + V_k) / 2.
+            const auto tmp = limb_half_mod(limb_add_mod(u, v, n), n);
+            v = limb_half_mod(limb_add_mod(limb_mont_mul(dm, u, n, ninv), v, n), n);
+            u = tmp;
+            qk = limb_mont_mul(qk, qm, n, ninv);
+        }
+    }
+    if (u == 0u || v == 0u) {
+        return true;
+    }
+    for (unsigned r = 1; r < s; ++r) {
+        v = limb_sub_mod(limb_mont_mul(v, v, n, ninv), limb_add_mod(qk, qk, n), n);
+        if (v == 0u) {
+            return true;
+        }
+        qk = limb_mont_mul(qk, qk, n, ninv);
+    }
+
+    return false;
+}
+
+#endif
+
 template <std::size_t SSize>
 inline void nextprime_impl(integer<SSize> &rop, const integer<SSize> &n)
 {
+#if defined(MPPP_INTEGER_HAVE_LIMB_PRIME_TEST)
+    // Fast path for nonnegative n with at most one limb.
+    if (n.sgn() >= 0 && n.size() <= 1u) {
+        const auto &u = n._get_union();
+        const ::mp_limb_t l = n.is_zero() ? 0u : (u.is_static() ? u.g_st().m_limbs[0] : u.g_dy()._mp_d[0]);
+        if (l < 2u) {
+            rop = 2;
+            return;
+        }
+        // NOTE: iterate over the odd candidates, stopping
+        // before the candidate overflows a limb.
+        for (auto c = (l & 1u) ? l + 2u : l + 1u; c >= l; c += 2u) {
+            if (limb_is_prime(c)) {
+                rop = c;
+                return;
+            }
+        }
+    }
+#endif
     MPPP_MAYBE_TLS mpz_raii tmp;
     mpz_nextprime(&tmp.m_mpz, n.get_mpz_view());
     rop = &tmp.m_mpz;
 }
+
+template <std::size_t SSize>
+inline int probab_prime_p_impl(const integer<SSize> &n, int reps)
+{
+    assert(reps >= 1 && n.sgn() >= 0);
+#if defined(MPPP_INTEGER_HAVE_LIMB_PRIME_TEST)
+    // NOTE: the test on a single limb is deterministic.
+    if (n.size() == 1u) {
+        const auto &u = n._get_union();
+        return limb_is_prime(u.is_static() ? u.g_st().m_limbs[0] : u.g_dy()._mp_d[0]) ? 2 : 0;
+    }
+#endif
+    return mpz_probab_prime_p(n.get_mpz_view(), reps);
+}
+
 } // namespace detail
 
 // Compute next prime number (binary version).
@@ -6640,18 +8472,151 @@ inline int probab_prime_p(const integer<SSize> &n, int reps = 25)
     return n.probab_prime_p(reps);
 }
 
+namespace detail
+{
+
+// Early overflow detection for static exponentiation: return true if base**exp
+// certainly does not fit in static storage. exp must be nonzero.
+template <std::size_t SSize>
+inline bool static_pow_ui_overflow(const static_int<SSize> &base, unsigned long exp)
+{
+    assert(exp != 0u);
+
+    const auto asize = static_cast<std::size_t>(base.abs_size());
+    if (asize == 0u) {
+        return false;
+    }
+
+    // NOTE: if base has nbits bits, then base**exp has at least
+    // (nbits - 1) * exp + 1 bits. If nbits is 1, base is +-1
+    // and the result always fits.
+    const auto nbits = (asize - 1u) * unsigned(GMP_NUMB_BITS) + limb_size_nbits(base.m_limbs[asize - 1u]);
+    return nbits > 1u && exp > (SSize * unsigned(GMP_NUMB_BITS) - 1u) / (nbits - 1u);
+}
+
+// Static exponentiation via left-to-right binary exponentiation.
+// exp must be nonzero. rop is written only in case of success (and it
+// may thus overlap with base). Returns false if the result does
+// not fit in static storage.
+template <std::size_t SSize>
+inline bool static_pow_ui(static_int<SSize> &rop, const static_int<SSize> &base, unsigned long exp)
+{
+    assert(exp != 0u);
+
+    if (mppp_unlikely(static_pow_ui_overflow(base, exp))) {
+        return false;
+    }
+
+    // NOTE: the most significant bit of the exponent is accounted
+    // for by the initialisation of acc.
+    auto acc(base);
+    auto nbits = unsigned(nl_digits<unsigned long>()) - 1u;
+    while (((exp >> nbits) & 1u) == 0u) {
+        --nbits;
+    }
+    while (nbits-- > 0u) {
+        if (mppp_unlikely(static_sqr(acc, acc) != 0u)) {
+            return false;
+        }
+        if (((exp >> nbits) & 1u) != 0u && mppp_unlikely(static_mul(acc, acc, base) != 0u)) {
+            return false;
+        }
+    }
+
+    rop = acc;
+    return true;
+}
+
+// Unrolled version of static_pow_ui() for a compile-time exponent.
+// acc must be initialised to base, and it will be set to base**N in case
+// of success. N must be nonzero.
+template <unsigned long N>
+struct static_pow_ui_unroller {
+    template <std::size_t SSize>
+    static bool run(static_int<SSize> &acc, const static_int<SSize> &base)
+    {
+        if (mppp_unlikely(!static_pow_ui_unroller<N / 2u>::run(acc, base) || static_sqr(acc, acc) != 0u)) {
+            return false;
+        }
+        return N % 2u == 0u || mppp_likely(static_mul(acc, acc, base) == 0u);
+    }
+};
+
+template <>
+struct static_pow_ui_unroller<1> {
+    template <std::size_t SSize>
+    static bool run(static_int<SSize> &, const static_int<SSize> &)
+    {
+        return true;
+    }
+};
+
+} // namespace detail
+
 // Ternary exponentiation.
 template <std::size_t SSize>
 inline integer<SSize> &pow_ui(integer<SSize> &rop, const integer<SSize> &base, unsigned long exp)
 {
+    if (exp == 0u) {
+        return rop.set_one();
+    }
+    if (mppp_likely(base.is_static())) {
+        // NOTE: compute into a local variable, so that a dynamic rop
+        // is demoted only if the result fits in static storage.
+        detail::static_int<SSize> res;
+        if (mppp_likely(detail::static_pow_ui(res, base._get_union().g_st(), exp))) {
+            if (!rop.is_static()) {
+                rop.set_zero();
+            }
+            rop._get_union().g_st() = res;
+            return rop;
+        }
+    }
+    MPPP_MAYBE_TLS detail::mpz_raii tmp;
+    mpz_pow_ui(&tmp.m_mpz, base.get_mpz_view(), exp);
+    return rop = &tmp.m_mpz;
+}
+
+// Binary exponentiation.
+template <std::size_t SSize>
+inline integer<SSize> pow_ui(const integer<SSize> &base, unsigned long exp)
+{
+    integer<SSize> retval;
+    pow_ui(retval, base, exp);
+    return retval;
+}
+
+// Ternary exponentiation with a compile-time exponent.
+template <std::size_t SSize, unsigned long N>
+inline integer<SSize> &pow_ui(integer<SSize> &rop, const integer<SSize> &base,
+                              const std::integral_constant<unsigned long, N> &)
+{
+    if (N == 0u) {
+        return rop.set_one();
+    }
+    if (mppp_likely(base.is_static())) {
+        // NOTE: accumulate in a local variable, so that
+        // base is left untouched in case of failure.
+        auto acc(base._get_union().g_st());
+        if (mppp_likely(!detail::static_pow_ui_overflow(acc, N)
+                        && detail::static_pow_ui_unroller<N == 0u ? 1u : N>::run(acc, base._get_union().g_st()))) {
+            if (!rop.is_static()) {
+                rop.set_zero();
+            }
+            rop._get_union().g_st() = acc;
+            return rop;
+        }
+    }
+    // NOTE: don't forward to the runtime pow_ui(), which
+    // would attempt the static computation again.
     MPPP_MAYBE_TLS detail::mpz_raii tmp;
-    mpz_pow_ui(&tmp.m_mpz, base.get_mpz_view(), exp);
+    mpz_pow_ui(&tmp.m_mpz, base.get_mpz_view(), N);
     return rop = &tmp.m_mpz;
 }
 
-// Binary exponentiation.
-template <std::size_t SSize>
-inline integer<SSize> pow_ui(const integer<SSize> &base, unsigned long exp)
+// Binary exponentiation with a compile-time exponent.
+template <std::size_t SSize, unsigned long N>
+inline integer<SSize> pow_ui(const integer<SSize> &base, const std::integral_constant<unsigned long, N> &exp)
 {
     integer<SSize> retval;
     pow_ui(retval, base, exp);
@@ -6745,6 +8710,132 @@ pow(const T &base, const U &exp)
 namespace detail
 {
 
+// Approximate conversion of a limb to double.
+// NOTE: this goes through conversions of signed integrals, because the conversion
+// of unsigned integrals to floating point is slow on some architectures.
+inline double limb_to_double_approx(::mp_limb_t l)
+{
+    return static_cast<double>(static_cast<std::int_least64_t>(l >> 1)) * 2.
+           + static_cast<double>(static_cast<int>(l & 1u));
+}
+
+// Square root with remainder of the limb n. The root is returned,
+// the remainder is written into r.
+inline ::mp_limb_t limb_sqrtrem(::mp_limb_t n, ::mp_limb_t *r)
+{
+    // The largest possible root.
+    constexpr auto max_root = static_cast<::mp_limb_t>(GMP_NUMB_MAX >> (GMP_NUMB_BITS / 2));
+    // NOTE: the floating-point estimate is off by at most 1,
+    // but it might exceed the largest possible root.
+    auto s = c_min(static_cast<::mp_limb_t>(std::sqrt(limb_to_double_approx(n))), max_root);
+    while (s * s > n) {
+        --s;
+    }
+    while (s != max_root && (s + 1u) * (s + 1u) <= n) {
+        ++s;
+    }
+    *r = n - s * s;
+    return s;
+}
+
+#if defined(MPPP_HAVE_DLIMB_T)
+
+// Square root with remainder of the 2-limb value (hi, lo), with nonzero hi.
+// The root is returned, the remainder is written into (r1, r0).
+inline ::mp_limb_t dlimb_sqrtrem(::mp_limb_t hi, ::mp_limb_t lo, ::mp_limb_t *r1, ::mp_limb_t *r0)
+{
+    assert(hi != 0u);
+
+    const auto n = (static_cast<dlimb_t>(hi) << GMP_NUMB_BITS) + lo;
+
+    // Floating-point estimate of the root, with about 50 correct bits.
+    constexpr auto two_pow_numb = static_cast<double>(::mp_limb_t(1) << (GMP_NUMB_BITS - 1)) * 2.;
+    const auto fs = std::sqrt(limb_to_double_approx(hi) * two_pow_numb + limb_to_double_approx(lo));
+    auto s = fs >= two_pow_numb ? GMP_NUMB_MAX : static_cast<::mp_limb_t>(fs);
+
+    // One Newton step, s += (n - s**2) / (2 * s), computed in floating point
+    // from the exact residual. The result is off by at most a few units.
+    // NOTE: convert the residual to double via its limbs, as the
+    // conversion of a dlimb_t to double is usually slow.
+    auto dlimb_to_double = [two_pow_numb](dlimb_t x) {
+        return limb_to_double_approx(static_cast<::mp_limb_t>(x >> GMP_NUMB_BITS)) * two_pow_numb
+               + limb_to_double_approx(static_cast<::mp_limb_t>(x));
+    };
+    auto s2 = static_cast<dlimb_t>(s) * s;
+    if (s2 <= n) {
+        const auto inc = static_cast<::mp_limb_t>(dlimb_to_double(n - s2) / (2. * fs));
+        s = inc > GMP_NUMB_MAX - s ? GMP_NUMB_MAX : s + inc;
+    } else {
+        const auto dec = static_cast<::mp_limb_t>(dlimb_to_double(s2 - n) / (2. * fs)) + 1u;
+        s -= c_min(dec, s);
+    }
+
+    // Final correction, via the residual r = n - s**2.
+    // NOTE: (s + 1)**2 <= n if and only if r > 2 * s.
+    s2 = static_cast<dlimb_t>(s) * s;
+    while (s2 > n) {
+        --s;
+        s2 = static_cast<dlimb_t>(s) * s;
+    }
+    auto r = n - s2;
+    while (r > 2u * static_cast<dlimb_t>(s)) {
+        r -= 2u * static_cast<dlimb_t>(s) + 1u;
+        ++s;
+    }
+
+    *r1 = static_cast<::mp_limb_t>(r >> GMP_NUMB_BITS);
+    *r0 = static_cast<::mp_limb_t>(r);
+    return s;
+}
+
+#endif
+
+// Static sqrt with remainder for nonzero values of size 1 and,
+// if a double-limb type is available, 2. The root is written into
+// rops, the remainder into rems (if not null). Returns false if n is
+// too large for the optimised implementation.
+// NOTE: the limbs of ns are read before anything is written, hence
+// ns can overlap with rops or rems.
+template <std::size_t SSize>
+inline bool static_sqrtrem_small(static_int<SSize> &rops, static_int<SSize> *rems, const static_int<SSize> &ns,
+                                 std::size_t size)
+{
+    assert(size > 0u);
+
+    if (GMP_NAIL_BITS || size > 2u) {
+        return false;
+    }
+
+    // NOLINTNEXTLINE(cppcoreguidelines-init-variables)
+    ::mp_limb_t root, r1 = 0, r0;
+    if (size == 1u) {
+        root = limb_sqrtrem(ns.m_limbs[0], &r0);
+    } else {
+#if defined(MPPP_HAVE_DLIMB_T)
+        root = dlimb_sqrtrem(ns.m_limbs[1], ns.m_limbs[0], &r1, &r0);
+#else
+        return false;
+#endif
+    }
+
+    // NOTE: the root of a nonzero value is nonzero.
+    assert(root != 0u);
+    rops._mp_size = 1;
+    rops.m_limbs[0] = root;
+    rops.zero_upper_limbs(1);
+    if (rems != nullptr) {
+        // NOTE: if r1 is nonzero, we are in the size 2 case.
+        rems->_mp_size = r1 != 0u ? 2 : static_cast<mpz_size_t>(r0 != 0u);
+        rems->m_limbs[0] = r0;
+        if (r1 != 0u) {
+            rems->m_limbs[1] = r1;
+        }
+        rems->zero_upper_limbs(static_cast<std::size_t>(rems->_mp_size));
+    }
+
+    return true;
+}
+
 // Implementation of sqrt.
 template <std::size_t SSize>
 inline void sqrt_impl(integer<SSize> &rop, const integer<SSize> &n)
@@ -6765,6 +8856,11 @@ inline void sqrt_impl(integer<SSize> &rop, const integer<SSize> &n)
         // the computation of new_size below more efficient.
         const auto size = static_cast<make_unsigned_t<mpz_size_t>>(ns._mp_size);
         if (mppp_likely(size)) {
+            // Try first the optimised implementation for small values.
+            if (static_sqrtrem_small(rs, static_cast<static_int<SSize> *>(nullptr), ns,
+                                     static_cast<std::size_t>(size))) {
+                return;
+            }
             // In case of overlap we need to go through a tmp variable.
             // NOLINTNEXTLINE(cppcoreguidelines-pro-type-member-init, hicpp-member-init)
             std::array<::mp_limb_t, SSize> tmp;
@@ -6825,6 +8921,10 @@ inline void static_sqrtrem(static_int<SSize> &rops, static_int<SSize> &rems, con
     // the computation of rop_size below more efficient.
     const auto size = static_cast<make_unsigned_t<mpz_size_t>>(ns._mp_size);
     if (mppp_likely(size)) {
+        // Try first the optimised implementation for small values.
+        if (static_sqrtrem_small(rops, &rems, ns, static_cast<std::size_t>(size))) {
+            return;
+        }
         // NOTE: rop and n must be separate. rem and n can coincide. See:
         // https://gmplib.org/manual/Low_002dlevel-Functions.html
         // In case of overlap of rop and n, we need to go through a tmp variable.
@@ -6890,6 +8990,201 @@ inline void sqrtrem(integer<SSize> &rop, integer<SSize> &rem, const integer<SSiz
     }
 }
 
+namespace detail
+{
+
+// Quadratic residue filter for perfect squares: r64 and r45045 are the
+// residues of a value n modulo 64 and 45045 = 63 * 65 * 11. Returns false
+// if n is certainly not a square.
+// NOTE: the masks encode the quadratic residues modulo 64, 63, 65 and 11.
+// About 99.4% of non-squares are rejected.
+inline bool sqr_residue_filter(unsigned r64, unsigned r45045)
+{
+    constexpr std::uint_least64_t mask64 = 0x202021202030213ull, mask63 = 0x402483012450293ull,
+                                  mask65 = 0x218a019866014613ull, mask11 = 0x23bull;
+
+    if (!((mask64 >> r64) & 1u)) {
+        return false;
+    }
+    if (!((mask63 >> (r45045 % 63u)) & 1u)) {
+        return false;
+    }
+    // NOTE: 64 is a quadratic residue modulo 65.
+    const auto r65 = r45045 % 65u;
+    if (r65 != 64u && !((mask65 >> r65) & 1u)) {
+        return false;
+    }
+    return ((mask11 >> (r45045 % 11u)) & 1u) != 0u;
+}
+
+// Perfect square detection for a limb.
+inline bool limb_perfect_square_p(::mp_limb_t n)
+{
+    if (!sqr_residue_filter(static_cast<unsigned>(n & 63u), static_cast<unsigned>(n % 45045u))) {
+        return false;
+    }
+    // NOLINTNEXTLINE(cppcoreguidelines-init-variables)
+    ::mp_limb_t r;
+    limb_sqrtrem(n, &r);
+    return r == 0u;
+}
+
+#if defined(MPPP_HAVE_DLIMB_T)
+
+// Perfect square detection for the 2-limb value (hi, lo), with nonzero hi.
+inline bool dlimb_perfect_square_p(::mp_limb_t hi, ::mp_limb_t lo)
+{
+    // NOTE: n mod 45045 is computed as (hi mod 45045) * (2**GMP_NUMB_BITS mod 45045) + lo mod 45045,
+    // which is much cheaper than a double-limb modulo operation.
+    constexpr auto b45045 = static_cast<std::uint_least64_t>((GMP_NUMB_MAX % 45045u + 1u) % 45045u);
+    const auto r45045 = static_cast<unsigned>(
+        (static_cast<std::uint_least64_t>(hi % 45045u) * b45045 + static_cast<std::uint_least64_t>(lo % 45045u))
+        % 45045u);
+    if (!sqr_residue_filter(static_cast<unsigned>(lo & 63u), r45045)) {
+        return false;
+    }
+    // NOLINTNEXTLINE(cppcoreguidelines-init-variables)
+    ::mp_limb_t r1, r0;
+    dlimb_sqrtrem(hi, lo, &r1, &r0);
+    return r1 == 0u && r0 == 0u;
+}
+
+#endif
+
+// Check if s**m <= n, for s >= 1 and m >= 1. The value of
+// s**m is written into p if the check is successful.
+inline bool limb_pow_le(::mp_limb_t s, unsigned long m, ::mp_limb_t n, ::mp_limb_t *p)
+{
+    assert(s >= 1u && m >= 1u);
+
+    ::mp_limb_t acc = s;
+    for (unsigned long i = 1; i < m; ++i) {
+        // NOTE: the product cannot overflow if the sum of the bit
+        // widths of the operands does not exceed the limb width.
+        if (limb_size_nbits(acc) + limb_size_nbits(s) > GMP_NUMB_BITS && acc > n / s) {
+            return false;
+        }
+        acc *= s;
+        if (acc > n) {
+            return false;
+        }
+    }
+    if (acc > n) {
+        return false;
+    }
+    *p = acc;
+    return true;
+}
+
+// m-th root with remainder of the limb n, rounded down, for m >= 1.
+// The root is returned, the remainder is written into r.
+inline ::mp_limb_t limb_rootrem(::mp_limb_t n, unsigned long m, ::mp_limb_t *r)
+{
+    assert(m >= 1u);
+
+    if (m == 1u) {
+        *r = 0;
+        return n;
+    }
+    if (m == 2u) {
+        return limb_sqrtrem(n, r);
+    }
+    if (n < 2u || m >= limb_size_nbits(n)) {
+        // NOTE: if m >= nbits(n), then 2**m > n and the root is at most 1.
+        const auto root = static_cast<::mp_limb_t>(n != 0u);
+        *r = n - root;
+        return root;
+    }
+
+    // NOTE: here m < GMP_NUMB_BITS, so the root is small
+    // enough that the floating-point estimate is off at most by a few units.
+    auto s = c_max(static_cast<::mp_limb_t>(std::pow(limb_to_double_approx(n), 1. / static_cast<double>(m))),
+                   ::mp_limb_t(1));
+    ::mp_limb_t p = 1;
+    while (!limb_pow_le(s, m, n, &p)) {
+        --s;
+    }
+    // NOLINTNEXTLINE(cppcoreguidelines-init-variables)
+    ::mp_limb_t p1;
+    while (limb_pow_le(s + 1u, m, n, &p1)) {
+        ++s;
+        p = p1;
+    }
+    *r = n - p;
+    return s;
+}
+
+// Perfect power detection for the limb n, with sign given by neg.
+inline bool limb_perfect_power_p(::mp_limb_t n, bool neg)
+{
+    // NOTE: 0, 1 and -1 are perfect powers.
+    if (n < 2u) {
+        return true;
+    }
+
+    // Remove the small prime factors from n, computing the gcd g of their
+    // multiplicities. If n is a perfect p-th power, then p must divide g.
+    // NOTE: this rejects quickly most of the values which are not perfect powers.
+    static constexpr unsigned char small_primes[] = {2, 3, 5, 7, 11, 13};
+    ::mp_limb_t g = 0;
+    for (auto q : small_primes) {
+        if (n % q == 0u) {
+            ::mp_limb_t e = 0;
+            do {
+                n /= q;
+                ++e;
+            } while (n % q == 0u);
+            g = g == 0u ? e : limb_gcd(g, e);
+            if (g == 1u) {
+                return false;
+            }
+        }
+    }
+
+    if (n == 1u) {
+        // n was a product of small primes, thus it is a g-th power, and a p-th power
+        // for every prime p dividing g. Negative numbers can be only odd powers,
+        // thus g must not be a power of 2.
+        return !neg || (g & (g - 1u)) != 0u;
+    }
+
+    // The prime exponents which need to be checked.
+    // NOTE: the factors of the root of the cofactor are greater than 13,
+    // hence if the cofactor is a p-th power then 16**p is less than the cofactor.
+    static constexpr unsigned char primes[] = {2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37, 41, 43, 47, 53, 59, 61};
+    const auto nbits = limb_size_nbits(n);
+    for (auto p : primes) {
+        if (4u * p >= nbits) {
+            break;
+        }
+        // NOTE: negative numbers can be only odd powers.
+        if ((p == 2u && neg) || (g != 0u && g % p != 0u)) {
+            continue;
+        }
+        // NOLINTNEXTLINE(cppcoreguidelines-init-variables)
+        ::mp_limb_t r;
+        if (p == 2u) {
+            if (limb_perfect_square_p(n)) {
+                return true;
+            }
+        } else if (limb_rootrem(n, p, &r), r == 0u) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Fetch the absolute value of an integer with at most one limb.
+template <std::size_t SSize>
+inline ::mp_limb_t integer_abs_limb(const integer<SSize> &n)
+{
+    assert(n.size() <= 1u);
+    const auto &u = n._get_union();
+    return n.is_zero() ? 0u : (u.is_static() ? u.g_st().m_limbs[0] : u.g_dy()._mp_d[0]);
+}
+
+} // namespace detail
+
 // Detect perfect square.
 template <std::size_t SSize>
 inline bool perfect_square_p(const integer<SSize> &n)
@@ -6907,6 +9202,15 @@ inline bool perfect_square_p(const integer<SSize> &n)
         } else {
             ptr = u.g_dy()._mp_d;
         }
+        // Fast paths for small values.
+        if (!GMP_NAIL_BITS && size == 1) {
+            return detail::limb_perfect_square_p(ptr[0]);
+        }
+#if defined(MPPP_HAVE_DLIMB_T)
+        if (size == 2) {
+            return detail::dlimb_perfect_square_p(ptr[1], ptr[0]);
+        }
+#endif
         // NOTE: as usual, we assume that we can freely cast any valid mpz_size_t to
         // mp_size_t when calling mpn functions.
         return mpn_perfect_square_p(ptr, static_cast<::mp_size_t>(size)) != 0;
@@ -6928,6 +9232,17 @@ inline bool root(integer<SSize> &rop, const integer<SSize> &n, unsigned long m)
         throw std::domain_error("Cannot compute the integer root of degree " + std::to_string(m)
                                 + " of the negative number " + n.to_string());
     }
+    // Fast path for values with at most one limb.
+    if (!GMP_NAIL_BITS && n.size() <= 1u) {
+        const auto neg = n.sgn() == -1;
+        // NOLINTNEXTLINE(cppcoreguidelines-init-variables)
+        ::mp_limb_t r;
+        rop = detail::limb_rootrem(detail::integer_abs_limb(n), m, &r);
+        if (neg) {
+            rop.neg();
+        }
+        return r == 0u;
+    }
     MPPP_MAYBE_TLS detail::mpz_raii tmp;
     const auto ret = mpz_root(&tmp.m_mpz, n.get_mpz_view(), m);
     rop = &tmp.m_mpz;
@@ -6954,6 +9269,25 @@ inline void rootrem(integer<SSize> &rop, integer<SSize> &rem, const integer<SSiz
         throw std::domain_error("Cannot compute the integer root with remainder of degree " + std::to_string(m)
                                 + " of the negative number " + n.to_string());
     }
+    // Fast path for values with at most one limb.
+    // NOTE: rop and rem might coincide with n.
+    if (!GMP_NAIL_BITS && n.size() <= 1u) {
+        const auto neg = n.sgn() == -1;
+        // NOLINTNEXTLINE(cppcoreguidelines-init-variables)
+        ::mp_limb_t r;
+        const auto root = detail::limb_rootrem(detail::integer_abs_limb(n), m, &r);
+        // NOTE: for negative n, the root is truncated towards zero
+        // and the remainder has the sign of n.
+        rop = root;
+        if (neg) {
+            rop.neg();
+        }
+        rem = r;
+        if (neg) {
+            rem.neg();
+        }
+        return;
+    }
     MPPP_MAYBE_TLS detail::mpz_raii tmp_rop;
     MPPP_MAYBE_TLS detail::mpz_raii tmp_rem;
     mpz_rootrem(&tmp_rop.m_mpz, &tmp_rem.m_mpz, n.get_mpz_view(), m);
@@ -6965,6 +9299,10 @@ inline void rootrem(integer<SSize> &rop, integer<SSize> &rem, const integer<SSiz
 template <std::size_t SSize>
 inline bool perfect_power_p(const integer<SSize> &n)
 {
+    // Fast path for values with at most one limb.
+    if (!GMP_NAIL_BITS && n.size() <= 1u) {
+        return detail::limb_perfect_power_p(detail::integer_abs_limb(n), n.sgn() == -1);
+    }
     return mpz_perfect_power_p(n.get_mpz_view()) != 0;
 }
 
@@ -7014,6 +9352,21 @@ MPPP_DLL_PUBLIC std::ostream &integer_stream_operator_impl(std::ostream &, const
 template <std::size_t SSize>
 inline std::ostream &operator<<(std::ostream &os, const integer<SSize> &n)
 {
+    // NOTE: fast path for static values printed in base 10 without
+    // a leading '+' and without filling.
+    const auto flags = os.flags();
+    if (n.is_static() && detail::stream_flags_to_base(flags) == 10 && (flags & std::ios_base::showpos) == 0) {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-member-init, hicpp-member-init)
+        std::array<char, detail::static_int_dec_max_size<SSize>()> buffer;
+        const auto size = static_cast<std::streamsize>(
+            detail::static_int_to_dec(buffer.data(), n._get_union().g_st()) - buffer.data());
+        if (os.width() <= size) {
+            os.write(buffer.data(), size);
+            os.width(0);
+            return os;
+        }
+    }
+
     return detail::integer_stream_operator_impl(os, n.get_mpz_view(), n.sgn());
 }
 
@@ -7060,6 +9413,30 @@ inline std::size_t hash(const integer<SSize> &n)
 // Free the caches.
 MPPP_DLL_PUBLIC void free_integer_caches();
 
+// Statistics of the integer caches.
+struct integer_cache_stats {
+    // Number of allocations served by the caches.
+    std::uint64_t hits = 0;
+    // Number of allocations not served by the caches.
+    std::uint64_t misses = 0;
+    // Number of arrays which could not be cached because
+    // the cache was full.
+    std::uint64_t evictions = 0;
+    // Number of bytes held in the caches, for each size class.
+    std::array<std::size_t, detail::mpz_alloc_cache::max_size> bytes{};
+};
+
+// Statistics of the cache of the calling thread.
+MPPP_DLL_PUBLIC integer_cache_stats get_thread_integer_cache_stats();
+// Statistics of the caches of all threads.
+MPPP_DLL_PUBLIC integer_cache_stats get_integer_cache_stats();
+
+// Runtime limits for the caches.
+MPPP_DLL_PUBLIC void set_integer_cache_max_size(std::size_t);
+MPPP_DLL_PUBLIC std::size_t get_integer_cache_max_size();
+MPPP_DLL_PUBLIC void set_integer_cache_max_entries(std::size_t);
+MPPP_DLL_PUBLIC std::size_t get_integer_cache_max_entries();
+
 namespace detail
 {
 
@@ -7148,13 +9525,16 @@ inline void dispatch_in_place_add(T &rop, const integer<SSize> &op)
 template <std::size_t SSize>
 inline integer<SSize> operator+(const integer<SSize> &n)
 {
-    // NOTE: here potentially we could avoid a copy via either
-    // a universal reference or maybe passing by copy n and then
-    // moving in. Not sure how critical this is. Same in the negated
-    // copy operator.
     return n;
 }
 
+// Identity operator for rvalues.
+template <std::size_t SSize>
+inline integer<SSize> operator+(integer<SSize> &&n)
+{
+    return std::move(n);
+}
+
 // Binary addition.
 template <typename T, typename U>
 #if defined(MPPP_HAVE_CONCEPTS)
@@ -7181,6 +9561,32 @@ inline T &operator+=(T &rop, const U &op)
     return rop;
 }
 
+// Binary addition with rvalue operands.
+// NOTE: the result is computed directly into the storage of the expiring
+// operand, so that chained expressions involving dynamic integers do not
+// allocate a new limb array at every step.
+template <std::size_t SSize, typename T,
+          detail::enable_if_t<detail::is_integer_rvalue_op_type<T, SSize>::value, int> = 0>
+inline integer<SSize> operator+(integer<SSize> &&op1, const T &op2)
+{
+    detail::dispatch_in_place_add(op1, op2);
+    return std::move(op1);
+}
+
+template <std::size_t SSize, typename T,
+          detail::enable_if_t<detail::is_integer_rvalue_op_type<T, SSize>::value, int> = 0>
+inline integer<SSize> operator+(const T &op1, integer<SSize> &&op2)
+{
+    detail::dispatch_in_place_add(op2, op1);
+    return std::move(op2);
+}
+
+template <std::size_t SSize>
+inline integer<SSize> operator+(integer<SSize> &&op1, integer<SSize> &&op2)
+{
+    return std::move(op1) + op2;
+}
+
 // Prefix increment.
 template <std::size_t SSize>
 inline integer<SSize> &operator++(integer<SSize> &n)
@@ -7292,6 +9698,14 @@ integer<SSize> operator-(const integer<SSize> &n)
     return retval;
 }
 
+// Negation of an rvalue.
+template <std::size_t SSize>
+inline integer<SSize> operator-(integer<SSize> &&n)
+{
+    n.neg();
+    return std::move(n);
+}
+
 // Binary subtraction.
 template <typename T, typename U>
 #if defined(MPPP_HAVE_CONCEPTS)
@@ -7318,25 +9732,193 @@ inline T &operator-=(T &rop, const U &op)
     return rop;
 }
 
-// Prefix decrement.
-template <std::size_t SSize>
-inline integer<SSize> &operator--(integer<SSize> &n)
+// Binary subtraction with rvalue operands.
+template <std::size_t SSize, typename T,
+          detail::enable_if_t<detail::is_integer_rvalue_op_type<T, SSize>::value, int> = 0>
+inline integer<SSize> operator-(integer<SSize> &&op1, const T &op2)
+{
+    detail::dispatch_in_place_sub(op1, op2);
+    return std::move(op1);
+}
+
+template <std::size_t SSize, typename T,
+          detail::enable_if_t<detail::is_integer_rvalue_op_type<T, SSize>::value, int> = 0>
+inline integer<SSize> operator-(const T &op1, integer<SSize> &&op2)
+{
+    // NOTE: op1 - op2 == -(op2 - op1).
+    detail::dispatch_in_place_sub(op2, op1);
+    op2.neg();
+    return std::move(op2);
+}
+
+template <std::size_t SSize>
+inline integer<SSize> operator-(integer<SSize> &&op1, integer<SSize> &&op2)
+{
+    return std::move(op1) - op2;
+}
+
+// Prefix decrement.
+template <std::size_t SSize>
+inline integer<SSize> &operator--(integer<SSize> &n)
+{
+    sub_ui(n, n, 1u);
+    return n;
+}
+
+// Suffix decrement.
+template <std::size_t SSize>
+inline integer<SSize> operator--(integer<SSize> &n, int)
+{
+    auto retval(n);
+    --n;
+    return retval;
+}
+
+namespace detail
+{
+
+// Multiplication between an integer and a C++ integral, without constructing
+// a temporary integer.
+template <std::size_t SSize, typename T>
+inline void mul_integral(integer<SSize> &rop, const integer<SSize> &op1, const T &n)
+{
+    const integral_limbs<T> nl(n);
+    const bool s1 = op1.is_static();
+    bool sr = rop.is_static();
+    std::size_t size_hint = 0u;
+    if (mppp_likely(s1 && nl.abs_size() <= SSize)) {
+        if (!sr) {
+            rop.set_zero();
+            sr = true;
+        }
+        size_hint = static_mul(rop._get_union().g_st(), op1._get_union().g_st(), nl.template to_static<SSize>());
+        if (mppp_likely(size_hint == 0u)) {
+            return;
+        }
+    }
+    if (sr) {
+        rop._get_union().promote(size_hint);
+    }
+    const auto nl_view = nl.get_mpz_view();
+    mpz_mul(&rop._get_union().g_dy(), op1.get_mpz_view(), &nl_view);
+}
+
+// Truncated division between an integer and a C++ integral (or vice-versa),
+// without constructing a temporary integer.
+template <std::size_t SSize, typename T>
+inline void tdiv_q_integral(integer<SSize> &q, const integer<SSize> &n, const T &d)
+{
+    const integral_limbs<T> dl(d);
+    if (mppp_unlikely(dl.m_size == 0)) {
+        throw zero_division_error("Integer division by zero");
+    }
+    const bool sq = q.is_static(), s1 = n.is_static();
+    if (mppp_likely(s1 && dl.abs_size() <= SSize)) {
+        if (!sq) {
+            q.set_zero();
+        }
+        static_tdiv_q(q._get_union().g_st(), n._get_union().g_st(), dl.template to_static<SSize>());
+        return;
+    }
+    if (sq) {
+        q._get_union().promote();
+    }
+    const auto dl_view = dl.get_mpz_view();
+    mpz_tdiv_q(&q._get_union().g_dy(), n.get_mpz_view(), &dl_view);
+}
+
+template <std::size_t SSize, typename T>
+inline void tdiv_q_integral(integer<SSize> &q, const T &n, const integer<SSize> &d)
+{
+    if (mppp_unlikely(d.sgn() == 0)) {
+        throw zero_division_error("Integer division by zero");
+    }
+    const integral_limbs<T> nl(n);
+    const bool sq = q.is_static(), s2 = d.is_static();
+    if (mppp_likely(s2 && nl.abs_size() <= SSize)) {
+        if (!sq) {
+            q.set_zero();
+        }
+        static_tdiv_q(q._get_union().g_st(), nl.template to_static<SSize>(), d._get_union().g_st());
+        return;
+    }
+    if (sq) {
+        q._get_union().promote();
+    }
+    const auto nl_view = nl.get_mpz_view();
+    mpz_tdiv_q(&q._get_union().g_dy(), &nl_view, d.get_mpz_view());
+}
+
+// Remainder of the truncated division between an integer and a C++ integral
+// (or vice-versa), without constructing a temporary integer.
+template <std::size_t SSize, typename T>
+inline void tdiv_r_integral(integer<SSize> &r, const integer<SSize> &n, const T &d)
 {
-    sub_ui(n, n, 1u);
-    return n;
+    const integral_limbs<T> dl(d);
+    if (mppp_unlikely(dl.m_size == 0)) {
+        throw zero_division_error("Integer division by zero");
+    }
+    const bool sr = r.is_static(), s1 = n.is_static();
+    if (mppp_likely(s1 && dl.abs_size() <= SSize)) {
+        if (!sr) {
+            r.set_zero();
+        }
+        static_int<SSize> q;
+        static_tdiv_qr(q, r._get_union().g_st(), n._get_union().g_st(), dl.template to_static<SSize>());
+        return;
+    }
+    if (sr) {
+        r._get_union().promote();
+    }
+    const auto dl_view = dl.get_mpz_view();
+    mpz_tdiv_r(&r._get_union().g_dy(), n.get_mpz_view(), &dl_view);
 }
 
-// Suffix decrement.
-template <std::size_t SSize>
-inline integer<SSize> operator--(integer<SSize> &n, int)
+template <std::size_t SSize, typename T>
+inline void tdiv_r_integral(integer<SSize> &r, const T &n, const integer<SSize> &d)
 {
-    auto retval(n);
-    --n;
-    return retval;
+    if (mppp_unlikely(d.sgn() == 0)) {
+        throw zero_division_error("Integer division by zero");
+    }
+    const integral_limbs<T> nl(n);
+    const bool sr = r.is_static(), s2 = d.is_static();
+    if (mppp_likely(s2 && nl.abs_size() <= SSize)) {
+        if (!sr) {
+            r.set_zero();
+        }
+        static_int<SSize> q;
+        static_tdiv_qr(q, r._get_union().g_st(), nl.template to_static<SSize>(), d._get_union().g_st());
+        return;
+    }
+    if (sr) {
+        r._get_union().promote();
+    }
+    const auto nl_view = nl.get_mpz_view();
+    mpz_tdiv_r(&r._get_union().g_dy(), &nl_view, d.get_mpz_view());
 }
 
-namespace detail
+// Remainder of the truncated division between two integers, without
+// constructing a quotient integer.
+template <std::size_t SSize>
+inline void tdiv_r_impl(integer<SSize> &r, const integer<SSize> &n, const integer<SSize> &d)
 {
+    if (mppp_unlikely(d.sgn() == 0)) {
+        throw zero_division_error("Integer division by zero");
+    }
+    const bool sr = r.is_static(), s1 = n.is_static(), s2 = d.is_static();
+    if (mppp_likely(s1 && s2)) {
+        if (!sr) {
+            r.set_zero();
+        }
+        static_int<SSize> q;
+        static_tdiv_qr(q, r._get_union().g_st(), n._get_union().g_st(), d._get_union().g_st());
+        return;
+    }
+    if (sr) {
+        r._get_union().promote();
+    }
+    mpz_tdiv_r(&r._get_union().g_dy(), n.get_mpz_view(), d.get_mpz_view());
+}
 
 // Dispatching for the binary multiplication operator.
 template <std::size_t SSize>
@@ -7354,7 +9936,7 @@ inline integer<SSize> dispatch_binary_mul(const integer<SSize> &op1, T n)
     // from the operands. Having a separate destination is generally better
     // for multiplication.
     integer<SSize> retval;
-    mul(retval, op1, integer<SSize>{n});
+    mul_integral(retval, op1, n);
     return retval;
 }
 
@@ -7388,7 +9970,7 @@ inline void dispatch_in_place_mul(integer<SSize> &retval, const integer<SSize> &
 template <typename T, std::size_t SSize, enable_if_t<is_cpp_integral<T>::value, int> = 0>
 inline void dispatch_in_place_mul(integer<SSize> &retval, const T &n)
 {
-    mul(retval, retval, integer<SSize>{n});
+    mul_integral(retval, retval, n);
 }
 
 template <typename T, std::size_t SSize,
@@ -7433,6 +10015,29 @@ inline T &operator*=(T &rop, const U &op)
     return rop;
 }
 
+// Binary multiplication with rvalue operands.
+template <std::size_t SSize, typename T,
+          detail::enable_if_t<detail::is_integer_rvalue_op_type<T, SSize>::value, int> = 0>
+inline integer<SSize> operator*(integer<SSize> &&op1, const T &op2)
+{
+    detail::dispatch_in_place_mul(op1, op2);
+    return std::move(op1);
+}
+
+template <std::size_t SSize, typename T,
+          detail::enable_if_t<detail::is_integer_rvalue_op_type<T, SSize>::value, int> = 0>
+inline integer<SSize> operator*(const T &op1, integer<SSize> &&op2)
+{
+    detail::dispatch_in_place_mul(op2, op1);
+    return std::move(op2);
+}
+
+template <std::size_t SSize>
+inline integer<SSize> operator*(integer<SSize> &&op1, integer<SSize> &&op2)
+{
+    return std::move(op1) * op2;
+}
+
 namespace detail
 {
 
@@ -7449,7 +10054,7 @@ template <typename T, std::size_t SSize, enable_if_t<is_cpp_integral<T>::value,
 inline integer<SSize> dispatch_binary_div(const integer<SSize> &op1, T n)
 {
     integer<SSize> retval;
-    tdiv_q(retval, op1, integer<SSize>{n});
+    tdiv_q_integral(retval, op1, n);
     return retval;
 }
 
@@ -7457,7 +10062,7 @@ template <typename T, std::size_t SSize, enable_if_t<is_cpp_integral<T>::value,
 inline integer<SSize> dispatch_binary_div(T n, const integer<SSize> &op2)
 {
     integer<SSize> retval;
-    tdiv_q(retval, integer<SSize>{n}, op2);
+    tdiv_q_integral(retval, n, op2);
     return retval;
 }
 
@@ -7485,7 +10090,7 @@ inline void dispatch_in_place_div(integer<SSize> &retval, const integer<SSize> &
 template <typename T, std::size_t SSize, enable_if_t<is_cpp_integral<T>::value, int> = 0>
 inline void dispatch_in_place_div(integer<SSize> &retval, const T &n)
 {
-    tdiv_q(retval, retval, integer<SSize>{n});
+    tdiv_q_integral(retval, retval, n);
 }
 
 template <typename T, std::size_t SSize,
@@ -7506,24 +10111,24 @@ inline void dispatch_in_place_div(T &rop, const integer<SSize> &op)
 template <std::size_t SSize>
 inline integer<SSize> dispatch_binary_mod(const integer<SSize> &op1, const integer<SSize> &op2)
 {
-    integer<SSize> q, retval;
-    tdiv_qr(q, retval, op1, op2);
+    integer<SSize> retval;
+    tdiv_r_impl(retval, op1, op2);
     return retval;
 }
 
 template <typename T, std::size_t SSize, enable_if_t<is_cpp_integral<T>::value, int> = 0>
 inline integer<SSize> dispatch_binary_mod(const integer<SSize> &op1, T n)
 {
-    integer<SSize> q, retval;
-    tdiv_qr(q, retval, op1, integer<SSize>{n});
+    integer<SSize> retval;
+    tdiv_r_integral(retval, op1, n);
     return retval;
 }
 
 template <typename T, std::size_t SSize, enable_if_t<is_cpp_integral<T>::value, int> = 0>
 inline integer<SSize> dispatch_binary_mod(T n, const integer<SSize> &op2)
 {
-    integer<SSize> q, retval;
-    tdiv_qr(q, retval, integer<SSize>{n}, op2);
+    integer<SSize> retval;
+    tdiv_r_integral(retval, n, op2);
     return retval;
 }
 
@@ -7531,15 +10136,13 @@ inline integer<SSize> dispatch_binary_mod(T n, const integer<SSize> &op2)
 template <std::size_t SSize>
 inline void dispatch_in_place_mod(integer<SSize> &retval, const integer<SSize> &n)
 {
-    integer<SSize> q;
-    tdiv_qr(q, retval, retval, n);
+    tdiv_r_impl(retval, retval, n);
 }
 
 template <typename T, std::size_t SSize, enable_if_t<is_cpp_integral<T>::value, int> = 0>
 inline void dispatch_in_place_mod(integer<SSize> &retval, const T &n)
 {
-    integer<SSize> q;
-    tdiv_qr(q, retval, retval, integer<SSize>{n});
+    tdiv_r_integral(retval, retval, n);
 }
 
 template <typename T, std::size_t SSize, enable_if_t<is_cpp_integral<T>::value, int> = 0>
@@ -7547,6 +10150,32 @@ inline void dispatch_in_place_mod(T &rop, const integer<SSize> &op)
 {
     rop = static_cast<T>(rop % op);
 }
+
+// Dispatching for the division and modulo operators with an rvalue
+// divisor: the result is written into the divisor.
+template <std::size_t SSize>
+inline void dispatch_in_place_rdiv(integer<SSize> &rop, const integer<SSize> &n)
+{
+    tdiv_q(rop, n, rop);
+}
+
+template <typename T, std::size_t SSize, enable_if_t<is_cpp_integral<T>::value, int> = 0>
+inline void dispatch_in_place_rdiv(integer<SSize> &rop, const T &n)
+{
+    tdiv_q_integral(rop, n, rop);
+}
+
+template <std::size_t SSize>
+inline void dispatch_in_place_rmod(integer<SSize> &rop, const integer<SSize> &n)
+{
+    tdiv_r_impl(rop, n, rop);
+}
+
+template <typename T, std::size_t SSize, enable_if_t<is_cpp_integral<T>::value, int> = 0>
+inline void dispatch_in_place_rmod(integer<SSize> &rop, const T &n)
+{
+    tdiv_r_integral(rop, n, rop);
+}
 } // namespace detail
 
 // Binary division.
@@ -7575,6 +10204,29 @@ inline T &operator/=(T &rop, const U &op)
     return rop;
 }
 
+// Binary division with rvalue operands.
+template <std::size_t SSize, typename T,
+          detail::enable_if_t<detail::is_integer_rvalue_op_type<T, SSize>::value, int> = 0>
+inline integer<SSize> operator/(integer<SSize> &&op1, const T &op2)
+{
+    detail::dispatch_in_place_div(op1, op2);
+    return std::move(op1);
+}
+
+template <std::size_t SSize, typename T,
+          detail::enable_if_t<detail::is_integer_rvalue_op_type<T, SSize>::value, int> = 0>
+inline integer<SSize> operator/(const T &op1, integer<SSize> &&op2)
+{
+    detail::dispatch_in_place_rdiv(op2, op1);
+    return std::move(op2);
+}
+
+template <std::size_t SSize>
+inline integer<SSize> operator/(integer<SSize> &&op1, integer<SSize> &&op2)
+{
+    return std::move(op1) / op2;
+}
+
 // Binary modulo operator.
 #if defined(MPPP_HAVE_CONCEPTS)
 template <typename T, typename U>
@@ -7602,6 +10254,29 @@ inline T &operator%=(T &rop, const U &op)
     return rop;
 }
 
+// Binary modulo operator with rvalue operands.
+template <std::size_t SSize, typename T,
+          detail::enable_if_t<detail::is_integer_rvalue_op_type<T, SSize>::value, int> = 0>
+inline integer<SSize> operator%(integer<SSize> &&op1, const T &op2)
+{
+    detail::dispatch_in_place_mod(op1, op2);
+    return std::move(op1);
+}
+
+template <std::size_t SSize, typename T,
+          detail::enable_if_t<detail::is_integer_rvalue_op_type<T, SSize>::value, int> = 0>
+inline integer<SSize> operator%(const T &op1, integer<SSize> &&op2)
+{
+    detail::dispatch_in_place_rmod(op2, op1);
+    return std::move(op2);
+}
+
+template <std::size_t SSize>
+inline integer<SSize> operator%(integer<SSize> &&op1, integer<SSize> &&op2)
+{
+    return std::move(op1) % op2;
+}
+
 // Binary left shift operator.
 #if defined(MPPP_HAVE_CONCEPTS)
 template <cpp_integral T, std::size_t SSize>
@@ -7627,6 +10302,18 @@ inline integer<SSize> &operator<<=(integer<SSize> &rop, T s)
     return rop;
 }
 
+// Binary left shift operator with an rvalue operand.
+#if defined(MPPP_HAVE_CONCEPTS)
+template <cpp_integral T, std::size_t SSize>
+#else
+template <typename T, std::size_t SSize, detail::enable_if_t<is_cpp_integral<T>::value, int> = 0>
+#endif
+inline integer<SSize> operator<<(integer<SSize> &&n, T s)
+{
+    mul_2exp(n, n, detail::safe_cast<::mp_bitcnt_t>(s));
+    return std::move(n);
+}
+
 // Binary right shift operator.
 #if defined(MPPP_HAVE_CONCEPTS)
 template <cpp_integral T, std::size_t SSize>
@@ -7652,9 +10339,145 @@ inline integer<SSize> &operator>>=(integer<SSize> &rop, T s)
     return rop;
 }
 
+// Binary right shift operator with an rvalue operand.
+#if defined(MPPP_HAVE_CONCEPTS)
+template <cpp_integral T, std::size_t SSize>
+#else
+template <typename T, std::size_t SSize, detail::enable_if_t<is_cpp_integral<T>::value, int> = 0>
+#endif
+inline integer<SSize> operator>>(integer<SSize> &&n, T s)
+{
+    tdiv_q_2exp(n, n, detail::safe_cast<::mp_bitcnt_t>(s));
+    return std::move(n);
+}
+
 namespace detail
 {
 
+// Comparison between an integer and a C++ integral, performed directly
+// on the limbs. Returns the sign of a - n.
+template <typename T, std::size_t SSize>
+inline int integer_cmp_integral(const integer<SSize> &a, const T &n)
+{
+    const integral_limbs<T> nl(n);
+    const mpz_size_t size_a = a._get_union().m_st._mp_size;
+    if (size_a != nl.m_size) {
+        return size_a < nl.m_size ? -1 : 1;
+    }
+    if (size_a == 0) {
+        // NOTE: as elsewhere, avoid calling mpn_cmp() on zero operands.
+        return 0;
+    }
+    const ::mp_limb_t *ptr_a = a.is_static() ? a._get_union().g_st().m_limbs.data() : a._get_union().g_dy()._mp_d;
+    const int cmp_abs = mpn_cmp(ptr_a, nl.m_limbs.data(), static_cast<::mp_size_t>(nl.abs_size()));
+    return size_a > 0 ? cmp_abs : -cmp_abs;
+}
+
+// Shift down by lo bits the nonzero normalised limb array ptr of size asize.
+// The result must fit in an unsigned long long.
+inline unsigned long long limbs_rshift_ull(const ::mp_limb_t *ptr, std::size_t asize, std::size_t lo)
+{
+    unsigned long long ret = 0;
+    auto idx = lo / unsigned(GMP_NUMB_BITS);
+    auto sh = static_cast<unsigned>(lo % unsigned(GMP_NUMB_BITS));
+    for (unsigned nbits = 0; idx < asize && nbits < unsigned(nl_digits<unsigned long long>()); ++idx, sh = 0) {
+        ret |= static_cast<unsigned long long>((ptr[idx] & GMP_NUMB_MASK) >> sh) << nbits;
+        nbits += unsigned(GMP_NUMB_BITS) - sh;
+    }
+    return ret;
+}
+
+// Check if any of the bits of the limb array ptr below the bit index n is set.
+inline bool limbs_low_bits_nonzero(const ::mp_limb_t *ptr, std::size_t n)
+{
+    const auto idx = n / unsigned(GMP_NUMB_BITS);
+    const auto sh = static_cast<unsigned>(n % unsigned(GMP_NUMB_BITS));
+    for (std::size_t i = 0; i < idx; ++i) {
+        if ((ptr[i] & GMP_NUMB_MASK) != 0u) {
+            return true;
+        }
+    }
+    return sh != 0u && (ptr[idx] & GMP_NUMB_MASK & ((::mp_limb_t(1) << sh) - 1u)) != 0u;
+}
+
+// The exact comparison between integer and a floating-point type T
+// is available if T is binary and its significand fits in an unsigned long long.
+template <typename T>
+using integer_have_exact_fp_cmp
+    = std::integral_constant<bool, std::numeric_limits<T>::radix == 2
+                                       && std::numeric_limits<T>::digits <= nl_digits<unsigned long long>()>;
+
+// Exact comparison between an integer and a finite floating-point value x,
+// for use when the conversion of a to T is equal to x. Returns the sign of a - x.
+template <typename T, std::size_t SSize>
+inline int integer_cmp_fp_tie(const integer<SSize> &a, const T &x, const std::true_type &)
+{
+    const mpz_size_t size_a = a._get_union().m_st._mp_size;
+    const auto asize = static_cast<std::size_t>(std::abs(size_a));
+    if (asize == 0u) {
+        // NOTE: x must be zero as well.
+        return 0;
+    }
+
+    // NOTE: a and x have the same sign, compare their absolute values.
+    const ::mp_limb_t *ptr_a = a.is_static() ? a._get_union().g_st().m_limbs.data() : a._get_union().g_dy()._mp_d;
+    const auto nbits_a
+        = static_cast<std::size_t>((asize - 1u) * unsigned(GMP_NUMB_BITS) + limb_size_nbits(ptr_a[asize - 1u]));
+    constexpr auto digits = static_cast<unsigned>(std::numeric_limits<T>::digits);
+    if (nbits_a <= digits) {
+        // abs(a) is exactly representable in T.
+        return 0;
+    }
+
+    // NOTE: abs(x) == m * 2**exp_x, with m in [0.5, 1).
+    int exp_x = 0;
+    const auto m = std::frexp(std::abs(x), &exp_x);
+    int cmp_abs = 0;
+    if (nbits_a != static_cast<std::size_t>(exp_x)) {
+        // NOTE: this can happen if the conversion rounded abs(a) up
+        // to the next power of two.
+        cmp_abs = nbits_a < static_cast<std::size_t>(exp_x) ? -1 : 1;
+    } else {
+        // abs(a) and abs(x) have the same bit size. Compare the top bits
+        // of abs(a) with the significand of x, written as an integer.
+        const auto sig_x = static_cast<unsigned long long>(std::ldexp(m, static_cast<int>(digits)));
+        const auto top_a = limbs_rshift_ull(ptr_a, asize, nbits_a - digits);
+        if (top_a != sig_x) {
+            cmp_abs = top_a < sig_x ? -1 : 1;
+        } else {
+            // The top bits are equal, abs(a) is greater than abs(x)
+            // if any of its remaining bits is set.
+            cmp_abs = static_cast<int>(limbs_low_bits_nonzero(ptr_a, nbits_a - digits));
+        }
+    }
+
+    return size_a > 0 ? cmp_abs : -cmp_abs;
+}
+
+template <typename T, std::size_t SSize>
+inline int integer_cmp_fp_tie(const integer<SSize> &, const T &, const std::false_type &)
+{
+    return 0;
+}
+
+// Exact comparison between an integer a and a floating-point value x,
+// for use when the conversion of a to T is equal to x (which thus cannot be NaN).
+// Returns the sign of a - x.
+// NOTE: the conversion of integer to T is monotonic, thus
+// if the converted value differs from x, the result of the comparison
+// is the same as for the original value, and this function
+// is needed only to break ties.
+template <typename T, std::size_t SSize>
+inline int integer_cmp_fp_tie(const integer<SSize> &a, const T &x)
+{
+    assert(static_cast<T>(a) == x);
+    if (mppp_unlikely(std::isinf(x))) {
+        // NOTE: the conversion of a overflowed.
+        return x > 0 ? -1 : 1;
+    }
+    return integer_cmp_fp_tie(a, x, integer_have_exact_fp_cmp<T>{});
+}
+
 // Equality operator.
 // NOTE: special implementation instead of using cmp, this should be faster.
 template <std::size_t SSize>
@@ -7678,7 +10501,7 @@ inline bool dispatch_equality(const integer<SSize> &a, const integer<SSize> &b)
 template <typename T, std::size_t SSize, enable_if_t<is_cpp_integral<T>::value, int> = 0>
 inline bool dispatch_equality(const integer<SSize> &a, T n)
 {
-    return dispatch_equality(a, integer<SSize>{n});
+    return integer_cmp_integral(a, n) == 0;
 }
 
 template <typename T, std::size_t SSize, enable_if_t<is_cpp_integral<T>::value, int> = 0>
@@ -7687,11 +10510,16 @@ inline bool dispatch_equality(T n, const integer<SSize> &a)
     return dispatch_equality(a, n);
 }
 
-template <typename T, std::size_t SSize,
-          enable_if_t<disjunction<is_cpp_floating_point<T>, is_cpp_complex<T>>::value, int> = 0>
+template <typename T, std::size_t SSize, enable_if_t<is_cpp_floating_point<T>::value, int> = 0>
+inline bool dispatch_equality(const integer<SSize> &a, const T &x)
+{
+    return static_cast<T>(a) == x && integer_cmp_fp_tie(a, x) == 0;
+}
+
+template <typename T, std::size_t SSize, enable_if_t<is_cpp_complex<T>::value, int> = 0>
 inline bool dispatch_equality(const integer<SSize> &a, const T &x)
 {
-    return static_cast<T>(a) == x;
+    return x.imag() == 0 && dispatch_equality(a, x.real());
 }
 
 template <typename T, std::size_t SSize,
@@ -7774,7 +10602,7 @@ inline bool dispatch_less_than(const integer<SSize> &op1, const integer<SSize> &
 template <typename T, std::size_t SSize, enable_if_t<is_cpp_integral<T>::value, int> = 0>
 inline bool dispatch_less_than(const integer<SSize> &a, T n)
 {
-    return dispatch_less_than(a, integer<SSize>{n});
+    return integer_cmp_integral(a, n) < 0;
 }
 
 template <typename T, std::size_t SSize, enable_if_t<is_cpp_integral<T>::value, int> = 0>
@@ -7783,7 +10611,8 @@ bool dispatch_less_than(T, const integer<SSize> &);
 template <typename T, std::size_t SSize, enable_if_t<is_cpp_floating_point<T>::value, int> = 0>
 inline bool dispatch_less_than(const integer<SSize> &a, T x)
 {
-    return static_cast<T>(a) < x;
+    const auto fa = static_cast<T>(a);
+    return fa < x || (fa == x && integer_cmp_fp_tie(a, x) < 0);
 }
 
 template <typename T, std::size_t SSize, enable_if_t<is_cpp_floating_point<T>::value, int> = 0>
@@ -7845,19 +10674,20 @@ inline bool dispatch_greater_than(const integer<SSize> &op1, const integer<SSize
 template <typename T, std::size_t SSize, enable_if_t<is_cpp_integral<T>::value, int> = 0>
 inline bool dispatch_greater_than(const integer<SSize> &a, T n)
 {
-    return dispatch_greater_than(a, integer<SSize>{n});
+    return integer_cmp_integral(a, n) > 0;
 }
 
 template <typename T, std::size_t SSize, enable_if_t<is_cpp_integral<T>::value, int> = 0>
 inline bool dispatch_greater_than(T n, const integer<SSize> &a)
 {
-    return dispatch_less_than(a, integer<SSize>{n});
+    return integer_cmp_integral(a, n) < 0;
 }
 
 template <typename T, std::size_t SSize, enable_if_t<is_cpp_floating_point<T>::value, int> = 0>
 inline bool dispatch_greater_than(const integer<SSize> &a, T x)
 {
-    return static_cast<T>(a) > x;
+    const auto fa = static_cast<T>(a);
+    return fa > x || (fa == x && integer_cmp_fp_tie(a, x) > 0);
 }
 
 template <typename T, std::size_t SSize, enable_if_t<is_cpp_floating_point<T>::value, int> = 0>
@@ -7870,7 +10700,7 @@ inline bool dispatch_greater_than(T x, const integer<SSize> &a)
 template <typename T, std::size_t SSize, enable_if_t<is_cpp_integral<T>::value, int>>
 inline bool dispatch_less_than(T n, const integer<SSize> &a)
 {
-    return dispatch_greater_than(a, integer<SSize>{n});
+    return integer_cmp_integral(a, n) > 0;
 }
 
 template <typename T, std::size_t SSize, enable_if_t<is_cpp_floating_point<T>::value, int>>
@@ -7961,9 +10791,76 @@ integer<SSize> operator~(const integer<SSize> &op)
     return retval;
 }
 
+// Unary bitwise NOT of an rvalue.
+template <std::size_t SSize>
+inline integer<SSize> operator~(integer<SSize> &&op)
+{
+    bitwise_not(op, op);
+    return std::move(op);
+}
+
 namespace detail
 {
 
+// Bitwise OR/AND/XOR between an integer and a C++ integral, without constructing
+// a temporary integer. sf is the static kernel (returning false on failure),
+// mf the corresponding mpz function.
+template <std::size_t SSize, typename T, typename SF, typename MF>
+inline void bitwise_integral(integer<SSize> &rop, const integer<SSize> &op1, const T &n, const SF &sf, const MF &mf)
+{
+    const integral_limbs<T> nl(n);
+    const bool s1 = op1.is_static();
+    bool sr = rop.is_static();
+    if (mppp_likely(s1 && nl.abs_size() <= SSize)) {
+        if (!sr) {
+            rop.set_zero();
+            sr = true;
+        }
+        if (mppp_likely(sf(rop._get_union().g_st(), op1._get_union().g_st(), nl.template to_static<SSize>()))) {
+            return;
+        }
+    }
+    if (sr) {
+        rop._get_union().promote();
+    }
+    const auto nl_view = nl.get_mpz_view();
+    mf(&rop._get_union().g_dy(), op1.get_mpz_view(), &nl_view);
+}
+
+template <std::size_t SSize, typename T>
+inline void ior_integral(integer<SSize> &rop, const integer<SSize> &op1, const T &n)
+{
+    bitwise_integral(
+        rop, op1, n,
+        [](static_int<SSize> &r, const static_int<SSize> &a, const static_int<SSize> &b) {
+            static_ior(r, a, b);
+            return true;
+        },
+        [](mpz_struct_t *r, const mpz_struct_t *a, const mpz_struct_t *b) { mpz_ior(r, a, b); });
+}
+
+template <std::size_t SSize, typename T>
+inline void and_integral(integer<SSize> &rop, const integer<SSize> &op1, const T &n)
+{
+    bitwise_integral(
+        rop, op1, n,
+        [](static_int<SSize> &r, const static_int<SSize> &a, const static_int<SSize> &b) {
+            return static_and(r, a, b);
+        },
+        [](mpz_struct_t *r, const mpz_struct_t *a, const mpz_struct_t *b) { mpz_and(r, a, b); });
+}
+
+template <std::size_t SSize, typename T>
+inline void xor_integral(integer<SSize> &rop, const integer<SSize> &op1, const T &n)
+{
+    bitwise_integral(
+        rop, op1, n,
+        [](static_int<SSize> &r, const static_int<SSize> &a, const static_int<SSize> &b) {
+            return static_xor(r, a, b);
+        },
+        [](mpz_struct_t *r, const mpz_struct_t *a, const mpz_struct_t *b) { mpz_xor(r, a, b); });
+}
+
 // Dispatch for binary OR.
 template <std::size_t SSize>
 inline integer<SSize> dispatch_operator_or(const integer<SSize> &op1, const integer<SSize> &op2)
@@ -7976,7 +10873,9 @@ inline integer<SSize> dispatch_operator_or(const integer<SSize> &op1, const inte
 template <std::size_t SSize, typename T, enable_if_t<is_cpp_integral<T>::value, int> = 0>
 inline integer<SSize> dispatch_operator_or(const integer<SSize> &op1, const T &op2)
 {
-    return dispatch_operator_or(op1, integer<SSize>{op2});
+    integer<SSize> retval;
+    ior_integral(retval, op1, op2);
+    return retval;
 }
 
 template <typename T, std::size_t SSize, enable_if_t<is_cpp_integral<T>::value, int> = 0>
@@ -7995,7 +10894,7 @@ inline void dispatch_in_place_or(integer<SSize> &rop, const integer<SSize> &op)
 template <typename T, std::size_t SSize, enable_if_t<is_cpp_integral<T>::value, int> = 0>
 inline void dispatch_in_place_or(integer<SSize> &rop, const T &op)
 {
-    dispatch_in_place_or(rop, integer<SSize>{op});
+    ior_integral(rop, rop, op);
 }
 
 template <typename T, std::size_t SSize, enable_if_t<is_cpp_integral<T>::value, int> = 0>
@@ -8032,6 +10931,29 @@ inline T &operator|=(T &rop, const U &op)
     return rop;
 }
 
+// Binary bitwise OR operator with rvalue operands.
+template <std::size_t SSize, typename T,
+          detail::enable_if_t<detail::is_integer_rvalue_op_type<T, SSize>::value, int> = 0>
+inline integer<SSize> operator|(integer<SSize> &&op1, const T &op2)
+{
+    detail::dispatch_in_place_or(op1, op2);
+    return std::move(op1);
+}
+
+template <std::size_t SSize, typename T,
+          detail::enable_if_t<detail::is_integer_rvalue_op_type<T, SSize>::value, int> = 0>
+inline integer<SSize> operator|(const T &op1, integer<SSize> &&op2)
+{
+    detail::dispatch_in_place_or(op2, op1);
+    return std::move(op2);
+}
+
+template <std::size_t SSize>
+inline integer<SSize> operator|(integer<SSize> &&op1, integer<SSize> &&op2)
+{
+    return std::move(op1) | op2;
+}
+
 namespace detail
 {
 
@@ -8047,7 +10969,9 @@ inline integer<SSize> dispatch_operator_and(const integer<SSize> &op1, const int
 template <std::size_t SSize, typename T, enable_if_t<is_cpp_integral<T>::value, int> = 0>
 inline integer<SSize> dispatch_operator_and(const integer<SSize> &op1, const T &op2)
 {
-    return dispatch_operator_and(op1, integer<SSize>{op2});
+    integer<SSize> retval;
+    and_integral(retval, op1, op2);
+    return retval;
 }
 
 template <typename T, std::size_t SSize, enable_if_t<is_cpp_integral<T>::value, int> = 0>
@@ -8066,7 +10990,7 @@ inline void dispatch_in_place_and(integer<SSize> &rop, const integer<SSize> &op)
 template <typename T, std::size_t SSize, enable_if_t<is_cpp_integral<T>::value, int> = 0>
 inline void dispatch_in_place_and(integer<SSize> &rop, const T &op)
 {
-    dispatch_in_place_and(rop, integer<SSize>{op});
+    and_integral(rop, rop, op);
 }
 
 template <typename T, std::size_t SSize, enable_if_t<is_cpp_integral<T>::value, int> = 0>
@@ -8103,6 +11027,29 @@ inline T &operator&=(T &rop, const U &op)
     return rop;
 }
 
+// Binary bitwise AND operator with rvalue operands.
+template <std::size_t SSize, typename T,
+          detail::enable_if_t<detail::is_integer_rvalue_op_type<T, SSize>::value, int> = 0>
+inline integer<SSize> operator&(integer<SSize> &&op1, const T &op2)
+{
+    detail::dispatch_in_place_and(op1, op2);
+    return std::move(op1);
+}
+
+template <std::size_t SSize, typename T,
+          detail::enable_if_t<detail::is_integer_rvalue_op_type<T, SSize>::value, int> = 0>
+inline integer<SSize> operator&(const T &op1, integer<SSize> &&op2)
+{
+    detail::dispatch_in_place_and(op2, op1);
+    return std::move(op2);
+}
+
+template <std::size_t SSize>
+inline integer<SSize> operator&(integer<SSize> &&op1, integer<SSize> &&op2)
+{
+    return std::move(op1) & op2;
+}
+
 namespace detail
 {
 
@@ -8118,7 +11065,9 @@ inline integer<SSize> dispatch_operator_xor(const integer<SSize> &op1, const int
 template <std::size_t SSize, typename T, enable_if_t<is_cpp_integral<T>::value, int> = 0>
 inline integer<SSize> dispatch_operator_xor(const integer<SSize> &op1, const T &op2)
 {
-    return dispatch_operator_xor(op1, integer<SSize>{op2});
+    integer<SSize> retval;
+    xor_integral(retval, op1, op2);
+    return retval;
 }
 
 template <typename T, std::size_t SSize, enable_if_t<is_cpp_integral<T>::value, int> = 0>
@@ -8137,7 +11086,7 @@ inline void dispatch_in_place_xor(integer<SSize> &rop, const integer<SSize> &op)
 template <typename T, std::size_t SSize, enable_if_t<is_cpp_integral<T>::value, int> = 0>
 inline void dispatch_in_place_xor(integer<SSize> &rop, const T &op)
 {
-    dispatch_in_place_xor(rop, integer<SSize>{op});
+    xor_integral(rop, rop, op);
 }
 
 template <typename T, std::size_t SSize, enable_if_t<is_cpp_integral<T>::value, int> = 0>
@@ -8174,6 +11123,29 @@ inline T &operator^=(T &rop, const U &op)
     return rop;
 }
 
+// Binary bitwise XOR operator with rvalue operands.
+template <std::size_t SSize, typename T,
+          detail::enable_if_t<detail::is_integer_rvalue_op_type<T, SSize>::value, int> = 0>
+inline integer<SSize> operator^(integer<SSize> &&op1, const T &op2)
+{
+    detail::dispatch_in_place_xor(op1, op2);
+    return std::move(op1);
+}
+
+template <std::size_t SSize, typename T,
+          detail::enable_if_t<detail::is_integer_rvalue_op_type<T, SSize>::value, int> = 0>
+inline integer<SSize> operator^(const T &op1, integer<SSize> &&op2)
+{
+    detail::dispatch_in_place_xor(op2, op1);
+    return std::move(op2);
+}
+
+template <std::size_t SSize>
+inline integer<SSize> operator^(integer<SSize> &&op1, integer<SSize> &&op2)
+{
+    return std::move(op1) ^ op2;
+}
+
 MPPP_END_NAMESPACE
 
 #if defined(MPPP_WITH_BOOST_S11N)
@@ -8240,6 +11212,20 @@ namespace fmt
 
 template <std::size_t SSize>
 struct formatter<mppp::integer<SSize>> : mppp::detail::to_string_formatter {
+    template <typename FormatContext>
+    auto format(const mppp::integer<SSize> &n, FormatContext &ctx) const -> decltype(ctx.out())
+    {
+        if (n.is_static()) {
+            // NOTE: fast path for static values, which
+            // avoids the creation of a string.
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-type-member-init, hicpp-member-init)
+            std::array<char, mppp::detail::static_int_dec_max_size<SSize>()> buffer;
+            const auto end = mppp::detail::static_int_to_dec(buffer.data(), n._get_union().g_st());
+            return fmt::format_to(ctx.out(), "{}", fmt::string_view(buffer.data(), std::size_t(end - buffer.data())));
+        }
+
+        return mppp::detail::to_string_formatter::format(n, ctx);
+    }
 };
 
 } // namespace fmt
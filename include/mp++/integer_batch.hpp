@@ -0,0 +1,187 @@
+// Copyright 2016-2023 Francesco Biscani (bluescarni@gmail.com)
+//
+// This file is part of the mp++ library.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef MPPP_INTEGER_BATCH_HPP
+#define MPPP_INTEGER_BATCH_HPP
+
+#include <mp++/config.hpp>
+
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#if defined(MPPP_HAVE_STRING_VIEW)
+#include <string_view>
+#endif
+
+#include <mp++/detail/gmp.hpp>
+#include <mp++/detail/utils.hpp>
+#include <mp++/integer.hpp>
+
+MPPP_BEGIN_NAMESPACE
+
+namespace detail
+{
+
+// Parse the string s in base base into n.
+template <std::size_t SSize, typename S>
+inline void integer_batch_parse(integer<SSize> &n, const S &s, int base)
+{
+    if (base == 10) {
+        // Fast path: try to parse the string directly into static storage.
+        const auto begin = s.data(), end = s.data() + s.size();
+        auto &u = n._get_union();
+        if (u.is_static()) {
+            if (static_int_from_dec(u.g_st(), begin, end)) {
+                return;
+            }
+        } else {
+            static_int<SSize> st;
+            if (static_int_from_dec(st, begin, end)) {
+                // NOTE: like in the assignment from a static
+                // integer, the dynamic storage is destroyed.
+                u.destroy_dynamic();
+                ::new (static_cast<void *>(&u.m_st)) static_int<SSize>(st);
+                return;
+            }
+        }
+    }
+
+    // Slow path: go through the string constructor.
+    n = integer<SSize>{s, base};
+}
+
+// Implementation of parse_integers().
+template <std::size_t SSize, typename S>
+inline void parse_integers_impl(std::vector<integer<SSize>> &out, const S *strs, std::size_t n, int base,
+                                unsigned nthreads)
+{
+    if (mppp_unlikely(base != 0 && (base < 2 || base > 62))) {
+        throw std::invalid_argument("In the parsing of a batch of integers, a base of " + to_string(base)
+                                    + " was specified, but the only valid values are 0 and any value in the [2,62] "
+                                      "range");
+    }
+
+    out.resize(n);
+
+    auto func = [&out, strs, base](std::size_t, std::size_t begin, std::size_t end) {
+        for (auto i = begin; i != end; ++i) {
+            integer_batch_parse(out[i], strs[i], base);
+        }
+    };
+    parallel_for_chunks(n, nthreads, func);
+}
+
+// Append the representation of n in base base to out.
+template <std::size_t SSize>
+inline void integer_batch_format(std::vector<char> &out, const integer<SSize> &n, int base)
+{
+    const auto old_size = out.size();
+    const auto &u = n._get_union();
+
+    if (base == 10 && u.is_static()) {
+        // Fast path: print directly from static storage.
+        out.resize(old_size + static_int_dec_max_size<SSize>());
+        const auto end = static_int_to_dec(out.data() + old_size, u.g_st());
+        out.resize(static_cast<std::size_t>(end - out.data()));
+    } else {
+        const auto v = n.get_mpz_view();
+        // NOTE: as in mpz_to_str(), make room for the sign and the terminator.
+        out.resize(old_size + mpz_sizeinbase(v, base) + 2u);
+        mpz_get_str(out.data() + old_size, base, v);
+        out.resize(old_size + std::strlen(out.data() + old_size));
+    }
+}
+
+} // namespace detail
+
+// Batch parsing of integers.
+template <std::size_t SSize>
+inline void parse_integers(std::vector<integer<SSize>> &out, const std::string *strs, std::size_t n, int base = 10,
+                           unsigned nthreads = 1)
+{
+    detail::parse_integers_impl(out, strs, n, base, nthreads);
+}
+
+#if defined(MPPP_HAVE_STRING_VIEW)
+
+template <std::size_t SSize>
+inline void parse_integers(std::vector<integer<SSize>> &out, const std::string_view *strs, std::size_t n,
+                           int base = 10, unsigned nthreads = 1)
+{
+    detail::parse_integers_impl(out, strs, n, base, nthreads);
+}
+
+#endif
+
+// Batch formatting of integers.
+template <std::size_t SSize>
+inline void format_integers(std::vector<char> &buf, std::vector<std::size_t> &offsets, const integer<SSize> *ints,
+                            std::size_t n, int base = 10, unsigned nthreads = 1)
+{
+    if (mppp_unlikely(base < 2 || base > 62)) {
+        throw std::invalid_argument("Invalid base for string conversion: the base must be between "
+                                    "2 and 62, but a value of "
+                                    + detail::to_string(base) + " was provided instead");
+    }
+
+    const auto nchunks = detail::parallel_nchunks(n, nthreads);
+
+    // NOTE: the first chunk is written directly into buf,
+    // the other chunks are written into separate buffers
+    // and appended to buf at the end.
+    std::vector<std::vector<char>> cbufs(nchunks > 1u ? nchunks - 1u : 0u);
+    std::vector<std::size_t> cbegins(nchunks);
+
+    buf.clear();
+    offsets.resize(n + 1u);
+
+    auto func = [&buf, &offsets, &cbufs, &cbegins, ints, base](std::size_t c, std::size_t begin, std::size_t end) {
+        auto &cbuf = c == 0u ? buf : cbufs[c - 1u];
+        cbegins[c] = begin;
+        for (auto i = begin; i != end; ++i) {
+            // NOTE: the offsets are relative to the
+            // beginning of the chunk at this stage.
+            offsets[i] = cbuf.size();
+            detail::integer_batch_format(cbuf, ints[i], base);
+        }
+    };
+    detail::parallel_for_chunks(n, nthreads, func);
+
+    for (std::size_t c = 1; c < nchunks; ++c) {
+        const auto shift = buf.size();
+        const auto end = c + 1u < nchunks ? cbegins[c + 1u] : n;
+        for (auto i = cbegins[c]; i != end; ++i) {
+            offsets[i] += shift;
+        }
+        buf.insert(buf.end(), cbufs[c - 1u].begin(), cbufs[c - 1u].end());
+    }
+    offsets[n] = buf.size();
+}
+
+// Batch conversion of integers to double.
+template <std::size_t SSize>
+inline void batch_to_double(std::vector<double> &out, const integer<SSize> *ints, std::size_t n,
+                            fp_rounding rnd = fp_rounding::nearest, unsigned nthreads = 1)
+{
+    out.resize(n);
+
+    auto func = [&out, ints, rnd](std::size_t, std::size_t begin, std::size_t end) {
+        for (auto i = begin; i != end; ++i) {
+            out[i] = to_double(ints[i], rnd);
+        }
+    };
+    detail::parallel_for_chunks(n, nthreads, func);
+}
+
+MPPP_END_NAMESPACE
+
+#endif
@@ -0,0 +1,210 @@
+// Copyright 2016-2023 Francesco Biscani (bluescarni@gmail.com)
+//
+// This file is part of the mp++ library.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef MPPP_INTEGER_BATCH_GCD_HPP
+#define MPPP_INTEGER_BATCH_GCD_HPP
+
+#include <mp++/config.hpp>
+
+#include <cassert>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include <mp++/detail/utils.hpp>
+#include <mp++/integer.hpp>
+
+MPPP_BEGIN_NAMESPACE
+
+namespace detail
+{
+
+// Build a product tree on top of leaves.
+// The first level of the tree is leaves itself, each subsequent level contains
+// the products of pairs of consecutive nodes of the previous level (if the number
+// of nodes is odd, the last node is carried over). The last level contains
+// a single node, i.e., the product of all the leaves.
+template <std::size_t SSize>
+inline std::vector<std::vector<integer<SSize>>> product_tree(std::vector<integer<SSize>> &&leaves, unsigned nthreads)
+{
+    assert(!leaves.empty());
+
+    std::vector<std::vector<integer<SSize>>> tree;
+    tree.push_back(std::move(leaves));
+
+    while (tree.back().size() > 1u) {
+        const auto &prev = tree.back();
+        const auto psize = prev.size();
+        std::vector<integer<SSize>> level(psize / 2u + psize % 2u);
+
+        auto func = [&level, &prev, psize](std::size_t, std::size_t begin, std::size_t end) {
+            for (auto i = begin; i != end; ++i) {
+                if (2u * i + 1u < psize) {
+                    mul(level[i], prev[2u * i], prev[2u * i + 1u]);
+                } else {
+                    level[i] = prev[2u * i];
+                }
+            }
+        };
+        // NOTE: in the upper levels of the tree there are fewer nodes than
+        // threads, and the cost is dominated by a few large multiplications.
+        parallel_for_chunks(level.size(), nthreads, func);
+
+        tree.push_back(std::move(level));
+    }
+
+    return tree;
+}
+
+// Implementation of batch_gcd() for nonzero values. leaves contains
+// the absolute values of the input values.
+template <std::size_t SSize>
+inline void batch_gcd_nonzero(std::vector<integer<SSize>> &out, std::vector<integer<SSize>> &&leaves, unsigned nthreads)
+{
+    const auto n = leaves.size();
+    assert(n > 1u);
+
+    auto tree = product_tree(std::move(leaves), nthreads);
+    const auto nlevels = tree.size();
+
+    // Remainder tree: descend the product tree, replacing each node
+    // with the remainder of the product of all the leaves modulo the square
+    // of the node. Because the square of a node divides the square of its parent,
+    // the remainder can be computed from the (smaller) remainder of the parent.
+    // NOTE: the root is left untouched, as P mod P**2 == P.
+    for (auto k = nlevels - 2u; k > 0u; --k) {
+        auto &level = tree[k];
+        const auto &parent = tree[k + 1u];
+
+        auto func = [&level, &parent](std::size_t, std::size_t begin, std::size_t end) {
+            integer<SSize> sq;
+            for (auto i = begin; i != end; ++i) {
+                sqr(sq, level[i]);
+                tdiv_r_impl(level[i], parent[i / 2u], sq);
+            }
+        };
+        parallel_for_chunks(level.size(), nthreads, func);
+    }
+
+    // At the leaves: if r = P mod x**2, then
+    // gcd(x, P / x) == gcd(x, r / x).
+    const auto &xs = tree[0];
+    const auto &parent = tree[1];
+    auto func = [&out, &xs, &parent](std::size_t, std::size_t begin, std::size_t end) {
+        integer<SSize> sq;
+        for (auto i = begin; i != end; ++i) {
+            sqr(sq, xs[i]);
+            tdiv_r_impl(out[i], parent[i / 2u], sq);
+            divexact(out[i], out[i], xs[i]);
+            gcd(out[i], out[i], xs[i]);
+        }
+    };
+    parallel_for_chunks(n, nthreads, func);
+}
+
+} // namespace detail
+
+// Batch GCD.
+template <std::size_t SSize>
+inline void batch_gcd(std::vector<integer<SSize>> &out, const integer<SSize> *ints, std::size_t n,
+                      unsigned nthreads = 1)
+{
+    out.resize(n);
+
+    if (n == 0u) {
+        return;
+    }
+    if (n == 1u) {
+        // NOTE: the product of the other values
+        // is the empty product.
+        out[0].set_one();
+        return;
+    }
+
+    // Compute the absolute values, and count the zeroes.
+    std::vector<integer<SSize>> leaves(n);
+    std::size_t nzeroes = 0, zero_idx = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        abs(leaves[i], ints[i]);
+        if (leaves[i].is_zero()) {
+            ++nzeroes;
+            zero_idx = i;
+        }
+    }
+
+    if (nzeroes == 0u) {
+        detail::batch_gcd_nonzero(out, std::move(leaves), nthreads);
+        return;
+    }
+
+    // If there are zeroes in the input, the products of the other values
+    // are zero (gcd(x, 0) == abs(x)), except, if there is a single zero,
+    // for the product associated to the zero.
+    for (std::size_t i = 0; i < n; ++i) {
+        out[i] = leaves[i];
+    }
+    if (nzeroes == 1u) {
+        leaves[zero_idx].set_one();
+        out[zero_idx] = std::move(detail::product_tree(std::move(leaves), nthreads).back()[0]);
+    }
+}
+
+// GCD of a range of integers.
+template <std::size_t SSize>
+inline integer<SSize> &gcd_range(integer<SSize> &rop, const integer<SSize> *ints, std::size_t n,
+                                 unsigned nthreads = 1)
+{
+    std::vector<integer<SSize>> partial(detail::parallel_nchunks(n, nthreads));
+
+    auto func = [&partial, ints](std::size_t c, std::size_t begin, std::size_t end) {
+        auto &g = partial[c];
+        // NOTE: stop early if the gcd becomes 1.
+        for (auto i = begin; i != end && !g.is_one(); ++i) {
+            gcd(g, g, ints[i]);
+        }
+    };
+    detail::parallel_for_chunks(n, nthreads, func);
+
+    // NOTE: rop is written only after all the input
+    // values have been read, so that it can be one of them.
+    rop.set_zero();
+    for (const auto &g : partial) {
+        gcd(rop, rop, g);
+    }
+
+    return rop;
+}
+
+// LCM of a range of integers.
+template <std::size_t SSize>
+inline integer<SSize> &lcm_range(integer<SSize> &rop, const integer<SSize> *ints, std::size_t n,
+                                 unsigned nthreads = 1)
+{
+    std::vector<integer<SSize>> partial(detail::parallel_nchunks(n, nthreads));
+
+    auto func = [&partial, ints](std::size_t c, std::size_t begin, std::size_t end) {
+        auto &l = partial[c];
+        l.set_one();
+        // NOTE: stop early if the lcm becomes 0.
+        for (auto i = begin; i != end && !l.is_zero(); ++i) {
+            lcm(l, l, ints[i]);
+        }
+    };
+    detail::parallel_for_chunks(n, nthreads, func);
+
+    rop.set_one();
+    for (const auto &l : partial) {
+        lcm(rop, rop, l);
+    }
+
+    return rop;
+}
+
+MPPP_END_NAMESPACE
+
+#endif
@@ -0,0 +1,424 @@
+// Copyright 2016-2023 Francesco Biscani (bluescarni@gmail.com)
+//
+// This file is part of the mp++ library.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef MPPP_INTEGER_COMBINATORICS_HPP
+#define MPPP_INTEGER_COMBINATORICS_HPP
+
+#include <mp++/config.hpp>
+
+#include <cassert>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <mp++/detail/utils.hpp>
+#include <mp++/integer.hpp>
+
+MPPP_BEGIN_NAMESPACE
+
+namespace detail
+{
+
+// The maximum argument accepted by the multi-threaded
+// combinatorial functions.
+constexpr unsigned long max_comb_mt = 100000000ul;
+
+// Throw if the argument n of the multi-threaded combinatorial function
+// with name fname is too large.
+inline void check_comb_mt_arg(unsigned long n, const char *fname)
+{
+    if (mppp_unlikely(n > max_comb_mt)) {
+        throw std::invalid_argument("The value " + to_string(n) + " is too large to be used as input for the "
+                                    + fname + " function (the maximum allowed value is " + to_string(max_comb_mt)
+                                    + ")");
+    }
+}
+
+// The product tree used by the multi-threaded binomial and
+// multinomial coefficients needs the primes up to n, whose computation
+// costs O(n) regardless of the bottom arguments. When the bottom
+// argument k (or the sum of all the bottom arguments of a multinomial
+// except the largest one) is small, GMP's mpz_bin_ui() is
+// much faster. Use the product tree only if k >= min_bin_mt_k
+// and k >= n / bin_mt_ratio.
+constexpr unsigned long min_bin_mt_k = 64;
+constexpr unsigned long bin_mt_ratio = 64;
+
+inline bool use_bin_mt(unsigned long n, unsigned long k)
+{
+    return k >= min_bin_mt_k && k >= n / bin_mt_ratio;
+}
+
+// The largest n whose double factorial fits in 64 bits.
+constexpr unsigned long max_small_double_fac = 33;
+
+// The largest n whose primorial fits in 64 bits.
+constexpr unsigned long max_small_primorial = 52;
+
+// Small double factorials and primorials, read from tables.
+inline unsigned long long small_double_fac(unsigned long n)
+{
+    static constexpr unsigned long long small_dfacs[] = {1ull,
+                                                         1ull,
+                                                         2ull,
+                                                         3ull,
+                                                         8ull,
+                                                         15ull,
+                                                         48ull,
+                                                         105ull,
+                                                         384ull,
+                                                         945ull,
+                                                         3840ull,
+                                                         10395ull,
+                                                         46080ull,
+                                                         135135ull,
+                                                         645120ull,
+                                                         2027025ull,
+                                                         10321920ull,
+                                                         34459425ull,
+                                                         185794560ull,
+                                                         654729075ull,
+                                                         3715891200ull,
+                                                         13749310575ull,
+                                                         81749606400ull,
+                                                         316234143225ull,
+                                                         1961990553600ull,
+                                                         7905853580625ull,
+                                                         51011754393600ull,
+                                                         213458046676875ull,
+                                                         1428329123020800ull,
+                                                         6190283353629375ull,
+                                                         42849873690624000ull,
+                                                         191898783962510625ull,
+                                                         1371195958099968000ull,
+                                                         6332659870762850625ull};
+    static_assert(sizeof(small_dfacs) / sizeof(small_dfacs[0]) == max_small_double_fac + 1u,
+                  "Invalid size for the table of small double factorials.");
+    assert(n <= max_small_double_fac);
+    return small_dfacs[n];
+}
+
+inline unsigned long long small_primorial(unsigned long n)
+{
+    // NOTE: the i-th element of small_prims is the product
+    // of the primes up to and including small_primes[i].
+    static constexpr unsigned long small_primes[] = {2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37, 41, 43, 47};
+    static constexpr unsigned long long small_prims[] = {2ull,
+                                                         6ull,
+                                                         30ull,
+                                                         210ull,
+                                                         2310ull,
+                                                         30030ull,
+                                                         510510ull,
+                                                         9699690ull,
+                                                         223092870ull,
+                                                         6469693230ull,
+                                                         200560490130ull,
+                                                         7420738134810ull,
+                                                         304250263527210ull,
+                                                         13082761331670030ull,
+                                                         614889782588491410ull};
+    static_assert(sizeof(small_primes) / sizeof(small_primes[0]) == sizeof(small_prims) / sizeof(small_prims[0]),
+                  "Inconsistent sizes for the tables of small primorials.");
+    assert(n <= max_small_primorial);
+    unsigned long long retval = 1;
+    for (std::size_t i = 0; i < sizeof(small_primes) / sizeof(small_primes[0]) && small_primes[i] <= n; ++i) {
+        retval = small_prims[i];
+    }
+    return retval;
+}
+
+// List of the primes up to n (included), via a sieve of Eratosthenes on the odd numbers.
+inline std::vector<unsigned long> comb_primes(unsigned long n)
+{
+    std::vector<unsigned long> retval;
+    if (n < 2u) {
+        return retval;
+    }
+    retval.push_back(2);
+
+    // NOTE: the i-th element of the sieve corresponds to 2 * i + 1.
+    std::vector<char> sieve(static_cast<std::size_t>((n - 1u) / 2u + 1u), 1);
+    for (unsigned long i = 1; i < sieve.size(); ++i) {
+        if (sieve[i]) {
+            const auto p = 2u * i + 1u;
+            retval.push_back(p);
+            // NOTE: p <= n / p implies p * p <= n, thus
+            // there is no overflow in the computation of p * p.
+            if (p <= n / p) {
+                for (auto j = (p * p) / 2u; j < sieve.size(); j += p) {
+                    sieve[j] = 0;
+                }
+            }
+        }
+    }
+
+    return retval;
+}
+
+// Exponent of the prime p in n! (Legendre's formula).
+inline unsigned long legendre_exp(unsigned long n, unsigned long p)
+{
+    unsigned long retval = 0;
+    while (n >= p) {
+        n /= p;
+        retval += n;
+    }
+    return retval;
+}
+
+// Set rop to the product of the values in [begin, end),
+// via binary splitting.
+template <std::size_t SSize>
+inline void ulong_product(integer<SSize> &rop, const unsigned long *begin, const unsigned long *end)
+{
+    if (end - begin <= 32) {
+        // Accumulate the values in an unsigned long for as long as possible,
+        // and multiply rop only on overflow.
+        rop.set_one();
+        unsigned long acc = 1;
+        for (; begin != end; ++begin) {
+            if (acc > std::numeric_limits<unsigned long>::max() / *begin) {
+                rop *= acc;
+                acc = *begin;
+            } else {
+                acc *= *begin;
+            }
+        }
+        rop *= acc;
+        return;
+    }
+
+    const auto mid = begin + (end - begin) / 2;
+    integer<SSize> tmp;
+    ulong_product(rop, begin, mid);
+    ulong_product(tmp, mid, end);
+    mul(rop, rop, tmp);
+}
+
+// Set rop to the product of the values in v, with the computation
+// split in nthreads contiguous chunks. The partial products are then
+// combined pairwise, so that the operands of each multiplication
+// have similar sizes.
+template <std::size_t SSize>
+inline void parallel_ulong_product(integer<SSize> &rop, const std::vector<unsigned long> &v, unsigned nthreads)
+{
+    std::vector<integer<SSize>> partial(parallel_nchunks(v.size(), nthreads));
+    auto func = [&partial, &v](std::size_t c, std::size_t begin, std::size_t end) {
+        ulong_product(partial[c], v.data() + begin, v.data() + end);
+    };
+    parallel_for_chunks(v.size(), nthreads, func);
+
+    while (partial.size() > 1u) {
+        const auto psize = partial.size();
+        auto func2 = [&partial, psize](std::size_t, std::size_t begin, std::size_t end) {
+            for (auto i = begin; i != end; ++i) {
+                if (2u * i + 1u < psize) {
+                    mul(partial[2u * i], partial[2u * i], partial[2u * i + 1u]);
+                }
+            }
+        };
+        parallel_for_chunks(psize / 2u + psize % 2u, nthreads, func2);
+        for (std::size_t i = 1; 2u * i < psize; ++i) {
+            swap(partial[i], partial[2u * i]);
+        }
+        partial.resize(psize / 2u + psize % 2u);
+    }
+
+    if (partial.empty()) {
+        rop.set_one();
+    } else {
+        rop = std::move(partial[0]);
+    }
+}
+
+// Set rop to the product of p**e(p) for all the primes p in primes.
+// Writing the exponents in binary, the product is computed as
+// Q_0 * (Q_1 * (Q_2 * ...)**2)**2, where Q_k is the product of
+// the primes whose exponent has the k-th bit set. In this way, the bulk of
+// the work is spent in balanced products of primes and in squarings.
+template <std::size_t SSize, typename F>
+inline void prime_power_product(integer<SSize> &rop, const std::vector<unsigned long> &primes, const F &e,
+                                unsigned nthreads)
+{
+    std::vector<unsigned long> exps(primes.size());
+    auto func = [&exps, &primes, &e](std::size_t, std::size_t begin, std::size_t end) {
+        for (auto i = begin; i != end; ++i) {
+            exps[i] = e(primes[i]);
+        }
+    };
+    parallel_for_chunks(primes.size(), nthreads, func);
+
+    unsigned long max_exp = 0;
+    for (auto x : exps) {
+        max_exp = c_max(max_exp, x);
+    }
+
+    int nbits = 0;
+    for (auto x = max_exp; x != 0u; x >>= 1) {
+        ++nbits;
+    }
+
+    // NOTE: use a separate accumulator, as rop might
+    // alias one of the arguments in the callers.
+    integer<SSize> acc{1}, q;
+    std::vector<unsigned long> qprimes;
+    for (auto k = nbits - 1; k >= 0; --k) {
+        qprimes.clear();
+        for (decltype(primes.size()) i = 0; i < primes.size(); ++i) {
+            if ((exps[i] >> k) & 1u) {
+                qprimes.push_back(primes[i]);
+            }
+        }
+        parallel_ulong_product(q, qprimes, nthreads);
+        sqr(acc, acc);
+        mul(acc, acc, q);
+    }
+
+    rop = std::move(acc);
+}
+
+} // namespace detail
+
+// Multi-threaded factorial.
+template <std::size_t SSize>
+inline integer<SSize> &fac_ui(integer<SSize> &rop, unsigned long n, unsigned nthreads)
+{
+    detail::check_comb_mt_arg(n, "factorial");
+    if (n <= detail::max_small_fac) {
+        return fac_ui(rop, n);
+    }
+    detail::prime_power_product(
+        rop, detail::comb_primes(n), [n](unsigned long p) { return detail::legendre_exp(n, p); }, nthreads);
+    return rop;
+}
+
+// Double factorial.
+template <std::size_t SSize>
+inline integer<SSize> &double_fac_ui(integer<SSize> &rop, unsigned long n, unsigned nthreads = 1)
+{
+    detail::check_comb_mt_arg(n, "double factorial");
+    if (n <= detail::max_small_double_fac) {
+        return rop = detail::small_double_fac(n);
+    }
+    if (n % 2u == 0u) {
+        // n!! = 2**m * m!, with m = n / 2.
+        const auto m = n / 2u;
+        detail::prime_power_product(
+            rop, detail::comb_primes(m),
+            [m](unsigned long p) { return detail::legendre_exp(m, p) + (p == 2u ? m : 0u); }, nthreads);
+    } else {
+        // n!! = n! / (2**m * m!), with m = (n - 1) / 2.
+        const auto m = (n - 1u) / 2u;
+        detail::prime_power_product(
+            rop, detail::comb_primes(n),
+            [n, m](unsigned long p) {
+                return detail::legendre_exp(n, p) - detail::legendre_exp(m, p) - (p == 2u ? m : 0u);
+            },
+            nthreads);
+    }
+    return rop;
+}
+
+// Primorial.
+template <std::size_t SSize>
+inline integer<SSize> &primorial_ui(integer<SSize> &rop, unsigned long n, unsigned nthreads = 1)
+{
+    detail::check_comb_mt_arg(n, "primorial");
+    if (n <= detail::max_small_primorial) {
+        return rop = detail::small_primorial(n);
+    }
+    detail::parallel_ulong_product(rop, detail::comb_primes(n), nthreads);
+    return rop;
+}
+
+// Multi-threaded binomial coefficient.
+template <std::size_t SSize>
+inline integer<SSize> &bin_ui(integer<SSize> &rop, const integer<SSize> &n, unsigned long k, unsigned nthreads)
+{
+    // NOTE: use the product tree only for nonnegative
+    // top arguments within the limit.
+    if (n.sgn() < 0 || n > detail::max_comb_mt) {
+        return bin_ui(rop, n, k);
+    }
+    const auto nl = static_cast<unsigned long>(n);
+    if (k > nl) {
+        rop.set_zero();
+        return rop;
+    }
+    k = detail::c_min(k, nl - k);
+    if (!detail::use_bin_mt(nl, k)) {
+        return bin_ui(rop, n, k);
+    }
+    detail::prime_power_product(
+        rop, detail::comb_primes(nl),
+        [nl, k](unsigned long p) {
+            // NOTE: this is Kummer's theorem.
+            return detail::legendre_exp(nl, p) - detail::legendre_exp(k, p) - detail::legendre_exp(nl - k, p);
+        },
+        nthreads);
+    return rop;
+}
+
+// Multinomial coefficient.
+template <std::size_t SSize>
+inline integer<SSize> &multinomial(integer<SSize> &rop, const unsigned long *ks, std::size_t nk, unsigned nthreads = 1)
+{
+    // Compute the sum of the ks.
+    unsigned long n = 0;
+    for (std::size_t i = 0; i < nk; ++i) {
+        if (mppp_unlikely(ks[i] > std::numeric_limits<unsigned long>::max() - n)) {
+            throw std::overflow_error("Overflow in the computation of the sum of the arguments of a multinomial "
+                                      "coefficient");
+        }
+        n += ks[i];
+    }
+    detail::check_comb_mt_arg(n, "multinomial");
+
+    if (nk != 0u) {
+        // Locate the largest bottom argument.
+        std::size_t imax = 0;
+        for (std::size_t i = 1; i < nk; ++i) {
+            if (ks[i] > ks[imax]) {
+                imax = i;
+            }
+        }
+        // NOTE: the multinomial coefficient is bin(n, r) times the multinomial
+        // coefficient of the remaining bottom arguments, where r = n - ks[imax].
+        // If r is small, compute bin(n, r) without the product tree, and the
+        // remaining multinomial via a product tree of size r.
+        const auto r = n - ks[imax];
+        if (!detail::use_bin_mt(n, r)) {
+            std::vector<unsigned long> rest(ks, ks + imax);
+            rest.insert(rest.end(), ks + imax + 1, ks + nk);
+            integer<SSize> tmp;
+            multinomial(tmp, rest.data(), rest.size(), nthreads);
+            bin_ui(rop, integer<SSize>{n}, r);
+            mul(rop, rop, tmp);
+            return rop;
+        }
+    }
+
+    detail::prime_power_product(
+        rop, detail::comb_primes(n),
+        [n, ks, nk](unsigned long p) {
+            auto retval = detail::legendre_exp(n, p);
+            for (std::size_t i = 0; i < nk; ++i) {
+                retval -= detail::legendre_exp(ks[i], p);
+            }
+            return retval;
+        },
+        nthreads);
+    return rop;
+}
+
+MPPP_END_NAMESPACE
+
+#endif
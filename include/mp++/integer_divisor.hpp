@@ -0,0 +1,507 @@
+// Copyright 2016-2023 Francesco Biscani (bluescarni@gmail.com)
+//
+// This file is part of the mp++ library.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef MPPP_INTEGER_DIVISOR_HPP
+#define MPPP_INTEGER_DIVISOR_HPP
+
+#include <mp++/config.hpp>
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <stdexcept>
+
+#include <mp++/detail/gmp.hpp>
+#include <mp++/detail/utils.hpp>
+#include <mp++/exceptions.hpp>
+#include <mp++/integer.hpp>
+
+MPPP_BEGIN_NAMESPACE
+
+template <std::size_t>
+class integer_divisor;
+
+namespace detail
+{
+
+template <std::size_t>
+struct integer_divisor_impl;
+
+// The division kernels with precomputed reciprocals require
+// double-limb multiplication (which also implies no nail bits).
+#if (defined(_MSC_VER) && defined(_WIN64) && GMP_NUMB_BITS == 64 && !GMP_NAIL_BITS) || defined(MPPP_HAVE_DLIMB_T)
+
+#define MPPP_INTEGER_DIVISOR_HAVE_PREINV
+
+// Divide (nh, nl) by the normalised divisor d, using the precomputed
+// reciprocal v = (B**2 - 1) / d - B, where B = 2**GMP_NUMB_BITS.
+// nh must be less than d. The quotient is returned, the remainder
+// is written into r.
+// NOTE: this is algorithm 4 from Moller and Granlund,
+// "Improved division by invariant integers" (2011).
+inline ::mp_limb_t div_2by1_preinv(::mp_limb_t *r, ::mp_limb_t nh, ::mp_limb_t nl, ::mp_limb_t d, ::mp_limb_t v)
+{
+    assert(nh < d);
+
+    // (qh, ql) = v * nh + (nh + 1, nl).
+    // NOLINTNEXTLINE(cppcoreguidelines-init-variables)
+    ::mp_limb_t qh;
+    auto ql = dlimb_mul(nh, v, &qh);
+    ql += nl;
+    qh += nh + 1u + static_cast<::mp_limb_t>(ql < nl);
+
+    // Candidate remainder, and adjustments.
+    // NOTE: the first adjustment is taken with
+    // roughly even probability, thus we implement it
+    // via a mask in order to avoid branch mispredictions.
+    auto rem = static_cast<::mp_limb_t>(nl - qh * d);
+    const auto mask = static_cast<::mp_limb_t>(-static_cast<::mp_limb_t>(rem > ql));
+    qh += mask;
+    rem += mask & d;
+    if (mppp_unlikely(rem >= d)) {
+        ++qh;
+        rem -= d;
+    }
+
+    *r = rem;
+    return qh;
+}
+
+// Divide (n2, n1, n0) by the normalised divisor (d1, d0), using
+// the precomputed reciprocal v = (B**3 - 1) / (d1, d0) - B.
+// (n2, n1) must be less than (d1, d0). The quotient is returned,
+// the remainder is written into (r1, r0).
+// NOTE: this is algorithm 5 from Moller and Granlund,
+// "Improved division by invariant integers" (2011).
+inline ::mp_limb_t div_3by2_preinv(::mp_limb_t *r1, ::mp_limb_t *r0, ::mp_limb_t n2, ::mp_limb_t n1, ::mp_limb_t n0,
+                                   ::mp_limb_t d1, ::mp_limb_t d0, ::mp_limb_t v)
+{
+    // (q, q0) = v * n2 + (n2, n1).
+    // NOLINTNEXTLINE(cppcoreguidelines-init-variables)
+    ::mp_limb_t q;
+    auto q0 = dlimb_mul(n2, v, &q);
+    q0 += n1;
+    q += n2 + static_cast<::mp_limb_t>(q0 < n1);
+
+    // (s1, s0) = (n1 - d1 * q, n0) - (d1, d0).
+    const auto a1 = static_cast<::mp_limb_t>(n1 - d1 * q);
+    const auto s0 = static_cast<::mp_limb_t>(n0 - d0);
+    const auto s1 = static_cast<::mp_limb_t>(a1 - d1 - static_cast<::mp_limb_t>(n0 < d0));
+
+    // (t1, t0) = d0 * q.
+    // NOLINTNEXTLINE(cppcoreguidelines-init-variables)
+    ::mp_limb_t t1;
+    const auto t0 = dlimb_mul(d0, q, &t1);
+
+    // Candidate remainder (s1, s0) - (t1, t0), and adjustments.
+    auto rr0 = static_cast<::mp_limb_t>(s0 - t0);
+    auto rr1 = static_cast<::mp_limb_t>(s1 - t1 - static_cast<::mp_limb_t>(s0 < t0));
+    ++q;
+    // NOTE: branchless first adjustment, as above.
+    const auto mask = static_cast<::mp_limb_t>(-static_cast<::mp_limb_t>(rr1 >= q0));
+    q += mask;
+    rr0 += mask & d0;
+    rr1 += (mask & d1) + static_cast<::mp_limb_t>(rr0 < (mask & d0));
+    if (mppp_unlikely(rr1 >= d1) && (rr1 > d1 || rr0 >= d0)) {
+        ++q;
+        rr1 = static_cast<::mp_limb_t>(rr1 - d1 - static_cast<::mp_limb_t>(rr0 < d0));
+        rr0 -= d0;
+    }
+
+    *r1 = rr1;
+    *r0 = rr0;
+    return q;
+}
+
+// Limb i of the array np shifted left by s bits (with 0 < s < GMP_NUMB_BITS),
+// including the bits shifted out of limb i - 1.
+inline ::mp_limb_t divisor_shifted_limb(const ::mp_limb_t *np, std::size_t i, unsigned s)
+{
+    assert(s > 0u && s < unsigned(GMP_NUMB_BITS));
+
+    return static_cast<::mp_limb_t>((np[i] << s) | (i != 0u ? (np[i - 1u] >> (unsigned(GMP_NUMB_BITS) - s)) : 0u));
+}
+
+// Divide the asize limbs in np by the 1-limb divisor d, normalised via a left shift
+// by s bits, with reciprocal v. The asize limbs of the quotient are written into qp,
+// the remainder is returned. qp and np may coincide.
+inline ::mp_limb_t divisor_divrem_1(::mp_limb_t *qp, const ::mp_limb_t *np, std::size_t asize, ::mp_limb_t d,
+                                    unsigned s, ::mp_limb_t v)
+{
+    ::mp_limb_t r = 0;
+    if (asize == 0u) {
+        return r;
+    }
+
+    if (s == 0u) {
+        for (auto i = asize; i-- > 0u;) {
+            qp[i] = div_2by1_preinv(&r, r, np[i], d, v);
+        }
+        return r;
+    }
+
+    // NOTE: the dividend is shifted by s bits as well,
+    // and the bits shifted out of the top limb form the
+    // initial remainder.
+    r = np[asize - 1u] >> (unsigned(GMP_NUMB_BITS) - s);
+    for (auto i = asize; i-- > 0u;) {
+        qp[i] = div_2by1_preinv(&r, r, divisor_shifted_limb(np, i, s), d, v);
+    }
+    return r >> s;
+}
+
+// Divide the asize limbs in np by the 2-limb divisor (d1, d0), normalised via a left shift
+// by s bits, with reciprocal v. asize must be at least 2. The asize - 1 limbs of the quotient
+// are written into qp, the 2 limbs of the remainder are written into rp. qp and np may coincide.
+inline void divisor_divrem_2(::mp_limb_t *qp, ::mp_limb_t *rp, const ::mp_limb_t *np, std::size_t asize,
+                             ::mp_limb_t d1, ::mp_limb_t d0, unsigned s, ::mp_limb_t v)
+{
+    assert(asize >= 2u);
+
+    // NOLINTNEXTLINE(cppcoreguidelines-init-variables)
+    ::mp_limb_t r1, r0;
+    if (s == 0u) {
+        r1 = 0;
+        r0 = np[asize - 1u];
+        for (auto i = asize - 1u; i-- > 0u;) {
+            qp[i] = div_3by2_preinv(&r1, &r0, r1, r0, np[i], d1, d0, v);
+        }
+        rp[0] = r0;
+        rp[1] = r1;
+        return;
+    }
+
+    r1 = np[asize - 1u] >> (unsigned(GMP_NUMB_BITS) - s);
+    r0 = divisor_shifted_limb(np, asize - 1u, s);
+    for (auto i = asize - 1u; i-- > 0u;) {
+        qp[i] = div_3by2_preinv(&r1, &r0, r1, r0, divisor_shifted_limb(np, i, s), d1, d0, v);
+    }
+    rp[0] = static_cast<::mp_limb_t>((r0 >> s) | (r1 << (unsigned(GMP_NUMB_BITS) - s)));
+    rp[1] = r1 >> s;
+}
+
+#endif
+
+// Write into the integer n the value with absolute value l
+// and sign given by neg. n will be in static storage.
+template <std::size_t SSize>
+inline void integer_divisor_store_1(integer<SSize> &n, bool neg, ::mp_limb_t l)
+{
+    if (!n.is_static()) {
+        n.set_zero();
+    }
+    auto &st = n._get_union().g_st();
+    st._mp_size = l == 0u ? 0 : (neg ? -1 : 1);
+    st.m_limbs[0] = l;
+    st.zero_upper_limbs(1);
+}
+
+// Write into the integer n the value with signed size size
+// and limbs lp. n will be in static storage.
+template <std::size_t SSize>
+inline void integer_divisor_store(integer<SSize> &n, mpz_size_t size, const ::mp_limb_t *lp)
+{
+    if (!n.is_static()) {
+        n.set_zero();
+    }
+    auto &st = n._get_union().g_st();
+    const auto asize = static_cast<std::size_t>(size >= 0 ? size : -size);
+    st._mp_size = size;
+    copy_limbs_no(lp, lp + asize, st.m_limbs.data());
+    st.zero_upper_limbs(asize);
+}
+
+} // namespace detail
+
+// Integer divisor with precomputed reciprocal.
+template <std::size_t SSize>
+class integer_divisor
+{
+    template <std::size_t>
+    friend struct detail::integer_divisor_impl;
+
+public:
+    // Constructor from a divisor.
+    explicit integer_divisor(const integer<SSize> &d) : m_d(d)
+    {
+        if (mppp_unlikely(m_d.sgn() == 0)) {
+            throw zero_division_error("Integer division by zero");
+        }
+
+        m_d.demote();
+
+#if defined(MPPP_INTEGER_DIVISOR_HAVE_PREINV)
+        const auto asize = m_d.size();
+        if (!m_d.is_static() || asize > 2u) {
+            return;
+        }
+
+        const auto dp = m_d._get_union().g_st().m_limbs.data();
+        // NOTE: the divisor is normalised by shifting it left until
+        // its most significant bit is set.
+        m_shift = unsigned(GMP_NUMB_BITS) - detail::limb_size_nbits(dp[asize - 1u]);
+
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-member-init, hicpp-member-init)
+        std::array<::mp_limb_t, 3> n, q;
+        if (asize == 1u) {
+            m_dn[0] = static_cast<::mp_limb_t>(dp[0] << m_shift);
+            m_dn[1] = 0;
+
+            // v = (B**2 - 1) / d - B is the quotient of
+            // (B - 1 - d, B - 1) by d.
+            n[0] = ~::mp_limb_t(0);
+            n[1] = static_cast<::mp_limb_t>(~m_dn[0]);
+            mpn_divrem_1(q.data(), 0, n.data(), 2, m_dn[0]);
+        } else {
+            m_dn[0] = static_cast<::mp_limb_t>(dp[0] << m_shift);
+            m_dn[1] = static_cast<::mp_limb_t>(
+                (dp[1] << m_shift) | (m_shift != 0u ? (dp[0] >> (unsigned(GMP_NUMB_BITS) - m_shift)) : 0u));
+
+            // v = (B**3 - 1) / (d1, d0) - B is the quotient of
+            // (B - 1 - d1, B - 1 - d0, B - 1) by (d1, d0).
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-type-member-init, hicpp-member-init)
+            std::array<::mp_limb_t, 2> r;
+            n[0] = ~::mp_limb_t(0);
+            n[1] = static_cast<::mp_limb_t>(~m_dn[0]);
+            n[2] = static_cast<::mp_limb_t>(~m_dn[1]);
+            mpn_tdiv_qr(q.data(), r.data(), 0, n.data(), 3, m_dn.data(), 2);
+        }
+        assert(q[1] == 0u);
+        m_inv = q[0];
+        m_nlimbs = asize;
+#endif
+    }
+
+    // Getter for the divisor.
+    MPPP_NODISCARD const integer<SSize> &get() const
+    {
+        return m_d;
+    }
+
+private:
+    integer<SSize> m_d;
+    // Number of limbs of the divisor, if the precomputed
+    // reciprocal is available, zero otherwise.
+    std::size_t m_nlimbs = 0;
+    unsigned m_shift = 0;
+    std::array<::mp_limb_t, 2> m_dn{};
+    ::mp_limb_t m_inv = 0;
+};
+
+namespace detail
+{
+
+template <std::size_t SSize>
+struct integer_divisor_impl {
+    // Truncated division of n by d via the precomputed reciprocal, in the case
+    // in which both n and d consist of a single limb. The absolute values of the
+    // quotient and of the remainder are written into q and r. Returns false if
+    // this fast path is not available.
+    static bool divrem_1(::mp_limb_t &q, ::mp_limb_t &r, const integer<SSize> &n, const integer_divisor<SSize> &d)
+    {
+#if defined(MPPP_INTEGER_DIVISOR_HAVE_PREINV)
+        if (d.m_nlimbs != 1u || !n.is_static()) {
+            return false;
+        }
+
+        const auto &st = n._get_union().g_st();
+        if (st._mp_size != 1 && st._mp_size != -1) {
+            return false;
+        }
+
+        const auto n0 = st.m_limbs[0];
+        if (d.m_shift == 0u) {
+            q = div_2by1_preinv(&r, 0, n0, d.m_dn[0], d.m_inv);
+        } else {
+            q = div_2by1_preinv(&r, n0 >> (unsigned(GMP_NUMB_BITS) - d.m_shift),
+                                static_cast<::mp_limb_t>(n0 << d.m_shift), d.m_dn[0], d.m_inv);
+            r >>= d.m_shift;
+        }
+
+        return true;
+#else
+        ignore(q, r, n, d);
+        return false;
+#endif
+    }
+    // Truncated division of n by d via the precomputed reciprocal. The limbs of the
+    // absolute values of the quotient and of the remainder are written into qp and rp,
+    // and their sizes into qsize and rsize. Returns false if the fast path is not available.
+    static bool divrem(::mp_limb_t *qp, ::mp_limb_t *rp, std::size_t &qsize, std::size_t &rsize,
+                       const integer<SSize> &n, const integer_divisor<SSize> &d)
+    {
+#if defined(MPPP_INTEGER_DIVISOR_HAVE_PREINV)
+        if (d.m_nlimbs == 0u || !n.is_static()) {
+            return false;
+        }
+
+        const auto np = n._get_union().g_st().m_limbs.data();
+        const auto asize = n.size();
+
+        if (asize < d.m_nlimbs) {
+            // The dividend is smaller than the divisor.
+            copy_limbs_no(np, np + asize, rp);
+            qsize = 0;
+            rsize = asize;
+            return true;
+        }
+
+        if (d.m_nlimbs == 1u) {
+            rp[0] = divisor_divrem_1(qp, np, asize, d.m_dn[0], d.m_shift, d.m_inv);
+            qsize = asize;
+            rsize = static_cast<std::size_t>(rp[0] != 0u);
+        } else {
+            divisor_divrem_2(qp, rp, np, asize, d.m_dn[1], d.m_dn[0], d.m_shift, d.m_inv);
+            qsize = asize - 1u;
+            rsize = rp[1] != 0u ? 2u : static_cast<std::size_t>(rp[0] != 0u);
+        }
+        while (qsize != 0u && qp[qsize - 1u] == 0u) {
+            --qsize;
+        }
+
+        return true;
+#else
+        ignore(qp, rp, qsize, rsize, n, d);
+        return false;
+#endif
+    }
+};
+
+} // namespace detail
+
+// Truncated division with remainder.
+template <std::size_t SSize>
+inline void tdiv_qr(integer<SSize> &q, integer<SSize> &r, const integer<SSize> &n, const integer_divisor<SSize> &d)
+{
+    if (mppp_unlikely(&q == &r)) {
+        throw std::invalid_argument("When performing a division with remainder, the quotient 'q' and the "
+                                    "remainder 'r' must be distinct objects");
+    }
+
+    // NOLINTNEXTLINE(cppcoreguidelines-init-variables)
+    ::mp_limb_t q1, r1;
+    if (detail::integer_divisor_impl<SSize>::divrem_1(q1, r1, n, d)) {
+        // NOTE: the signs must be computed before writing into q and r,
+        // which may overlap with n.
+        const auto neg_n = n._get_union().g_st()._mp_size < 0, neg_q = neg_n != (d.get().sgn() < 0);
+        detail::integer_divisor_store_1(q, neg_q, q1);
+        detail::integer_divisor_store_1(r, neg_n, r1);
+        return;
+    }
+
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-member-init, hicpp-member-init)
+    std::array<::mp_limb_t, SSize> ql;
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-member-init, hicpp-member-init)
+    std::array<::mp_limb_t, SSize < 2u ? 2u : SSize> rl;
+    // NOLINTNEXTLINE(cppcoreguidelines-init-variables)
+    std::size_t qsize, rsize;
+    if (detail::integer_divisor_impl<SSize>::divrem(ql.data(), rl.data(), qsize, rsize, n, d)) {
+        // NOTE: the signs must be computed before writing into q and r,
+        // which may overlap with n.
+        const auto sign_n = n.sgn(), sign_q = sign_n * d.get().sgn();
+        const auto qs = static_cast<detail::mpz_size_t>(qsize), rs = static_cast<detail::mpz_size_t>(rsize);
+        detail::integer_divisor_store(q, sign_q < 0 ? -qs : qs, ql.data());
+        detail::integer_divisor_store(r, sign_n < 0 ? -rs : rs, rl.data());
+        return;
+    }
+
+    tdiv_qr(q, r, n, d.get());
+}
+
+// Truncated division without remainder.
+template <std::size_t SSize>
+inline integer<SSize> &tdiv_q(integer<SSize> &q, const integer<SSize> &n, const integer_divisor<SSize> &d)
+{
+    // NOLINTNEXTLINE(cppcoreguidelines-init-variables)
+    ::mp_limb_t q1, r1;
+    if (detail::integer_divisor_impl<SSize>::divrem_1(q1, r1, n, d)) {
+        detail::integer_divisor_store_1(q, (n._get_union().g_st()._mp_size < 0) != (d.get().sgn() < 0), q1);
+        return q;
+    }
+
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-member-init, hicpp-member-init)
+    std::array<::mp_limb_t, SSize> ql;
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-member-init, hicpp-member-init)
+    std::array<::mp_limb_t, SSize < 2u ? 2u : SSize> rl;
+    // NOLINTNEXTLINE(cppcoreguidelines-init-variables)
+    std::size_t qsize, rsize;
+    if (detail::integer_divisor_impl<SSize>::divrem(ql.data(), rl.data(), qsize, rsize, n, d)) {
+        const auto qs = static_cast<detail::mpz_size_t>(qsize);
+        detail::integer_divisor_store(q, n.sgn() * d.get().sgn() < 0 ? -qs : qs, ql.data());
+        return q;
+    }
+
+    return tdiv_q(q, n, d.get());
+}
+
+// Exact division (ternary version).
+template <std::size_t SSize>
+inline integer<SSize> &divexact(integer<SSize> &rop, const integer<SSize> &n, const integer_divisor<SSize> &d)
+{
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-member-init, hicpp-member-init)
+    std::array<::mp_limb_t, SSize> ql;
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-member-init, hicpp-member-init)
+    std::array<::mp_limb_t, SSize < 2u ? 2u : SSize> rl;
+    // NOLINTNEXTLINE(cppcoreguidelines-init-variables)
+    std::size_t qsize, rsize;
+    if (detail::integer_divisor_impl<SSize>::divrem(ql.data(), rl.data(), qsize, rsize, n, d)) {
+        assert(rsize == 0u);
+        const auto qs = static_cast<detail::mpz_size_t>(qsize);
+        detail::integer_divisor_store(rop, n.sgn() * d.get().sgn() < 0 ? -qs : qs, ql.data());
+        return rop;
+    }
+
+    return divexact(rop, n, d.get());
+}
+
+// Exact division (binary version).
+template <std::size_t SSize>
+inline integer<SSize> divexact(const integer<SSize> &n, const integer_divisor<SSize> &d)
+{
+    integer<SSize> retval;
+    divexact(retval, n, d);
+    return retval;
+}
+
+// Binary division operator.
+template <std::size_t SSize>
+inline integer<SSize> operator/(const integer<SSize> &n, const integer_divisor<SSize> &d)
+{
+    integer<SSize> retval;
+    tdiv_q(retval, n, d);
+    return retval;
+}
+
+// In-place division operator.
+template <std::size_t SSize>
+inline integer<SSize> &operator/=(integer<SSize> &rop, const integer_divisor<SSize> &d)
+{
+    return tdiv_q(rop, rop, d);
+}
+
+// Binary modulo operator.
+template <std::size_t SSize>
+inline integer<SSize> operator%(const integer<SSize> &n, const integer_divisor<SSize> &d)
+{
+    integer<SSize> q, r;
+    tdiv_qr(q, r, n, d);
+    return r;
+}
+
+// In-place modulo operator.
+template <std::size_t SSize>
+inline integer<SSize> &operator%=(integer<SSize> &rop, const integer_divisor<SSize> &d)
+{
+    integer<SSize> q;
+    tdiv_qr(q, rop, rop, d);
+    return rop;
+}
+
+MPPP_END_NAMESPACE
+
+#endif
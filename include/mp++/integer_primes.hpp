@@ -0,0 +1,144 @@
+// Copyright 2016-2023 Francesco Biscani (bluescarni@gmail.com)
+//
+// This file is part of the mp++ library.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef MPPP_INTEGER_PRIMES_HPP
+#define MPPP_INTEGER_PRIMES_HPP
+
+#include <mp++/config.hpp>
+
+#include <cstddef>
+#include <iterator>
+#include <vector>
+
+#include <mp++/detail/utils.hpp>
+#include <mp++/detail/visibility.hpp>
+#include <mp++/integer.hpp>
+
+MPPP_BEGIN_NAMESPACE
+
+// Batch primality test.
+template <std::size_t SSize>
+inline void batch_probab_prime_p(std::vector<int> &out, const integer<SSize> *ints, std::size_t n, int reps = 25,
+                                 unsigned nthreads = 1)
+{
+    out.resize(n);
+
+    auto func = [&out, ints, reps](std::size_t, std::size_t begin, std::size_t end) {
+        for (auto i = begin; i != end; ++i) {
+            out[i] = ints[i].probab_prime_p(reps);
+        }
+    };
+    detail::parallel_for_chunks(n, nthreads, func);
+}
+
+// The primes in a range, computed via a segmented sieve.
+class MPPP_DLL_PUBLIC prime_range
+{
+public:
+    // Single-pass iterator over the primes in the range.
+    class iterator
+    {
+        friend class prime_range;
+
+        explicit iterator(prime_range *r) : m_range(r) {}
+
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = unsigned long long;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const unsigned long long *;
+        using reference = const unsigned long long &;
+
+        iterator() = default;
+
+        reference operator*() const
+        {
+            return m_range->m_cur;
+        }
+        pointer operator->() const
+        {
+            return &m_range->m_cur;
+        }
+        iterator &operator++()
+        {
+            m_range->advance();
+            return *this;
+        }
+        // NOTE: as in all input iterators, the post-increment
+        // operator cannot return the previous state.
+        void operator++(int)
+        {
+            m_range->advance();
+        }
+
+        friend bool operator==(const iterator &a, const iterator &b)
+        {
+            return a.is_end() == b.is_end();
+        }
+        friend bool operator!=(const iterator &a, const iterator &b)
+        {
+            return !(a == b);
+        }
+
+    private:
+        MPPP_NODISCARD bool is_end() const
+        {
+            return m_range == nullptr || m_range->m_done;
+        }
+
+        prime_range *m_range = nullptr;
+    };
+
+    explicit prime_range(unsigned long long, unsigned long long);
+
+    // Iterators.
+    // NOTE: begin() points to the next prime
+    // which has not been iterated over yet.
+    iterator begin()
+    {
+        return iterator{this};
+    }
+    static iterator end()
+    {
+        return iterator{};
+    }
+
+private:
+    void advance();
+    void sieve_segment();
+    MPPP_NODISCARD bool sieve_survivor_is_prime(unsigned long long) const;
+
+    // The end of the range.
+    unsigned long long m_end;
+    // The odd primes used in the sieve.
+    std::vector<unsigned long> m_primes;
+    // The primes used in the sieve are all the primes
+    // less than or equal to m_sieve_max.
+    unsigned long long m_sieve_max = 0;
+    // The first odd number in the current segment
+    // and the number of odd numbers in the segment.
+    unsigned long long m_lo = 0;
+    std::size_t m_count = 0;
+    // The sieve for the current segment: the i-th element
+    // is nonzero if m_lo + 2 * i has no factors among m_primes.
+    std::vector<char> m_seg;
+    // The index of the next element of the
+    // current segment to be examined.
+    std::size_t m_idx = 0;
+    // The current prime.
+    unsigned long long m_cur = 0;
+    // Flag signalling that the current segment
+    // is the last one.
+    bool m_last_seg = false;
+    // Flag signalling that the range has been exhausted.
+    bool m_done = false;
+};
+
+MPPP_END_NAMESPACE
+
+#endif
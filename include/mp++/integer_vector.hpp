@@ -0,0 +1,731 @@
+// Copyright 2016-2023 Francesco Biscani (bluescarni@gmail.com)
+//
+// This file is part of the mp++ library.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef MPPP_INTEGER_VECTOR_HPP
+#define MPPP_INTEGER_VECTOR_HPP
+
+#include <mp++/config.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <mp++/detail/gmp.hpp>
+#include <mp++/detail/type_traits.hpp>
+#include <mp++/detail/utils.hpp>
+#include <mp++/integer.hpp>
+
+MPPP_BEGIN_NAMESPACE
+
+template <std::size_t>
+class integer_vector;
+
+namespace detail
+{
+
+template <std::size_t>
+struct integer_vector_impl;
+
+// The branch-free kernels for 1-limb and 2-limb vectors are available
+// if we have a 128-bit signed type and 64-bit limbs with no nails.
+#if defined(MPPP_HAVE_GCC_INT128) && GMP_NUMB_BITS == 64 && !GMP_NAIL_BITS
+
+#define MPPP_INTEGER_VECTOR_HAVE_FAST_KERNELS
+
+#endif
+
+template <typename It>
+using iterator_category_t = typename std::iterator_traits<It>::iterator_category;
+
+template <typename It>
+using iterator_reference_t = typename std::iterator_traits<It>::reference;
+
+// Detect input iterators whose values are convertible to integer<SSize>.
+template <typename It, std::size_t SSize>
+using is_integer_vector_input_iterator
+    = conjunction<std::is_convertible<detected_t<iterator_category_t, It>, std::input_iterator_tag>,
+                  std::is_convertible<detected_t<iterator_reference_t, It>, integer<SSize>>>;
+
+} // namespace detail
+
+// Vector of integers in structure-of-arrays layout.
+template <std::size_t SSize>
+class integer_vector
+{
+    template <std::size_t>
+    friend struct detail::integer_vector_impl;
+
+    using s_storage = detail::static_int<SSize>;
+
+public:
+    // Alias for the template parameter SSize.
+    static constexpr std::size_t ssize = SSize;
+    using size_type = std::size_t;
+    using value_type = integer<SSize>;
+
+    // Default constructor.
+    integer_vector() = default;
+    // Copy/move constructors.
+    integer_vector(const integer_vector &) = default;
+    integer_vector(integer_vector &&) noexcept = default;
+    // Constructor from size: the elements are inited to zero.
+    explicit integer_vector(size_type n) : m_sizes(n), m_limbs(limbs_size(n)) {}
+    // Constructor from size and value.
+    explicit integer_vector(size_type n, const integer<SSize> &value) : integer_vector(n)
+    {
+        for (size_type i = 0; i < n; ++i) {
+            store(i, value);
+        }
+    }
+    // Constructor from a range of integers.
+    template <typename It, detail::enable_if_t<detail::is_integer_vector_input_iterator<It, SSize>::value, int> = 0>
+    explicit integer_vector(It begin, It end)
+    {
+        for (; begin != end; ++begin) {
+            push_back(*begin);
+        }
+    }
+    // Constructor from an initializer list of integers.
+    integer_vector(std::initializer_list<integer<SSize>> l) : integer_vector(l.begin(), l.end()) {}
+    ~integer_vector() = default;
+    // Copy/move assignment.
+    integer_vector &operator=(const integer_vector &) = default;
+    integer_vector &operator=(integer_vector &&) noexcept = default;
+
+    // Number of elements.
+    MPPP_NODISCARD size_type size() const
+    {
+        return m_sizes.size();
+    }
+    // Test if the vector is empty.
+    MPPP_NODISCARD bool empty() const
+    {
+        return m_sizes.empty();
+    }
+    // Reserve storage for n elements.
+    void reserve(size_type n)
+    {
+        m_sizes.reserve(n);
+        m_limbs.reserve(limbs_size(n));
+    }
+    // Resize: new elements are inited to zero.
+    void resize(size_type n)
+    {
+        for (auto i = n; i < size(); ++i) {
+            if (m_sizes[i] == dyn_tag) {
+                release_dyn(i);
+            }
+        }
+        m_sizes.resize(n);
+        m_limbs.resize(limbs_size(n));
+    }
+    // Remove all elements.
+    void clear()
+    {
+        m_sizes.clear();
+        m_limbs.clear();
+        m_dyn.clear();
+        m_free.clear();
+    }
+    // Append an element.
+    void push_back(const integer<SSize> &n)
+    {
+        // NOTE: resize first, so that the new element
+        // is a valid zero before store() is invoked.
+        resize(size() + 1u);
+        store(size() - 1u, n);
+    }
+    // Test if the i-th element is stored in static storage.
+    MPPP_NODISCARD bool is_static(size_type i) const
+    {
+        return m_sizes[check_idx(i)] != dyn_tag;
+    }
+    // Get a copy of the i-th element.
+    MPPP_NODISCARD integer<SSize> get(size_type i) const
+    {
+        return load(check_idx(i));
+    }
+    // Set the i-th element.
+    void set(size_type i, const integer<SSize> &n)
+    {
+        store(check_idx(i), n);
+    }
+    // Convert to a vector of integers.
+    MPPP_NODISCARD std::vector<integer<SSize>> to_vector() const
+    {
+        std::vector<integer<SSize>> retval;
+        retval.reserve(size());
+        for (size_type i = 0; i < size(); ++i) {
+            retval.push_back(load(i));
+        }
+        return retval;
+    }
+
+private:
+    // Special size value signalling that an element has been promoted
+    // to dynamic storage. For such elements, the first limb stores
+    // the index of the element in m_dyn.
+    static constexpr detail::mpz_size_t dyn_tag = detail::nl_min<detail::mpz_size_t>();
+
+    static size_type limbs_size(size_type n)
+    {
+        // LCOV_EXCL_START
+        if (mppp_unlikely(n > detail::nl_max<size_type>() / SSize)) {
+            throw std::overflow_error(
+                "Overflow in the computation of the size of the limbs array of an integer_vector");
+        }
+        // LCOV_EXCL_STOP
+        return n * SSize;
+    }
+    size_type check_idx(size_type i) const
+    {
+        if (mppp_unlikely(i >= size())) {
+            throw std::out_of_range("Cannot access the element at index " + detail::to_string(i)
+                                    + " of an integer_vector of size " + detail::to_string(size()));
+        }
+        return i;
+    }
+    ::mp_limb_t *limbs_ptr(size_type i)
+    {
+        return m_limbs.data() + i * SSize;
+    }
+    MPPP_NODISCARD const ::mp_limb_t *limbs_ptr(size_type i) const
+    {
+        return m_limbs.data() + i * SSize;
+    }
+    MPPP_NODISCARD size_type dyn_idx(size_type i) const
+    {
+        assert(m_sizes[i] == dyn_tag);
+        return static_cast<size_type>(m_limbs[i * SSize]);
+    }
+    // Release the dynamic storage of the i-th element. The element
+    // will be left in an invalid state, to be overwritten by the caller.
+    void release_dyn(size_type i)
+    {
+        const auto idx = dyn_idx(i);
+        // NOTE: set the storage to zero in order to free
+        // its memory right away.
+        m_dyn[idx].set_zero();
+        m_free.push_back(idx);
+    }
+    // Load the i-th element as a static integer. The element must be static.
+    MPPP_NODISCARD s_storage load_static(size_type i) const
+    {
+        const auto size = m_sizes[i];
+        assert(size != dyn_tag);
+        return s_storage{size, limbs_ptr(i), static_cast<std::size_t>(size >= 0 ? size : -size)};
+    }
+    MPPP_NODISCARD integer<SSize> load(size_type i) const
+    {
+        if (m_sizes[i] == dyn_tag) {
+            return m_dyn[dyn_idx(i)];
+        }
+        integer<SSize> retval;
+        retval._get_union().g_st() = load_static(i);
+        return retval;
+    }
+    // Store a static integer (represented by its signed size and limbs) into the i-th element.
+    void store_static(size_type i, detail::mpz_size_t size, const ::mp_limb_t *p)
+    {
+        if (m_sizes[i] == dyn_tag) {
+            release_dyn(i);
+        }
+        const auto asize = static_cast<std::size_t>(size >= 0 ? size : -size);
+        assert(asize <= SSize);
+        auto out = limbs_ptr(i);
+        detail::copy_limbs(p, p + asize, out);
+        // NOTE: the unused limbs are always kept to zero.
+        std::fill(out + asize, out + SSize, ::mp_limb_t(0));
+        m_sizes[i] = size;
+    }
+    void store(size_type i, const integer<SSize> &n)
+    {
+        if (n.is_static()) {
+            const auto &st = n._get_union().g_st();
+            store_static(i, st._mp_size, st.m_limbs.data());
+        } else if (n.size() <= SSize) {
+            // NOTE: dynamic values which fit in static storage
+            // are always stored in the limbs array.
+            const auto &dy = n._get_union().g_dy();
+            store_static(i, dy._mp_size, dy._mp_d);
+        } else if (m_sizes[i] == dyn_tag) {
+            m_dyn[dyn_idx(i)] = n;
+        } else {
+            // Fetch a free slot in m_dyn, or create a new one.
+            size_type idx;
+            if (m_free.empty()) {
+                idx = m_dyn.size();
+                m_dyn.push_back(n);
+            } else {
+                idx = m_free.back();
+                m_dyn[idx] = n;
+                m_free.pop_back();
+            }
+            auto out = limbs_ptr(i);
+            std::fill(out, out + SSize, ::mp_limb_t(0));
+            out[0] = static_cast<::mp_limb_t>(idx);
+            m_sizes[i] = dyn_tag;
+        }
+    }
+
+    // Signed sizes of the elements.
+    std::vector<detail::mpz_size_t> m_sizes;
+    // The limbs of the elements, SSize limbs per element.
+    std::vector<::mp_limb_t> m_limbs;
+    // Storage for the elements promoted to dynamic storage.
+    std::vector<integer<SSize>> m_dyn;
+    // Unused slots in m_dyn.
+    std::vector<size_type> m_free;
+};
+
+#if MPPP_CPLUSPLUS < 201703L
+
+// NOTE: see the explanation in integer.hpp regarding static constexpr variables in C++17.
+
+template <std::size_t SSize>
+constexpr std::size_t integer_vector<SSize>::ssize;
+
+template <std::size_t SSize>
+constexpr detail::mpz_size_t integer_vector<SSize>::dyn_tag;
+
+#endif
+
+namespace detail
+{
+
+template <std::size_t SSize>
+struct integer_vector_impl {
+    using vec_t = integer_vector<SSize>;
+    using size_type = typename vec_t::size_type;
+
+    static void check_sizes(const vec_t &a, const vec_t &b, const char *name)
+    {
+        if (mppp_unlikely(a.size() != b.size())) {
+            throw std::invalid_argument(std::string("Cannot compute the ") + name
+                                        + " of two integer vectors with different sizes (" + to_string(a.size())
+                                        + " and " + to_string(b.size()) + ")");
+        }
+    }
+    // Prepare rop for an elementwise operation on vectors of size n.
+    static void prepare_rop(vec_t &rop, size_type n)
+    {
+        if (rop.size() != n) {
+            rop.resize(n);
+        }
+    }
+
+    // Elementwise evaluation via the integer API. This is used
+    // for the elements that cannot be computed by the fast kernels.
+    // Op: 0 for add, 1 for sub, 2 for mul, 3 for addmul.
+    template <int Op>
+    static void elementwise_generic(vec_t &rop, const vec_t &a, const vec_t &b, size_type i)
+    {
+        const auto x = a.load(i), y = b.load(i);
+        // NOLINTNEXTLINE(cppcoreguidelines-init-variables)
+        integer<SSize> tmp;
+        switch (Op) {
+            case 0:
+                add(tmp, x, y);
+                break;
+            case 1:
+                sub(tmp, x, y);
+                break;
+            case 2:
+                mul(tmp, x, y);
+                break;
+            default:
+                tmp = rop.load(i);
+                addmul(tmp, x, y);
+        }
+        rop.store(i, tmp);
+    }
+
+    // Elementwise evaluation via the static primitives, with fallback to the integer API
+    // for dynamic elements and for results which do not fit in static storage.
+    // Tag type for the selection of the kernels: 0 for the generic
+    // kernels, otherwise the number of limbs of the branch-free kernels.
+    template <std::size_t N>
+    using kernel_tag = std::integral_constant<std::size_t, N>;
+
+    template <int Op>
+    static void elementwise(vec_t &rop, const vec_t &a, const vec_t &b, const kernel_tag<0> &)
+    {
+        const auto n = a.size();
+        for (size_type i = 0; i < n; ++i) {
+            if (a.m_sizes[i] != vec_t::dyn_tag && b.m_sizes[i] != vec_t::dyn_tag
+                && rop.m_sizes[i] != vec_t::dyn_tag) {
+                const auto x = a.load_static(i), y = b.load_static(i);
+                auto r = (Op == 3) ? rop.load_static(i) : static_int<SSize>{};
+                bool ok;
+                switch (Op) {
+                    case 0:
+                        ok = static_addsub<true>(r, x, y);
+                        break;
+                    case 1:
+                        ok = static_addsub<false>(r, x, y);
+                        break;
+                    case 2:
+                        ok = static_mul(r, x, y) == 0u;
+                        break;
+                    default:
+                        ok = static_addsubmul<true>(r, x, y) == 0u;
+                }
+                if (mppp_likely(ok)) {
+                    rop.store_static(i, r._mp_size, r.m_limbs.data());
+                    continue;
+                }
+            }
+            elementwise_generic<Op>(rop, a, b, i);
+        }
+    }
+
+#if defined(MPPP_INTEGER_VECTOR_HAVE_FAST_KERNELS)
+
+    // Branch-free kernels for 1-limb vectors. The elements that cannot be computed
+    // in static storage (because they are dynamic or because the result overflows)
+    // are left untouched in rop, and their indices are recorded in fidx. They will
+    // then be computed with the generic primitives.
+    template <int Op>
+    static void elementwise(vec_t &rop, const vec_t &a, const vec_t &b, const kernel_tag<1> &)
+    {
+        const auto n = a.size();
+
+        MPPP_MAYBE_TLS std::vector<size_type> fidx;
+        fidx.resize(n);
+        size_type nf = 0;
+
+        const auto sa_ptr = a.m_sizes.data(), sb_ptr = b.m_sizes.data();
+        const auto la_ptr = a.m_limbs.data(), lb_ptr = b.m_limbs.data();
+        const auto sr_ptr = rop.m_sizes.data();
+        const auto lr_ptr = rop.m_limbs.data();
+
+        for (size_type i = 0; i < n; ++i) {
+            const auto sa_raw = sa_ptr[i], sb_raw = sb_ptr[i], sr_raw = sr_ptr[i];
+            const ::mp_limb_t la = la_ptr[i], lb = lb_ptr[i], lr = lr_ptr[i];
+            const bool dyn = (sa_raw == vec_t::dyn_tag) | (sb_raw == vec_t::dyn_tag) | (sr_raw == vec_t::dyn_tag);
+            // NOTE: zero out the sizes of dynamic elements, so that the computations
+            // below are well defined. Their results will be discarded anyway.
+            const mpz_size_t sa = dyn ? 0 : sa_raw, sb = dyn ? 0 : sb_raw, sr = dyn ? 0 : sr_raw;
+
+            // NOLINTNEXTLINE(cppcoreguidelines-init-variables)
+            bool overflow;
+            // NOLINTNEXTLINE(cppcoreguidelines-init-variables)
+            mpz_size_t rsize;
+            // NOLINTNEXTLINE(cppcoreguidelines-init-variables)
+            ::mp_limb_t rlimb;
+            if (Op == 2) {
+                const auto p = static_cast<__uint128_t>(la) * lb;
+                rlimb = static_cast<::mp_limb_t>(p);
+                overflow = (p >> 64) != 0u;
+                rsize = sa * sb;
+            } else {
+                // NOTE: in the addmul case the product is folded into the signed 128-bit
+                // computation only if it is small enough, otherwise the result overflows anyway.
+                const auto p = static_cast<__uint128_t>(la) * lb;
+                const bool p_overflow = Op == 3 && (p >> 64) > 1u;
+                const auto x = static_cast<__int128_t>(Op == 3 ? sr : sa) * static_cast<__int128_t>(Op == 3 ? lr : la);
+                const auto y = (Op == 3)
+                                   ? static_cast<__int128_t>(sa * sb) * static_cast<__int128_t>(p_overflow ? 0u : p)
+                                   : static_cast<__int128_t>(sb) * static_cast<__int128_t>(lb);
+                const auto s = (Op == 1) ? x - y : x + y;
+                const bool neg = s < 0;
+                const auto mag = neg ? -static_cast<__uint128_t>(s) : static_cast<__uint128_t>(s);
+                rlimb = static_cast<::mp_limb_t>(mag);
+                overflow = p_overflow || (mag >> 64) != 0u;
+                rsize = static_cast<mpz_size_t>(rlimb != 0u) * (neg ? -1 : 1);
+            }
+
+            const bool fail = dyn | overflow;
+            sr_ptr[i] = fail ? sr_raw : rsize;
+            lr_ptr[i] = fail ? lr : rlimb;
+            fidx[nf] = i;
+            nf += static_cast<size_type>(fail);
+        }
+
+        for (size_type j = 0; j < nf; ++j) {
+            elementwise_generic<Op>(rop, a, b, fidx[j]);
+        }
+    }
+
+    // Sign of a (static) signed size.
+    static int size_sign(mpz_size_t s)
+    {
+        return static_cast<int>(s > 0) - static_cast<int>(s < 0);
+    }
+
+    // Product of the 2-limb magnitudes (a0, a1) and (b0, b1). The result is written
+    // into p, and true is returned if it does not fit in 2 limbs.
+    static bool mul_2limbs(__uint128_t &p, ::mp_limb_t a0, ::mp_limb_t a1, ::mp_limb_t b0, ::mp_limb_t b1)
+    {
+        const auto p00 = static_cast<__uint128_t>(a0) * b0;
+        // NOTE: if both a1 and b1 are nonzero the product overflows, and the
+        // value of cross does not matter. Otherwise, one of the two terms is zero.
+        const auto cross = static_cast<__uint128_t>(a1) * b0 + static_cast<__uint128_t>(a0) * b1;
+        const auto hi = (p00 >> 64) + static_cast<::mp_limb_t>(cross);
+        p = static_cast<__uint128_t>(static_cast<::mp_limb_t>(p00)) | (hi << 64);
+        return ((a1 != 0u) & (b1 != 0u)) | ((cross >> 64) != 0u) | ((hi >> 64) != 0u);
+    }
+
+    // Branch-free kernels for 2-limb vectors. The values are handled as signs and 128-bit
+    // magnitudes, and the failures are dealt with as in the 1-limb kernels.
+    template <int Op>
+    static void elementwise(vec_t &rop, const vec_t &a, const vec_t &b, const kernel_tag<2> &)
+    {
+        const auto n = a.size();
+
+        MPPP_MAYBE_TLS std::vector<size_type> fidx;
+        fidx.resize(n);
+        size_type nf = 0;
+
+        const auto sa_ptr = a.m_sizes.data(), sb_ptr = b.m_sizes.data();
+        const auto la_ptr = a.m_limbs.data(), lb_ptr = b.m_limbs.data();
+        const auto sr_ptr = rop.m_sizes.data();
+        const auto lr_ptr = rop.m_limbs.data();
+
+        for (size_type i = 0; i < n; ++i) {
+            const auto sa_raw = sa_ptr[i], sb_raw = sb_ptr[i], sr_raw = sr_ptr[i];
+            const ::mp_limb_t la0 = la_ptr[2u * i], la1 = la_ptr[2u * i + 1u], lb0 = lb_ptr[2u * i],
+                              lb1 = lb_ptr[2u * i + 1u], lr0 = lr_ptr[2u * i], lr1 = lr_ptr[2u * i + 1u];
+            const bool dyn = (sa_raw == vec_t::dyn_tag) | (sb_raw == vec_t::dyn_tag) | (sr_raw == vec_t::dyn_tag);
+            // NOTE: as in the 1-limb kernels, the results for dynamic elements are discarded.
+            const int sa = dyn ? 0 : size_sign(sa_raw), sb = dyn ? 0 : size_sign(sb_raw),
+                      sr = dyn ? 0 : size_sign(sr_raw);
+
+            // NOLINTNEXTLINE(cppcoreguidelines-init-variables)
+            __uint128_t p;
+            const bool p_overflow = (Op >= 2) && mul_2limbs(p, la0, la1, lb0, lb1);
+
+            // NOLINTNEXTLINE(cppcoreguidelines-init-variables)
+            bool overflow;
+            // NOLINTNEXTLINE(cppcoreguidelines-init-variables)
+            int rsign;
+            // NOLINTNEXTLINE(cppcoreguidelines-init-variables)
+            __uint128_t mag;
+            if (Op == 2) {
+                mag = p;
+                rsign = sa * sb;
+                overflow = p_overflow;
+            } else {
+                // Signed addition of (sx, x) and (sy, y).
+                const int sx = (Op == 3) ? sr : sa;
+                const int sy = (Op == 3) ? sa * sb : ((Op == 1) ? -sb : sb);
+                const auto x = (Op == 3) ? (static_cast<__uint128_t>(lr0) | (static_cast<__uint128_t>(lr1) << 64))
+                                         : (static_cast<__uint128_t>(la0) | (static_cast<__uint128_t>(la1) << 64));
+                const auto y = (Op == 3) ? p : (static_cast<__uint128_t>(lb0) | (static_cast<__uint128_t>(lb1) << 64));
+                const bool same = sx * sy >= 0, ge = x >= y;
+                const auto sum = x + y;
+                mag = same ? sum : (ge ? x - y : y - x);
+                rsign = same ? (sx != 0 ? sx : sy) : (ge ? sx : sy);
+                overflow = p_overflow | (same & (sum < x));
+            }
+            const auto rlo = static_cast<::mp_limb_t>(mag), rhi = static_cast<::mp_limb_t>(mag >> 64);
+            const auto rsize = static_cast<mpz_size_t>(static_cast<mpz_size_t>(rhi != 0u ? 2 : (rlo != 0u)) * rsign);
+
+            const bool fail = dyn | overflow;
+            sr_ptr[i] = fail ? sr_raw : rsize;
+            lr_ptr[2u * i] = fail ? lr0 : rlo;
+            lr_ptr[2u * i + 1u] = fail ? lr1 : rhi;
+            fidx[nf] = i;
+            nf += static_cast<size_type>(fail);
+        }
+
+        for (size_type j = 0; j < nf; ++j) {
+            elementwise_generic<Op>(rop, a, b, fidx[j]);
+        }
+    }
+
+#endif
+
+    using kernel_t = kernel_tag<
+#if defined(MPPP_INTEGER_VECTOR_HAVE_FAST_KERNELS)
+        (SSize <= 2u) ? SSize : 0u
+#else
+        0u
+#endif
+        >;
+
+    template <int Op>
+    static vec_t &binary_op(vec_t &rop, const vec_t &a, const vec_t &b, const char *name)
+    {
+        check_sizes(a, b, name);
+        if (Op == 3) {
+            check_sizes(rop, a, name);
+        } else {
+            prepare_rop(rop, a.size());
+        }
+        elementwise<Op>(rop, a, b, kernel_t{});
+        return rop;
+    }
+
+    static integer<SSize> dot(const vec_t &a, const vec_t &b, const kernel_tag<0> &)
+    {
+        integer<SSize> retval;
+        const auto n = a.size();
+        for (size_type i = 0; i < n; ++i) {
+            if (a.m_sizes[i] != vec_t::dyn_tag && b.m_sizes[i] != vec_t::dyn_tag && retval.is_static()) {
+                const auto x = a.load_static(i), y = b.load_static(i);
+                const auto size_hint = static_addsubmul<true>(retval._get_union().g_st(), x, y);
+                if (mppp_likely(size_hint == 0u)) {
+                    continue;
+                }
+                retval._get_union().promote(size_hint);
+            }
+            addmul(retval, a.load(i), b.load(i));
+        }
+        return retval;
+    }
+
+#if defined(MPPP_INTEGER_VECTOR_HAVE_FAST_KERNELS)
+
+    // Build an integer from a 3-limb unsigned magnitude.
+    static integer<SSize> from_3_limbs(__uint128_t lo, ::mp_limb_t hi)
+    {
+        const std::array<::mp_limb_t, 3> tmp{{static_cast<::mp_limb_t>(lo), static_cast<::mp_limb_t>(lo >> 64), hi}};
+        std::size_t size = 3;
+        for (; size > 0u && tmp[size - 1u] == 0u; --size) {
+        }
+        return integer<SSize>{tmp.data(), size};
+    }
+
+    // Branch-free dot product for 1-limb vectors. The products are accumulated
+    // in two unsigned 3-limb accumulators, one for the positive products and one for the negative
+    // products. The pairs involving dynamic elements are accumulated at the end.
+    static integer<SSize> dot(const vec_t &a, const vec_t &b, const kernel_tag<1> &)
+    {
+        const auto n = a.size();
+
+        MPPP_MAYBE_TLS std::vector<size_type> fidx;
+        fidx.resize(n);
+        size_type nf = 0;
+
+        const auto sa_ptr = a.m_sizes.data(), sb_ptr = b.m_sizes.data();
+        const auto la_ptr = a.m_limbs.data(), lb_ptr = b.m_limbs.data();
+
+        __uint128_t pos = 0, neg = 0;
+        ::mp_limb_t pos_c = 0, neg_c = 0;
+
+        for (size_type i = 0; i < n; ++i) {
+            const auto sa_raw = sa_ptr[i], sb_raw = sb_ptr[i];
+            const bool dyn = (sa_raw == vec_t::dyn_tag) | (sb_raw == vec_t::dyn_tag);
+            const auto sp = dyn ? 0 : sa_raw * sb_raw;
+            const auto p = static_cast<__uint128_t>(la_ptr[i]) * lb_ptr[i];
+            const auto pp = sp > 0 ? p : __uint128_t(0), pn = sp < 0 ? p : __uint128_t(0);
+            pos += pp;
+            pos_c += static_cast<::mp_limb_t>(pos < pp);
+            neg += pn;
+            neg_c += static_cast<::mp_limb_t>(neg < pn);
+            fidx[nf] = i;
+            nf += static_cast<size_type>(dyn);
+        }
+
+        auto retval = from_3_limbs(pos, pos_c);
+        sub(retval, retval, from_3_limbs(neg, neg_c));
+        for (size_type j = 0; j < nf; ++j) {
+            addmul(retval, a.load(fidx[j]), b.load(fidx[j]));
+        }
+        return retval;
+    }
+
+    // Branch-free dot product for 2-limb vectors. As in the 1-limb version, the products
+    // are accumulated in two 3-limb accumulators. The pairs involving dynamic elements
+    // and the products which do not fit in 2 limbs are accumulated at the end.
+    static integer<SSize> dot(const vec_t &a, const vec_t &b, const kernel_tag<2> &)
+    {
+        const auto n = a.size();
+
+        MPPP_MAYBE_TLS std::vector<size_type> fidx;
+        fidx.resize(n);
+        size_type nf = 0;
+
+        const auto sa_ptr = a.m_sizes.data(), sb_ptr = b.m_sizes.data();
+        const auto la_ptr = a.m_limbs.data(), lb_ptr = b.m_limbs.data();
+
+        __uint128_t pos = 0, neg = 0;
+        ::mp_limb_t pos_c = 0, neg_c = 0;
+
+        for (size_type i = 0; i < n; ++i) {
+            const auto sa_raw = sa_ptr[i], sb_raw = sb_ptr[i];
+            // NOLINTNEXTLINE(cppcoreguidelines-init-variables)
+            __uint128_t p;
+            const bool overflow
+                = mul_2limbs(p, la_ptr[2u * i], la_ptr[2u * i + 1u], lb_ptr[2u * i], lb_ptr[2u * i + 1u]);
+            const bool fail = (sa_raw == vec_t::dyn_tag) | (sb_raw == vec_t::dyn_tag) | overflow;
+            const auto sp = fail ? 0 : size_sign(sa_raw) * size_sign(sb_raw);
+            const auto pp = sp > 0 ? p : __uint128_t(0), pn = sp < 0 ? p : __uint128_t(0);
+            pos += pp;
+            pos_c += static_cast<::mp_limb_t>(pos < pp);
+            neg += pn;
+            neg_c += static_cast<::mp_limb_t>(neg < pn);
+            fidx[nf] = i;
+            nf += static_cast<size_type>(fail);
+        }
+
+        auto retval = from_3_limbs(pos, pos_c);
+        sub(retval, retval, from_3_limbs(neg, neg_c));
+        for (size_type j = 0; j < nf; ++j) {
+            addmul(retval, a.load(fidx[j]), b.load(fidx[j]));
+        }
+        return retval;
+    }
+
+#endif
+};
+
+} // namespace detail
+
+// Elementwise addition.
+template <std::size_t SSize>
+inline integer_vector<SSize> &add(integer_vector<SSize> &rop, const integer_vector<SSize> &a,
+                                  const integer_vector<SSize> &b)
+{
+    return detail::integer_vector_impl<SSize>::template binary_op<0>(rop, a, b, "sum");
+}
+
+// Elementwise subtraction.
+template <std::size_t SSize>
+inline integer_vector<SSize> &sub(integer_vector<SSize> &rop, const integer_vector<SSize> &a,
+                                  const integer_vector<SSize> &b)
+{
+    return detail::integer_vector_impl<SSize>::template binary_op<1>(rop, a, b, "difference");
+}
+
+// Elementwise multiplication.
+template <std::size_t SSize>
+inline integer_vector<SSize> &mul(integer_vector<SSize> &rop, const integer_vector<SSize> &a,
+                                  const integer_vector<SSize> &b)
+{
+    return detail::integer_vector_impl<SSize>::template binary_op<2>(rop, a, b, "product");
+}
+
+// Elementwise multiply-add.
+template <std::size_t SSize>
+inline integer_vector<SSize> &addmul(integer_vector<SSize> &rop, const integer_vector<SSize> &a,
+                                     const integer_vector<SSize> &b)
+{
+    return detail::integer_vector_impl<SSize>::template binary_op<3>(rop, a, b, "multiply-add");
+}
+
+// Dot product.
+template <std::size_t SSize>
+inline integer<SSize> dot(const integer_vector<SSize> &a, const integer_vector<SSize> &b)
+{
+    detail::integer_vector_impl<SSize>::check_sizes(a, b, "dot product");
+    return detail::integer_vector_impl<SSize>::dot(a, b, typename detail::integer_vector_impl<SSize>::kernel_t{});
+}
+
+MPPP_END_NAMESPACE
+
+#endif
@@ -0,0 +1,684 @@
+// Copyright 2016-2023 Francesco Biscani (bluescarni@gmail.com)
+//
+// This file is part of the mp++ library.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef MPPP_LAZY_HPP
+#define MPPP_LAZY_HPP
+
+#include <mp++/config.hpp>
+
+#if defined(MPPP_WITH_MPFR)
+
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include <mp++/detail/mpfr.hpp>
+#include <mp++/detail/type_traits.hpp>
+#include <mp++/detail/utils.hpp>
+#include <mp++/real.hpp>
+
+#if defined(MPPP_WITH_MPC)
+
+#include <mp++/complex.hpp>
+#include <mp++/detail/mpc.hpp>
+
+#endif
+
+MPPP_BEGIN_NAMESPACE
+
+namespace detail
+{
+
+// The lazy evaluation layer builds expression trees out of real (or complex) operands.
+// The leaves of the trees are either references to lvalues (lazy_cref) or values
+// moved in from rvalues (lazy_val). The inner nodes (lazy_expr) are tagged
+// with the operation to be performed. Multiplications followed by an addition/subtraction
+// are fused at construction time into a single node.
+//
+// An expression tree is evaluated when it is converted to real (or complex). All the nodes
+// are evaluated with the largest precision among the leaves. The evaluation
+// proceeds as follows:
+//
+// - the return value is stolen from a lazy_val leaf with the target precision
+//   if possible, otherwise it is created anew;
+// - in each node, the first operand which is not a leaf is evaluated directly
+//   into the return value, the other non-leaf operands are evaluated into temporaries
+//   (which are in turn stolen from their own leaves if possible);
+// - the operation of each node is performed with a single function call (or, in
+//   the fallback implementations, with a final function call which reads the operands
+//   only after any temporary has been computed), so that it is safe for the return value
+//   to overlap with an operand.
+//
+// In order for the above to be correct, the leaf the return value is stolen from must be
+// an operand of the first node to be evaluated. Thus, steal() follows the same path
+// followed by the evaluation of the first non-leaf operands.
+
+// Traits for the value types supported in the lazy evaluation layer.
+template <typename>
+struct lazy_traits;
+
+template <>
+struct lazy_traits<real> {
+    using struct_t = mpfr_struct_t;
+
+    static const struct_t *get(const real &x)
+    {
+        return x.get_mpfr_t();
+    }
+    static real make(::mpfr_prec_t p)
+    {
+        return real{real_kind::zero, p};
+    }
+    static void set(real &rop, const struct_t *a)
+    {
+        mpfr_set(rop._get_mpfr_t(), a, MPFR_RNDN);
+    }
+    static void add(real &rop, ::mpfr_prec_t, const struct_t *a, const struct_t *b)
+    {
+        ::mpfr_add(rop._get_mpfr_t(), a, b, MPFR_RNDN);
+    }
+    static void sub(real &rop, ::mpfr_prec_t, const struct_t *a, const struct_t *b)
+    {
+        ::mpfr_sub(rop._get_mpfr_t(), a, b, MPFR_RNDN);
+    }
+    static void mul(real &rop, ::mpfr_prec_t, const struct_t *a, const struct_t *b)
+    {
+        ::mpfr_mul(rop._get_mpfr_t(), a, b, MPFR_RNDN);
+    }
+    static void div(real &rop, ::mpfr_prec_t, const struct_t *a, const struct_t *b)
+    {
+        ::mpfr_div(rop._get_mpfr_t(), a, b, MPFR_RNDN);
+    }
+    // a*b+c.
+    static void fma(real &rop, ::mpfr_prec_t, const struct_t *a, const struct_t *b, const struct_t *c)
+    {
+        ::mpfr_fma(rop._get_mpfr_t(), a, b, c, MPFR_RNDN);
+    }
+    // a*b-c.
+    static void fms(real &rop, ::mpfr_prec_t, const struct_t *a, const struct_t *b, const struct_t *c)
+    {
+        ::mpfr_fms(rop._get_mpfr_t(), a, b, c, MPFR_RNDN);
+    }
+    // c-a*b.
+    static void nfms(real &rop, ::mpfr_prec_t, const struct_t *a, const struct_t *b, const struct_t *c)
+    {
+        // NOTE: the negation is exact, thus there is still a single rounding.
+        ::mpfr_fms(rop._get_mpfr_t(), a, b, c, MPFR_RNDN);
+        ::mpfr_neg(rop._get_mpfr_t(), rop.get_mpfr_t(), MPFR_RNDN);
+    }
+#if MPFR_VERSION_MAJOR >= 4
+    // a*b+c*d.
+    static void fmma(real &rop, ::mpfr_prec_t, const struct_t *a, const struct_t *b, const struct_t *c,
+                     const struct_t *d)
+    {
+        ::mpfr_fmma(rop._get_mpfr_t(), a, b, c, d, MPFR_RNDN);
+    }
+    // a*b-c*d.
+    static void fmms(real &rop, ::mpfr_prec_t, const struct_t *a, const struct_t *b, const struct_t *c,
+                     const struct_t *d)
+    {
+        ::mpfr_fmms(rop._get_mpfr_t(), a, b, c, d, MPFR_RNDN);
+    }
+#else
+    // NOTE: mpfr_fmma() and mpfr_fmms() are available only since MPFR 4. In earlier
+    // versions, compute one of the products exactly in a temporary and then use
+    // a single fma/fms, so that there is still a single rounding.
+    static real &exact_product(const struct_t *a, const struct_t *b)
+    {
+        MPPP_MAYBE_TLS real tmp;
+        tmp.set_prec(c_min(mpfr_get_prec(a) + mpfr_get_prec(b), real_prec_max()));
+        ::mpfr_mul(tmp._get_mpfr_t(), a, b, MPFR_RNDN);
+        return tmp;
+    }
+    static void fmma(real &rop, ::mpfr_prec_t, const struct_t *a, const struct_t *b, const struct_t *c,
+                     const struct_t *d)
+    {
+        const auto &ab = exact_product(a, b);
+        ::mpfr_fma(rop._get_mpfr_t(), c, d, ab.get_mpfr_t(), MPFR_RNDN);
+    }
+    static void fmms(real &rop, ::mpfr_prec_t, const struct_t *a, const struct_t *b, const struct_t *c,
+                     const struct_t *d)
+    {
+        const auto &cd = exact_product(c, d);
+        ::mpfr_fms(rop._get_mpfr_t(), a, b, cd.get_mpfr_t(), MPFR_RNDN);
+    }
+#endif
+};
+
+#if defined(MPPP_WITH_MPC)
+
+template <>
+struct lazy_traits<complex> {
+    using struct_t = mpc_struct_t;
+
+    static const struct_t *get(const complex &x)
+    {
+        return x.get_mpc_t();
+    }
+    static complex make(::mpfr_prec_t p)
+    {
+        return complex{0, complex_prec_t(p)};
+    }
+    static void set(complex &rop, const struct_t *a)
+    {
+        ::mpc_set(rop._get_mpc_t(), a, MPC_RNDNN);
+    }
+    static void add(complex &rop, ::mpfr_prec_t, const struct_t *a, const struct_t *b)
+    {
+        ::mpc_add(rop._get_mpc_t(), a, b, MPC_RNDNN);
+    }
+    static void sub(complex &rop, ::mpfr_prec_t, const struct_t *a, const struct_t *b)
+    {
+        ::mpc_sub(rop._get_mpc_t(), a, b, MPC_RNDNN);
+    }
+    static void mul(complex &rop, ::mpfr_prec_t, const struct_t *a, const struct_t *b)
+    {
+        ::mpc_mul(rop._get_mpc_t(), a, b, MPC_RNDNN);
+    }
+    static void div(complex &rop, ::mpfr_prec_t, const struct_t *a, const struct_t *b)
+    {
+        ::mpc_div(rop._get_mpc_t(), a, b, MPC_RNDNN);
+    }
+    static void fma(complex &rop, ::mpfr_prec_t, const struct_t *a, const struct_t *b, const struct_t *c)
+    {
+        ::mpc_fma(rop._get_mpc_t(), a, b, c, MPC_RNDNN);
+    }
+    // NOTE: MPC provides only mpc_fma(). The other fused operations are implemented
+    // on top of it with a thread-local temporary with precision p. p is never smaller than
+    // the precision of the operands, thus the negations below are exact.
+    static complex &tmp(::mpfr_prec_t p)
+    {
+        MPPP_MAYBE_TLS complex t;
+        t.set_prec(p);
+        return t;
+    }
+    static void fms(complex &rop, ::mpfr_prec_t p, const struct_t *a, const struct_t *b, const struct_t *c)
+    {
+        auto &t = tmp(p);
+        ::mpc_neg(t._get_mpc_t(), c, MPC_RNDNN);
+        ::mpc_fma(rop._get_mpc_t(), a, b, t.get_mpc_t(), MPC_RNDNN);
+    }
+    static void nfms(complex &rop, ::mpfr_prec_t p, const struct_t *a, const struct_t *b, const struct_t *c)
+    {
+        auto &t = tmp(p);
+        ::mpc_neg(t._get_mpc_t(), a, MPC_RNDNN);
+        ::mpc_fma(rop._get_mpc_t(), t.get_mpc_t(), b, c, MPC_RNDNN);
+    }
+    // NOTE: unlike in the real case, fmma and fmms round twice: the product a*b (or c*d)
+    // is rounded to precision p before being passed to mpc_fma(). An exact product
+    // is not practical, as its real and imaginary parts are sums of two products,
+    // whose exact representation may require an unbounded precision.
+    static void fmma(complex &rop, ::mpfr_prec_t p, const struct_t *a, const struct_t *b, const struct_t *c,
+                     const struct_t *d)
+    {
+        auto &t = tmp(p);
+        ::mpc_mul(t._get_mpc_t(), a, b, MPC_RNDNN);
+        ::mpc_fma(rop._get_mpc_t(), c, d, t.get_mpc_t(), MPC_RNDNN);
+    }
+    static void fmms(complex &rop, ::mpfr_prec_t p, const struct_t *a, const struct_t *b, const struct_t *c,
+                     const struct_t *d)
+    {
+        auto &t = tmp(p);
+        ::mpc_mul(t._get_mpc_t(), c, d, MPC_RNDNN);
+        ::mpc_neg(t._get_mpc_t(), t.get_mpc_t(), MPC_RNDNN);
+        ::mpc_fma(rop._get_mpc_t(), a, b, t.get_mpc_t(), MPC_RNDNN);
+    }
+};
+
+#endif
+
+// The operations.
+#define MPPP_LAZY_OP(name)                                                                                             \
+    struct lazy_##name {                                                                                               \
+        template <typename T, typename... Args>                                                                        \
+        static void apply(T &rop, ::mpfr_prec_t p, const Args *...args)                                                \
+        {                                                                                                              \
+            lazy_traits<T>::name(rop, p, args...);                                                                     \
+        }                                                                                                              \
+    };
+
+MPPP_LAZY_OP(add)
+MPPP_LAZY_OP(sub)
+MPPP_LAZY_OP(mul)
+MPPP_LAZY_OP(div)
+MPPP_LAZY_OP(fma)
+MPPP_LAZY_OP(fms)
+MPPP_LAZY_OP(nfms)
+MPPP_LAZY_OP(fmma)
+MPPP_LAZY_OP(fmms)
+
+#undef MPPP_LAZY_OP
+
+template <typename>
+struct is_lazy : std::false_type {
+};
+
+// Evaluate the expression e with precision p.
+template <typename E>
+inline typename E::value_type lazy_evaluate(E &e, ::mpfr_prec_t p)
+{
+    auto *s = e.steal(p);
+    if (s != nullptr) {
+        e.eval(*s, p);
+        return std::move(*s);
+    }
+    auto rop = lazy_traits<typename E::value_type>::make(p);
+    e.eval(rop, p);
+    return rop;
+}
+
+// Base class providing the conversion to the value type.
+template <typename Derived, typename T>
+class lazy_base
+{
+public:
+    // NOLINTNEXTLINE(google-explicit-constructor, hicpp-explicit-conversions)
+    operator T() &&
+    {
+        auto &self = static_cast<Derived &>(*this);
+        return lazy_evaluate(self, self.prec());
+    }
+    // NOTE: if this is an lvalue, evaluate a copy of the expression
+    // in order not to steal from it.
+    // NOLINTNEXTLINE(google-explicit-constructor, hicpp-explicit-conversions)
+    operator T() const &
+    {
+        auto tmp(static_cast<const Derived &>(*this));
+        return lazy_evaluate(tmp, tmp.prec());
+    }
+};
+
+// Leaf referring to an lvalue.
+template <typename T>
+class lazy_cref : public lazy_base<lazy_cref<T>, T>
+{
+public:
+    using value_type = T;
+    static constexpr bool composite = false;
+
+    explicit lazy_cref(const T &x) : m_ptr(&x) {}
+
+    MPPP_NODISCARD ::mpfr_prec_t prec() const
+    {
+        return m_ptr->get_prec();
+    }
+    T *steal(::mpfr_prec_t)
+    {
+        return nullptr;
+    }
+    MPPP_NODISCARD const typename lazy_traits<T>::struct_t *get() const
+    {
+        return lazy_traits<T>::get(*m_ptr);
+    }
+    void eval(T &rop, ::mpfr_prec_t) const
+    {
+        lazy_traits<T>::set(rop, get());
+    }
+
+private:
+    const T *m_ptr;
+};
+
+// Leaf storing a value moved in from an rvalue.
+template <typename T>
+class lazy_val : public lazy_base<lazy_val<T>, T>
+{
+public:
+    using value_type = T;
+    static constexpr bool composite = false;
+
+    explicit lazy_val(T &&x) : m_value(std::move(x)) {}
+
+    MPPP_NODISCARD ::mpfr_prec_t prec() const
+    {
+        return m_value.get_prec();
+    }
+    T *steal(::mpfr_prec_t p)
+    {
+        return m_value.get_prec() == p ? &m_value : nullptr;
+    }
+    MPPP_NODISCARD const typename lazy_traits<T>::struct_t *get() const
+    {
+        return lazy_traits<T>::get(m_value);
+    }
+    void eval(T &rop, ::mpfr_prec_t) const
+    {
+        if (&rop != &m_value) {
+            lazy_traits<T>::set(rop, get());
+        }
+    }
+
+private:
+    T m_value;
+};
+
+// Index of the first non-leaf type in Args
+// (or sizeof...(Args) if all the types are leaves).
+template <typename...>
+struct lazy_first_composite : std::integral_constant<std::size_t, 0> {
+};
+
+template <typename Arg0, typename... Args>
+struct lazy_first_composite<Arg0, Args...>
+    : std::integral_constant<std::size_t, Arg0::composite ? 0 : 1 + lazy_first_composite<Args...>::value> {
+};
+
+// Expression node.
+template <typename Op, typename Arg0, typename... Args>
+class lazy_expr : public lazy_base<lazy_expr<Op, Arg0, Args...>, typename Arg0::value_type>
+{
+    using args_t = std::tuple<Arg0, Args...>;
+    static constexpr std::size_t nargs = sizeof...(Args) + 1u;
+    static constexpr std::size_t first_comp = lazy_first_composite<Arg0, Args...>::value;
+
+public:
+    using value_type = typename Arg0::value_type;
+    static constexpr bool composite = true;
+
+    explicit lazy_expr(Arg0 &&arg0, Args &&...args) : m_args(std::move(arg0), std::move(args)...) {}
+
+    MPPP_NODISCARD ::mpfr_prec_t prec() const
+    {
+        return prec_impl<0>(std::false_type{});
+    }
+    value_type *steal(::mpfr_prec_t p)
+    {
+        return steal_impl<first_comp>(p, std::integral_constant<bool, (first_comp < nargs)>{});
+    }
+    void eval(value_type &rop, ::mpfr_prec_t p)
+    {
+        eval_arg<0>(rop, p, arg_kind<0>{});
+    }
+    args_t &_get_args()
+    {
+        return m_args;
+    }
+
+private:
+    template <std::size_t I>
+    using arg_t = typename std::tuple_element<I, args_t>::type;
+
+    template <std::size_t I>
+    ::mpfr_prec_t prec_impl(std::false_type) const
+    {
+        return c_max(std::get<I>(m_args).prec(), prec_impl<I + 1u>(std::integral_constant<bool, I + 1u == nargs>{}));
+    }
+    template <std::size_t I>
+    ::mpfr_prec_t prec_impl(std::true_type) const
+    {
+        return 0;
+    }
+
+    // There is a non-leaf operand: steal from it.
+    template <std::size_t I>
+    value_type *steal_impl(::mpfr_prec_t p, std::true_type)
+    {
+        return std::get<I>(m_args).steal(p);
+    }
+    // All the operands are leaves: steal from the first one which allows it.
+    template <std::size_t>
+    value_type *steal_impl(::mpfr_prec_t p, std::false_type)
+    {
+        return steal_leaves<0>(p, std::false_type{});
+    }
+    template <std::size_t I>
+    value_type *steal_leaves(::mpfr_prec_t p, std::false_type)
+    {
+        auto *ret = std::get<I>(m_args).steal(p);
+        return ret != nullptr ? ret : steal_leaves<I + 1u>(p, std::integral_constant<bool, I + 1u == nargs>{});
+    }
+    template <std::size_t I>
+    value_type *steal_leaves(::mpfr_prec_t, std::true_type)
+    {
+        return nullptr;
+    }
+
+    // The kind of the I-th operand: 0 for leaves, 1 for the first
+    // non-leaf operand, 2 for the other non-leaf operands. The past-the-end
+    // index has kind 3.
+    template <std::size_t I, typename = void>
+    struct arg_kind_impl : std::integral_constant<int, !arg_t<I>::composite ? 0 : (I == first_comp ? 1 : 2)> {
+    };
+    template <typename Dummy>
+    struct arg_kind_impl<nargs, Dummy> : std::integral_constant<int, 3> {
+    };
+    template <std::size_t I>
+    using arg_kind = arg_kind_impl<I>;
+
+    // Leaf operand.
+    template <std::size_t I, typename... Ptrs>
+    void eval_arg(value_type &rop, ::mpfr_prec_t p, std::integral_constant<int, 0>, const Ptrs *...ptrs)
+    {
+        eval_arg<I + 1u>(rop, p, arg_kind<I + 1u>{}, ptrs..., std::get<I>(m_args).get());
+    }
+    // First non-leaf operand: evaluate it into rop.
+    template <std::size_t I, typename... Ptrs>
+    void eval_arg(value_type &rop, ::mpfr_prec_t p, std::integral_constant<int, 1>, const Ptrs *...ptrs)
+    {
+        std::get<I>(m_args).eval(rop, p);
+        eval_arg<I + 1u>(rop, p, arg_kind<I + 1u>{}, ptrs..., lazy_traits<value_type>::get(rop));
+    }
+    // Other non-leaf operands: evaluate them into temporaries.
+    template <std::size_t I, typename... Ptrs>
+    void eval_arg(value_type &rop, ::mpfr_prec_t p, std::integral_constant<int, 2>, const Ptrs *...ptrs)
+    {
+        const auto tmp = lazy_evaluate(std::get<I>(m_args), p);
+        eval_arg<I + 1u>(rop, p, arg_kind<I + 1u>{}, ptrs..., lazy_traits<value_type>::get(tmp));
+    }
+    // All operands have been processed: run the operation.
+    template <std::size_t, typename... Ptrs>
+    void eval_arg(value_type &rop, ::mpfr_prec_t p, std::integral_constant<int, 3>, const Ptrs *...ptrs)
+    {
+        Op::apply(rop, p, ptrs...);
+    }
+
+    args_t m_args;
+};
+
+template <typename T>
+struct is_lazy<lazy_cref<T>> : std::true_type {
+};
+
+template <typename T>
+struct is_lazy<lazy_val<T>> : std::true_type {
+};
+
+template <typename Op, typename... Args>
+struct is_lazy<lazy_expr<Op, Args...>> : std::true_type {
+};
+
+// Value types supported by the lazy evaluation layer.
+template <typename T>
+using is_lazy_value_type = disjunction<std::is_same<T, real>
+#if defined(MPPP_WITH_MPC)
+                                       ,
+                                       std::is_same<T, complex>
+#endif
+                                       >;
+
+// The value type of an operand in a lazy operation (void if T
+// is not a valid operand).
+template <typename T, typename = void>
+struct lazy_value_type {
+    using type = void;
+};
+
+template <typename T>
+struct lazy_value_type<T, enable_if_t<is_lazy<uncvref_t<T>>::value>> {
+    using type = typename uncvref_t<T>::value_type;
+};
+
+template <typename T>
+struct lazy_value_type<T, enable_if_t<is_lazy_value_type<uncvref_t<T>>::value>> {
+    using type = uncvref_t<T>;
+};
+
+// Lazy operations are enabled if at least one operand is a lazy expression and the
+// value types of the operands are the same.
+template <typename T, typename U>
+using are_lazy_op_types
+    = conjunction<disjunction<is_lazy<uncvref_t<T>>, is_lazy<uncvref_t<U>>>,
+                  std::is_same<typename lazy_value_type<T>::type, typename lazy_value_type<U>::type>>;
+
+// Turn an operand into a lazy expression.
+template <typename T>
+using lazy_wrap_t = typename std::conditional<
+    is_lazy<uncvref_t<T>>::value, uncvref_t<T>,
+    typename std::conditional<is_ncrvr<T &&>::value, lazy_val<uncvref_t<T>>, lazy_cref<uncvref_t<T>>>::type>::type;
+
+template <typename T, enable_if_t<is_lazy<uncvref_t<T>>::value, int> = 0>
+inline uncvref_t<T> lazy_wrap(T &&x)
+{
+    return std::forward<T>(x);
+}
+
+template <typename T, enable_if_t<conjunction<is_lazy_value_type<uncvref_t<T>>, is_ncrvr<T &&>>::value, int> = 0>
+inline lazy_val<uncvref_t<T>> lazy_wrap(T &&x)
+{
+    return lazy_val<uncvref_t<T>>(std::move(x));
+}
+
+template <typename T,
+          enable_if_t<conjunction<is_lazy_value_type<uncvref_t<T>>, negation<is_ncrvr<T &&>>>::value, int> = 0>
+inline lazy_cref<uncvref_t<T>> lazy_wrap(T &&x)
+{
+    return lazy_cref<uncvref_t<T>>(x);
+}
+
+// Builders for the nodes of the expression trees. The partial specialisations
+// implement the fusion of the multiplications into the additions/subtractions.
+template <typename Op, typename L, typename R>
+struct lazy_builder {
+    using type = lazy_expr<Op, L, R>;
+    static type make(L &&l, R &&r)
+    {
+        return type(std::move(l), std::move(r));
+    }
+};
+
+// Helper to build the fused nodes.
+template <typename Op, typename... Args>
+inline lazy_expr<Op, Args...> lazy_make_fused(Args &&...args)
+{
+    return lazy_expr<Op, Args...>(std::move(args)...);
+}
+
+// a*b + c -> fma(a, b, c).
+template <typename A, typename B, typename C>
+struct lazy_builder<lazy_add, lazy_expr<lazy_mul, A, B>, C> {
+    using type = lazy_expr<lazy_fma, A, B, C>;
+    static type make(lazy_expr<lazy_mul, A, B> &&l, C &&r)
+    {
+        auto &args = l._get_args();
+        return lazy_make_fused<lazy_fma>(std::move(std::get<0>(args)), std::move(std::get<1>(args)), std::move(r));
+    }
+};
+
+// c + a*b -> fma(a, b, c).
+template <typename C, typename A, typename B>
+struct lazy_builder<lazy_add, C, lazy_expr<lazy_mul, A, B>> {
+    using type = lazy_expr<lazy_fma, A, B, C>;
+    static type make(C &&l, lazy_expr<lazy_mul, A, B> &&r)
+    {
+        auto &args = r._get_args();
+        return lazy_make_fused<lazy_fma>(std::move(std::get<0>(args)), std::move(std::get<1>(args)), std::move(l));
+    }
+};
+
+// a*b + c*d -> fmma(a, b, c, d).
+template <typename A, typename B, typename C, typename D>
+struct lazy_builder<lazy_add, lazy_expr<lazy_mul, A, B>, lazy_expr<lazy_mul, C, D>> {
+    using type = lazy_expr<lazy_fmma, A, B, C, D>;
+    static type make(lazy_expr<lazy_mul, A, B> &&l, lazy_expr<lazy_mul, C, D> &&r)
+    {
+        auto &largs = l._get_args();
+        auto &rargs = r._get_args();
+        return lazy_make_fused<lazy_fmma>(std::move(std::get<0>(largs)), std::move(std::get<1>(largs)),
+                                          std::move(std::get<0>(rargs)), std::move(std::get<1>(rargs)));
+    }
+};
+
+// a*b - c -> fms(a, b, c).
+template <typename A, typename B, typename C>
+struct lazy_builder<lazy_sub, lazy_expr<lazy_mul, A, B>, C> {
+    using type = lazy_expr<lazy_fms, A, B, C>;
+    static type make(lazy_expr<lazy_mul, A, B> &&l, C &&r)
+    {
+        auto &args = l._get_args();
+        return lazy_make_fused<lazy_fms>(std::move(std::get<0>(args)), std::move(std::get<1>(args)), std::move(r));
+    }
+};
+
+// c - a*b -> nfms(a, b, c).
+template <typename C, typename A, typename B>
+struct lazy_builder<lazy_sub, C, lazy_expr<lazy_mul, A, B>> {
+    using type = lazy_expr<lazy_nfms, A, B, C>;
+    static type make(C &&l, lazy_expr<lazy_mul, A, B> &&r)
+    {
+        auto &args = r._get_args();
+        return lazy_make_fused<lazy_nfms>(std::move(std::get<0>(args)), std::move(std::get<1>(args)), std::move(l));
+    }
+};
+
+// a*b - c*d -> fmms(a, b, c, d).
+template <typename A, typename B, typename C, typename D>
+struct lazy_builder<lazy_sub, lazy_expr<lazy_mul, A, B>, lazy_expr<lazy_mul, C, D>> {
+    using type = lazy_expr<lazy_fmms, A, B, C, D>;
+    static type make(lazy_expr<lazy_mul, A, B> &&l, lazy_expr<lazy_mul, C, D> &&r)
+    {
+        auto &largs = l._get_args();
+        auto &rargs = r._get_args();
+        return lazy_make_fused<lazy_fmms>(std::move(std::get<0>(largs)), std::move(std::get<1>(largs)),
+                                          std::move(std::get<0>(rargs)), std::move(std::get<1>(rargs)));
+    }
+};
+
+template <typename Op, typename T, typename U>
+using lazy_op_t = typename lazy_builder<Op, lazy_wrap_t<T>, lazy_wrap_t<U>>::type;
+
+template <typename Op, typename T, typename U>
+inline lazy_op_t<Op, T, U> lazy_make_op(T &&a, U &&b)
+{
+    return lazy_builder<Op, lazy_wrap_t<T>, lazy_wrap_t<U>>::make(lazy_wrap(std::forward<T>(a)),
+                                                                   lazy_wrap(std::forward<U>(b)));
+}
+
+} // namespace detail
+
+// Start a lazy expression.
+#if defined(MPPP_HAVE_CONCEPTS)
+template <typename T>
+    requires detail::is_lazy_value_type<detail::uncvref_t<T>>::value
+#else
+template <typename T, detail::enable_if_t<detail::is_lazy_value_type<detail::uncvref_t<T>>::value, int> = 0>
+#endif
+inline detail::lazy_wrap_t<T> lazy(T &&x)
+{
+    return detail::lazy_wrap(std::forward<T>(x));
+}
+
+#define MPPP_LAZY_BINARY_OP(op, name)                                                                                  \
+    template <typename T, typename U, detail::enable_if_t<detail::are_lazy_op_types<T, U>::value, int> = 0>           \
+    inline detail::lazy_op_t<detail::lazy_##name, T, U> operator op(T &&a, U &&b)                                      \
+    {                                                                                                                  \
+        return detail::lazy_make_op<detail::lazy_##name>(std::forward<T>(a), std::forward<U>(b));                      \
+    }
+
+MPPP_LAZY_BINARY_OP(+, add)
+MPPP_LAZY_BINARY_OP(-, sub)
+MPPP_LAZY_BINARY_OP(*, mul)
+MPPP_LAZY_BINARY_OP(/, div)
+
+#undef MPPP_LAZY_BINARY_OP
+
+MPPP_END_NAMESPACE
+
+#endif
+
+#endif
@@ -0,0 +1,66 @@
+// Copyright 2016-2023 Francesco Biscani (bluescarni@gmail.com)
+//
+// This file is part of the mp++ library.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef MPPP_LIMB_POOL_HPP
+#define MPPP_LIMB_POOL_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+#include <mp++/config.hpp>
+#include <mp++/detail/visibility.hpp>
+
+MPPP_BEGIN_NAMESPACE
+
+// Configuration of the limb pool.
+struct limb_pool_config {
+    // Size (in limbs) of the largest size class. Must be a power of two.
+    // Larger requests bypass the pool.
+    std::size_t max_class_limbs = 4096;
+    // Max number of arrays in a per-thread magazine.
+    std::size_t magazine_entries = 64;
+    // Max number of bytes cached in a per-thread magazine. The number of entries
+    // of the magazines of the larger size classes is reduced accordingly.
+    std::size_t magazine_bytes = 65536;
+    // Max number of full magazines kept in the global depot for each size class.
+    std::size_t depot_magazines = 32;
+};
+
+// Statistics of the limb pool.
+struct limb_pool_stats {
+    // Number of allocations served by the per-thread magazines.
+    std::uint64_t thread_hits = 0;
+    // Number of magazines fetched from the global depot.
+    std::uint64_t depot_hits = 0;
+    // Number of allocations forwarded to the underlying allocator.
+    std::uint64_t misses = 0;
+    // Number of arrays returned to the underlying allocator
+    // because the depot was full.
+    std::uint64_t evictions = 0;
+    // Number of allocations and deallocations which bypassed the
+    // pool because of their size.
+    std::uint64_t oversize = 0;
+    // Number of bytes currently cached in the global depot.
+    std::uint64_t depot_bytes = 0;
+};
+
+// Install the limb pool as GMP's allocator.
+MPPP_DLL_PUBLIC void install_limb_pool(const limb_pool_config & = limb_pool_config{});
+// Check if the limb pool has been installed.
+MPPP_DLL_PUBLIC bool limb_pool_installed();
+// Get the configuration of the limb pool.
+MPPP_DLL_PUBLIC limb_pool_config get_limb_pool_config();
+// Get the statistics of the limb pool.
+MPPP_DLL_PUBLIC limb_pool_stats get_limb_pool_stats();
+// Return the memory cached by the calling thread and by
+// the global depot to the underlying allocator.
+MPPP_DLL_PUBLIC void trim_limb_pool();
+
+MPPP_END_NAMESPACE
+
+#endif
@@ -0,0 +1,402 @@
+// Copyright 2016-2023 Francesco Biscani (bluescarni@gmail.com)
+//
+// This file is part of the mp++ library.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef MPPP_MODULUS_CTX_HPP
+#define MPPP_MODULUS_CTX_HPP
+
+#include <mp++/config.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <vector>
+
+#include <mp++/detail/gmp.hpp>
+#include <mp++/detail/utils.hpp>
+#include <mp++/exceptions.hpp>
+#include <mp++/integer.hpp>
+
+MPPP_BEGIN_NAMESPACE
+
+namespace detail
+{
+
+// The Montgomery kernels require double-limb
+// multiplication (which also implies no nail bits).
+#if (defined(_MSC_VER) && defined(_WIN64) && GMP_NUMB_BITS == 64 && !GMP_NAIL_BITS) || defined(MPPP_HAVE_DLIMB_T)
+
+#define MPPP_MODULUS_CTX_HAVE_MONTGOMERY
+
+#endif
+
+// Maximum size (in limbs) of the moduli for which
+// Montgomery multiplication is used.
+constexpr std::size_t modulus_ctx_mont_max_size = 4;
+
+#if defined(MPPP_MODULUS_CTX_HAVE_MONTGOMERY)
+
+// Compute a * b + c + d, returning the low limb and writing
+// the high limb into hi. The result always fits in two limbs.
+inline ::mp_limb_t mont_mul_add2(::mp_limb_t a, ::mp_limb_t b, ::mp_limb_t c, ::mp_limb_t d, ::mp_limb_t *hi)
+{
+    // NOLINTNEXTLINE(cppcoreguidelines-init-variables)
+    ::mp_limb_t h;
+    auto l = dlimb_mul(a, b, &h);
+    l += c;
+    h += static_cast<::mp_limb_t>(l < c);
+    l += d;
+    h += static_cast<::mp_limb_t>(l < d);
+    *hi = h;
+    return l;
+}
+
+// Montgomery multiplication for an N-limb modulus (CIOS method):
+// rp = ap * bp * 2**(-N * GMP_NUMB_BITS) mod mp.
+// ap and bp must be less than mp, and minv must be -mp**-1 modulo 2**GMP_NUMB_BITS.
+// rp may overlap with ap and/or bp.
+// NOTE: all the loops have trip counts known at compile time,
+// so that the compiler can unroll them completely.
+template <std::size_t N>
+inline void mont_mul(::mp_limb_t *rp, const ::mp_limb_t *ap, const ::mp_limb_t *bp, const ::mp_limb_t *mp,
+                     ::mp_limb_t minv)
+{
+    std::array<::mp_limb_t, N + 2u> t{};
+
+    for (std::size_t i = 0; i < N; ++i) {
+        // t += ap * bp[i].
+        ::mp_limb_t c = 0;
+        for (std::size_t j = 0; j < N; ++j) {
+            t[j] = mont_mul_add2(ap[j], bp[i], t[j], c, &c);
+        }
+        t[N] += c;
+        t[N + 1u] = static_cast<::mp_limb_t>(t[N] < c);
+
+        // t = (t + q * mp) / 2**GMP_NUMB_BITS, where q is chosen
+        // so that the division is exact.
+        const auto q = static_cast<::mp_limb_t>(t[0] * minv);
+        mont_mul_add2(q, mp[0], t[0], 0, &c);
+        for (std::size_t j = 1; j < N; ++j) {
+            t[j - 1u] = mont_mul_add2(q, mp[j], t[j], c, &c);
+        }
+        t[N - 1u] = t[N] + c;
+        t[N] = t[N + 1u] + static_cast<::mp_limb_t>(t[N - 1u] < c);
+    }
+
+    // t is now less than 2 * mp, subtract mp if needed.
+    if (t[N] != 0u || mpn_cmp(t.data(), mp, static_cast<::mp_size_t>(N)) >= 0) {
+        mpn_sub_n(rp, t.data(), mp, static_cast<::mp_size_t>(N));
+    } else {
+        copy_limbs_no(t.data(), t.data() + N, rp);
+    }
+}
+
+#endif
+
+// Montgomery multiplication for an n-limb modulus,
+// dispatching to the fixed-size kernels.
+inline void mont_mul_n(std::size_t n, ::mp_limb_t *rp, const ::mp_limb_t *ap, const ::mp_limb_t *bp,
+                       const ::mp_limb_t *mp, ::mp_limb_t minv)
+{
+#if defined(MPPP_MODULUS_CTX_HAVE_MONTGOMERY)
+    switch (n) {
+        case 1u:
+            mont_mul<1>(rp, ap, bp, mp, minv);
+            break;
+        case 2u:
+            mont_mul<2>(rp, ap, bp, mp, minv);
+            break;
+        case 3u:
+            mont_mul<3>(rp, ap, bp, mp, minv);
+            break;
+        default:
+            assert(n == modulus_ctx_mont_max_size);
+            mont_mul<modulus_ctx_mont_max_size>(rp, ap, bp, mp, minv);
+    }
+#else
+    // NOTE: this is never invoked if the kernels
+    // are not available.
+    ignore(n, rp, ap, bp, mp, minv);
+    assert(false);
+#endif
+}
+
+} // namespace detail
+
+// Modular arithmetic context.
+template <std::size_t SSize>
+class modulus_ctx
+{
+public:
+    // Constructor from a modulus.
+    explicit modulus_ctx(const integer<SSize> &mod) : m_mod(mod)
+    {
+        if (mppp_unlikely(m_mod.sgn() == 0)) {
+            throw zero_division_error("Integer division by zero");
+        }
+
+        // NOTE: store the absolute value of the modulus,
+        // in static storage if possible.
+        m_mod.abs();
+        m_mod.demote();
+        m_nlimbs = m_mod.size();
+
+#if defined(MPPP_MODULUS_CTX_HAVE_MONTGOMERY)
+        if (m_mod.is_static() && m_nlimbs <= detail::modulus_ctx_mont_max_size && m_mod.odd_p()) {
+            const auto mp = mod_limbs();
+
+            m_minv = detail::mont_minv(mp[0]);
+
+            // Compute R**2 mod m, with R = 2**(m_nlimbs * GMP_NUMB_BITS).
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-type-member-init, hicpp-member-init)
+            std::array<::mp_limb_t, detail::modulus_ctx_mont_max_size * 2u + 1u> r2, q;
+            std::fill(r2.begin(), r2.begin() + m_nlimbs * 2u, ::mp_limb_t(0));
+            r2[m_nlimbs * 2u] = 1;
+            mpn_tdiv_qr(q.data(), m_r2.data(), 0, r2.data(), static_cast<::mp_size_t>(m_nlimbs * 2u + 1u), mp,
+                        static_cast<::mp_size_t>(m_nlimbs));
+
+            m_mont = true;
+        }
+#endif
+    }
+
+    // Getters.
+    MPPP_NODISCARD const integer<SSize> &get_mod() const
+    {
+        return m_mod;
+    }
+    MPPP_NODISCARD bool is_montgomery() const
+    {
+        return m_mont;
+    }
+
+    // Modular reduction.
+    integer<SSize> &reduce(integer<SSize> &rop, const integer<SSize> &n) const
+    {
+        if (m_mod.is_static()) {
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-type-member-init, hicpp-member-init)
+            std::array<::mp_limb_t, SSize> x;
+            load(x.data(), n);
+            return store(rop, x.data());
+        }
+
+        MPPP_MAYBE_TLS detail::mpz_raii tmp;
+        mpz_mod(&tmp.m_mpz, n.get_mpz_view(), m_mod.get_mpz_view());
+        return rop = &tmp.m_mpz;
+    }
+    MPPP_NODISCARD integer<SSize> reduce(const integer<SSize> &n) const
+    {
+        integer<SSize> retval;
+        reduce(retval, n);
+        return retval;
+    }
+
+    // Modular multiplication.
+    integer<SSize> &mulm(integer<SSize> &rop, const integer<SSize> &a, const integer<SSize> &b) const
+    {
+        if (m_mod.is_static()) {
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-type-member-init, hicpp-member-init)
+            std::array<::mp_limb_t, SSize> x, y;
+            load(x.data(), a);
+            load(y.data(), b);
+            if (m_mont) {
+                // NOTE: the second multiplication by R**2
+                // brings the result out of the Montgomery representation.
+                mul_mont(x.data(), x.data(), y.data());
+                mul_mont(x.data(), x.data(), m_r2.data());
+            } else {
+                mul_plain(x.data(), x.data(), y.data());
+            }
+            return store(rop, x.data());
+        }
+
+        MPPP_MAYBE_TLS detail::mpz_raii tmp;
+        mpz_mul(&tmp.m_mpz, a.get_mpz_view(), b.get_mpz_view());
+        mpz_mod(&tmp.m_mpz, &tmp.m_mpz, m_mod.get_mpz_view());
+        return rop = &tmp.m_mpz;
+    }
+    MPPP_NODISCARD integer<SSize> mulm(const integer<SSize> &a, const integer<SSize> &b) const
+    {
+        integer<SSize> retval;
+        mulm(retval, a, b);
+        return retval;
+    }
+
+    // Modular squaring.
+    integer<SSize> &sqrm(integer<SSize> &rop, const integer<SSize> &n) const
+    {
+        return mulm(rop, n, n);
+    }
+    MPPP_NODISCARD integer<SSize> sqrm(const integer<SSize> &n) const
+    {
+        return mulm(n, n);
+    }
+
+    // Modular exponentiation.
+    integer<SSize> &powm(integer<SSize> &rop, const integer<SSize> &base, const integer<SSize> &exp) const
+    {
+        if (mppp_unlikely(exp.sgn() < 0)) {
+            // Negative exponent: raise the inverse of base
+            // to the absolute value of exp.
+            integer<SSize> inv;
+            invert(inv, base, m_mod);
+            return powm(rop, inv, abs(exp));
+        }
+
+        if (!m_mod.is_static()) {
+            MPPP_MAYBE_TLS detail::mpz_raii tmp;
+            mpz_powm(&tmp.m_mpz, base.get_mpz_view(), exp.get_mpz_view(), m_mod.get_mpz_view());
+            return rop = &tmp.m_mpz;
+        }
+
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-member-init, hicpp-member-init)
+        std::array<::mp_limb_t, SSize> x, acc;
+
+        if (exp.sgn() == 0) {
+            // NOTE: x**0 == 1, unless we are working modulo 1.
+            std::fill(acc.begin(), acc.begin() + m_nlimbs, ::mp_limb_t(0));
+            acc[0] = static_cast<::mp_limb_t>(!m_mod.is_one());
+            return store(rop, acc.data());
+        }
+
+        load(x.data(), base);
+
+        const auto ev = exp.get_mpz_view();
+        const auto ep = ev.get()->_mp_d;
+        const auto esize = static_cast<std::size_t>(ev.get()->_mp_size);
+
+        if (m_mont) {
+            // Convert x to the Montgomery representation.
+            mul_mont(x.data(), x.data(), m_r2.data());
+            powm_impl(acc.data(), x.data(), ep, esize,
+                      [this](::mp_limb_t *rp, const ::mp_limb_t *ap, const ::mp_limb_t *bp) { mul_mont(rp, ap, bp); });
+            // Convert the result back from the Montgomery representation.
+            std::fill(x.begin(), x.begin() + m_nlimbs, ::mp_limb_t(0));
+            x[0] = 1;
+            mul_mont(acc.data(), acc.data(), x.data());
+        } else {
+            powm_impl(acc.data(), x.data(), ep, esize,
+                      [this](::mp_limb_t *rp, const ::mp_limb_t *ap, const ::mp_limb_t *bp) { mul_plain(rp, ap, bp); });
+        }
+
+        return store(rop, acc.data());
+    }
+    MPPP_NODISCARD integer<SSize> powm(const integer<SSize> &base, const integer<SSize> &exp) const
+    {
+        integer<SSize> retval;
+        powm(retval, base, exp);
+        return retval;
+    }
+
+private:
+    // NOTE: the following helpers are used only if the modulus
+    // is in static storage, and they operate on arrays of
+    // m_nlimbs limbs representing values in the [0, m_mod) range.
+    MPPP_NODISCARD const ::mp_limb_t *mod_limbs() const
+    {
+        assert(m_mod.is_static());
+        return m_mod._get_union().g_st().m_limbs.data();
+    }
+    // Write into out the limbs of n modulo m_mod.
+    void load(::mp_limb_t *out, const integer<SSize> &n) const
+    {
+        const auto mp = mod_limbs();
+        const auto ev = n.get_mpz_view();
+        const auto np = ev.get()->_mp_d;
+        const auto asize = n.size();
+
+        if (asize < m_nlimbs) {
+            // NOTE: n has fewer limbs than m_mod,
+            // thus its absolute value is less than m_mod.
+            detail::copy_limbs_no(np, np + asize, out);
+            std::fill(out + asize, out + m_nlimbs, ::mp_limb_t(0));
+        } else if (asize <= SSize) {
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-type-member-init, hicpp-member-init)
+            std::array<::mp_limb_t, SSize> q;
+            mpn_tdiv_qr(q.data(), out, 0, np, static_cast<::mp_size_t>(asize), mp,
+                        static_cast<::mp_size_t>(m_nlimbs));
+        } else {
+            // NOTE: the quotient does not fit in static
+            // storage, use a thread-local buffer.
+            MPPP_MAYBE_TLS std::vector<::mp_limb_t> q;
+            q.resize(asize - m_nlimbs + 1u);
+            mpn_tdiv_qr(q.data(), out, 0, np, static_cast<::mp_size_t>(asize), mp,
+                        static_cast<::mp_size_t>(m_nlimbs));
+        }
+
+        // For negative n, the remainder has to be brought
+        // into the [0, m_mod) range.
+        if (n.sgn() < 0 && std::any_of(out, out + m_nlimbs, [](::mp_limb_t l) { return l != 0u; })) {
+            mpn_sub_n(out, mp, out, static_cast<::mp_size_t>(m_nlimbs));
+        }
+    }
+    // Write the value in rp into rop, which will be in static storage.
+    integer<SSize> &store(integer<SSize> &rop, const ::mp_limb_t *rp) const
+    {
+        auto size = m_nlimbs;
+        while (size != 0u && rp[size - 1u] == 0u) {
+            --size;
+        }
+
+        if (!rop.is_static()) {
+            rop.set_zero();
+        }
+        auto &st = rop._get_union().g_st();
+        st._mp_size = static_cast<detail::mpz_size_t>(size);
+        detail::copy_limbs_no(rp, rp + size, st.m_limbs.data());
+        st.zero_upper_limbs(size);
+
+        return rop;
+    }
+    // Multiplication in the Montgomery representation.
+    void mul_mont(::mp_limb_t *rp, const ::mp_limb_t *ap, const ::mp_limb_t *bp) const
+    {
+        detail::mont_mul_n(m_nlimbs, rp, ap, bp, mod_limbs(), m_minv);
+    }
+    // Multiplication followed by division.
+    void mul_plain(::mp_limb_t *rp, const ::mp_limb_t *ap, const ::mp_limb_t *bp) const
+    {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-member-init, hicpp-member-init)
+        std::array<::mp_limb_t, SSize * 2u> prod, q;
+        mpn_mul_n(prod.data(), ap, bp, static_cast<::mp_size_t>(m_nlimbs));
+        mpn_tdiv_qr(q.data(), rp, 0, prod.data(), static_cast<::mp_size_t>(m_nlimbs * 2u), mod_limbs(),
+                    static_cast<::mp_size_t>(m_nlimbs));
+    }
+    // Left-to-right binary exponentiation of x, using mul for
+    // the multiplications. The exponent must be nonzero and normalised.
+    template <typename F>
+    void powm_impl(::mp_limb_t *acc, const ::mp_limb_t *x, const ::mp_limb_t *ep, std::size_t esize,
+                   const F &mul) const
+    {
+        assert(esize != 0u);
+
+        // NOTE: the most significant bit of the exponent is accounted
+        // for by the initialisation of acc.
+        detail::copy_limbs_no(x, x + m_nlimbs, acc);
+        auto nbits = detail::limb_size_nbits(ep[esize - 1u]) - 1u;
+        for (auto i = esize; i-- > 0u; nbits = unsigned(GMP_NUMB_BITS)) {
+            const auto l = ep[i];
+            while (nbits-- > 0u) {
+                mul(acc, acc, acc);
+                if ((l >> nbits) & 1u) {
+                    mul(acc, acc, x);
+                }
+            }
+        }
+    }
+
+    integer<SSize> m_mod;
+    std::size_t m_nlimbs = 0;
+    ::mp_limb_t m_minv = 0;
+    std::array<::mp_limb_t, detail::modulus_ctx_mont_max_size> m_r2{};
+    bool m_mont = false;
+};
+
+MPPP_END_NAMESPACE
+
+#endif
@@ -10,13 +10,26 @@
 #define MPPP_MPPP_HPP
 
 #include <mp++/config.hpp>
+#include <mp++/array_file.hpp>
+#include <mp++/binary_archive.hpp>
 #include <mp++/exceptions.hpp>
 #include <mp++/integer.hpp>
+#include <mp++/integer_batch.hpp>
+#include <mp++/integer_batch_gcd.hpp>
+#include <mp++/integer_combinatorics.hpp>
+#include <mp++/integer_divisor.hpp>
+#include <mp++/integer_primes.hpp>
+#include <mp++/integer_vector.hpp>
+#include <mp++/limb_pool.hpp>
+#include <mp++/modulus_ctx.hpp>
 #include <mp++/rational.hpp>
+#include <mp++/rational_accumulator.hpp>
 #include <mp++/type_name.hpp>
 
 #if defined(MPPP_WITH_MPFR)
+#include <mp++/lazy.hpp>
 #include <mp++/real.hpp>
+#include <mp++/static_real.hpp>
 #endif
 
 #if defined(MPPP_WITH_MPC)
@@ -140,6 +140,14 @@ struct is_same_ssize_rational<rational<SSize>, rational<SSize>> : std::true_type
 template <std::size_t SSize>
 mpq_struct_t get_mpq_view(const rational<SSize> &);
 
+#if defined(MPPP_HAVE_DLIMB_T)
+
+// Fwd declaration of the fast path for the conversion to double.
+template <std::size_t SSize>
+bool rational_1limb_to_double(double &, const rational<SSize> &, fp_rounding);
+
+#endif
+
 } // namespace detail
 
 // Multiprecision rational class.
@@ -523,6 +531,14 @@ private:
               detail::enable_if_t<detail::disjunction<std::is_same<T, float>, std::is_same<T, double>>::value, int> = 0>
     MPPP_NODISCARD std::pair<bool, T> dispatch_conversion() const
     {
+#if defined(MPPP_HAVE_DLIMB_T)
+        // NOTE: mpq_get_d() truncates, thus we round towards zero in order
+        // to produce the same result as the GMP routine.
+        double ret;
+        if (detail::rational_1limb_to_double(ret, *this, fp_rounding::toward_zero)) {
+            return std::make_pair(true, static_cast<T>(ret));
+        }
+#endif
         const auto v = detail::get_mpq_view(*this);
         return std::make_pair(true, static_cast<T>(mpq_get_d(&v)));
     }
@@ -794,12 +810,197 @@ struct rational_common_type<
 template <typename T, typename U>
 using rational_common_t = typename rational_common_type<T, U>::type;
 
+#if defined(MPPP_HAVE_DLIMB_T)
+
+// Fast paths for rationals whose numerator and denominator are both
+// in static storage and consist of at most 1 limb. In this case,
+// the cross products fit in a double limb and the gcds can be computed
+// on limbs, so that no intermediate integer is ever created.
+
+// Extract the sign and the absolute value of the numerator (sn, an)
+// and the denominator (ad) of q. Returns false if q is not eligible
+// for the fast paths.
+template <std::size_t SSize>
+inline bool rational_1limb_get(int &sn, ::mp_limb_t &an, ::mp_limb_t &ad, const rational<SSize> &q)
+{
+    const auto &nu = q.get_num()._get_union();
+    const auto &du = q.get_den()._get_union();
+    if (!nu.is_static() || !du.is_static()) {
+        return false;
+    }
+    const auto &nst = nu.g_st();
+    const auto &dst = du.g_st();
+    if (nst._mp_size < -1 || nst._mp_size > 1 || dst._mp_size != 1) {
+        return false;
+    }
+    sn = nst._mp_size;
+    an = (sn != 0) ? nst.m_limbs[0] : ::mp_limb_t(0);
+    ad = dst.m_limbs[0];
+    return true;
+}
+
+// Write the (already canonical) value (sn * an) / ad into rop.
+template <std::size_t SSize>
+inline void rational_1limb_set(rational<SSize> &rop, int sn, dlimb_t an, dlimb_t ad)
+{
+    rop._get_num() = an;
+    if (sn < 0) {
+        rop._get_num().neg();
+    }
+    rop._get_den() = ad;
+}
+
+// Conversion to double with the rounding mode rnd. Returns false if q is not eligible.
+template <std::size_t SSize>
+inline bool rational_1limb_to_double(double &rop, const rational<SSize> &q, fp_rounding rnd)
+{
+    int sn;
+    ::mp_limb_t an, ad;
+    if (!rational_1limb_get(sn, an, ad, q)) {
+        return false;
+    }
+    if (sn == 0) {
+        rop = 0.;
+        return true;
+    }
+    constexpr auto digits = std::numeric_limits<double>::digits;
+    if (rnd == fp_rounding::nearest && limb_size_nbits(an) <= unsigned(digits)
+        && limb_size_nbits(ad) <= unsigned(digits)) {
+        // NOTE: numerator and denominator are exactly representable, and the
+        // floating-point division is correctly rounded to nearest
+        // (in the default floating-point environment).
+        rop = static_cast<double>(an) / static_cast<double>(ad);
+        if (sn < 0) {
+            rop = -rop;
+        }
+        return true;
+    }
+#if GMP_NUMB_BITS == 64
+    // Scale the numerator so that the quotient has 63 or 64 bits. The nonzero
+    // bits of the remainder then contribute only to the sticky bit of the rounding.
+    const auto k = unsigned(GMP_NUMB_BITS) - 1u + limb_size_nbits(ad) - limb_size_nbits(an);
+    const auto num = static_cast<dlimb_t>(an) << k;
+    const auto qt = static_cast<::mp_limb_t>(num / ad);
+    const auto sticky = num - static_cast<dlimb_t>(qt) * ad != 0u;
+    rop = limbs_to_double(&qt, 1, sn < 0, sticky, -static_cast<long long>(k), rnd);
+    return true;
+#else
+    // NOTE: with narrower limbs the quotient computed in a double limb
+    // does not have enough bits for a correct rounding, let the
+    // general algorithm deal with it.
+    return false;
+#endif
+}
+
+// GCD of a nonzero double limb and a nonzero limb.
+inline ::mp_limb_t dlimb_limb_gcd(dlimb_t a, ::mp_limb_t b)
+{
+    assert(a != 0u && b != 0u);
+    if (!(a >> GMP_NUMB_BITS)) {
+        return limb_gcd(static_cast<::mp_limb_t>(a), b);
+    }
+    // NOTE: gcd(a, b) == gcd(a mod b, b), and the remainder fits in a limb.
+    const auto r = static_cast<::mp_limb_t>(a % b);
+    return r == 0u ? b : limb_gcd(r, b);
+}
+
+// Add/sub fast path. Returns false if the operands are not eligible,
+// or if the numerator of the result does not fit in a double limb.
+template <bool AddOrSub, std::size_t SSize>
+inline bool rational_1limb_addsub(rational<SSize> &rop, const rational<SSize> &op1, const rational<SSize> &op2)
+{
+    // NOTE: all the values are read before writing into rop,
+    // so that overlapping arguments are not a problem.
+    int sa, sc;
+    ::mp_limb_t a, b, c, d;
+    if (!rational_1limb_get(sa, a, b, op1) || !rational_1limb_get(sc, c, d, op2)) {
+        return false;
+    }
+    if (!AddOrSub) {
+        sc = -sc;
+    }
+
+    // The algorithm is the same as in the general case of addsub_impl(), with
+    // the gcd of the dens used to keep the cross products small.
+    const auto g = (b == d) ? b : limb_gcd(b, d);
+    const auto bg = b / g;
+    const auto x = dlimb_t(a) * (d / g), y = dlimb_t(c) * bg;
+
+    // Compute the absolute value and the sign of the numerator.
+    dlimb_t t;
+    int st;
+    if (sa * sc >= 0) {
+        t = x + y;
+        if (mppp_unlikely(t < x)) {
+            // Overflow, let the general algorithm deal with it.
+            return false;
+        }
+        st = sa + sc;
+    } else if (x >= y) {
+        t = x - y;
+        st = sa;
+    } else {
+        t = y - x;
+        st = sc;
+    }
+    if (t == 0u) {
+        rop._get_num().set_zero();
+        rop._get_den().set_one();
+        return true;
+    }
+
+    // Reduce by the common factors between the numerator and g.
+    const auto g2 = (g == 1u) ? g : dlimb_limb_gcd(t, g);
+    if (g2 == 1u) {
+        rational_1limb_set(rop, st, t, dlimb_t(bg) * d);
+    } else {
+        // NOTE: avoid the (slow) double-limb division if possible.
+        rational_1limb_set(rop, st, (t >> GMP_NUMB_BITS) ? t / g2 : dlimb_t(static_cast<::mp_limb_t>(t) / g2),
+                           dlimb_t(bg) * (d / g2));
+    }
+    return true;
+}
+
+// Multiplication fast path: (sa*a)/b * (sc*c)/d.
+template <std::size_t SSize>
+inline void rational_1limb_mul(rational<SSize> &rop, int sa, ::mp_limb_t a, ::mp_limb_t b, int sc, ::mp_limb_t c,
+                               ::mp_limb_t d)
+{
+    if (sa == 0 || sc == 0) {
+        rop._get_num().set_zero();
+        rop._get_den().set_one();
+        return;
+    }
+    // Like in mul_impl(), remove the common factors
+    // between nums and dens before multiplying.
+    const auto g1 = limb_gcd(a, d), g2 = limb_gcd(b, c);
+    rational_1limb_set(rop, sa * sc, dlimb_t(a / g1) * (c / g2), dlimb_t(b / g2) * (d / g1));
+}
+
+// Comparison fast path.
+inline int rational_1limb_cmp(int sa, ::mp_limb_t a, ::mp_limb_t b, int sc, ::mp_limb_t c, ::mp_limb_t d)
+{
+    if (sa != sc) {
+        return sa < sc ? -1 : 1;
+    }
+    const auto x = dlimb_t(a) * d, y = dlimb_t(c) * b;
+    const int ret = static_cast<int>(x > y) - static_cast<int>(x < y);
+    return sa < 0 ? -ret : ret;
+}
+
+#endif
+
 // Implementation of binary add/sub. The NewRop flag indicates that
 // rop is a def-cted rational distinct from op1 and op2.
 template <bool AddOrSub, bool NewRop, std::size_t SSize>
 inline void addsub_impl(rational<SSize> &rop, const rational<SSize> &op1, const rational<SSize> &op2)
 {
     assert(!NewRop || (rop.is_zero() && &rop != &op1 && &rop != &op2));
+#if defined(MPPP_HAVE_DLIMB_T)
+    if (rational_1limb_addsub<AddOrSub>(rop, op1, op2)) {
+        return;
+    }
+#endif
     const bool u1 = op1.get_den().is_one(), u2 = op2.get_den().is_one();
     // NOTE: it's important here to take care about overlapping arguments: we cannot use
     // rop as a "temporary" storage space, because if it overlaps with op1/op2 we will be
@@ -924,6 +1125,17 @@ MPPP_CONCEPT_DECL rational_real_op_types = are_rational_real_op_types<T, U>::val
 
 #endif
 
+namespace detail
+{
+
+// The types which, combined with an rvalue rational<SSize> in the binary operators,
+// allow to compute the result directly into the storage of the rvalue.
+template <typename T, std::size_t SSize>
+using is_rational_rvalue_op_type
+    = disjunction<std::is_same<T, rational<SSize>>, std::is_same<T, integer<SSize>>, is_cpp_integral<T>>;
+
+} // namespace detail
+
 // Generic conversion function.
 #if defined(MPPP_HAVE_CONCEPTS)
 template <std::size_t SSize, rational_interoperable<SSize> T>
@@ -935,6 +1147,44 @@ inline bool get(T &rop, const rational<SSize> &q)
     return q.get(rop);
 }
 
+namespace detail
+{
+
+MPPP_DLL_PUBLIC double mpq_to_double(const mpz_struct_t *, const mpz_struct_t *, fp_rounding);
+
+} // namespace detail
+
+// Conversion to double with the rounding mode rnd.
+template <std::size_t SSize>
+inline double to_double(const rational<SSize> &q, fp_rounding rnd = fp_rounding::nearest)
+{
+#if defined(MPPP_HAVE_DLIMB_T)
+    double ret;
+    if (detail::rational_1limb_to_double(ret, q, rnd)) {
+        return ret;
+    }
+#endif
+    if (q.get_den().is_one()) {
+        return to_double(q.get_num(), rnd);
+    }
+    return detail::mpq_to_double(q.get_num().get_mpz_view(), q.get_den().get_mpz_view(), rnd);
+}
+
+// Batch conversion to double.
+template <std::size_t SSize>
+inline void batch_to_double(std::vector<double> &out, const rational<SSize> *qs, std::size_t n,
+                            fp_rounding rnd = fp_rounding::nearest, unsigned nthreads = 1)
+{
+    out.resize(n);
+
+    auto func = [&out, qs, rnd](std::size_t, std::size_t begin, std::size_t end) {
+        for (auto i = begin; i != end; ++i) {
+            out[i] = to_double(qs[i], rnd);
+        }
+    };
+    detail::parallel_for_chunks(n, nthreads, func);
+}
+
 // Ternary addition.
 template <std::size_t SSize>
 inline rational<SSize> &add(rational<SSize> &rop, const rational<SSize> &op1, const rational<SSize> &op2)
@@ -957,6 +1207,16 @@ template <bool NewRop, std::size_t SSize>
 inline void mul_impl(rational<SSize> &rop, const rational<SSize> &op1, const rational<SSize> &op2)
 {
     assert(!NewRop || rop.is_zero());
+#if defined(MPPP_HAVE_DLIMB_T)
+    {
+        int sa, sc;
+        ::mp_limb_t a, b, c, d;
+        if (rational_1limb_get(sa, a, b, op1) && rational_1limb_get(sc, c, d, op2)) {
+            rational_1limb_mul(rop, sa, a, b, sc, c, d);
+            return;
+        }
+    }
+#endif
     const bool u1 = op1.get_den().is_one(), u2 = op2.get_den().is_one();
     // NOTE: it's important here to take care about overlapping arguments: we cannot use
     // rop as a "temporary" storage space, because if it overlaps with op1/op2 we will be
@@ -1038,6 +1298,17 @@ inline rational<SSize> &div(rational<SSize> &rop, const rational<SSize> &op1, co
     if (mppp_unlikely(op2.is_zero())) {
         throw zero_division_error("Zero divisor in rational division");
     }
+#if defined(MPPP_HAVE_DLIMB_T)
+    {
+        int sa, sc;
+        ::mp_limb_t a, b, c, d;
+        if (detail::rational_1limb_get(sa, a, b, op1) && detail::rational_1limb_get(sc, c, d, op2)) {
+            // (a/b) / (c/d) -> a/b * d/c, with the sign of c.
+            detail::rational_1limb_mul(rop, sa, a, b, sc, d, c);
+            return rop;
+        }
+    }
+#endif
     if (mppp_unlikely(&rop == &op2)) {
         // Following the GMP algorithm, special case in which rop and op2 are the same object.
         // This allows us to use op2.get_num() safely later, even after setting rop's num, as
@@ -1190,6 +1461,13 @@ inline rational<SSize> operator+(const rational<SSize> &q)
     return q;
 }
 
+// Identity operator for rvalues.
+template <std::size_t SSize>
+inline rational<SSize> operator+(rational<SSize> &&q)
+{
+    return std::move(q);
+}
+
 namespace detail
 {
 
@@ -1315,6 +1593,31 @@ inline T &operator+=(T &rop, const U &op)
     return rop;
 }
 
+// Binary addition operator with rvalue operands.
+// NOTE: as in the integer operators, the result is computed directly
+// into the storage of the expiring operand.
+template <std::size_t SSize, typename T,
+          detail::enable_if_t<detail::is_rational_rvalue_op_type<T, SSize>::value, int> = 0>
+inline rational<SSize> operator+(rational<SSize> &&op1, const T &op2)
+{
+    detail::dispatch_in_place_add(op1, op2);
+    return std::move(op1);
+}
+
+template <std::size_t SSize, typename T,
+          detail::enable_if_t<detail::is_rational_rvalue_op_type<T, SSize>::value, int> = 0>
+inline rational<SSize> operator+(const T &op1, rational<SSize> &&op2)
+{
+    detail::dispatch_in_place_add(op2, op1);
+    return std::move(op2);
+}
+
+template <std::size_t SSize>
+inline rational<SSize> operator+(rational<SSize> &&op1, rational<SSize> &&op2)
+{
+    return std::move(op1) + op2;
+}
+
 // Prefix increment.
 template <std::size_t SSize>
 inline rational<SSize> &operator++(rational<SSize> &q)
@@ -1341,6 +1644,14 @@ inline rational<SSize> operator-(const rational<SSize> &q)
     return retval;
 }
 
+// Negation of an rvalue.
+template <std::size_t SSize>
+inline rational<SSize> operator-(rational<SSize> &&q)
+{
+    q.neg();
+    return std::move(q);
+}
+
 namespace detail
 {
 
@@ -1470,6 +1781,31 @@ inline T &operator-=(T &rop, const U &op)
     return rop;
 }
 
+// Binary subtraction operator with rvalue operands.
+template <std::size_t SSize, typename T,
+          detail::enable_if_t<detail::is_rational_rvalue_op_type<T, SSize>::value, int> = 0>
+inline rational<SSize> operator-(rational<SSize> &&op1, const T &op2)
+{
+    detail::dispatch_in_place_sub(op1, op2);
+    return std::move(op1);
+}
+
+template <std::size_t SSize, typename T,
+          detail::enable_if_t<detail::is_rational_rvalue_op_type<T, SSize>::value, int> = 0>
+inline rational<SSize> operator-(const T &op1, rational<SSize> &&op2)
+{
+    // NOTE: op1 - op2 == -(op2 - op1).
+    detail::dispatch_in_place_sub(op2, op1);
+    op2.neg();
+    return std::move(op2);
+}
+
+template <std::size_t SSize>
+inline rational<SSize> operator-(rational<SSize> &&op1, rational<SSize> &&op2)
+{
+    return std::move(op1) - op2;
+}
+
 // Prefix decrement.
 template <std::size_t SSize>
 inline rational<SSize> &operator--(rational<SSize> &q)
@@ -1635,6 +1971,29 @@ inline T &operator*=(T &rop, const U &op)
     return rop;
 }
 
+// Binary multiplication operator with rvalue operands.
+template <std::size_t SSize, typename T,
+          detail::enable_if_t<detail::is_rational_rvalue_op_type<T, SSize>::value, int> = 0>
+inline rational<SSize> operator*(rational<SSize> &&op1, const T &op2)
+{
+    detail::dispatch_in_place_mul(op1, op2);
+    return std::move(op1);
+}
+
+template <std::size_t SSize, typename T,
+          detail::enable_if_t<detail::is_rational_rvalue_op_type<T, SSize>::value, int> = 0>
+inline rational<SSize> operator*(const T &op1, rational<SSize> &&op2)
+{
+    detail::dispatch_in_place_mul(op2, op1);
+    return std::move(op2);
+}
+
+template <std::size_t SSize>
+inline rational<SSize> operator*(rational<SSize> &&op1, rational<SSize> &&op2)
+{
+    return std::move(op1) * op2;
+}
+
 namespace detail
 {
 
@@ -1811,6 +2170,26 @@ inline void dispatch_in_place_div(T &rop, const rational<SSize> &op)
     rop = static_cast<T>(rop / op);
 }
 
+// Dispatching for the division operator with an rvalue
+// divisor: the result is written into the divisor.
+template <std::size_t SSize>
+inline void dispatch_in_place_rdiv(rational<SSize> &rop, const rational<SSize> &q)
+{
+    div(rop, q, rop);
+}
+
+template <std::size_t SSize, typename T,
+          enable_if_t<disjunction<std::is_same<T, integer<SSize>>, is_cpp_integral<T>>::value, int> = 0>
+inline void dispatch_in_place_rdiv(rational<SSize> &rop, const T &n)
+{
+    if (mppp_unlikely(rop.is_zero())) {
+        throw zero_division_error("Zero divisor in rational division");
+    }
+    // NOTE: n / rop == n * (1 / rop).
+    rop.inv();
+    dispatch_in_place_mul(rop, n);
+}
+
 } // namespace detail
 
 // In-place division operator.
@@ -1826,6 +2205,29 @@ inline T &operator/=(T &rop, const U &op)
     return rop;
 }
 
+// Binary division operator with rvalue operands.
+template <std::size_t SSize, typename T,
+          detail::enable_if_t<detail::is_rational_rvalue_op_type<T, SSize>::value, int> = 0>
+inline rational<SSize> operator/(rational<SSize> &&op1, const T &op2)
+{
+    detail::dispatch_in_place_div(op1, op2);
+    return std::move(op1);
+}
+
+template <std::size_t SSize, typename T,
+          detail::enable_if_t<detail::is_rational_rvalue_op_type<T, SSize>::value, int> = 0>
+inline rational<SSize> operator/(const T &op1, rational<SSize> &&op2)
+{
+    detail::dispatch_in_place_rdiv(op2, op1);
+    return std::move(op2);
+}
+
+template <std::size_t SSize>
+inline rational<SSize> operator/(rational<SSize> &&op1, rational<SSize> &&op2)
+{
+    return std::move(op1) / op2;
+}
+
 namespace detail
 {
 
@@ -2045,6 +2447,15 @@ inline int cmp(const rational<SSize> &op1, const rational<SSize> &op2)
     // - try to see if the limb/bit sizes of nums and dens can tell use immediately which
     //   number is larger,
     // - otherwise, do the two multiplications and compare.
+#if defined(MPPP_HAVE_DLIMB_T)
+    {
+        int sa, sc;
+        ::mp_limb_t a, b, c, d;
+        if (detail::rational_1limb_get(sa, a, b, op1) && detail::rational_1limb_get(sc, c, d, op2)) {
+            return detail::rational_1limb_cmp(sa, a, b, sc, c, d);
+        }
+    }
+#endif
     const auto v1 = detail::get_mpq_view(op1);
     const auto v2 = detail::get_mpq_view(op2);
     return mpq_cmp(&v1, &v2);
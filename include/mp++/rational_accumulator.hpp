@@ -0,0 +1,208 @@
+// Copyright 2016-2023 Francesco Biscani (bluescarni@gmail.com)
+//
+// This file is part of the mp++ library.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef MPPP_RATIONAL_ACCUMULATOR_HPP
+#define MPPP_RATIONAL_ACCUMULATOR_HPP
+
+#include <mp++/config.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+
+#include <mp++/concepts.hpp>
+#include <mp++/detail/type_traits.hpp>
+#include <mp++/integer.hpp>
+#include <mp++/rational.hpp>
+
+MPPP_BEGIN_NAMESPACE
+
+namespace detail
+{
+
+// Minimum size (in limbs) of the denominator above which
+// a rational_accumulator canonicalises its state.
+constexpr std::size_t rational_accumulator_min_den_size = 8;
+
+} // namespace detail
+
+// Accumulator for sums and products of rationals with
+// deferred canonicalisation.
+template <std::size_t SSize>
+class rational_accumulator
+{
+public:
+    // Default constructor, the initial value is zero.
+    rational_accumulator() : m_den(1u) {}
+    // Constructor from a rational.
+    explicit rational_accumulator(const rational<SSize> &q) : m_num(q.get_num()), m_den(q.get_den()) {}
+
+    // In-place addition.
+    rational_accumulator &operator+=(const rational<SSize> &q)
+    {
+        addsub<true>(q.get_num(), q.get_den());
+        return *this;
+    }
+    rational_accumulator &operator+=(const integer<SSize> &n)
+    {
+        addmul(m_num, n, m_den);
+        return *this;
+    }
+#if defined(MPPP_HAVE_CONCEPTS)
+    template <cpp_integral T>
+#else
+    template <typename T, detail::enable_if_t<is_cpp_integral<T>::value, int> = 0>
+#endif
+    rational_accumulator &operator+=(const T &n)
+    {
+        return *this += integer<SSize>{n};
+    }
+
+    // In-place subtraction.
+    rational_accumulator &operator-=(const rational<SSize> &q)
+    {
+        addsub<false>(q.get_num(), q.get_den());
+        return *this;
+    }
+    rational_accumulator &operator-=(const integer<SSize> &n)
+    {
+        submul(m_num, n, m_den);
+        return *this;
+    }
+#if defined(MPPP_HAVE_CONCEPTS)
+    template <cpp_integral T>
+#else
+    template <typename T, detail::enable_if_t<is_cpp_integral<T>::value, int> = 0>
+#endif
+    rational_accumulator &operator-=(const T &n)
+    {
+        return *this -= integer<SSize>{n};
+    }
+
+    // In-place multiplication.
+    rational_accumulator &operator*=(const rational<SSize> &q)
+    {
+        mul(m_num, m_num, q.get_num());
+        mul(m_den, m_den, q.get_den());
+        fix_zero();
+        check_den_size();
+        return *this;
+    }
+    rational_accumulator &operator*=(const integer<SSize> &n)
+    {
+        mul(m_num, m_num, n);
+        fix_zero();
+        return *this;
+    }
+#if defined(MPPP_HAVE_CONCEPTS)
+    template <cpp_integral T>
+#else
+    template <typename T, detail::enable_if_t<is_cpp_integral<T>::value, int> = 0>
+#endif
+    rational_accumulator &operator*=(const T &n)
+    {
+        return *this *= integer<SSize>{n};
+    }
+
+    // Canonicalise the internal state.
+    void canonicalise()
+    {
+        gcd(m_g, m_num, m_den);
+        if (!m_g.is_one()) {
+            divexact_gcd(m_num, m_num, m_g);
+            divexact_gcd(m_den, m_den, m_g);
+        }
+        m_max_den_size = std::max(detail::rational_accumulator_min_den_size, m_den.size() * 2u);
+    }
+
+    // Getters.
+    MPPP_NODISCARD rational<SSize> get() const
+    {
+        return rational<SSize>{m_num, m_den};
+    }
+    MPPP_NODISCARD const integer<SSize> &get_num() const
+    {
+        return m_num;
+    }
+    MPPP_NODISCARD const integer<SSize> &get_den() const
+    {
+        return m_den;
+    }
+
+private:
+    // Add/subtract n / d, with d positive.
+    template <bool AddOrSub>
+    void addsub(const integer<SSize> &n, const integer<SSize> &d)
+    {
+        assert(d.sgn() > 0);
+
+        if (d.is_one()) {
+            AddOrSub ? addmul(m_num, n, m_den) : submul(m_num, n, m_den);
+            return;
+        }
+        if (m_den.is_one()) {
+            // a / 1 + n / d = (a * d + n) / d.
+            mul(m_num, m_num, d);
+            AddOrSub ? add(m_num, m_num, n) : sub(m_num, m_num, n);
+            m_den = d;
+            check_den_size();
+            return;
+        }
+
+        // NOTE: the common case in long summations is that d divides
+        // the current denominator (e.g., because the denominator
+        // of the accumulator is already a multiple of all the denominators
+        // added so far). In such case, the numerator is updated with a
+        // single multiply-add, and no gcd is computed.
+        tdiv_qr(m_q, m_g, m_den, d);
+        if (m_g.is_zero()) {
+            AddOrSub ? addmul(m_num, n, m_q) : submul(m_num, n, m_q);
+            return;
+        }
+
+        // Otherwise, switch to lcm(m_den, d) as common denominator.
+        // NOTE: gcd(m_den, d) == gcd(d, m_den mod d), and the remainder
+        // is not larger than d. Contrary to the eager rational addition,
+        // the result is not reduced.
+        gcd(m_g, d, m_g);
+        divexact_gcd(m_q, d, m_g);
+        divexact_gcd(m_g, m_den, m_g);
+        mul(m_num, m_num, m_q);
+        AddOrSub ? addmul(m_num, n, m_g) : submul(m_num, n, m_g);
+        mul(m_den, m_den, m_q);
+        check_den_size();
+    }
+    // Reset the denominator if the numerator is zero.
+    void fix_zero()
+    {
+        if (m_num.is_zero()) {
+            m_den.set_one();
+        }
+    }
+    // Canonicalise if the denominator grew too large.
+    // NOTE: the threshold is at least doubled after each canonicalisation,
+    // so that the cost of the reductions is amortised if the denominator
+    // keeps on growing after canonicalisation.
+    void check_den_size()
+    {
+        if (m_den.size() > m_max_den_size) {
+            canonicalise();
+        }
+    }
+
+    integer<SSize> m_num;
+    integer<SSize> m_den;
+    std::size_t m_max_den_size = detail::rational_accumulator_min_den_size;
+    // Scratch space.
+    integer<SSize> m_q;
+    integer<SSize> m_g;
+};
+
+MPPP_END_NAMESPACE
+
+#endif
@@ -165,6 +165,13 @@ real mpfr_nary_op_return_impl(::mpfr_prec_t, const F &, Arg0 &&, Args &&...);
 template <typename F>
 real real_constant(const F &, ::mpfr_prec_t);
 
+// Init/clear an mpfr_t via the thread-local cache.
+MPPP_DLL_PUBLIC void mpfr_init2_cached(mpfr_struct_t &, ::mpfr_prec_t);
+MPPP_DLL_PUBLIC void mpfr_clear_cached(mpfr_struct_t &);
+
+// Compute the binary size of a serialised real from its serialised precision.
+MPPP_DLL_PUBLIC std::size_t real_binary_size_from_prec(::mpfr_prec_t);
+
 // Wrapper for calling mpfr_lgamma().
 MPPP_DLL_PUBLIC void real_lgamma_wrapper(::mpfr_t, const ::mpfr_t, ::mpfr_rnd_t);
 
@@ -1404,8 +1411,8 @@ MPPP_DLL_PUBLIC real &set_si_2exp(real &, long, ::mpfr_exp_t);
 template <std::size_t SSize>
 // NOLINTNEXTLINE(cppcoreguidelines-pro-type-member-init, hicpp-member-init, bugprone-easily-swappable-parameters)
 inline real::real(const integer<SSize> &n, ::mpfr_exp_t e, ::mpfr_prec_t p)
+    : real(ptag{}, check_init_prec(p), true)
 {
-    ::mpfr_init2(&m_mpfr, check_init_prec(p));
     set_z_2exp(*this, n, e);
 }
 
@@ -1478,16 +1485,23 @@ inline mpfr_exp_t get_z_2exp(integer<SSize> &n, const real &r)
 namespace detail
 {
 
+// Detect if we can steal resources from an argument of type T in the helpers below.
+// This is true only for non-const rvalue references to real: other types
+// providing get_prec() and get_mpfr_t() (e.g., static_real) can be passed
+// to the helpers as input arguments, but their resources are not stealable.
+template <typename T>
+using mpfr_nary_op_stealable = conjunction<is_ncrvr<T>, std::is_same<uncvref_t<T>, real>>;
+
 // A small helper to init the pairs in the functions below. We need this because
 // we cannot take the address of a const real as a real *.
-template <typename Arg, enable_if_t<!is_ncrvr<Arg &&>::value, int> = 0>
+template <typename Arg, enable_if_t<!mpfr_nary_op_stealable<Arg &&>::value, int> = 0>
 inline std::pair<real *, ::mpfr_prec_t> mpfr_nary_op_init_pair(::mpfr_prec_t min_prec, Arg &&arg)
 {
     // arg is not a non-const rvalue ref, we cannot steal from it. Init with nullptr.
     return std::make_pair(static_cast<real *>(nullptr), c_max(arg.get_prec(), min_prec));
 }
 
-template <typename Arg, enable_if_t<is_ncrvr<Arg &&>::value, int> = 0>
+template <typename Arg, enable_if_t<mpfr_nary_op_stealable<Arg &&>::value, int> = 0>
 inline std::pair<real *, ::mpfr_prec_t> mpfr_nary_op_init_pair(::mpfr_prec_t min_prec, Arg &&arg)
 {
     // arg is a non-const rvalue ref, and a candidate for stealing resources.
@@ -1501,13 +1515,13 @@ inline void mpfr_nary_op_check_steal(std::pair<real *, ::mpfr_prec_t> &) {}
 
 // NOTE: we need 2 overloads for this, as we cannot extract a non-const pointer from
 // arg0 if arg0 is a const ref.
-template <typename Arg0, typename... Args, enable_if_t<!is_ncrvr<Arg0 &&>::value, int> = 0>
+template <typename Arg0, typename... Args, enable_if_t<!mpfr_nary_op_stealable<Arg0 &&>::value, int> = 0>
 void mpfr_nary_op_check_steal(std::pair<real *, ::mpfr_prec_t> &, Arg0 &&, Args &&...);
 
-template <typename Arg0, typename... Args, enable_if_t<is_ncrvr<Arg0 &&>::value, int> = 0>
+template <typename Arg0, typename... Args, enable_if_t<mpfr_nary_op_stealable<Arg0 &&>::value, int> = 0>
 void mpfr_nary_op_check_steal(std::pair<real *, ::mpfr_prec_t> &, Arg0 &&, Args &&...);
 
-template <typename Arg0, typename... Args, enable_if_t<!is_ncrvr<Arg0 &&>::value, int>>
+template <typename Arg0, typename... Args, enable_if_t<!mpfr_nary_op_stealable<Arg0 &&>::value, int>>
 inline void mpfr_nary_op_check_steal(std::pair<real *, ::mpfr_prec_t> &p, Arg0 &&arg0, Args &&...args)
 {
     // arg0 is not a non-const rvalue ref, we won't be able to steal from it regardless. Just
@@ -1516,7 +1530,7 @@ inline void mpfr_nary_op_check_steal(std::pair<real *, ::mpfr_prec_t> &p, Arg0 &
     mpfr_nary_op_check_steal(p, std::forward<Args>(args)...);
 }
 
-template <typename Arg0, typename... Args, enable_if_t<is_ncrvr<Arg0 &&>::value, int>>
+template <typename Arg0, typename... Args, enable_if_t<mpfr_nary_op_stealable<Arg0 &&>::value, int>>
 inline void mpfr_nary_op_check_steal(std::pair<real *, ::mpfr_prec_t> &p, Arg0 &&arg0, Args &&...args)
 {
     const auto prec0 = arg0.get_prec();
@@ -2693,6 +2707,9 @@ inline auto binary_load(real &x, T &&src) -> decltype(x.binary_load(std::forward
     return x.binary_load(std::forward<T>(src));
 }
 
+// Free the real caches.
+MPPP_DLL_PUBLIC void free_real_caches();
+
 // Constants.
 MPPP_DLL_PUBLIC real real_pi(::mpfr_prec_t);
 MPPP_DLL_PUBLIC real &real_pi(real &);
@@ -0,0 +1,555 @@
+// Copyright 2016-2023 Francesco Biscani (bluescarni@gmail.com)
+//
+// This file is part of the mp++ library.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef MPPP_STATIC_REAL_HPP
+#define MPPP_STATIC_REAL_HPP
+
+#include <mp++/config.hpp>
+
+#if defined(MPPP_WITH_MPFR)
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <limits>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include <mp++/concepts.hpp>
+#include <mp++/detail/gmp.hpp>
+#include <mp++/detail/mpfr.hpp>
+#include <mp++/detail/type_traits.hpp>
+#include <mp++/detail/utils.hpp>
+#include <mp++/integer.hpp>
+#include <mp++/rational.hpp>
+#include <mp++/real.hpp>
+
+MPPP_BEGIN_NAMESPACE
+
+template <::mpfr_prec_t>
+class static_real;
+
+namespace detail
+{
+
+template <typename>
+struct is_static_real : std::false_type {
+};
+
+template <::mpfr_prec_t NBits>
+struct is_static_real<static_real<NBits>> : std::true_type {
+};
+
+// Number of limbs needed to store the significand
+// of an MPFR float with precision p.
+constexpr std::size_t static_real_nlimbs(::mpfr_prec_t p)
+{
+    return static_cast<std::size_t>(p / GMP_NUMB_BITS + ((p % GMP_NUMB_BITS) != 0));
+}
+
+// The smallest precision which allows to represent exactly
+// all the values of the C++ arithmetic type T.
+template <typename T>
+constexpr ::mpfr_prec_t static_real_exact_prec()
+{
+    return c_max(real_prec_min(), static_cast<::mpfr_prec_t>(nl_digits<T>()));
+}
+
+template <typename T>
+using static_real_exact_t = static_real<static_real_exact_prec<T>()>;
+
+// Setters for the MPFR struct r, which must have been already inited.
+inline void static_real_set(mpfr_struct_t &r, const bool &b)
+{
+    mpfr_set_ui(&r, static_cast<unsigned long>(b), MPFR_RNDN);
+}
+
+template <typename T, enable_if_t<conjunction<is_cpp_unsigned_integral<T>, negation<std::is_same<T, bool>>>::value,
+                                  int> = 0>
+inline void static_real_set(mpfr_struct_t &r, const T &n)
+{
+    if (n <= nl_max<unsigned long>()) {
+        mpfr_set_ui(&r, static_cast<unsigned long>(n), MPFR_RNDN);
+    } else {
+        ::mpfr_set_z(&r, integer<2>(n).get_mpz_view(), MPFR_RNDN);
+    }
+}
+
+template <typename T, enable_if_t<is_cpp_signed_integral<T>::value, int> = 0>
+inline void static_real_set(mpfr_struct_t &r, const T &n)
+{
+    if (n <= nl_max<long>() && n >= nl_min<long>()) {
+        mpfr_set_si(&r, static_cast<long>(n), MPFR_RNDN);
+    } else {
+        ::mpfr_set_z(&r, integer<2>(n).get_mpz_view(), MPFR_RNDN);
+    }
+}
+
+template <typename T, enable_if_t<is_cpp_floating_point<T>::value, int> = 0>
+inline void static_real_set(mpfr_struct_t &r, const T &x)
+{
+    // NOTE: the exact precision computed in static_real_exact_prec()
+    // assumes a binary floating-point type.
+    static_assert(std::numeric_limits<T>::radix == 2, "static_real requires binary floating-point types.");
+
+    if (std::is_same<T, long double>::value) {
+        ::mpfr_set_ld(&r, static_cast<long double>(x), MPFR_RNDN);
+    } else {
+        ::mpfr_set_d(&r, static_cast<double>(x), MPFR_RNDN);
+    }
+}
+
+template <std::size_t SSize>
+inline void static_real_set(mpfr_struct_t &r, const integer<SSize> &n)
+{
+    ::mpfr_set_z(&r, n.get_mpz_view(), MPFR_RNDN);
+}
+
+template <std::size_t SSize>
+inline void static_real_set(mpfr_struct_t &r, const rational<SSize> &q)
+{
+    const auto v = get_mpq_view(q);
+    ::mpfr_set_q(&r, &v, MPFR_RNDN);
+}
+
+// Fetch the operand of a static_real operation. Other static_real
+// and real objects are returned as they are, C++ arithmetic values
+// are converted exactly to a static_real with a suitable precision.
+template <::mpfr_prec_t NBits>
+inline const static_real<NBits> &static_real_operand(const static_real<NBits> &x)
+{
+    return x;
+}
+
+inline const real &static_real_operand(const real &x)
+{
+    return x;
+}
+
+template <typename T, enable_if_t<is_cpp_arithmetic<T>::value, int> = 0>
+inline static_real_exact_t<T> static_real_operand(const T &x)
+{
+    return static_real_exact_t<T>(x);
+}
+
+} // namespace detail
+
+template <typename T>
+using is_static_real_interoperable
+    = detail::disjunction<is_cpp_arithmetic<T>, detail::is_integer<T>, detail::is_rational<T>>;
+
+#if defined(MPPP_HAVE_CONCEPTS)
+
+template <typename T>
+MPPP_CONCEPT_DECL static_real_interoperable = is_static_real_interoperable<T>::value;
+
+#endif
+
+// Multiprecision floating-point class with a fixed precision.
+//
+// The significand is stored inline, so that no memory allocation is needed during
+// the lifetime of a static_real. The MPFR struct is set up via the MPFR custom interface,
+// and its significand pointer points into the object itself.
+template <::mpfr_prec_t NBits>
+class static_real
+{
+    static_assert(detail::real_prec_check(NBits), "Invalid precision for a static_real.");
+
+    template <::mpfr_prec_t>
+    friend class static_real;
+
+public:
+    // Number of limbs used to store the significand.
+    static constexpr std::size_t nlimbs = detail::static_real_nlimbs(NBits);
+
+    // Default constructor: the value will be zero.
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-member-init, hicpp-member-init)
+    static_real() : m_limbs()
+    {
+        // NOTE: this is checked only at runtime as mpfr_custom_get_size()
+        // is not a constant expression.
+        assert(mpfr_custom_get_size(NBits) == nlimbs * sizeof(::mp_limb_t));
+        mpfr_custom_init(m_limbs.data(), NBits);
+        mpfr_custom_init_set(&m_mpfr, MPFR_ZERO_KIND, 0, NBits, m_limbs.data());
+    }
+    // Copy constructor.
+    // NOTE: the precision is the same, thus we can just copy
+    // the exponent, sign and limbs of other and fix the significand pointer.
+    static_real(const static_real &other) noexcept : m_mpfr(other.m_mpfr), m_limbs(other.m_limbs)
+    {
+        m_mpfr._mpfr_d = m_limbs.data();
+    }
+    // Move constructor (equivalent to the copy constructor).
+    static_real(static_real &&other) noexcept : static_real(static_cast<const static_real &>(other)) {}
+    // Generic constructor.
+#if defined(MPPP_HAVE_CONCEPTS)
+    template <static_real_interoperable T>
+#else
+    template <typename T, detail::enable_if_t<is_static_real_interoperable<T>::value, int> = 0>
+#endif
+    // NOLINTNEXTLINE(google-explicit-constructor, hicpp-explicit-conversions)
+    static_real(const T &x) : static_real()
+    {
+        detail::static_real_set(m_mpfr, x);
+    }
+    // Constructor from static_real with a different precision.
+    template <::mpfr_prec_t NBits2, detail::enable_if_t<NBits2 != NBits, int> = 0>
+    explicit static_real(const static_real<NBits2> &other) : static_real()
+    {
+        mpfr_set(&m_mpfr, other.get_mpfr_t(), MPFR_RNDN);
+    }
+    // Constructor from real.
+    explicit static_real(const real &r) : static_real()
+    {
+        mpfr_set(&m_mpfr, r.get_mpfr_t(), MPFR_RNDN);
+    }
+    // Constructor from mpfr_t.
+    explicit static_real(const ::mpfr_t x) : static_real()
+    {
+        mpfr_set(&m_mpfr, x, MPFR_RNDN);
+    }
+    // Constructor from C string.
+    explicit static_real(const char *s, int base = 10) : static_real()
+    {
+        if (mppp_unlikely(base && (base < 2 || base > 62))) {
+            throw std::invalid_argument("Cannot construct a static_real from a string in base "
+                                        + detail::to_string(base)
+                                        + ": the base must either be zero or in the [2,62] range");
+        }
+        if (mppp_unlikely(::mpfr_set_str(&m_mpfr, s, base, MPFR_RNDN) == -1)) {
+            throw std::invalid_argument(std::string{"The string '"} + s
+                                        + "' does not represent a valid static_real in base "
+                                        + detail::to_string(base));
+        }
+    }
+    // Constructor from std::string.
+    explicit static_real(const std::string &s, int base = 10) : static_real(s.c_str(), base) {}
+
+    // Copy assignment operator.
+    static_real &operator=(const static_real &other) noexcept
+    {
+        // NOTE: self-assignment is harmless here.
+        m_mpfr._mpfr_sign = other.m_mpfr._mpfr_sign;
+        m_mpfr._mpfr_exp = other.m_mpfr._mpfr_exp;
+        m_limbs = other.m_limbs;
+        return *this;
+    }
+    // Move assignment operator (equivalent to the copy assignment operator).
+    static_real &operator=(static_real &&other) noexcept
+    {
+        return *this = static_cast<const static_real &>(other);
+    }
+    // Generic assignment operator.
+#if defined(MPPP_HAVE_CONCEPTS)
+    template <static_real_interoperable T>
+#else
+    template <typename T, detail::enable_if_t<is_static_real_interoperable<T>::value, int> = 0>
+#endif
+    static_real &operator=(const T &x)
+    {
+        detail::static_real_set(m_mpfr, x);
+        return *this;
+    }
+
+    ~static_real() = default;
+
+    // Precision.
+    static constexpr ::mpfr_prec_t get_prec()
+    {
+        return NBits;
+    }
+
+    // Const reference to the internal mpfr_t.
+    MPPP_NODISCARD const mpfr_struct_t *get_mpfr_t() const
+    {
+        return &m_mpfr;
+    }
+    // Mutable reference to the internal mpfr_t.
+    // NOTE: the precision and the significand pointer
+    // of the returned object must not be changed.
+    mpfr_struct_t *_get_mpfr_t()
+    {
+        return &m_mpfr;
+    }
+
+    // Detect NaN.
+    MPPP_NODISCARD bool nan_p() const
+    {
+        return mpfr_nan_p(&m_mpfr) != 0;
+    }
+    // Detect infinity.
+    MPPP_NODISCARD bool inf_p() const
+    {
+        return mpfr_inf_p(&m_mpfr) != 0;
+    }
+    // Detect finite number.
+    MPPP_NODISCARD bool number_p() const
+    {
+        return mpfr_number_p(&m_mpfr) != 0;
+    }
+    // Detect zero.
+    MPPP_NODISCARD bool zero_p() const
+    {
+        return mpfr_zero_p(&m_mpfr) != 0;
+    }
+    // Detect sign.
+    MPPP_NODISCARD int sgn() const
+    {
+        if (mppp_unlikely(nan_p())) {
+            throw std::domain_error("Cannot determine the sign of a static_real NaN");
+        }
+        return mpfr_sgn(&m_mpfr);
+    }
+    // Get the sign bit.
+    MPPP_NODISCARD bool signbit() const
+    {
+        return mpfr_signbit(&m_mpfr) != 0;
+    }
+
+    // Conversion to real.
+    explicit operator real() const
+    {
+        return real{&m_mpfr};
+    }
+    // Conversion to the interoperable types.
+#if defined(MPPP_HAVE_CONCEPTS)
+    template <real_interoperable T>
+#else
+    template <typename T, detail::enable_if_t<is_real_interoperable<T>::value, int> = 0>
+#endif
+    explicit operator T() const
+    {
+        return dispatch_conversion<T>();
+    }
+
+    // Convert to string.
+    MPPP_NODISCARD std::string to_string(int base = 10) const
+    {
+        return real{&m_mpfr}.to_string(base);
+    }
+
+private:
+    template <typename T, detail::enable_if_t<std::is_floating_point<T>::value, int> = 0>
+    MPPP_NODISCARD T dispatch_conversion() const
+    {
+        if (std::is_same<T, float>::value) {
+            return static_cast<T>(::mpfr_get_flt(&m_mpfr, MPFR_RNDN));
+        }
+        if (std::is_same<T, double>::value) {
+            return static_cast<T>(::mpfr_get_d(&m_mpfr, MPFR_RNDN));
+        }
+        return static_cast<T>(::mpfr_get_ld(&m_mpfr, MPFR_RNDN));
+    }
+    // NOTE: the other conversions go through real, which takes care
+    // of the error handling.
+    template <typename T, detail::enable_if_t<!std::is_floating_point<T>::value, int> = 0>
+    MPPP_NODISCARD T dispatch_conversion() const
+    {
+        return static_cast<T>(real{&m_mpfr});
+    }
+
+    mpfr_struct_t m_mpfr;
+    std::array<::mp_limb_t, nlimbs> m_limbs;
+};
+
+#if MPPP_CPLUSPLUS < 201703L
+
+// NOTE: see the explanation in integer.hpp regarding static constexpr variables in C++17.
+
+template <::mpfr_prec_t NBits>
+constexpr std::size_t static_real<NBits>::nlimbs;
+
+#endif
+
+namespace detail
+{
+
+// static_real-static_real (with the same precision), static_real-C++ arithmetic
+// and C++ arithmetic-static_real.
+template <typename T, typename U>
+using are_static_real_op_types
+    = disjunction<conjunction<is_static_real<T>, std::is_same<T, U>>,
+                  conjunction<is_static_real<T>, is_cpp_arithmetic<U>>,
+                  conjunction<is_cpp_arithmetic<T>, is_static_real<U>>>;
+
+template <typename T, typename U>
+using static_real_op_result_t = typename std::conditional<is_static_real<T>::value, T, U>::type;
+
+// static_real-real and real-static_real. The arguments are forwarding references.
+template <typename T, typename U>
+using are_static_real_real_op_types
+    = disjunction<conjunction<is_static_real<uncvref_t<T>>, is_cvr_real<U>>,
+                  conjunction<is_cvr_real<T>, is_static_real<uncvref_t<U>>>>;
+
+// Invoke the MPFR function f on the operands a and b, returning
+// the result as a static_real.
+template <typename F, typename T, typename U>
+inline static_real_op_result_t<T, U> static_real_binary_op(const F &f, const T &a, const U &b)
+{
+    static_real_op_result_t<T, U> retval;
+    const auto &ao = static_real_operand(a);
+    const auto &bo = static_real_operand(b);
+    f(retval._get_mpfr_t(), ao.get_mpfr_t(), bo.get_mpfr_t(), MPFR_RNDN);
+    return retval;
+}
+
+// Invoke the MPFR function f on a and b, storing the result in a.
+template <typename F, ::mpfr_prec_t NBits, typename T>
+inline static_real<NBits> &static_real_in_place_op(const F &f, static_real<NBits> &a, const T &b)
+{
+    const auto &bo = static_real_operand(b);
+    f(a._get_mpfr_t(), a.get_mpfr_t(), bo.get_mpfr_t(), MPFR_RNDN);
+    return a;
+}
+
+// Invoke the MPFR predicate f on the operands a and b.
+template <typename F, typename T, typename U>
+inline bool static_real_cmp_op(const F &f, const T &a, const U &b)
+{
+    const auto &ao = static_real_operand(a);
+    const auto &bo = static_real_operand(b);
+    return f(ao.get_mpfr_t(), bo.get_mpfr_t()) != 0;
+}
+
+} // namespace detail
+
+#if defined(MPPP_HAVE_CONCEPTS)
+
+template <typename T, typename U>
+MPPP_CONCEPT_DECL static_real_op_types = detail::are_static_real_op_types<T, U>::value;
+
+#endif
+
+// Identity operator.
+template <::mpfr_prec_t NBits>
+inline static_real<NBits> operator+(const static_real<NBits> &x)
+{
+    return x;
+}
+
+// Negation operator.
+template <::mpfr_prec_t NBits>
+inline static_real<NBits> operator-(const static_real<NBits> &x)
+{
+    auto retval(x);
+    ::mpfr_neg(retval._get_mpfr_t(), retval.get_mpfr_t(), MPFR_RNDN);
+    return retval;
+}
+
+// Absolute value.
+template <::mpfr_prec_t NBits>
+inline static_real<NBits> abs(const static_real<NBits> &x)
+{
+    auto retval(x);
+    ::mpfr_abs(retval._get_mpfr_t(), retval.get_mpfr_t(), MPFR_RNDN);
+    return retval;
+}
+
+// Square root.
+template <::mpfr_prec_t NBits>
+inline static_real<NBits> sqrt(const static_real<NBits> &x)
+{
+    static_real<NBits> retval;
+    ::mpfr_sqrt(retval._get_mpfr_t(), x.get_mpfr_t(), MPFR_RNDN);
+    return retval;
+}
+
+// Fused multiply-add.
+template <::mpfr_prec_t NBits>
+inline static_real<NBits> fma(const static_real<NBits> &a, const static_real<NBits> &b, const static_real<NBits> &c)
+{
+    static_real<NBits> retval;
+    ::mpfr_fma(retval._get_mpfr_t(), a.get_mpfr_t(), b.get_mpfr_t(), c.get_mpfr_t(), MPFR_RNDN);
+    return retval;
+}
+
+// Stream operator.
+template <::mpfr_prec_t NBits>
+inline std::ostream &operator<<(std::ostream &os, const static_real<NBits> &x)
+{
+    return os << static_cast<real>(x);
+}
+
+// NOTE: the binary operators involving static_real and real return a real
+// whose precision is the largest among the operands'. They are implemented on top
+// of the real machinery, so that the resources of real rvalue references are reused.
+#define MPPP_STATIC_REAL_BINARY_OP(op, mpfr_f)                                                                         \
+    template <typename T, typename U, detail::enable_if_t<detail::are_static_real_op_types<T, U>::value, int> = 0>     \
+    inline detail::static_real_op_result_t<T, U> operator op(const T &a, const U &b)                                   \
+    {                                                                                                                  \
+        return detail::static_real_binary_op(mpfr_f, a, b);                                                            \
+    }                                                                                                                  \
+    template <typename T, typename U,                                                                                  \
+              detail::enable_if_t<detail::are_static_real_real_op_types<T, U>::value, int> = 0>                        \
+    inline real operator op(T &&a, U &&b)                                                                              \
+    {                                                                                                                  \
+        return detail::mpfr_nary_op_return_impl<true>(0, mpfr_f, std::forward<T>(a), std::forward<U>(b));             \
+    }                                                                                                                  \
+    template <::mpfr_prec_t NBits, typename T,                                                                         \
+              detail::enable_if_t<detail::disjunction<std::is_same<T, static_real<NBits>>, is_cpp_arithmetic<T>,       \
+                                                      std::is_same<T, real>>::value,                                   \
+                                  int>                                                                                 \
+              = 0>                                                                                                     \
+    inline static_real<NBits> &operator op##=(static_real<NBits> &a, const T &b)                                       \
+    {                                                                                                                  \
+        return detail::static_real_in_place_op(mpfr_f, a, b);                                                          \
+    }                                                                                                                  \
+    template <::mpfr_prec_t NBits>                                                                                     \
+    inline real &operator op##=(real &a, const static_real<NBits> &b)                                                  \
+    {                                                                                                                  \
+        return detail::mpfr_nary_op_impl<true>(0, mpfr_f, a, a, b);                                                    \
+    }
+
+MPPP_STATIC_REAL_BINARY_OP(+, ::mpfr_add)
+MPPP_STATIC_REAL_BINARY_OP(-, ::mpfr_sub)
+MPPP_STATIC_REAL_BINARY_OP(*, ::mpfr_mul)
+MPPP_STATIC_REAL_BINARY_OP(/, ::mpfr_div)
+
+#undef MPPP_STATIC_REAL_BINARY_OP
+
+// NOTE: the comparison operators follow the IEEE semantics
+// for NaN values, like the comparison operators of real.
+#define MPPP_STATIC_REAL_CMP_OP(op, mpfr_f)                                                                            \
+    template <typename T, typename U,                                                                                  \
+              detail::enable_if_t<detail::disjunction<detail::are_static_real_op_types<T, U>,                          \
+                                                      detail::are_static_real_real_op_types<T, U>>::value,             \
+                                  int>                                                                                 \
+              = 0>                                                                                                     \
+    inline bool operator op(const T &a, const U &b)                                                                    \
+    {                                                                                                                  \
+        return detail::static_real_cmp_op(mpfr_f, a, b);                                                               \
+    }
+
+MPPP_STATIC_REAL_CMP_OP(==, ::mpfr_equal_p)
+MPPP_STATIC_REAL_CMP_OP(<, ::mpfr_less_p)
+MPPP_STATIC_REAL_CMP_OP(<=, ::mpfr_lessequal_p)
+MPPP_STATIC_REAL_CMP_OP(>, ::mpfr_greater_p)
+MPPP_STATIC_REAL_CMP_OP(>=, ::mpfr_greaterequal_p)
+
+#undef MPPP_STATIC_REAL_CMP_OP
+
+// NOTE: implement inequality in terms of equality, so that
+// NaN values compare different from anything.
+template <typename T, typename U,
+          detail::enable_if_t<detail::disjunction<detail::are_static_real_op_types<T, U>,
+                                                  detail::are_static_real_real_op_types<T, U>>::value,
+                              int>
+          = 0>
+inline bool operator!=(const T &a, const U &b)
+{
+    return !(a == b);
+}
+
+MPPP_END_NAMESPACE
+
+#endif
+
+#endif
@@ -0,0 +1,509 @@
+// Copyright 2016-2023 Francesco Biscani (bluescarni@gmail.com)
+//
+// This file is part of the mp++ library.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <mp++/config.hpp>
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <ios>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+
+#define MPPP_ARRAY_FILE_MMAP
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#endif
+
+#include <mp++/array_file.hpp>
+#include <mp++/detail/gmp.hpp>
+#include <mp++/detail/utils.hpp>
+
+#if defined(MPPP_WITH_MPFR)
+#include <mp++/detail/mpfr.hpp>
+#include <mp++/real.hpp>
+#endif
+
+MPPP_BEGIN_NAMESPACE
+
+namespace detail
+{
+
+namespace
+{
+
+constexpr std::array<char, 8> array_file_magic = {{'M', 'P', 'P', 'P', 'A', 'R', 'R', '\0'}};
+
+// Number of columns in the size/offset table for each kind of object.
+std::size_t array_file_ncols(array_file_kind kind)
+{
+    return kind == array_file_kind::real ? 4u : 2u;
+}
+
+// Number of entries in each column for n objects of the given kind.
+std::uint64_t array_file_nentries(array_file_kind kind, std::uint64_t n)
+{
+    return kind == array_file_kind::rational ? n * 2u : n;
+}
+
+// Offset of the end of the size/offset table.
+std::uint64_t array_file_table_end(const array_file_header &h)
+{
+    const auto kind = static_cast<array_file_kind>(h.kind);
+    return h.columns[array_file_ncols(kind) - 1u] + array_file_nentries(kind, h.n) * sizeof(std::uint64_t);
+}
+
+[[noreturn]] void array_file_overflow()
+{
+    throw std::overflow_error("Overflow in the computation of the size of an array file");
+}
+
+} // namespace
+
+array_file_header array_file_make_header(array_file_kind kind, std::size_t n, std::size_t ncols, std::size_t nentries,
+                                         std::size_t nlimbs)
+{
+    assert(ncols == array_file_ncols(kind));
+    assert(nentries == array_file_nentries(kind, n));
+
+    array_file_header h{};
+
+    h.magic = array_file_magic;
+    h.version = array_file_version;
+    h.endian = array_file_endian;
+    h.kind = static_cast<std::uint32_t>(kind);
+    h.limb_size = static_cast<std::uint32_t>(sizeof(::mp_limb_t));
+    h.numb_bits = static_cast<std::uint32_t>(GMP_NUMB_BITS);
+    h.n = static_cast<std::uint64_t>(n);
+    h.nlimbs = static_cast<std::uint64_t>(nlimbs);
+
+    constexpr auto u64_max = nl_max<std::uint64_t>();
+
+    // The columns follow the header.
+    if (mppp_unlikely(static_cast<std::uint64_t>(nentries) > u64_max / sizeof(std::uint64_t))) {
+        array_file_overflow();
+    }
+    const auto col_size = static_cast<std::uint64_t>(nentries) * sizeof(std::uint64_t);
+    std::uint64_t offset = sizeof(array_file_header);
+    for (std::size_t i = 0; i < ncols; ++i) {
+        h.columns[i] = offset;
+        if (mppp_unlikely(col_size > u64_max - offset)) {
+            array_file_overflow();
+        }
+        offset += col_size;
+    }
+
+    // The limb blob is aligned to array_file_align.
+    if (mppp_unlikely(offset > u64_max - (array_file_align - 1u))) {
+        array_file_overflow();
+    }
+    h.limbs_offset = (offset + (array_file_align - 1u)) / array_file_align * array_file_align;
+
+    if (mppp_unlikely(static_cast<std::uint64_t>(nlimbs) > (u64_max - h.limbs_offset) / sizeof(::mp_limb_t))) {
+        array_file_overflow();
+    }
+    h.file_size = h.limbs_offset + static_cast<std::uint64_t>(nlimbs) * sizeof(::mp_limb_t);
+
+    return h;
+}
+
+void array_file_write_header(std::ofstream &os, const array_file_header &h)
+{
+    os.write(reinterpret_cast<const char *>(&h), static_cast<std::streamsize>(sizeof(h)));
+}
+
+void array_file_write_padding(std::ofstream &os, const array_file_header &h)
+{
+    const std::array<char, array_file_align> zeroes{};
+    const auto npad = h.limbs_offset - array_file_table_end(h);
+    assert(npad < array_file_align);
+    os.write(zeroes.data(), static_cast<std::streamsize>(npad));
+}
+
+std::ofstream array_file_open(const std::string &path)
+{
+    std::ofstream os(path, std::ios::binary | std::ios::trunc);
+    if (mppp_unlikely(!os)) {
+        throw std::runtime_error("Cannot open the file '" + path + "' for writing");
+    }
+    return os;
+}
+
+void array_file_close(std::ofstream &os, const std::string &path)
+{
+    os.close();
+    if (mppp_unlikely(!os)) {
+        throw std::runtime_error("An error occurred while writing the array file '" + path + "'");
+    }
+}
+
+} // namespace detail
+
+#if defined(MPPP_WITH_MPFR)
+
+void save_array_file(const std::string &path, const real *data, std::size_t n)
+{
+    // Number of limbs used by a real with precision p.
+    auto real_nlimbs = [](::mpfr_prec_t p) {
+        return static_cast<std::size_t>(mpfr_custom_get_size(p) / sizeof(::mp_limb_t));
+    };
+
+    std::size_t nlimbs = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        nlimbs += real_nlimbs(data[i].get_prec());
+    }
+    const auto header = detail::array_file_make_header(array_file_kind::real, n, 4, n, nlimbs);
+
+    auto os = detail::array_file_open(path);
+    detail::array_file_write_header(os, header);
+    {
+        // The precisions.
+        detail::array_file_column_writer w(os);
+        for (std::size_t i = 0; i < n; ++i) {
+            w.push(static_cast<std::int64_t>(data[i].get_mpfr_t()->_mpfr_prec));
+        }
+        w.flush();
+    }
+    {
+        // The signs.
+        detail::array_file_column_writer w(os);
+        for (std::size_t i = 0; i < n; ++i) {
+            w.push(static_cast<std::int64_t>(data[i].get_mpfr_t()->_mpfr_sign));
+        }
+        w.flush();
+    }
+    {
+        // The exponents.
+        detail::array_file_column_writer w(os);
+        for (std::size_t i = 0; i < n; ++i) {
+            w.push(static_cast<std::int64_t>(data[i].get_mpfr_t()->_mpfr_exp));
+        }
+        w.flush();
+    }
+    {
+        // The offsets.
+        detail::array_file_column_writer w(os);
+        std::uint64_t offset = 0;
+        for (std::size_t i = 0; i < n; ++i) {
+            w.push(offset);
+            offset += real_nlimbs(data[i].get_prec());
+        }
+        w.flush();
+    }
+    detail::array_file_write_padding(os, header);
+    // The limbs.
+    const ::mp_limb_t zero = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        const auto nl = real_nlimbs(data[i].get_prec());
+        if (data[i].regular_p()) {
+            os.write(reinterpret_cast<const char *>(data[i].get_mpfr_t()->_mpfr_d),
+                     static_cast<std::streamsize>(nl * sizeof(::mp_limb_t)));
+        } else {
+            // NOTE: the limbs of zeroes, infinities and NaNs
+            // are not meaningful (and they may be uninitialised).
+            for (std::size_t j = 0; j < nl; ++j) {
+                os.write(reinterpret_cast<const char *>(&zero), static_cast<std::streamsize>(sizeof(::mp_limb_t)));
+            }
+        }
+    }
+    detail::array_file_close(os, path);
+}
+
+#endif
+
+mapped_array_file::mapped_array_file(const std::string &path)
+{
+#if defined(MPPP_ARRAY_FILE_MMAP)
+    const auto fd = ::open(path.c_str(), O_RDONLY);
+    if (mppp_unlikely(fd == -1)) {
+        throw std::runtime_error("Cannot open the file '" + path + "' for reading");
+    }
+    struct ::stat st {
+    };
+    if (mppp_unlikely(::fstat(fd, &st) == -1)) {
+        // LCOV_EXCL_START
+        ::close(fd);
+        throw std::runtime_error("Cannot determine the size of the file '" + path + "'");
+        // LCOV_EXCL_STOP
+    }
+    if (mppp_unlikely(static_cast<std::uint64_t>(st.st_size) < sizeof(detail::array_file_header))) {
+        ::close(fd);
+        throw std::invalid_argument("The file '" + path + "' is not a valid array file: the file is too small");
+    }
+    m_size = static_cast<std::size_t>(st.st_size);
+    auto addr = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    // NOTE: the mapping stays valid after closing the file descriptor.
+    ::close(fd);
+    if (mppp_unlikely(addr == MAP_FAILED)) {
+        // LCOV_EXCL_START
+        throw std::runtime_error("Cannot map the file '" + path + "' into memory");
+        // LCOV_EXCL_STOP
+    }
+    m_addr = addr;
+#else
+    // NOTE: on platforms without mmap(), read the whole
+    // file into a memory buffer.
+    std::ifstream is(path, std::ios::binary | std::ios::ate);
+    if (mppp_unlikely(!is)) {
+        throw std::runtime_error("Cannot open the file '" + path + "' for reading");
+    }
+    const auto fsize = static_cast<std::uint64_t>(is.tellg());
+    if (mppp_unlikely(fsize < sizeof(detail::array_file_header))) {
+        throw std::invalid_argument("The file '" + path + "' is not a valid array file: the file is too small");
+    }
+    if (mppp_unlikely(fsize > detail::nl_max<std::size_t>())) {
+        throw std::overflow_error("The file '" + path + "' is too large to be loaded into memory");
+    }
+    m_size = static_cast<std::size_t>(fsize);
+    // NOTE: operator new() returns memory suitably aligned for the limbs.
+    m_addr = ::operator new(m_size);
+    is.seekg(0);
+    is.read(static_cast<char *>(m_addr), static_cast<std::streamsize>(m_size));
+    if (mppp_unlikely(!is)) {
+        unmap();
+        throw std::runtime_error("An error occurred while reading the file '" + path + "'");
+    }
+#endif
+
+    // NOTE: the mapped memory area is page-aligned (or suitably aligned
+    // by operator new()), and the validation below ensures that all the
+    // offsets are multiples of 8.
+    const auto base = static_cast<const char *>(m_addr);
+    m_header = static_cast<const detail::array_file_header *>(m_addr);
+    const auto &h = *m_header;
+
+    auto fail = [this, &path](const std::string &reason) {
+        unmap();
+        throw std::invalid_argument("The file '" + path + "' is not a valid array file: " + reason);
+    };
+
+    if (h.magic != detail::array_file_magic) {
+        fail("the magic number is invalid");
+    }
+    if (h.version != detail::array_file_version) {
+        fail("the version " + detail::to_string(h.version) + " is not supported");
+    }
+    if (h.endian != detail::array_file_endian) {
+        fail("the file was written on a machine with a different byte order");
+    }
+    if (h.limb_size != sizeof(::mp_limb_t) || h.numb_bits != static_cast<std::uint32_t>(GMP_NUMB_BITS)) {
+        fail("the file was written with an incompatible GMP limb type");
+    }
+    if (h.kind > static_cast<std::uint32_t>(array_file_kind::real)) {
+        fail("the object kind " + detail::to_string(h.kind) + " is invalid");
+    }
+#if !defined(MPPP_WITH_MPFR)
+    if (h.kind == static_cast<std::uint32_t>(array_file_kind::real)) {
+        fail("the file contains reals, but mp++ was configured without MPFR support");
+    }
+#endif
+    if (h.file_size != m_size) {
+        fail("the size recorded in the header (" + detail::to_string(h.file_size)
+             + ") does not match the size of the file (" + detail::to_string(m_size) + ")");
+    }
+    // NOTE: these checks guarantee that the computation
+    // of the expected layout below does not overflow.
+    if (h.n > m_size / (2u * sizeof(std::uint64_t)) || h.nlimbs > m_size / sizeof(::mp_limb_t)) {
+        fail("the number of objects or limbs is inconsistent with the size of the file");
+    }
+
+    // Check that the layout matches the one produced by save_array_file().
+    const auto kind = static_cast<array_file_kind>(h.kind);
+    const auto ncols = detail::array_file_ncols(kind);
+    const auto expected = detail::array_file_make_header(
+        kind, static_cast<std::size_t>(h.n), ncols, static_cast<std::size_t>(detail::array_file_nentries(kind, h.n)),
+        static_cast<std::size_t>(h.nlimbs));
+    if (h.columns != expected.columns || h.limbs_offset != expected.limbs_offset
+        || h.file_size != expected.file_size) {
+        fail("the layout of the file is inconsistent");
+    }
+
+    for (std::size_t i = 0; i < ncols; ++i) {
+        m_columns[i] = static_cast<const std::int64_t *>(static_cast<const void *>(base + h.columns[i]));
+    }
+    m_limbs = static_cast<const ::mp_limb_t *>(static_cast<const void *>(base + h.limbs_offset));
+}
+
+mapped_array_file::mapped_array_file(mapped_array_file &&other) noexcept
+    : m_addr(other.m_addr), m_size(other.m_size), m_header(other.m_header), m_columns(other.m_columns),
+      m_limbs(other.m_limbs)
+{
+    other.m_addr = nullptr;
+    other.m_size = 0;
+    other.m_header = nullptr;
+    other.m_columns = {};
+    other.m_limbs = nullptr;
+}
+
+mapped_array_file &mapped_array_file::operator=(mapped_array_file &&other) noexcept
+{
+    if (mppp_likely(this != &other)) {
+        unmap();
+        m_addr = other.m_addr;
+        m_size = other.m_size;
+        m_header = other.m_header;
+        m_columns = other.m_columns;
+        m_limbs = other.m_limbs;
+        other.m_addr = nullptr;
+        other.m_size = 0;
+        other.m_header = nullptr;
+        other.m_columns = {};
+        other.m_limbs = nullptr;
+    }
+    return *this;
+}
+
+mapped_array_file::~mapped_array_file()
+{
+    unmap();
+}
+
+void mapped_array_file::unmap() noexcept
+{
+    if (m_addr != nullptr) {
+#if defined(MPPP_ARRAY_FILE_MMAP)
+        ::munmap(m_addr, m_size);
+#else
+        ::operator delete(m_addr);
+#endif
+        m_addr = nullptr;
+    }
+}
+
+void mapped_array_file::check_access(array_file_kind kind, std::size_t i) const
+{
+    // NOTE: a moved-from object has no header.
+    if (mppp_unlikely(m_header == nullptr)) {
+        throw std::invalid_argument("Cannot access the objects of an invalid mapped array file");
+    }
+
+    if (mppp_unlikely(kind != this->kind())) {
+        constexpr std::array<const char *, 3> names = {{"integers", "rationals", "reals"}};
+        throw std::invalid_argument(std::string("Cannot access the objects of a mapped array file as ")
+                                    + names[static_cast<std::size_t>(kind)] + ": the file contains "
+                                    + names[static_cast<std::size_t>(m_header->kind)]);
+    }
+
+    if (mppp_unlikely(i >= size())) {
+        throw std::out_of_range("Cannot access the object at index " + detail::to_string(i)
+                                + " in a mapped array file of size " + detail::to_string(size()));
+    }
+}
+
+detail::mpz_struct_t mapped_array_file::mpz_at(std::size_t j) const
+{
+    // NOTE: the limbs of zero point to this limb, so that
+    // the views are always safe to read from.
+    static const ::mp_limb_t zero_limb = 0;
+
+    const auto size = m_columns[0][j];
+    const auto offset = static_cast<std::uint64_t>(m_columns[1][j]);
+
+    // NOTE: the absolute value is computed without
+    // negating size, which could overflow.
+    const auto asize = size >= 0 ? static_cast<std::uint64_t>(size) : 0u - static_cast<std::uint64_t>(size);
+    if (mppp_unlikely(asize > m_header->nlimbs || offset > m_header->nlimbs - asize
+                      || asize > static_cast<std::uint64_t>(detail::nl_max<detail::mpz_alloc_t>()))) {
+        throw std::invalid_argument("Invalid size or offset detected in a mapped array file");
+    }
+    const auto ptr = m_limbs + offset;
+    if (mppp_unlikely(asize != 0u && ptr[asize - 1u] == 0u)) {
+        throw std::invalid_argument("Non-normalised integer detected in a mapped array file");
+    }
+
+    detail::mpz_struct_t retval;
+    retval._mp_alloc = asize == 0u ? 1 : static_cast<detail::mpz_alloc_t>(asize);
+    retval._mp_size = static_cast<detail::mpz_size_t>(size);
+    // NOTE: the views are read-only, GMP does not
+    // write through _mp_d when the mpz_t is const.
+    retval._mp_d = const_cast<::mp_limb_t *>(asize == 0u ? &zero_limb : ptr);
+    return retval;
+}
+
+integer_cview mapped_array_file::get_integer(std::size_t i) const
+{
+    check_access(array_file_kind::integer, i);
+    return integer_cview{mpz_at(i)};
+}
+
+rational_cview mapped_array_file::get_rational(std::size_t i) const
+{
+    check_access(array_file_kind::rational, i);
+    const auto num = mpz_at(2u * i), den = mpz_at(2u * i + 1u);
+    if (mppp_unlikely(den._mp_size <= 0)) {
+        throw std::invalid_argument("Non-positive denominator detected in a mapped array file");
+    }
+    return rational_cview{num, den};
+}
+
+#if defined(MPPP_WITH_MPFR)
+
+real_cview mapped_array_file::get_real(std::size_t i) const
+{
+    check_access(array_file_kind::real, i);
+
+    const auto prec = m_columns[0][i], sign = m_columns[1][i], exp = m_columns[2][i];
+    const auto offset = static_cast<std::uint64_t>(m_columns[3][i]);
+
+    if (mppp_unlikely(prec < real_prec_min() || prec > real_prec_max())) {
+        throw std::invalid_argument("Invalid precision detected in a mapped array file");
+    }
+    if (mppp_unlikely(sign != 1 && sign != -1)) {
+        throw std::invalid_argument("Invalid sign detected in a mapped array file");
+    }
+    if (mppp_unlikely(exp < detail::nl_min<::mpfr_exp_t>() || exp > detail::nl_max<::mpfr_exp_t>())) {
+        throw std::invalid_argument("Invalid exponent detected in a mapped array file");
+    }
+    const auto nl = static_cast<std::uint64_t>(mpfr_custom_get_size(static_cast<::mpfr_prec_t>(prec)))
+                    / sizeof(::mp_limb_t);
+    if (mppp_unlikely(nl > m_header->nlimbs || offset > m_header->nlimbs - nl)) {
+        throw std::invalid_argument("Invalid offset detected in a mapped array file");
+    }
+
+    const auto ptr = m_limbs + offset;
+
+    mpfr_struct_t retval;
+    retval._mpfr_prec = static_cast<::mpfr_prec_t>(prec);
+    retval._mpfr_sign = static_cast<::mpfr_sign_t>(sign);
+    retval._mpfr_exp = static_cast<::mpfr_exp_t>(exp);
+    // NOTE: the views are read-only.
+    retval._mpfr_d = const_cast<::mp_limb_t *>(ptr);
+
+    if (mpfr_regular_p(&retval)) {
+        if (mppp_unlikely(retval._mpfr_exp < ::mpfr_get_emin_min() || retval._mpfr_exp > ::mpfr_get_emax_max())) {
+            throw std::invalid_argument("Invalid exponent detected in a mapped array file");
+        }
+        // NOTE: MPFR requires the significand of a regular value to be normalised
+        // (i.e., the highest bit of the top limb must be set), and the bits
+        // of the bottom limb beyond the precision to be zero.
+        const auto nunused = static_cast<unsigned>(nl * unsigned(GMP_NUMB_BITS) - static_cast<std::uint64_t>(prec));
+        assert(nunused < unsigned(GMP_NUMB_BITS));
+        if (mppp_unlikely((ptr[nl - 1u] >> (GMP_NUMB_BITS - 1)) == 0u
+                          || (ptr[0] & ((::mp_limb_t(1) << nunused) - 1u)) != 0u)) {
+            throw std::invalid_argument("Non-normalised real detected in a mapped array file");
+        }
+    } else if (mppp_unlikely(!mpfr_zero_p(&retval) && !mpfr_nan_p(&retval) && !mpfr_inf_p(&retval))) {
+        throw std::invalid_argument("Invalid exponent detected in a mapped array file");
+    }
+
+    return real_cview{retval};
+}
+
+#endif
+
+MPPP_END_NAMESPACE
@@ -8,7 +8,9 @@
 
 #include <mp++/config.hpp>
 
+#include <array>
 #include <cassert>
+#include <cstddef>
 #include <iostream>
 
 #include <mp++/detail/mpfr.hpp>
@@ -198,10 +200,114 @@ MPPP_CONSTINIT thread_local const flint_cleanup flint_cleanup_inst;
 
 #endif
 
+#if defined(MPPP_HAVE_THREAD_LOCAL)
+
+// Structure for caching the storage of reals.
+// NOTE: the cached values are mpfr_t which were
+// inited with mpfr_init2(), indexed by the number of limbs
+// of their precision. When a cached value is reused, its precision
+// is reset via mpfr_set_prec(), which does not allocate
+// because the significand is already large enough.
+// This way, all the functions of the MPFR API can still
+// be used on the cached values.
+// NOLINTNEXTLINE(cppcoreguidelines-special-member-functions, hicpp-special-member-functions)
+struct mpfr_alloc_cache {
+    // Values with up to this number of limbs will be cached.
+    static constexpr std::size_t max_size = 10;
+    // Max number of values to cache for each size.
+    static constexpr std::size_t max_entries = 32;
+    // The actual cache.
+    std::array<std::array<mpfr_struct_t, max_entries>, max_size> caches;
+    // The number of values actually stored in each cache entry.
+    std::array<std::size_t, max_size> sizes;
+    // Flag signalling that the cache has been destroyed.
+    bool dead;
+    constexpr mpfr_alloc_cache() noexcept : caches(), sizes(), dead(false) {}
+    void clear() noexcept
+    {
+#if !defined(NDEBUG)
+        std::cout << "Cleaning up the real alloc cache." << std::endl;
+#endif
+        for (std::size_t i = 0; i < max_size; ++i) {
+            for (std::size_t j = 0; j < sizes[i]; ++j) {
+                ::mpfr_clear(&caches[i][j]);
+            }
+            sizes[i] = 0;
+        }
+    }
+    ~mpfr_alloc_cache()
+    {
+        clear();
+        dead = true;
+    }
+};
+
+#if defined(__INTEL_COMPILER)
+
+#pragma warning(push)
+#pragma warning(disable : 854)
+
+#endif
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+MPPP_CONSTINIT thread_local mpfr_alloc_cache mpfr_alloc_cache_inst;
+
+#if defined(__INTEL_COMPILER)
+
+#pragma warning(pop)
+
+#endif
+
+// Index in the cache for values with precision p.
+// NOTE: mpfr_custom_get_size() returns the size in bytes
+// of the significand of a value with precision p.
+std::size_t mpfr_alloc_cache_idx(::mpfr_prec_t p)
+{
+    return mpfr_custom_get_size(p) / sizeof(::mp_limb_t) - 1u;
+}
+
+#endif
+
 } // namespace
 
+void mpfr_init2_cached(mpfr_struct_t &rop, ::mpfr_prec_t p)
+{
+#if defined(MPPP_HAVE_THREAD_LOCAL)
+    auto &mpfrc = mpfr_alloc_cache_inst;
+    const auto idx = mpfr_alloc_cache_idx(p);
+    if (!mpfrc.dead && idx < mpfrc.max_size && mpfrc.sizes[idx] != 0u) {
+        rop = mpfrc.caches[idx][--mpfrc.sizes[idx]];
+        // NOTE: mpfr_set_prec() also sets the value to NaN,
+        // as mpfr_init2() does.
+        ::mpfr_set_prec(&rop, p);
+        return;
+    }
+#endif
+    ::mpfr_init2(&rop, p);
+}
+
+void mpfr_clear_cached(mpfr_struct_t &m)
+{
+#if defined(MPPP_HAVE_THREAD_LOCAL)
+    auto &mpfrc = mpfr_alloc_cache_inst;
+    const auto idx = mpfr_alloc_cache_idx(mpfr_get_prec(&m));
+    if (!mpfrc.dead && idx < mpfrc.max_size && mpfrc.sizes[idx] < mpfrc.max_entries) {
+        mpfrc.caches[idx][mpfrc.sizes[idx]++] = m;
+        return;
+    }
+#endif
+    ::mpfr_clear(&m);
+}
+
 } // namespace detail
 
+void free_real_caches()
+{
+#if defined(MPPP_HAVE_THREAD_LOCAL)
+    detail::mpfr_alloc_cache_inst.clear();
+#endif
+}
+
 // Destructor.
 real::~real()
 {
@@ -223,7 +329,7 @@ real::~real()
     if (is_valid()) {
         // The object is not moved-from, destroy it.
         assert(detail::real_prec_check(get_prec()));
-        ::mpfr_clear(&m_mpfr);
+        detail::mpfr_clear_cached(m_mpfr);
     }
 }
 
@@ -13,10 +13,13 @@
 #endif
 #include <cassert>
 #include <cstddef>
+#include <exception>
 #if MPPP_CPLUSPLUS >= 201402L
 #include <iterator>
 #endif
 #include <string>
+#include <thread>
+#include <vector>
 
 #include <mp++/detail/utils.hpp>
 
@@ -102,6 +105,75 @@ std::string to_string(__int128_t n)
 
 #endif
 
+std::size_t parallel_nchunks(std::size_t n, unsigned nthreads)
+{
+    if (nthreads == 0u) {
+        // NOTE: hardware_concurrency() may return zero
+        // if the number of threads cannot be determined.
+        nthreads = std::thread::hardware_concurrency();
+        nthreads = nthreads ? nthreads : 1u;
+    }
+
+    return n < nthreads ? n : static_cast<std::size_t>(nthreads);
+}
+
+void parallel_for_chunks(std::size_t n, unsigned nthreads, void (*f)(void *, std::size_t, std::size_t, std::size_t),
+                         void *data)
+{
+    const auto nchunks = parallel_nchunks(n, nthreads);
+    if (nchunks == 0u) {
+        return;
+    }
+    if (nchunks == 1u) {
+        // Don't spawn any thread.
+        f(data, 0, 0, n);
+        return;
+    }
+
+    // NOTE: distribute the remainder of n / nchunks
+    // over the first chunks.
+    const auto q = n / nchunks, r = n % nchunks;
+    const auto chunk_begin = [q, r](std::size_t idx) { return idx * q + (idx < r ? idx : r); };
+
+    std::vector<std::exception_ptr> excs(nchunks);
+    const auto run_chunk = [&](std::size_t idx) {
+        try {
+            f(data, idx, chunk_begin(idx), chunk_begin(idx + 1u));
+        } catch (...) {
+            excs[idx] = std::current_exception();
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(nchunks - 1u);
+    try {
+        for (std::size_t i = 1; i < nchunks; ++i) {
+            threads.emplace_back(run_chunk, i);
+        }
+        // LCOV_EXCL_START
+    } catch (...) {
+        // Failure in the creation of a thread: join the
+        // threads that were started before re-throwing.
+        for (auto &t : threads) {
+            t.join();
+        }
+        throw;
+    }
+    // LCOV_EXCL_STOP
+
+    run_chunk(0);
+
+    for (auto &t : threads) {
+        t.join();
+    }
+
+    for (const auto &e : excs) {
+        if (e) {
+            std::rethrow_exception(e);
+        }
+    }
+}
+
 } // namespace detail
 
 MPPP_END_NAMESPACE
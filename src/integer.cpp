@@ -6,14 +6,18 @@
 // Public License v. 2.0. If a copy of the MPL was not distributed
 // with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
 
+#include <algorithm>
 #include <array>
+#include <atomic>
 #include <cassert>
 #include <cstddef>
+#include <cstdint>
 #include <cstdlib>
 #include <cstring>
 #include <ios>
 #include <iostream>
 #include <locale>
+#include <mutex>
 #include <stdexcept>
 #include <type_traits>
 #include <utility>
@@ -103,15 +107,118 @@ void mpz_alloc_cache::clear() noexcept
     assert(ffp != nullptr);
     for (std::size_t i = 0; i < max_size; ++i) {
         // Free all the limbs arrays allocated for this size.
+        // NOTE: the free() function accepts the size of the array in bytes.
         for (std::size_t j = 0; j < sizes[i]; ++j) {
-            ffp(static_cast<void *>(caches[i][j]), i + 1u);
+            ffp(static_cast<void *>(caches[i][j]), (i + 1u) * sizeof(::mp_limb_t));
         }
         // Reset the number of limbs array present in this
         // cache entry.
         sizes[i] = 0u;
+        held[i].store(0, std::memory_order_relaxed);
     }
 }
 
+namespace
+{
+
+// Runtime limits for the caches.
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+std::atomic<std::size_t> mpz_alloc_cache_max_size{mpz_alloc_cache::max_size};
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+std::atomic<std::size_t> mpz_alloc_cache_max_entries{mpz_alloc_cache::max_entries};
+
+// Helper to increase a statistics counter of a cache. An atomic
+// read-modify-write is not needed, because the counters are written
+// only by the thread owning the cache.
+void mpz_alloc_cache_bump(std::atomic<std::uint64_t> &c)
+{
+    c.store(c.load(std::memory_order_relaxed) + 1u, std::memory_order_relaxed);
+}
+
+// Accumulate the statistics of a cache into out.
+void mpz_alloc_cache_accumulate(integer_cache_stats &out, const mpz_alloc_cache &c)
+{
+    out.hits += c.hits.load(std::memory_order_relaxed);
+    out.misses += c.misses.load(std::memory_order_relaxed);
+    out.evictions += c.evictions.load(std::memory_order_relaxed);
+    for (std::size_t i = 0; i < mpz_alloc_cache::max_size; ++i) {
+        out.bytes[i] += c.held[i].load(std::memory_order_relaxed) * (i + 1u) * sizeof(::mp_limb_t);
+    }
+}
+
+// Registry of the caches of the running threads. It also stores
+// the statistics accumulated by the threads which have exited.
+struct mpz_alloc_cache_registry {
+    std::mutex mutex;
+    std::vector<const mpz_alloc_cache *> caches;
+    integer_cache_stats retired;
+    // Flag signalling that at least one cache
+    // has been registered.
+    bool used = false;
+};
+
+// NOTE: the registry is never destroyed, because threads may exit
+// after the destruction of the objects with static storage duration.
+mpz_alloc_cache_registry &get_mpz_alloc_cache_registry()
+{
+    static auto *const ret = new mpz_alloc_cache_registry;
+    return *ret;
+}
+
+void mpz_alloc_cache_register(mpz_alloc_cache &c) noexcept
+{
+    assert(c.reg_status == 0u);
+    try {
+        auto &r = get_mpz_alloc_cache_registry();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        r.caches.push_back(&c);
+        r.used = true;
+        c.reg_status = 1;
+        // LCOV_EXCL_START
+    } catch (...) {
+        // NOTE: in case of errors, the statistics of the cache
+        // will not be reported in the aggregated statistics. We will
+        // retry the registration later.
+    }
+    // LCOV_EXCL_STOP
+}
+
+} // namespace
+
+bool mpz_alloc_cache_used()
+{
+    auto &r = get_mpz_alloc_cache_registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    return r.used;
+}
+
+void mpz_alloc_cache::trim(std::size_t rt_max_size, std::size_t rt_max_entries) noexcept
+{
+    void (*ffp)(void *, std::size_t) = nullptr;
+    ::mp_get_memory_functions(nullptr, nullptr, &ffp);
+    assert(ffp != nullptr);
+    for (std::size_t i = 0; i < max_size; ++i) {
+        const auto limit = (i < rt_max_size) ? rt_max_entries : std::size_t(0);
+        for (; sizes[i] > limit; --sizes[i]) {
+            ffp(static_cast<void *>(caches[i][sizes[i] - 1u]), (i + 1u) * sizeof(::mp_limb_t));
+            mpz_alloc_cache_bump(evictions);
+        }
+        held[i].store(sizes[i], std::memory_order_relaxed);
+    }
+}
+
+mpz_alloc_cache::~mpz_alloc_cache()
+{
+    clear();
+    if (reg_status == 1u) {
+        auto &r = get_mpz_alloc_cache_registry();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        r.caches.erase(std::find(r.caches.begin(), r.caches.end(), this));
+        mpz_alloc_cache_accumulate(r.retired, *this);
+    }
+    reg_status = 2;
+}
+
 #if defined(MPPP_HAVE_THREAD_LOCAL)
 
 namespace
@@ -157,7 +264,15 @@ MPPP_CONSTINIT thread_local mpz_alloc_cache mpz_alloc_cache_inst;
 bool mpz_init_from_cache_impl(mpz_struct_t &rop, std::size_t nlimbs)
 {
     auto &mpzc = mpz_alloc_cache_inst;
-    if (nlimbs != 0u && nlimbs <= mpzc.max_size && mpzc.sizes[nlimbs - 1u] != 0u) {
+    if (mppp_unlikely(mpzc.reg_status != 1u)) {
+        if (mpzc.reg_status == 2u) {
+            // The cache has been destroyed already.
+            return false;
+        }
+        mpz_alloc_cache_register(mpzc);
+    }
+    if (nlimbs != 0u && nlimbs <= mpz_alloc_cache_max_size.load(std::memory_order_relaxed)
+        && mpzc.sizes[nlimbs - 1u] != 0u) {
         // LCOV_EXCL_START
         if (mppp_unlikely(nlimbs > make_unsigned(nl_max<mpz_alloc_t>()))) {
             std::abort();
@@ -168,8 +283,11 @@ bool mpz_init_from_cache_impl(mpz_struct_t &rop, std::size_t nlimbs)
         rop._mp_size = 0;
         rop._mp_d = mpzc.caches[idx][mpzc.sizes[idx] - 1u];
         --mpzc.sizes[idx];
+        mpzc.held[idx].store(mpzc.sizes[idx], std::memory_order_relaxed);
+        mpz_alloc_cache_bump(mpzc.hits);
         return true;
     }
+    mpz_alloc_cache_bump(mpzc.misses);
     return false;
 }
 
@@ -228,17 +346,27 @@ void mpz_clear_wrap(mpz_struct_t &m)
 {
 #if defined(MPPP_HAVE_THREAD_LOCAL)
     auto &mpzc = mpz_alloc_cache_inst;
+    if (mppp_unlikely(mpzc.reg_status != 1u)) {
+        if (mpzc.reg_status == 2u) {
+            // The cache has been destroyed already.
+            mpz_clear(&m);
+            return;
+        }
+        mpz_alloc_cache_register(mpzc);
+    }
     const auto ualloc = make_unsigned(m._mp_alloc);
-    if (ualloc != 0u && ualloc <= mpzc.max_size && mpzc.sizes[ualloc - 1u] < mpzc.max_entries) {
+    if (ualloc != 0u && ualloc <= mpz_alloc_cache_max_size.load(std::memory_order_relaxed)) {
         const auto idx = ualloc - 1u;
-        mpzc.caches[idx][mpzc.sizes[idx]] = m._mp_d;
-        ++mpzc.sizes[idx];
-    } else {
-#endif
-        mpz_clear(&m);
-#if defined(MPPP_HAVE_THREAD_LOCAL)
+        if (mpzc.sizes[idx] < mpz_alloc_cache_max_entries.load(std::memory_order_relaxed)) {
+            mpzc.caches[idx][mpzc.sizes[idx]] = m._mp_d;
+            ++mpzc.sizes[idx];
+            mpzc.held[idx].store(mpzc.sizes[idx], std::memory_order_relaxed);
+            return;
+        }
+        mpz_alloc_cache_bump(mpzc.evictions);
     }
 #endif
+    mpz_clear(&m);
 }
 
 void mpz_to_str(std::vector<char> &out, const mpz_struct_t *mpz, int base)
@@ -406,4 +534,60 @@ void free_integer_caches()
 #endif
 }
 
+integer_cache_stats get_thread_integer_cache_stats()
+{
+    integer_cache_stats retval;
+#if defined(MPPP_HAVE_THREAD_LOCAL)
+    detail::mpz_alloc_cache_accumulate(retval, detail::mpz_alloc_cache_inst);
+#endif
+    return retval;
+}
+
+integer_cache_stats get_integer_cache_stats()
+{
+    auto &r = detail::get_mpz_alloc_cache_registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    auto retval = r.retired;
+    for (const auto *c : r.caches) {
+        detail::mpz_alloc_cache_accumulate(retval, *c);
+    }
+    return retval;
+}
+
+void set_integer_cache_max_size(std::size_t n)
+{
+    if (mppp_unlikely(n > detail::mpz_alloc_cache::max_size)) {
+        throw std::invalid_argument("Cannot set the max size of the integer caches to " + detail::to_string(n)
+                                    + ": the value must not be greater than "
+                                    + detail::to_string(detail::mpz_alloc_cache::max_size));
+    }
+    detail::mpz_alloc_cache_max_size.store(n, std::memory_order_relaxed);
+#if defined(MPPP_HAVE_THREAD_LOCAL)
+    detail::mpz_alloc_cache_inst.trim(n, get_integer_cache_max_entries());
+#endif
+}
+
+std::size_t get_integer_cache_max_size()
+{
+    return detail::mpz_alloc_cache_max_size.load(std::memory_order_relaxed);
+}
+
+void set_integer_cache_max_entries(std::size_t n)
+{
+    if (mppp_unlikely(n > detail::mpz_alloc_cache::max_entries)) {
+        throw std::invalid_argument("Cannot set the max number of entries of the integer caches to "
+                                    + detail::to_string(n) + ": the value must not be greater than "
+                                    + detail::to_string(detail::mpz_alloc_cache::max_entries));
+    }
+    detail::mpz_alloc_cache_max_entries.store(n, std::memory_order_relaxed);
+#if defined(MPPP_HAVE_THREAD_LOCAL)
+    detail::mpz_alloc_cache_inst.trim(get_integer_cache_max_size(), n);
+#endif
+}
+
+std::size_t get_integer_cache_max_entries()
+{
+    return detail::mpz_alloc_cache_max_entries.load(std::memory_order_relaxed);
+}
+
 MPPP_END_NAMESPACE
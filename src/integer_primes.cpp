@@ -0,0 +1,172 @@
+// Copyright 2016-2023 Francesco Biscani (bluescarni@gmail.com)
+//
+// This file is part of the mp++ library.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+#include <mp++/detail/utils.hpp>
+#include <mp++/integer.hpp>
+#include <mp++/integer_primes.hpp>
+
+MPPP_BEGIN_NAMESPACE
+
+namespace detail
+{
+
+namespace
+{
+
+// Number of odd numbers in a segment of the sieve.
+constexpr std::size_t prime_range_seg_size = 1ul << 18;
+
+// Maximum value of the primes used in the sieve. The values
+// surviving the sieve above the square of this limit are
+// checked with probab_prime_p().
+constexpr unsigned long long prime_range_max_sieve_prime = 1ull << 20;
+
+} // namespace
+
+} // namespace detail
+
+prime_range::prime_range(unsigned long long begin, unsigned long long end) : m_end(end)
+{
+    if (begin >= end) {
+        m_done = true;
+        return;
+    }
+
+    // The first odd number in the range, excluding 1.
+    m_lo = detail::c_max(begin, 3ull);
+    if (m_lo % 2u == 0u) {
+        ++m_lo;
+    }
+
+    if (m_lo >= end) {
+        // No odd candidates in the range.
+        m_last_seg = true;
+    } else {
+        // Determine the primes to be used in the sieve,
+        // i.e., the odd primes up to sqrt(end - 1).
+        const auto hi = end - 1u;
+        auto lim = detail::c_min(static_cast<unsigned long long>(std::sqrt(static_cast<double>(hi))) + 1u,
+                                 detail::prime_range_max_sieve_prime);
+        while (lim * lim > hi) {
+            --lim;
+        }
+        m_sieve_max = lim;
+
+        std::vector<char> sieve(static_cast<std::size_t>(lim + 1u), 1);
+        for (unsigned long p = 3; p <= lim; p += 2u) {
+            if (sieve[p]) {
+                m_primes.push_back(p);
+                for (auto j = static_cast<unsigned long long>(p) * p; j <= lim; j += 2u * p) {
+                    sieve[static_cast<std::size_t>(j)] = 0;
+                }
+            }
+        }
+    }
+
+    if (begin <= 2u && end > 2u) {
+        // NOTE: 2 is handled separately from the sieve,
+        // which considers only odd numbers.
+        m_cur = 2;
+    } else {
+        advance();
+    }
+}
+
+// Move to the next prime in the range.
+void prime_range::advance()
+{
+    assert(!m_done);
+
+    while (true) {
+        for (; m_idx < m_count; ++m_idx) {
+            if (m_seg[m_idx] != 0) {
+                const auto x = m_lo + 2u * m_idx;
+                if (sieve_survivor_is_prime(x)) {
+                    ++m_idx;
+                    m_cur = x;
+                    return;
+                }
+            }
+        }
+
+        if (m_last_seg) {
+            m_done = true;
+            return;
+        }
+
+        sieve_segment();
+    }
+}
+
+// Move to the next segment and sieve it.
+void prime_range::sieve_segment()
+{
+    assert(!m_last_seg);
+
+    // NOTE: this cannot overflow, as there are values
+    // in the range after the current segment.
+    m_lo += 2u * m_count;
+    assert(m_lo < m_end);
+
+    // Number of odd values in [m_lo, m_end).
+    const auto rem = (m_end - m_lo - 1u) / 2u + 1u;
+    if (rem <= detail::prime_range_seg_size) {
+        m_count = static_cast<std::size_t>(rem);
+        m_last_seg = true;
+    } else {
+        m_count = detail::prime_range_seg_size;
+    }
+    m_idx = 0;
+
+    m_seg.assign(m_count, 1);
+    const auto seg_max = m_lo + 2u * (m_count - 1u);
+    for (auto p : m_primes) {
+        if (p > seg_max / p) {
+            break;
+        }
+
+        // Compute the offset from m_lo of the first odd multiple of p
+        // to be crossed out, starting from p**2.
+        const auto pp = static_cast<unsigned long long>(p) * p;
+        unsigned long long off;
+        if (pp >= m_lo) {
+            off = pp - m_lo;
+        } else {
+            off = (p - m_lo % p) % p;
+            // NOTE: m_lo is odd, thus m_lo + off
+            // is odd if and only if off is even.
+            if (off % 2u == 1u) {
+                off += p;
+            }
+        }
+
+        for (auto j = off / 2u; j < m_count; j += p) {
+            m_seg[static_cast<std::size_t>(j)] = 0;
+        }
+    }
+}
+
+// Check if a value which survived the sieve is prime.
+bool prime_range::sieve_survivor_is_prime(unsigned long long x) const
+{
+    // NOTE: the composite values surviving the sieve have
+    // all their prime factors greater than m_sieve_max.
+    if (x / (m_sieve_max + 1u) < m_sieve_max + 1u) {
+        return true;
+    }
+    // NOTE: on platforms with 64-bit limbs, x fits in a single limb
+    // and probab_prime_p() runs a deterministic test.
+    return integer<2>{x}.probab_prime_p() != 0;
+}
+
+MPPP_END_NAMESPACE
@@ -0,0 +1,447 @@
+// Copyright 2016-2023 Francesco Biscani (bluescarni@gmail.com)
+//
+// This file is part of the mp++ library.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <stdexcept>
+
+#include <mp++/config.hpp>
+#include <mp++/detail/gmp.hpp>
+#include <mp++/detail/type_traits.hpp>
+#include <mp++/detail/utils.hpp>
+#include <mp++/integer.hpp>
+#include <mp++/limb_pool.hpp>
+
+MPPP_BEGIN_NAMESPACE
+
+namespace detail
+{
+
+namespace
+{
+
+// Max number of size classes. The largest
+// possible size class has 2**30 limbs.
+constexpr std::size_t lp_max_nclasses = 31;
+
+// A magazine is a fixed-capacity stack of arrays
+// belonging to the same size class. The pointers to the arrays
+// are stored right after the header.
+struct lp_magazine {
+    std::size_t count;
+    void **items()
+    {
+        return reinterpret_cast<void **>(this + 1);
+    }
+};
+
+// Global state of the pool.
+struct lp_state {
+    limb_pool_config cfg;
+    // Number of size classes.
+    std::size_t nclasses = 0;
+    // Capacity of the magazines for each size class.
+    std::array<std::size_t, lp_max_nclasses> mag_cap{};
+    // The depot: cfg.depot_magazines slots for each size class.
+    std::atomic<lp_magazine *> *depot = nullptr;
+    // The underlying allocation functions.
+    void *(*alloc)(std::size_t) = nullptr;
+    void *(*realloc)(void *, std::size_t, std::size_t) = nullptr;
+    void (*free)(void *, std::size_t) = nullptr;
+    // Counters.
+    std::atomic<std::uint64_t> thread_hits{0};
+    std::atomic<std::uint64_t> depot_hits{0};
+    std::atomic<std::uint64_t> misses{0};
+    std::atomic<std::uint64_t> evictions{0};
+    std::atomic<std::uint64_t> oversize{0};
+    std::atomic<std::uint64_t> depot_bytes{0};
+};
+
+// NOTE: the state is created upon installation and never destroyed,
+// because GMP may invoke the allocation functions during the destruction
+// of objects with static storage duration.
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+std::atomic<lp_state *> lp_state_ptr{nullptr};
+
+// Mutex to serialise the installation of the pool.
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+std::mutex lp_mutex;
+
+lp_state &lp_get_state()
+{
+    auto ptr = lp_state_ptr.load(std::memory_order_acquire);
+    assert(ptr != nullptr);
+    return *ptr;
+}
+
+// Compute ceil(log2(n)), n > 0.
+std::size_t lp_ceil_log2(std::size_t n)
+{
+    assert(n > 0u);
+    std::size_t retval = 0;
+    for (--n; n != 0u; n >>= 1) {
+        ++retval;
+    }
+    return retval;
+}
+
+// Size class of an array of nbytes bytes. A return value not less
+// than s.nclasses means that the array is too large for the pool.
+std::size_t lp_size_class(const lp_state &s, std::size_t nbytes)
+{
+    const auto nlimbs = nbytes / sizeof(::mp_limb_t) + static_cast<std::size_t>(nbytes % sizeof(::mp_limb_t) != 0u);
+    if (nlimbs > s.cfg.max_class_limbs) {
+        return s.nclasses;
+    }
+    return nlimbs == 0u ? 0u : lp_ceil_log2(nlimbs);
+}
+
+std::size_t lp_class_bytes(std::size_t k)
+{
+    return (std::size_t(1) << k) * sizeof(::mp_limb_t);
+}
+
+lp_magazine *lp_new_magazine(const lp_state &s, std::size_t k)
+{
+    auto ret = static_cast<lp_magazine *>(std::malloc(sizeof(lp_magazine) + s.mag_cap[k] * sizeof(void *)));
+    if (ret != nullptr) {
+        ret->count = 0;
+    }
+    return ret;
+}
+
+// Return the contents of a magazine to the underlying allocator.
+void lp_evict_magazine(lp_state &s, std::size_t k, lp_magazine &m)
+{
+    const auto nbytes = lp_class_bytes(k);
+    for (std::size_t i = 0; i < m.count; ++i) {
+        s.free(m.items()[i], nbytes);
+    }
+    s.evictions.fetch_add(m.count, std::memory_order_relaxed);
+    m.count = 0;
+}
+
+// Try to push a full magazine into the depot.
+bool lp_depot_push(lp_state &s, std::size_t k, lp_magazine *m)
+{
+    // NOTE: as soon as m is in the depot, it may be popped by another
+    // thread. Thus, update the byte count in advance, so that it never
+    // goes negative.
+    const auto nbytes = m->count * lp_class_bytes(k);
+    s.depot_bytes.fetch_add(nbytes, std::memory_order_relaxed);
+    const auto begin = s.depot + k * s.cfg.depot_magazines;
+    for (auto it = begin; it != begin + s.cfg.depot_magazines; ++it) {
+        lp_magazine *expected = nullptr;
+        if (it->load(std::memory_order_relaxed) == nullptr
+            && it->compare_exchange_strong(expected, m, std::memory_order_release, std::memory_order_relaxed)) {
+            return true;
+        }
+    }
+    s.depot_bytes.fetch_sub(nbytes, std::memory_order_relaxed);
+    return false;
+}
+
+// Try to pop a full magazine from the depot.
+// NOTE: the slots are emptied via an atomic exchange, so that
+// only one thread can take ownership of a magazine. There are
+// no links between the slots, hence ABA is not an issue.
+lp_magazine *lp_depot_pop(lp_state &s, std::size_t k)
+{
+    const auto begin = s.depot + k * s.cfg.depot_magazines;
+    for (auto it = begin; it != begin + s.cfg.depot_magazines; ++it) {
+        if (it->load(std::memory_order_relaxed) != nullptr) {
+            if (auto m = it->exchange(nullptr, std::memory_order_acquire)) {
+                s.depot_bytes.fetch_sub(m->count * lp_class_bytes(k), std::memory_order_relaxed);
+                return m;
+            }
+        }
+    }
+    return nullptr;
+}
+
+#if defined(MPPP_HAVE_THREAD_LOCAL)
+
+// Per-thread magazines.
+struct lp_tcache {
+    // The magazines currently in use.
+    std::array<lp_magazine *, lp_max_nclasses> cur;
+    // Empty spare magazines.
+    std::array<lp_magazine *, lp_max_nclasses> spare;
+    // Counters not yet flushed into the global state.
+    std::uint64_t thread_hits;
+    std::uint64_t depot_hits;
+    std::uint64_t misses;
+    constexpr lp_tcache() noexcept : cur(), spare(), thread_hits(0), depot_hits(0), misses(0) {}
+    lp_tcache(const lp_tcache &) = delete;
+    lp_tcache(lp_tcache &&) = delete;
+    lp_tcache &operator=(const lp_tcache &) = delete;
+    lp_tcache &operator=(lp_tcache &&) = delete;
+    void flush_counters(lp_state &s)
+    {
+        s.thread_hits.fetch_add(thread_hits, std::memory_order_relaxed);
+        s.depot_hits.fetch_add(depot_hits, std::memory_order_relaxed);
+        s.misses.fetch_add(misses, std::memory_order_relaxed);
+        thread_hits = depot_hits = misses = 0;
+    }
+    // Release the magazines. If to_depot is true, the
+    // magazines in use are moved into the depot (if possible).
+    void release(bool to_depot) noexcept
+    {
+        auto ptr = lp_state_ptr.load(std::memory_order_acquire);
+        if (ptr == nullptr) {
+            return;
+        }
+        auto &s = *ptr;
+        for (std::size_t k = 0; k < s.nclasses; ++k) {
+            if (auto m = cur[k]) {
+                if (!to_depot || m->count == 0u || !lp_depot_push(s, k, m)) {
+                    lp_evict_magazine(s, k, *m);
+                    std::free(m);
+                }
+                cur[k] = nullptr;
+            }
+            std::free(spare[k]);
+            spare[k] = nullptr;
+        }
+        flush_counters(s);
+    }
+    ~lp_tcache();
+};
+
+// NOTE: this flag signals that the thread-local magazines
+// have been destroyed. After that, the pool will use directly the
+// underlying allocator in the current thread.
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+MPPP_CONSTINIT thread_local bool lp_tcache_dead = false;
+
+lp_tcache::~lp_tcache()
+{
+    // NOTE: at thread exit, the magazines in use are moved
+    // into the depot, so that other threads can reuse the arrays.
+    release(true);
+    lp_tcache_dead = true;
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+MPPP_CONSTINIT thread_local lp_tcache lp_tcache_inst;
+
+#endif
+
+void *lp_alloc(std::size_t nbytes)
+{
+    auto &s = lp_get_state();
+    const auto k = lp_size_class(s, nbytes);
+    if (k >= s.nclasses) {
+        s.oversize.fetch_add(1, std::memory_order_relaxed);
+        return s.alloc(nbytes);
+    }
+#if defined(MPPP_HAVE_THREAD_LOCAL)
+    if (mppp_likely(!lp_tcache_dead)) {
+        auto &tc = lp_tcache_inst;
+        auto m = tc.cur[k];
+        if (mppp_likely(m != nullptr && m->count != 0u)) {
+            ++tc.thread_hits;
+            return m->items()[--m->count];
+        }
+        // The current magazine is empty or missing: try to fetch
+        // a full magazine from the depot.
+        if (auto full = lp_depot_pop(s, k)) {
+            assert(full->count != 0u);
+            ++tc.depot_hits;
+            tc.flush_counters(s);
+            // Keep the old empty magazine as a spare, if possible.
+            if (m != nullptr) {
+                if (tc.spare[k] == nullptr) {
+                    tc.spare[k] = m;
+                } else {
+                    std::free(m);
+                }
+            }
+            tc.cur[k] = full;
+            return full->items()[--full->count];
+        }
+        ++tc.misses;
+        return s.alloc(lp_class_bytes(k));
+    }
+#endif
+    s.misses.fetch_add(1, std::memory_order_relaxed);
+    return s.alloc(lp_class_bytes(k));
+}
+
+void lp_free(void *ptr, std::size_t nbytes)
+{
+    auto &s = lp_get_state();
+    const auto k = lp_size_class(s, nbytes);
+    if (k >= s.nclasses) {
+        s.oversize.fetch_add(1, std::memory_order_relaxed);
+        s.free(ptr, nbytes);
+        return;
+    }
+#if defined(MPPP_HAVE_THREAD_LOCAL)
+    if (mppp_likely(!lp_tcache_dead)) {
+        auto &tc = lp_tcache_inst;
+        auto m = tc.cur[k];
+        if (mppp_unlikely(m == nullptr)) {
+            m = tc.cur[k] = lp_new_magazine(s, k);
+        } else if (mppp_unlikely(m->count == s.mag_cap[k])) {
+            // The current magazine is full: move it into the depot,
+            // and replace it with an empty one.
+            tc.flush_counters(s);
+            if (lp_depot_push(s, k, m)) {
+                m = tc.cur[k] = (tc.spare[k] != nullptr) ? tc.spare[k] : lp_new_magazine(s, k);
+                tc.spare[k] = nullptr;
+            } else {
+                // The depot is full, empty the magazine.
+                lp_evict_magazine(s, k, *m);
+            }
+        }
+        if (mppp_likely(m != nullptr)) {
+            m->items()[m->count++] = ptr;
+            return;
+        }
+        // LCOV_EXCL_START
+        // We could not allocate a new magazine.
+        s.evictions.fetch_add(1, std::memory_order_relaxed);
+        s.free(ptr, lp_class_bytes(k));
+        return;
+        // LCOV_EXCL_STOP
+    }
+#endif
+    s.evictions.fetch_add(1, std::memory_order_relaxed);
+    s.free(ptr, lp_class_bytes(k));
+}
+
+void *lp_realloc(void *ptr, std::size_t old_nbytes, std::size_t new_nbytes)
+{
+    auto &s = lp_get_state();
+    const auto old_k = lp_size_class(s, old_nbytes), new_k = lp_size_class(s, new_nbytes);
+    if (old_k >= s.nclasses && new_k >= s.nclasses) {
+        s.oversize.fetch_add(1, std::memory_order_relaxed);
+        return s.realloc(ptr, old_nbytes, new_nbytes);
+    }
+    if (old_k == new_k) {
+        // The array is already large enough.
+        return ptr;
+    }
+    auto retval = lp_alloc(new_nbytes);
+    std::memcpy(retval, ptr, std::min(old_nbytes, new_nbytes));
+    lp_free(ptr, old_nbytes);
+    return retval;
+}
+
+} // namespace
+
+} // namespace detail
+
+void install_limb_pool(const limb_pool_config &cfg)
+{
+    const auto &mcl = cfg.max_class_limbs;
+    if (mcl == 0u || (mcl & (mcl - 1u)) != 0u || detail::lp_ceil_log2(mcl) >= detail::lp_max_nclasses
+        || mcl > detail::nl_max<std::size_t>() / sizeof(::mp_limb_t)) {
+        throw std::invalid_argument("Invalid size of the largest size class of the limb pool: " + detail::to_string(mcl)
+                                    + " (the size must be a power of two not greater than 2**"
+                                    + detail::to_string(detail::lp_max_nclasses - 1u) + ")");
+    }
+    if (cfg.magazine_entries == 0u) {
+        throw std::invalid_argument("The number of entries of the magazines of the limb pool cannot be zero");
+    }
+
+    std::lock_guard<std::mutex> lock(detail::lp_mutex);
+
+    if (detail::lp_state_ptr.load(std::memory_order_relaxed) != nullptr) {
+        throw std::runtime_error("The limb pool has already been installed");
+    }
+
+    // NOTE: the pool identifies the size class of an array only via the size
+    // passed in by GMP. An array allocated by the old allocator and deallocated
+    // via the pool would thus be recycled as a (possibly larger) array of the
+    // pool. Hence, refuse the installation if mp++ has already allocated dynamic
+    // integers via GMP in any thread (the arrays may still be alive, or they may
+    // be sitting in the allocation caches of other threads).
+    if (detail::mpz_alloc_cache_used()) {
+        throw std::runtime_error("The limb pool cannot be installed after mp++ has allocated memory via GMP");
+    }
+
+    auto s = new detail::lp_state;
+    s->cfg = cfg;
+    s->nclasses = detail::lp_ceil_log2(mcl) + 1u;
+    for (std::size_t k = 0; k < s->nclasses; ++k) {
+        s->mag_cap[k]
+            = std::max(std::size_t(1), std::min(cfg.magazine_entries, cfg.magazine_bytes / detail::lp_class_bytes(k)));
+    }
+    const auto ndepot = s->nclasses * cfg.depot_magazines;
+    s->depot = new std::atomic<detail::lp_magazine *>[ndepot];
+    for (std::size_t i = 0; i < ndepot; ++i) {
+        s->depot[i].store(nullptr, std::memory_order_relaxed);
+    }
+    ::mp_get_memory_functions(&s->alloc, &s->realloc, &s->free);
+
+    detail::lp_state_ptr.store(s, std::memory_order_release);
+    ::mp_set_memory_functions(detail::lp_alloc, detail::lp_realloc, detail::lp_free);
+}
+
+bool limb_pool_installed()
+{
+    return detail::lp_state_ptr.load(std::memory_order_acquire) != nullptr;
+}
+
+limb_pool_config get_limb_pool_config()
+{
+    const auto ptr = detail::lp_state_ptr.load(std::memory_order_acquire);
+    return ptr == nullptr ? limb_pool_config{} : ptr->cfg;
+}
+
+limb_pool_stats get_limb_pool_stats()
+{
+    limb_pool_stats retval;
+    const auto ptr = detail::lp_state_ptr.load(std::memory_order_acquire);
+    if (ptr == nullptr) {
+        return retval;
+    }
+#if defined(MPPP_HAVE_THREAD_LOCAL)
+    if (!detail::lp_tcache_dead) {
+        detail::lp_tcache_inst.flush_counters(*ptr);
+    }
+#endif
+    retval.thread_hits = ptr->thread_hits.load(std::memory_order_relaxed);
+    retval.depot_hits = ptr->depot_hits.load(std::memory_order_relaxed);
+    retval.misses = ptr->misses.load(std::memory_order_relaxed);
+    retval.evictions = ptr->evictions.load(std::memory_order_relaxed);
+    retval.oversize = ptr->oversize.load(std::memory_order_relaxed);
+    retval.depot_bytes = ptr->depot_bytes.load(std::memory_order_relaxed);
+    return retval;
+}
+
+void trim_limb_pool()
+{
+    const auto ptr = detail::lp_state_ptr.load(std::memory_order_acquire);
+    if (ptr == nullptr) {
+        return;
+    }
+    auto &s = *ptr;
+#if defined(MPPP_HAVE_THREAD_LOCAL)
+    if (!detail::lp_tcache_dead) {
+        detail::lp_tcache_inst.release(false);
+    }
+#endif
+    for (std::size_t k = 0; k < s.nclasses; ++k) {
+        while (auto m = detail::lp_depot_pop(s, k)) {
+            detail::lp_evict_magazine(s, k, *m);
+            std::free(m);
+        }
+    }
+}
+
+MPPP_END_NAMESPACE
@@ -238,6 +238,37 @@ std::ostream &rational_stream_operator_impl(std::ostream &os, const mpz_struct_t
     return os;
 }
 
+// Conversion of the rational num / den to double, with the rounding mode rnd.
+// num must be nonzero, den must be greater than one.
+double mpq_to_double(const mpz_struct_t *num, const mpz_struct_t *den, fp_rounding rnd)
+{
+    assert(mpz_sgn(num) != 0);
+    assert(mpz_cmp_ui(den, 1u) > 0);
+
+    MPPP_MAYBE_TLS mpz_raii tmp, q, r;
+
+    // Scale num / den by 2**k, so that the scaled numerator has
+    // 64 + bits(den) bits and the truncated quotient has 64 or 65 bits.
+    // The discarded bits contribute only to the sticky bit of the rounding.
+    const auto k = 64 + static_cast<long long>(mpz_sizeinbase(den, 2)) - static_cast<long long>(mpz_sizeinbase(num, 2));
+    bool sticky = false;
+    if (k >= 0) {
+        mpz_mul_2exp(&tmp.m_mpz, num, static_cast<::mp_bitcnt_t>(k));
+        mpz_tdiv_qr(&q.m_mpz, &r.m_mpz, &tmp.m_mpz, den);
+    } else {
+        // NOTE: floor(floor(|num| / 2**s) / den) == floor(|num| / (den * 2**s)), thus
+        // we can shift num rather than den, if we keep track of the shifted-out bits.
+        const auto s = static_cast<::mp_bitcnt_t>(-k);
+        sticky = mpz_scan1(num, 0) < s;
+        mpz_tdiv_q_2exp(&tmp.m_mpz, num, s);
+        mpz_tdiv_qr(&q.m_mpz, &r.m_mpz, &tmp.m_mpz, den);
+    }
+    sticky = sticky || mpz_sgn(&r.m_mpz) != 0;
+
+    return limbs_to_double(q.m_mpz._mp_d, static_cast<std::size_t>(mpz_size(&q.m_mpz)), mpz_sgn(num) < 0, sticky, -k,
+                           rnd);
+}
+
 } // namespace detail
 
 MPPP_END_NAMESPACE
@@ -306,7 +306,7 @@ void mpfr_to_string(const ::mpfr_t r, std::ostream &os, int base)
 // NOLINTNEXTLINE(cppcoreguidelines-pro-type-member-init, hicpp-member-init)
 real::real()
 {
-    ::mpfr_init2(&m_mpfr, real_prec_min());
+    detail::mpfr_init2_cached(m_mpfr, real_prec_min());
     ::mpfr_set_zero(&m_mpfr, 1);
 }
 
@@ -318,7 +318,7 @@ real::real(const ptag &, ::mpfr_prec_t p, bool ignore_prec)
     assert(ignore_prec);
     assert(detail::real_prec_check(p));
     detail::ignore(ignore_prec);
-    ::mpfr_init2(&m_mpfr, p);
+    detail::mpfr_init2_cached(m_mpfr, p);
 }
 
 // Copy constructor.
@@ -329,7 +329,7 @@ real::real(const real &other) : real(&other.m_mpfr) {}
 real::real(const real &other, ::mpfr_prec_t p)
 {
     // Init with custom precision, and then set.
-    ::mpfr_init2(&m_mpfr, check_init_prec(p));
+    detail::mpfr_init2_cached(m_mpfr, check_init_prec(p));
     mpfr_set(&m_mpfr, &other.m_mpfr, MPFR_RNDN);
 }
 
@@ -405,10 +405,10 @@ void real::construct_from_c_string(const char *s, int base, ::mpfr_prec_t p)
         throw std::invalid_argument("Cannot construct a real from a string in base " + detail::to_string(base)
                                     + ": the base must either be zero or in the [2,62] range");
     }
-    ::mpfr_init2(&m_mpfr, check_init_prec(p));
+    detail::mpfr_init2_cached(m_mpfr, check_init_prec(p));
     const auto ret = ::mpfr_set_str(&m_mpfr, s, base, MPFR_RNDN);
     if (mppp_unlikely(ret == -1)) {
-        ::mpfr_clear(&m_mpfr);
+        detail::mpfr_clear_cached(m_mpfr);
         throw std::invalid_argument(std::string{"The string '"} + s + "' does not represent a valid real in base "
                                     + detail::to_string(base));
     }
@@ -446,7 +446,7 @@ real::real(const char *begin, const char *end, ::mpfr_prec_t p) : real(begin, en
 // NOLINTNEXTLINE(cppcoreguidelines-pro-type-member-init, hicpp-member-init, bugprone-easily-swappable-parameters)
 real::real(real_kind k, int sign, ::mpfr_prec_t p)
 {
-    ::mpfr_init2(&m_mpfr, check_init_prec(p));
+    detail::mpfr_init2_cached(m_mpfr, check_init_prec(p));
     // NOTE: handle all cases explicitly, in order to avoid
     // compiler warnings.
     switch (k) {
@@ -460,7 +460,7 @@ real::real(real_kind k, int sign, ::mpfr_prec_t p)
             break;
         default:
             // Clean up before throwing.
-            ::mpfr_clear(&m_mpfr);
+            detail::mpfr_clear_cached(m_mpfr);
             using kind_cast_t = std::underlying_type<::mpfr_kind_t>::type;
             throw std::invalid_argument(
                 "The 'real_kind' value passed to the constructor of a real ("
@@ -478,14 +478,14 @@ real::real(real_kind k, ::mpfr_prec_t p) : real(k, 0, p) {}
 // NOLINTNEXTLINE(cppcoreguidelines-pro-type-member-init, hicpp-member-init, bugprone-easily-swappable-parameters)
 real::real(unsigned long n, ::mpfr_exp_t e, ::mpfr_prec_t p)
 {
-    ::mpfr_init2(&m_mpfr, check_init_prec(p));
+    detail::mpfr_init2_cached(m_mpfr, check_init_prec(p));
     set_ui_2exp(*this, n, e);
 }
 
 // NOLINTNEXTLINE(cppcoreguidelines-pro-type-member-init, hicpp-member-init, bugprone-easily-swappable-parameters)
 real::real(long n, ::mpfr_exp_t e, ::mpfr_prec_t p)
 {
-    ::mpfr_init2(&m_mpfr, check_init_prec(p));
+    detail::mpfr_init2_cached(m_mpfr, check_init_prec(p));
     set_si_2exp(*this, n, e);
 }
 
@@ -494,7 +494,7 @@ real::real(long n, ::mpfr_exp_t e, ::mpfr_prec_t p)
 real::real(const ::mpfr_t x)
 {
     // Init with the same precision as other, and then set.
-    ::mpfr_init2(&m_mpfr, mpfr_get_prec(x));
+    detail::mpfr_init2_cached(m_mpfr, mpfr_get_prec(x));
     mpfr_set(&m_mpfr, x, MPFR_RNDN);
 }
 
@@ -509,7 +509,7 @@ real &real::operator=(const real &other)
             set_prec_impl<false>(other.get_prec());
         } else {
             // this has been moved-from: init before setting.
-            ::mpfr_init2(&m_mpfr, other.get_prec());
+            detail::mpfr_init2_cached(m_mpfr, other.get_prec());
         }
         // Perform the actual copy from other.
         mpfr_set(&m_mpfr, &other.m_mpfr, MPFR_RNDN);
@@ -2571,6 +2571,19 @@ std::size_t rbs_min_size()
 
 } // namespace
 
+// Compute the binary size of a serialised real from its serialised precision.
+std::size_t real_binary_size_from_prec(::mpfr_prec_t p)
+{
+    if (mppp_unlikely(!real_prec_check(p))) {
+        throw std::invalid_argument("Invalid precision detected in the binary deserialisation of a real: the "
+                                    "precision must be in the ["
+                                    + to_string(real_prec_min()) + ", " + to_string(real_prec_max())
+                                    + "] range, but it is " + to_string(p) + " instead");
+    }
+
+    return rbs_checked_add(rbs_base_size(), rbs_prec_to_size(p));
+}
+
 } // namespace detail
 
 #if defined(MPPP_MPFR_HAVE_MPFR_GET_STR_NDIGITS)
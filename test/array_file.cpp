@@ -0,0 +1,339 @@
+// Copyright 2016-2023 Francesco Biscani (bluescarni@gmail.com)
+//
+// This file is part of the mp++ library.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <mp++/config.hpp>
+
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <ios>
+#include <iterator>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <mp++/array_file.hpp>
+#include <mp++/detail/gmp.hpp>
+#include <mp++/integer.hpp>
+#include <mp++/rational.hpp>
+
+#if defined(MPPP_WITH_MPFR)
+#include <mp++/real.hpp>
+#endif
+
+#include "catch.hpp"
+#include "test_utils.hpp"
+
+static const int ntries = 1000;
+
+// NOLINTNEXTLINE(google-build-using-namespace)
+using namespace mppp;
+// NOLINTNEXTLINE(google-build-using-namespace)
+using namespace mppp_test;
+
+using sizes = std::tuple<std::integral_constant<std::size_t, 1>, std::integral_constant<std::size_t, 2>,
+                         std::integral_constant<std::size_t, 3>, std::integral_constant<std::size_t, 6>>;
+
+// NOLINTNEXTLINE(cert-err58-cpp, cert-msc32-c, cert-msc51-cpp)
+static std::mt19937 rng;
+
+static const std::string fname = "mppp_array_file_test.bin";
+
+// Remove the test file on scope exit.
+struct file_remover {
+    ~file_remover()
+    {
+        std::remove(fname.c_str());
+    }
+};
+
+// Read/write the raw contents of the test file.
+static std::vector<char> read_file()
+{
+    std::ifstream is(fname, std::ios::binary);
+    return std::vector<char>(std::istreambuf_iterator<char>(is), std::istreambuf_iterator<char>());
+}
+
+static void write_file(const std::vector<char> &v)
+{
+    std::ofstream os(fname, std::ios::binary | std::ios::trunc);
+    os.write(v.data(), static_cast<std::streamsize>(v.size()));
+}
+
+struct integer_tester {
+    template <typename S>
+    inline void operator()(const S &) const
+    {
+        using integer = integer<S::value>;
+
+        file_remover fr;
+
+        // Random integers with up to SSize + 1 limbs.
+        std::vector<integer> ints;
+        detail::mpz_raii tmp;
+        std::uniform_int_distribution<unsigned> sdist(0, static_cast<unsigned>(S::value) + 1u), bdist(0, 1);
+        for (int i = 0; i < ntries; ++i) {
+            random_integer(tmp, sdist(rng), rng);
+            ints.emplace_back(&tmp.m_mpz);
+            if (bdist(rng)) {
+                ints.back().neg();
+            }
+        }
+
+        save_array_file(fname, ints.data(), ints.size());
+        mapped_array_file maf(fname);
+        REQUIRE(maf.kind() == array_file_kind::integer);
+        REQUIRE(maf.size() == ints.size());
+        for (std::size_t i = 0; i < ints.size(); ++i) {
+            const auto v = maf.get_integer(i);
+            REQUIRE(integer{v.get()} == ints[i]);
+            REQUIRE(mpz_cmp(v, ints[i].get_mpz_view()) == 0);
+        }
+
+        // The limb blob is aligned.
+        const auto data = read_file();
+        REQUIRE(data.size() % sizeof(::mp_limb_t) == 0u);
+
+        // Move semantics.
+        auto maf2(std::move(maf));
+        REQUIRE(maf2.size() == ints.size());
+        REQUIRE(integer{maf2.get_integer(0).get()} == ints[0]);
+        maf = std::move(maf2);
+        REQUIRE(integer{maf.get_integer(ints.size() - 1u).get()} == ints.back());
+
+        // Empty array.
+        save_array_file(fname, ints.data(), 0);
+        REQUIRE(mapped_array_file(fname).size() == 0u);
+
+        // Zeroes.
+        const std::vector<integer> zeroes(3);
+        save_array_file(fname, zeroes.data(), zeroes.size());
+        mapped_array_file mz(fname);
+        REQUIRE(mpz_sgn(mz.get_integer(1).get()) == 0);
+        REQUIRE(integer{mz.get_integer(2).get()} == 0);
+    }
+};
+
+TEST_CASE("array_file integer")
+{
+    tuple_for_each(sizes{}, integer_tester{});
+}
+
+struct rational_tester {
+    template <typename S>
+    inline void operator()(const S &) const
+    {
+        using integer = integer<S::value>;
+        using rational = rational<S::value>;
+
+        file_remover fr;
+
+        std::vector<rational> rats;
+        detail::mpz_raii tmp;
+        std::uniform_int_distribution<unsigned> sdist(0, static_cast<unsigned>(S::value) + 1u), bdist(0, 1);
+        for (int i = 0; i < ntries; ++i) {
+            random_integer(tmp, sdist(rng), rng);
+            integer num{&tmp.m_mpz};
+            random_integer(tmp, sdist(rng), rng);
+            integer den{&tmp.m_mpz};
+            if (den.is_zero()) {
+                den = 1;
+            }
+            if (bdist(rng)) {
+                num.neg();
+            }
+            rats.emplace_back(num, den);
+        }
+
+        save_array_file(fname, rats.data(), rats.size());
+        mapped_array_file maf(fname);
+        REQUIRE(maf.kind() == array_file_kind::rational);
+        REQUIRE(maf.size() == rats.size());
+        for (std::size_t i = 0; i < rats.size(); ++i) {
+            REQUIRE(rational{maf.get_rational(i).get()} == rats[i]);
+        }
+    }
+};
+
+TEST_CASE("array_file rational")
+{
+    tuple_for_each(sizes{}, rational_tester{});
+}
+
+#if defined(MPPP_WITH_MPFR)
+
+TEST_CASE("array_file real")
+{
+    file_remover fr;
+
+    std::vector<real> reals;
+    for (auto prec : {real_prec_min(), ::mpfr_prec_t(53), ::mpfr_prec_t(64), ::mpfr_prec_t(65), ::mpfr_prec_t(1000)}) {
+        reals.emplace_back(real{1, prec} / 3);
+        reals.emplace_back(-real{"1.1e100", prec});
+        reals.emplace_back(real{0, prec});
+        reals.emplace_back(-real{0, prec});
+        reals.emplace_back("inf", prec);
+        reals.emplace_back("-inf", prec);
+        reals.emplace_back("nan", prec);
+    }
+
+    save_array_file(fname, reals.data(), reals.size());
+    mapped_array_file maf(fname);
+    REQUIRE(maf.kind() == array_file_kind::real);
+    REQUIRE(maf.size() == reals.size());
+    for (std::size_t i = 0; i < reals.size(); ++i) {
+        const real r{maf.get_real(i).get()};
+        REQUIRE(r.get_prec() == reals[i].get_prec());
+        REQUIRE(r.nan_p() == reals[i].nan_p());
+        if (!r.nan_p()) {
+            REQUIRE(r == reals[i]);
+            REQUIRE(r.signbit() == reals[i].signbit());
+        }
+    }
+
+    REQUIRE_THROWS_AS(maf.get_integer(0), std::invalid_argument);
+}
+
+TEST_CASE("array_file real errors")
+{
+    using Catch::Matchers::Message;
+
+    file_remover fr;
+
+    // A single real with 53 bits of precision: its only limb
+    // is at the end of the file.
+    const std::vector<real> reals{real{1, 53} / 3};
+    save_array_file(fname, reals.data(), reals.size());
+    const auto orig = read_file();
+    REQUIRE(orig.size() >= sizeof(::mp_limb_t));
+    const auto limb_pos = orig.size() - sizeof(::mp_limb_t);
+    ::mp_limb_t limb = 0;
+    std::memcpy(&limb, orig.data() + limb_pos, sizeof(::mp_limb_t));
+
+    auto write_limb = [&](::mp_limb_t l) {
+        auto data = orig;
+        std::memcpy(data.data() + limb_pos, &l, sizeof(::mp_limb_t));
+        write_file(data);
+    };
+
+    // Non-normalised top limb.
+    write_limb(limb & (GMP_NUMB_MASK >> 1));
+    {
+        mapped_array_file maf(fname);
+        REQUIRE_THROWS_MATCHES(maf.get_real(0), std::invalid_argument,
+                               Message("Non-normalised real detected in a mapped array file"));
+    }
+
+    // Nonzero bits beyond the precision.
+    write_limb(limb | 1u);
+    {
+        mapped_array_file maf(fname);
+        REQUIRE_THROWS_MATCHES(maf.get_real(0), std::invalid_argument,
+                               Message("Non-normalised real detected in a mapped array file"));
+    }
+
+    // The original file is fine.
+    write_limb(limb);
+    REQUIRE(real{mapped_array_file(fname).get_real(0).get()} == reals[0]);
+}
+
+#endif
+
+TEST_CASE("array_file errors")
+{
+    using Catch::Matchers::Message;
+
+    file_remover fr;
+
+    REQUIRE_THROWS_MATCHES(mapped_array_file("nonexistent_mppp_array_file.bin"), std::runtime_error,
+                           Message("Cannot open the file 'nonexistent_mppp_array_file.bin' for reading"));
+
+    const std::vector<integer<1>> ints{integer<1>{1}, integer<1>{-42}, integer<1>{"123456789012345678901234567890"}};
+    save_array_file(fname, ints.data(), ints.size());
+    const auto orig = read_file();
+
+    // Kind mismatch and out of range access.
+    {
+        mapped_array_file maf(fname);
+        REQUIRE_THROWS_MATCHES(maf.get_rational(0), std::invalid_argument,
+                               Message("Cannot access the objects of a mapped array file as rationals: the file "
+                                       "contains integers"));
+        REQUIRE_THROWS_MATCHES(
+            maf.get_integer(3), std::out_of_range,
+            Message("Cannot access the object at index 3 in a mapped array file of size 3"));
+
+        // Moved-from object.
+        mapped_array_file maf2(std::move(maf));
+        REQUIRE_THROWS_MATCHES(maf.get_integer(0), std::invalid_argument,
+                               Message("Cannot access the objects of an invalid mapped array file"));
+    }
+
+    // Truncated files.
+    auto data = orig;
+    data.resize(50);
+    write_file(data);
+    REQUIRE_THROWS_MATCHES(mapped_array_file(fname), std::invalid_argument,
+                           Message("The file '" + fname + "' is not a valid array file: the file is too small"));
+    data = orig;
+    data.pop_back();
+    write_file(data);
+    REQUIRE_THROWS_AS(mapped_array_file(fname), std::invalid_argument);
+
+    // Bad magic.
+    data = orig;
+    data[0] = 'X';
+    write_file(data);
+    REQUIRE_THROWS_MATCHES(mapped_array_file(fname), std::invalid_argument,
+                           Message("The file '" + fname + "' is not a valid array file: the magic number is invalid"));
+
+    // Bad endianness marker.
+    data = orig;
+    data[12] ^= 1;
+    write_file(data);
+    REQUIRE_THROWS_MATCHES(mapped_array_file(fname), std::invalid_argument,
+                           Message("The file '" + fname
+                                   + "' is not a valid array file: the file was written on a machine with a "
+                                     "different byte order"));
+
+    // Inconsistent number of objects.
+    data = orig;
+    data[32] = 2;
+    write_file(data);
+    REQUIRE_THROWS_MATCHES(mapped_array_file(fname), std::invalid_argument,
+                           Message("The file '" + fname + "' is not a valid array file: the layout of the file is "
+                                                          "inconsistent"));
+
+    // Corrupted size in the table: the error is detected on access.
+    data = orig;
+    data[96] = 100;
+    write_file(data);
+    {
+        mapped_array_file maf(fname);
+        REQUIRE_THROWS_MATCHES(maf.get_integer(0), std::invalid_argument,
+                               Message("Invalid size or offset detected in a mapped array file"));
+        REQUIRE(integer<1>{maf.get_integer(1).get()} == -42);
+    }
+
+    // Non-positive denominator.
+    const std::vector<rational<1>> rats{rational<1>{1, 2}};
+    save_array_file(fname, rats.data(), rats.size());
+    data = read_file();
+    // NOTE: the size of the denominator is the second entry of the first column.
+    data[104] = 0;
+    write_file(data);
+    {
+        mapped_array_file maf(fname);
+        REQUIRE_THROWS_MATCHES(maf.get_rational(0), std::invalid_argument,
+                               Message("Non-positive denominator detected in a mapped array file"));
+    }
+}
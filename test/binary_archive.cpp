@@ -0,0 +1,354 @@
+// Copyright 2016-2023 Francesco Biscani (bluescarni@gmail.com)
+//
+// This file is part of the mp++ library.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <mp++/config.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <list>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include <mp++/binary_archive.hpp>
+#include <mp++/detail/gmp.hpp>
+#include <mp++/integer.hpp>
+#include <mp++/rational.hpp>
+
+#if defined(MPPP_WITH_MPFR)
+#include <mp++/real.hpp>
+#endif
+
+#include "catch.hpp"
+#include "test_utils.hpp"
+
+static const int ntries = 1000;
+
+// NOLINTNEXTLINE(google-build-using-namespace)
+using namespace mppp;
+// NOLINTNEXTLINE(google-build-using-namespace)
+using namespace mppp_test;
+
+using sizes = std::tuple<std::integral_constant<std::size_t, 1>, std::integral_constant<std::size_t, 2>,
+                         std::integral_constant<std::size_t, 3>, std::integral_constant<std::size_t, 6>>;
+
+// NOLINTNEXTLINE(cert-err58-cpp, cert-msc32-c, cert-msc51-cpp)
+static std::mt19937 rng;
+
+// Concatenation of the binary representations of the objects in v.
+template <typename T>
+static std::vector<char> concat_binary_save(const std::vector<T> &v)
+{
+    std::vector<char> retval, tmp;
+    for (const auto &x : v) {
+        tmp.clear();
+        const auto bs = x.binary_save(tmp);
+        retval.insert(retval.end(), tmp.data(), tmp.data() + bs);
+    }
+    return retval;
+}
+
+// Write the objects in v via a binary_archive_writer using chunks
+// of random size up to max_chunk.
+template <typename T>
+static std::vector<char> chunked_write(const std::vector<T> &v, std::size_t max_chunk)
+{
+    std::vector<char> retval, chunk(max_chunk);
+    std::uniform_int_distribution<std::size_t> cdist(0, max_chunk);
+    auto w = make_binary_archive_writer(v.begin(), v.end());
+    while (!w.done()) {
+        const auto n = w.write(chunk.data(), cdist(rng));
+        retval.insert(retval.end(), chunk.data(), chunk.data() + n);
+    }
+    REQUIRE(w.count() == v.size());
+    REQUIRE(w.write(chunk.data(), max_chunk) == 0u);
+    return retval;
+}
+
+// An iterator over a vector which returns copies of the elements.
+template <typename T>
+class by_value_iterator
+{
+public:
+    explicit by_value_iterator(typename std::vector<T>::const_iterator it) : m_it(it) {}
+    T operator*() const
+    {
+        return *m_it;
+    }
+    by_value_iterator &operator++()
+    {
+        ++m_it;
+        return *this;
+    }
+    bool operator==(const by_value_iterator &other) const
+    {
+        return m_it == other.m_it;
+    }
+    bool operator!=(const by_value_iterator &other) const
+    {
+        return m_it != other.m_it;
+    }
+
+private:
+    typename std::vector<T>::const_iterator m_it;
+};
+
+// Read objects of type T from buf via a binary_archive_reader using chunks
+// of random size up to max_chunk.
+template <typename T, typename OutIt>
+static OutIt chunked_read(const std::vector<char> &buf, std::size_t max_chunk, OutIt out)
+{
+    std::uniform_int_distribution<std::size_t> cdist(0, max_chunk);
+    binary_archive_reader<T> r;
+    std::size_t offset = 0;
+    while (offset != buf.size()) {
+        const auto n = std::min(cdist(rng), buf.size() - offset);
+        out = r.read(buf.data() + offset, n, out);
+        offset += n;
+    }
+    REQUIRE(!r.pending());
+    return out;
+}
+
+struct integer_tester {
+    template <typename S>
+    inline void operator()(const S &) const
+    {
+        using integer = integer<S::value>;
+
+        std::vector<integer> ints;
+        detail::mpz_raii tmp;
+        std::uniform_int_distribution<unsigned> sdist(0, static_cast<unsigned>(S::value) + 1u), bdist(0, 1);
+        for (int i = 0; i < ntries; ++i) {
+            random_integer(tmp, sdist(rng), rng);
+            ints.emplace_back(&tmp.m_mpz);
+            if (bdist(rng)) {
+                ints.back().neg();
+            }
+        }
+
+        const auto ref = concat_binary_save(ints);
+        for (auto max_chunk : {std::size_t(1), std::size_t(7), std::size_t(64), std::size_t(10000)}) {
+            const auto buf = chunked_write(ints, max_chunk);
+            REQUIRE(buf == ref);
+
+            // Read into a back inserter.
+            std::vector<integer> out;
+            chunked_read<integer>(buf, max_chunk, std::back_inserter(out));
+            REQUIRE(out == ints);
+
+            // Read in-place into existing objects.
+            std::vector<integer> out2(ints.size(), integer{"123456789012345678901234567890"});
+            const auto it = chunked_read<integer>(buf, max_chunk, out2.begin());
+            REQUIRE(it == out2.end());
+            REQUIRE(out2 == ints);
+        }
+
+        // Empty sequences.
+        auto w = make_binary_archive_writer(ints.begin(), ints.begin());
+        REQUIRE(w.done());
+        REQUIRE(w.write(nullptr, 0) == 0u);
+
+        // Zeroes: the writer is done as soon as the last
+        // nonempty segment has been written.
+        const std::vector<integer> zeroes(2);
+        std::vector<char> buf(2 * sizeof(detail::mpz_size_t));
+        auto wz = make_binary_archive_writer(zeroes.begin(), zeroes.end());
+        REQUIRE(wz.write(buf.data(), sizeof(detail::mpz_size_t)) == sizeof(detail::mpz_size_t));
+        REQUIRE(wz.count() == 1u);
+        REQUIRE(wz.write(buf.data(), sizeof(detail::mpz_size_t)) == sizeof(detail::mpz_size_t));
+        REQUIRE(wz.done());
+
+        // Non-random-access iterators.
+        const std::list<integer> l(ints.begin(), ints.end());
+        std::vector<char> lbuf(ref.size());
+        auto wl = make_binary_archive_writer(l.begin(), l.end());
+        REQUIRE(wl.write(lbuf.data(), lbuf.size()) == ref.size());
+        REQUIRE(wl.done());
+        REQUIRE(lbuf == ref);
+
+        // Iterators returning by value, with small chunks
+        // so that the objects are written across multiple calls.
+        auto wv = make_binary_archive_writer(by_value_iterator<integer>(ints.begin()),
+                                             by_value_iterator<integer>(ints.end()));
+        std::vector<char> vbuf, vchunk(7);
+        while (!wv.done()) {
+            const auto n = wv.write(vchunk.data(), vchunk.size());
+            vbuf.insert(vbuf.end(), vchunk.data(), vchunk.data() + n);
+        }
+        REQUIRE(wv.count() == ints.size());
+        REQUIRE(vbuf == ref);
+    }
+};
+
+TEST_CASE("binary_archive integer")
+{
+    tuple_for_each(sizes{}, integer_tester{});
+}
+
+struct rational_tester {
+    template <typename S>
+    inline void operator()(const S &) const
+    {
+        using Catch::Matchers::Message;
+        using integer = integer<S::value>;
+        using rational = rational<S::value>;
+
+        std::vector<rational> rats;
+        detail::mpz_raii tmp;
+        std::uniform_int_distribution<unsigned> sdist(0, static_cast<unsigned>(S::value) + 1u), bdist(0, 1);
+        for (int i = 0; i < ntries; ++i) {
+            random_integer(tmp, sdist(rng), rng);
+            integer num{&tmp.m_mpz};
+            random_integer(tmp, sdist(rng), rng);
+            integer den{&tmp.m_mpz};
+            if (den.is_zero()) {
+                den = 1;
+            }
+            if (bdist(rng)) {
+                num.neg();
+            }
+            rats.emplace_back(num, den);
+        }
+
+        for (auto max_chunk : {std::size_t(1), std::size_t(13), std::size_t(10000)}) {
+            const auto buf = chunked_write(rats, max_chunk);
+            std::vector<rational> out;
+            chunked_read<rational>(buf, max_chunk, std::back_inserter(out));
+            REQUIRE(out == rats);
+        }
+
+        // The representation is the numerator followed by the denominator.
+        std::vector<char> buf(1000);
+        auto w = make_binary_archive_writer(rats.begin(), rats.begin() + 1);
+        const auto n = w.write(buf.data(), buf.size());
+        integer num, den;
+        const auto nsize = num.binary_load(buf.data());
+        REQUIRE(nsize + den.binary_load(buf.data() + nsize) == n);
+        REQUIRE(num == rats[0].get_num());
+        REQUIRE(den == rats[0].get_den());
+
+        // Non-canonical data.
+        std::vector<char> bad;
+        integer{2}.binary_save(buf);
+        bad.insert(bad.end(), buf.begin(), buf.begin() + static_cast<std::ptrdiff_t>(integer{2}.binary_size()));
+        integer{4}.binary_save(buf);
+        bad.insert(bad.end(), buf.begin(), buf.begin() + static_cast<std::ptrdiff_t>(integer{4}.binary_size()));
+        binary_archive_reader<rational> r;
+        std::vector<rational> out;
+        REQUIRE_THROWS_MATCHES(r.read(bad.data(), bad.size(), std::back_inserter(out)), std::invalid_argument,
+                               Message("Invalid data detected in the binary deserialisation of a rational: the "
+                                       "rational is not in canonical form"));
+        REQUIRE(out.empty());
+        REQUIRE(!r.pending());
+    }
+};
+
+TEST_CASE("binary_archive rational")
+{
+    tuple_for_each(sizes{}, rational_tester{});
+}
+
+#if defined(MPPP_WITH_MPFR)
+
+TEST_CASE("binary_archive real")
+{
+    std::vector<real> reals;
+    for (auto prec : {real_prec_min(), ::mpfr_prec_t(53), ::mpfr_prec_t(64), ::mpfr_prec_t(65), ::mpfr_prec_t(1000)}) {
+        reals.emplace_back(real{1, prec} / 3);
+        reals.emplace_back(-real{"1.1e100", prec});
+        reals.emplace_back(real{0, prec});
+        reals.emplace_back("inf", prec);
+    }
+
+    for (auto max_chunk : {std::size_t(1), std::size_t(13), std::size_t(10000)}) {
+        const auto buf = chunked_write(reals, max_chunk);
+        std::vector<real> out;
+        chunked_read<real>(buf, max_chunk, std::back_inserter(out));
+        REQUIRE(out.size() == reals.size());
+        for (std::size_t i = 0; i < out.size(); ++i) {
+            REQUIRE(out[i].get_prec() == reals[i].get_prec());
+            REQUIRE(out[i] == reals[i]);
+        }
+    }
+
+    std::stringstream ss;
+    REQUIRE(binary_save_range(ss, reals.begin(), reals.end()) > 0u);
+    std::vector<real> out;
+    binary_load_range<real>(ss, std::back_inserter(out));
+    REQUIRE(out.size() == reals.size());
+    for (std::size_t i = 0; i < out.size(); ++i) {
+        REQUIRE(out[i].get_prec() == reals[i].get_prec());
+        REQUIRE(out[i] == reals[i]);
+    }
+
+    // Several reals with mixed precisions loaded through
+    // a single reader into a non-reference output iterator.
+    std::vector<real> reals2;
+    for (int i = 0; i < 100; ++i) {
+        reals2.emplace_back(real{i, ::mpfr_prec_t(53 + 17 * (i % 7))} / 7);
+    }
+    std::stringstream ss2;
+    binary_save_range(ss2, reals2.begin(), reals2.end());
+    std::vector<real> out2;
+    binary_load_range<real>(ss2, std::back_inserter(out2));
+    REQUIRE(out2.size() == reals2.size());
+    for (std::size_t i = 0; i < out2.size(); ++i) {
+        REQUIRE(out2[i].get_prec() == reals2[i].get_prec());
+        REQUIRE(out2[i] == reals2[i]);
+    }
+}
+
+#endif
+
+TEST_CASE("binary_archive range")
+{
+    using Catch::Matchers::Message;
+
+    // Large enough to span several chunks.
+    std::vector<integer<1>> ints;
+    detail::mpz_raii tmp;
+    std::uniform_int_distribution<unsigned> sdist(0, 20);
+    for (int i = 0; i < 10 * ntries; ++i) {
+        random_integer(tmp, sdist(rng), rng);
+        ints.emplace_back(&tmp.m_mpz);
+    }
+    const auto ref = concat_binary_save(ints);
+    REQUIRE(ref.size() > 2u * detail::bin_archive_chunk_size);
+
+    std::stringstream ss;
+    REQUIRE(binary_save_range(ss, ints.begin(), ints.end()) == ref.size());
+    const auto str = ss.str();
+    REQUIRE(std::vector<char>(str.begin(), str.end()) == ref);
+
+    std::vector<integer<1>> out;
+    binary_load_range<integer<1>>(ss, std::back_inserter(out));
+    REQUIRE(out == ints);
+
+    // Empty stream.
+    std::stringstream empty;
+    out.clear();
+    binary_load_range<integer<1>>(empty, std::back_inserter(out));
+    REQUIRE(out.empty());
+
+    // Truncated stream.
+    std::stringstream trunc(str.substr(0, str.size() - 1u));
+    REQUIRE_THROWS_MATCHES(binary_load_range<integer<1>>(trunc, std::back_inserter(out)), std::invalid_argument,
+                           Message("Truncated binary archive: the end of the stream was reached while reading the "
+                                   "representation of an object"));
+
+    // Failing stream.
+    std::stringstream bad;
+    bad.setstate(std::ios_base::failbit);
+    REQUIRE(binary_save_range(bad, ints.begin(), ints.end()) == 0u);
+}
@@ -14,9 +14,11 @@
 
 #endif
 
+#include <cmath>
 #include <complex>
 #include <cstddef>
 #include <limits>
+#include <random>
 #include <stdexcept>
 #include <string>
 #include <tuple>
@@ -533,6 +535,157 @@ TEST_CASE("rel")
     tuple_for_each(sizes{}, rel_tester{});
 }
 
+// NOLINTNEXTLINE(cert-err58-cpp, cert-msc32-c, cert-msc51-cpp, cppcoreguidelines-avoid-non-const-global-variables)
+static std::mt19937 rng;
+
+template <typename Int, typename T>
+void check_mixed(const Int &n, const T &v)
+{
+    const Int iv{v};
+    REQUIRE((n == v) == (n == iv));
+    REQUIRE((v == n) == (n == iv));
+    REQUIRE((n < v) == (n < iv));
+    REQUIRE((v < n) == (iv < n));
+    REQUIRE((n > v) == (n > iv));
+    REQUIRE((v > n) == (iv > n));
+    REQUIRE(n * v == n * iv);
+    REQUIRE(v * n == n * iv);
+    auto m(n);
+    m *= v;
+    REQUIRE(m == n * iv);
+    REQUIRE(n + v == n + iv);
+    REQUIRE(n - v == n - iv);
+    REQUIRE((n | v) == (n | iv));
+    REQUIRE((v | n) == (n | iv));
+    REQUIRE((n & v) == (n & iv));
+    REQUIRE((v & n) == (n & iv));
+    REQUIRE((n ^ v) == (n ^ iv));
+    REQUIRE((v ^ n) == (n ^ iv));
+    m = n;
+    m |= v;
+    REQUIRE(m == (n | iv));
+    m = n;
+    m &= v;
+    REQUIRE(m == (n & iv));
+    m = n;
+    m ^= v;
+    REQUIRE(m == (n ^ iv));
+    if (!iv.is_zero()) {
+        REQUIRE(n / v == n / iv);
+        REQUIRE(n % v == n % iv);
+        m = n;
+        m /= v;
+        REQUIRE(m == n / iv);
+        m = n;
+        m %= v;
+        REQUIRE(m == n % iv);
+    }
+    if (!n.is_zero()) {
+        REQUIRE(v / n == iv / n);
+        REQUIRE(v % n == iv % n);
+    }
+}
+
+struct mixed_tester {
+    template <typename S>
+    // NOLINTNEXTLINE(google-readability-function-size, hicpp-function-size, readability-function-size)
+    void operator()(const S &) const
+    {
+        using Catch::Matchers::Message;
+        using integer = integer<S::value>;
+
+        // Exact comparisons with floating-point values.
+        const auto p53 = integer{1} << 53;
+        REQUIRE(p53 == 9007199254740992.);
+        REQUIRE(p53 + 1 != 9007199254740992.);
+        REQUIRE(9007199254740992. != p53 + 1);
+        REQUIRE(p53 + 1 > 9007199254740992.);
+        REQUIRE(9007199254740992. < p53 + 1);
+        REQUIRE(-(p53 + 1) < -9007199254740992.);
+        REQUIRE(p53 - 1 < 9007199254740992.);
+        REQUIRE(integer{16777217} != 16777216.f);
+        REQUIRE(integer{16777217} > 16777216.f);
+        REQUIRE(integer{3} > 2.5);
+        REQUIRE(integer{3} < 3.5);
+        REQUIRE(integer{3} != 3.5);
+        REQUIRE(integer{-3} < -2.5);
+        REQUIRE(integer{-3} > -3.5);
+        REQUIRE(integer{1} > 0.5);
+        REQUIRE(integer{} < 1E-300);
+        REQUIRE(integer{} > -1E-300);
+        REQUIRE(integer{} == -0.);
+        const integer big{1E300};
+        REQUIRE(big == 1E300);
+        REQUIRE(big + 1 > 1E300);
+        REQUIRE(big - 1 < 1E300);
+        REQUIRE(-big - 1 < -1E300);
+        REQUIRE(integer{1} << 2000 < std::numeric_limits<double>::infinity());
+        REQUIRE(-(integer{1} << 2000) > -std::numeric_limits<double>::infinity());
+        REQUIRE(integer{1} << 2000 != std::numeric_limits<double>::infinity());
+        const auto nan = std::numeric_limits<double>::quiet_NaN();
+        REQUIRE(!(integer{} == nan));
+        REQUIRE(integer{} != nan);
+        REQUIRE(!(integer{} < nan));
+        REQUIRE(!(integer{} > nan));
+        REQUIRE(!(nan < integer{}));
+        REQUIRE(!(nan > integer{}));
+        REQUIRE(std::complex<double>{9007199254740992., 0} != p53 + 1);
+        REQUIRE(std::complex<double>{9007199254740992., 0} == p53);
+
+        // Division by zero.
+        REQUIRE_THROWS_MATCHES(integer{1} / 0, zero_division_error, Message("Integer division by zero"));
+        REQUIRE_THROWS_MATCHES(integer{1} % 0ll, zero_division_error, Message("Integer division by zero"));
+        REQUIRE_THROWS_MATCHES(1 / integer{}, zero_division_error, Message("Integer division by zero"));
+        REQUIRE_THROWS_MATCHES(1u % integer{}, zero_division_error, Message("Integer division by zero"));
+
+        // Random testing against the integer-integer operations.
+        detail::mpz_raii tmp;
+        integer n;
+        std::uniform_int_distribution<long long> lldist(std::numeric_limits<long long>::min(),
+                                                        std::numeric_limits<long long>::max());
+        std::uniform_int_distribution<int> sdist(0, 1);
+        for (unsigned x = 0; x <= S::value + 1u; ++x) {
+            for (int i = 0; i < 200; ++i) {
+                random_integer(tmp, x, rng);
+                n = &tmp.m_mpz;
+                if (sdist(rng)) {
+                    n.neg();
+                }
+                if (n.is_static() && sdist(rng)) {
+                    n.promote();
+                }
+                const auto ll = lldist(rng);
+                check_mixed(n, ll);
+                check_mixed(n, static_cast<unsigned long long>(ll));
+                check_mixed(n, static_cast<int>(ll));
+                check_mixed(n, ll >> 40);
+                check_mixed(n, sdist(rng) == 1);
+                check_mixed(n, 0);
+#if defined(MPPP_HAVE_GCC_INT128)
+                const auto i128 = static_cast<__int128_t>(ll) * lldist(rng);
+                check_mixed(n, i128);
+                check_mixed(n, static_cast<__uint128_t>(i128));
+#endif
+                if (x <= 1u) {
+                    const auto d = static_cast<double>(ll);
+                    REQUIRE((n == d) == (n == integer{d}));
+                    REQUIRE((n < d) == (n < integer{d}));
+                    REQUIRE((n > d) == (n > integer{d}));
+                    const auto d2 = static_cast<double>(n);
+                    REQUIRE((n == d2) == (n == integer{d2}));
+                    REQUIRE((n < d2) == (n < integer{d2}));
+                    REQUIRE((n > d2) == (n > integer{d2}));
+                }
+            }
+        }
+    }
+};
+
+TEST_CASE("mixed mode")
+{
+    tuple_for_each(sizes{}, mixed_tester{});
+}
+
 #if defined(_MSC_VER)
 
 #pragma warning(pop)
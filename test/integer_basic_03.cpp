@@ -408,6 +408,63 @@ TEST_CASE("string constructor")
     tuple_for_each(sizes{}, string_ctor_tester{});
 }
 
+struct dec_string_tester {
+    template <typename S>
+    void operator()(const S &) const
+    {
+        using integer = integer<S::value>;
+        detail::mpz_raii m;
+        const auto check = [&m](const std::string &s) {
+            mpz_set_str(&m.m_mpz, s.c_str(), 10);
+            const integer n{s};
+            REQUIRE(n == integer{&m.m_mpz});
+            REQUIRE(n.is_static() == (mpz_size(&m.m_mpz) <= S::value));
+            REQUIRE(n.to_string() == s);
+            REQUIRE(lex_cast(n) == s);
+            REQUIRE((integer{s.data(), s.data() + s.size()} == n));
+            REQUIRE(integer{s[0] == '-' ? "-000" + s.substr(1) : "000" + s} == n);
+        };
+        // Values around the limb boundaries.
+        for (unsigned nbits = 1; nbits <= GMP_NUMB_BITS * (S::value + 1u); ++nbits) {
+            mpz_set_ui(&m.m_mpz, 1);
+            mpz_mul_2exp(&m.m_mpz, &m.m_mpz, nbits);
+            const auto p2 = detail::mpz_to_str(&m.m_mpz);
+            mpz_sub_ui(&m.m_mpz, &m.m_mpz, 1);
+            const auto p2m1 = detail::mpz_to_str(&m.m_mpz);
+            check(p2);
+            check("-" + p2);
+            check(p2m1);
+            check("-" + p2m1);
+        }
+        // Values around the powers of ten.
+        for (unsigned ndigits = 1; ndigits <= 20u * (S::value + 1u); ++ndigits) {
+            const auto p10 = "1" + std::string(ndigits, '0');
+            check(p10);
+            check("-" + p10);
+            check(std::string(ndigits, '9'));
+            check("-" + std::string(ndigits, '9'));
+        }
+        check("0");
+        REQUIRE(integer{"-0"}.is_zero());
+        REQUIRE(integer{"-0"}.is_static());
+        REQUIRE(integer{"0000000000000000000000000000000000000000000000000000000000000000000000000000001"} == 1);
+        // Random values.
+        for (int i = 0; i < ntries; ++i) {
+            random_integer(m, static_cast<unsigned>(rng() % (S::value + 2u)), rng);
+            const auto s = detail::mpz_to_str(&m.m_mpz);
+            check(s);
+            if (s != "0") {
+                check("-" + s);
+            }
+        }
+    }
+};
+
+TEST_CASE("decimal string conversions")
+{
+    tuple_for_each(sizes{}, dec_string_tester{});
+}
+
 struct mpz_copy_ctor_tester {
     template <typename S>
     void operator()(const S &) const
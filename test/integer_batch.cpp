@@ -0,0 +1,233 @@
+// Copyright 2016-2023 Francesco Biscani (bluescarni@gmail.com)
+//
+// This file is part of the mp++ library.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <mp++/config.hpp>
+
+#include <cstddef>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#if defined(MPPP_HAVE_STRING_VIEW)
+#include <string_view>
+#endif
+
+#include <mp++/detail/gmp.hpp>
+#include <mp++/detail/utils.hpp>
+#include <mp++/integer.hpp>
+#include <mp++/integer_batch.hpp>
+
+#include "catch.hpp"
+#include "test_utils.hpp"
+
+static const int ntries = 1000;
+
+// NOLINTNEXTLINE(google-build-using-namespace)
+using namespace mppp;
+// NOLINTNEXTLINE(google-build-using-namespace)
+using namespace mppp_test;
+
+using sizes = std::tuple<std::integral_constant<std::size_t, 1>, std::integral_constant<std::size_t, 2>,
+                         std::integral_constant<std::size_t, 3>, std::integral_constant<std::size_t, 6>>;
+
+// NOLINTNEXTLINE(cert-err58-cpp, cert-msc32-c, cert-msc51-cpp)
+static std::mt19937 rng;
+
+// Generate random integers with up to SSize + 1 limbs.
+template <std::size_t SSize>
+static std::vector<integer<SSize>> random_integers()
+{
+    std::vector<integer<SSize>> retval;
+    detail::mpz_raii tmp;
+    std::uniform_int_distribution<unsigned> sdist(0, static_cast<unsigned>(SSize) + 1u), bdist(0, 1);
+    for (int i = 0; i < ntries; ++i) {
+        random_integer(tmp, sdist(rng), rng);
+        retval.emplace_back(&tmp.m_mpz);
+        if (bdist(rng)) {
+            retval.back().neg();
+        }
+    }
+    return retval;
+}
+
+struct parse_tester {
+    template <typename S>
+    inline void operator()(const S &) const
+    {
+        using Catch::Matchers::Message;
+        using integer = integer<S::value>;
+
+        const auto ints = random_integers<S::value>();
+
+        for (auto base : {10, 16, 2, 36}) {
+            std::vector<std::string> strs;
+            for (const auto &n : ints) {
+                strs.push_back(n.to_string(base));
+            }
+            for (auto nthreads : {1u, 3u, 0u}) {
+                std::vector<integer> out;
+                parse_integers(out, strs.data(), strs.size(), base, nthreads);
+                REQUIRE(out == ints);
+                for (const auto &n : out) {
+                    REQUIRE(n.is_static() == (n.size() <= S::value));
+                }
+            }
+        }
+
+        // Limit values.
+        detail::mpz_raii tmp;
+        max_integer(tmp, static_cast<unsigned>(S::value));
+        const integer max{&tmp.m_mpz};
+        std::vector<std::string> strs{max.to_string(),     (-max).to_string(), (max + 1).to_string(),
+                                      (-max - 1).to_string(), "0",              "-0",
+                                      "00000000000000000000000000000000000000000000000000000000000000000000000042"};
+        std::vector<integer> out;
+        parse_integers(out, strs.data(), strs.size());
+        REQUIRE(out == std::vector<integer>{max, -max, max + 1, -max - 1, integer{}, integer{}, integer{42}});
+        REQUIRE(out[0].is_static());
+        REQUIRE(out[1].is_static());
+        REQUIRE(out[2].is_dynamic());
+        REQUIRE(out[3].is_dynamic());
+        REQUIRE(out[6].is_static());
+
+        // The storage of the existing elements is overwritten.
+        strs = {"1", "-2", "3"};
+        out = {max + 1, integer{5}};
+        parse_integers(out, strs.data(), strs.size(), 10, 2);
+        REQUIRE(out == std::vector<integer>{integer{1}, integer{-2}, integer{3}});
+        REQUIRE(out[0].is_static());
+
+        // Formats handled by the slow path.
+        strs = {" 123", "0x1f", "-0b101"};
+        parse_integers(out, strs.data(), strs.size(), 0);
+        REQUIRE(out == std::vector<integer>{integer{123}, integer{31}, integer{-5}});
+
+        // Empty input.
+        parse_integers(out, strs.data(), 0);
+        REQUIRE(out.empty());
+
+        // Errors.
+        strs = {"1", "2", "-", "3", "", "4a"};
+        for (auto nthreads : {1u, 2u, 6u}) {
+            REQUIRE_THROWS_MATCHES(parse_integers(out, strs.data(), strs.size(), 10, nthreads),
+                                   std::invalid_argument,
+                                   Message("The string '-' is not a valid integer in base 10"));
+        }
+        REQUIRE_THROWS_MATCHES(parse_integers(out, strs.data(), strs.size(), 1), std::invalid_argument,
+                               Message("In the parsing of a batch of integers, a base of 1 was specified, but the "
+                                       "only valid values are 0 and any value in the [2,62] range"));
+
+#if defined(MPPP_HAVE_STRING_VIEW)
+        const std::string buffer = "123-4567890";
+        const std::string_view views[] = {std::string_view(buffer.data(), 3u), std::string_view(buffer.data() + 3, 2u),
+                                          std::string_view(buffer.data() + 5, 6u)};
+        parse_integers(out, views, 3, 10, 2);
+        REQUIRE(out == std::vector<integer>{integer{123}, integer{-4}, integer{567890}});
+#endif
+    }
+};
+
+TEST_CASE("parse_integers")
+{
+    tuple_for_each(sizes{}, parse_tester{});
+}
+
+struct format_tester {
+    template <typename S>
+    inline void operator()(const S &) const
+    {
+        using Catch::Matchers::Message;
+        using integer = integer<S::value>;
+
+        const auto ints = random_integers<S::value>();
+
+        std::vector<char> buf;
+        std::vector<std::size_t> offsets;
+        for (auto base : {10, 16, 62}) {
+            for (auto nthreads : {1u, 3u, 0u}) {
+                format_integers(buf, offsets, ints.data(), ints.size(), base, nthreads);
+                REQUIRE(offsets.size() == ints.size() + 1u);
+                REQUIRE(offsets.front() == 0u);
+                REQUIRE(offsets.back() == buf.size());
+                for (std::size_t i = 0; i < ints.size(); ++i) {
+                    REQUIRE(std::string(buf.data() + offsets[i], buf.data() + offsets[i + 1u])
+                            == ints[i].to_string(base));
+                }
+            }
+        }
+
+        // Limit values.
+        detail::mpz_raii tmp;
+        max_integer(tmp, static_cast<unsigned>(S::value));
+        const integer max{&tmp.m_mpz};
+        const std::vector<integer> lims{integer{}, max, -max, max + 1, integer{-1}};
+        format_integers(buf, offsets, lims.data(), lims.size(), 10, 2);
+        REQUIRE(std::string(buf.begin(), buf.end())
+                == "0" + max.to_string() + (-max).to_string() + (max + 1).to_string() + "-1");
+        REQUIRE(offsets
+                == std::vector<std::size_t>{0u, 1u, 1u + max.to_string().size(), 2u + 2u * max.to_string().size(),
+                                            2u + 2u * max.to_string().size() + (max + 1).to_string().size(),
+                                            buf.size()});
+
+        // Empty input.
+        format_integers(buf, offsets, lims.data(), 0);
+        REQUIRE(buf.empty());
+        REQUIRE(offsets == std::vector<std::size_t>{0u});
+
+        // Round trip.
+        std::vector<std::string> strs;
+        format_integers(buf, offsets, ints.data(), ints.size(), 10, 4);
+        for (std::size_t i = 0; i < ints.size(); ++i) {
+            strs.emplace_back(buf.data() + offsets[i], buf.data() + offsets[i + 1u]);
+        }
+        std::vector<integer> out;
+        parse_integers(out, strs.data(), strs.size(), 10, 4);
+        REQUIRE(out == ints);
+
+        // Errors.
+        REQUIRE_THROWS_MATCHES(format_integers(buf, offsets, lims.data(), lims.size(), 63), std::invalid_argument,
+                               Message("Invalid base for string conversion: the base must be between 2 and 62, but "
+                                       "a value of 63 was provided instead"));
+    }
+};
+
+TEST_CASE("format_integers")
+{
+    tuple_for_each(sizes{}, format_tester{});
+}
+
+TEST_CASE("parallel_for_chunks")
+{
+    REQUIRE(detail::parallel_nchunks(0, 4) == 0u);
+    REQUIRE(detail::parallel_nchunks(3, 4) == 3u);
+    REQUIRE(detail::parallel_nchunks(10, 4) == 4u);
+    REQUIRE(detail::parallel_nchunks(10, 0) >= 1u);
+
+    // The chunks cover the range without overlaps.
+    for (auto n : {0u, 1u, 7u, 100u}) {
+        for (auto nthreads : {1u, 3u, 8u}) {
+            std::vector<int> flags(n);
+            std::vector<std::size_t> chunk_sizes(detail::parallel_nchunks(n, nthreads));
+            auto func = [&flags, &chunk_sizes](std::size_t c, std::size_t begin, std::size_t end) {
+                chunk_sizes[c] = end - begin;
+                for (auto i = begin; i != end; ++i) {
+                    ++flags[i];
+                }
+            };
+            detail::parallel_for_chunks(n, nthreads, func);
+            REQUIRE(flags == std::vector<int>(n, 1));
+            for (auto s : chunk_sizes) {
+                REQUIRE(s >= n / chunk_sizes.size());
+                REQUIRE(s <= n / chunk_sizes.size() + 1u);
+            }
+        }
+    }
+}
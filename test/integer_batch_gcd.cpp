@@ -0,0 +1,189 @@
+// Copyright 2016-2023 Francesco Biscani (bluescarni@gmail.com)
+//
+// This file is part of the mp++ library.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <cstddef>
+#include <random>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include <mp++/detail/gmp.hpp>
+#include <mp++/integer.hpp>
+#include <mp++/integer_batch_gcd.hpp>
+
+#include "catch.hpp"
+#include "test_utils.hpp"
+
+static const int ntries = 300;
+
+// NOLINTNEXTLINE(google-build-using-namespace)
+using namespace mppp;
+// NOLINTNEXTLINE(google-build-using-namespace)
+using namespace mppp_test;
+
+using sizes = std::tuple<std::integral_constant<std::size_t, 1>, std::integral_constant<std::size_t, 2>,
+                         std::integral_constant<std::size_t, 3>, std::integral_constant<std::size_t, 6>>;
+
+// NOLINTNEXTLINE(cert-err58-cpp, cert-msc32-c, cert-msc51-cpp)
+static std::mt19937 rng;
+
+// Quadratic reference implementation of batch_gcd().
+template <std::size_t SSize>
+static std::vector<integer<SSize>> naive_batch_gcd(const std::vector<integer<SSize>> &v)
+{
+    std::vector<integer<SSize>> retval;
+    for (decltype(v.size()) i = 0; i < v.size(); ++i) {
+        integer<SSize> prod{1};
+        for (decltype(v.size()) j = 0; j < v.size(); ++j) {
+            if (j != i) {
+                prod *= v[j];
+            }
+        }
+        retval.push_back(gcd(v[i], prod));
+    }
+    return retval;
+}
+
+struct batch_gcd_tester {
+    template <typename S>
+    inline void operator()(const S &) const
+    {
+        using integer = integer<S::value>;
+
+        std::vector<integer> v, out{integer{42}};
+
+        // Empty and single-element input.
+        batch_gcd(out, v.data(), v.size());
+        REQUIRE(out.empty());
+        v = {integer{-12}};
+        batch_gcd(out, v.data(), v.size());
+        REQUIRE(out == std::vector<integer>{integer{1}});
+        v = {integer{}};
+        batch_gcd(out, v.data(), v.size());
+        REQUIRE(out == std::vector<integer>{integer{1}});
+
+        // A few simple tests.
+        v = {integer{6}, integer{-10}, integer{15}, integer{7}};
+        batch_gcd(out, v.data(), v.size());
+        REQUIRE(out == std::vector<integer>{integer{6}, integer{10}, integer{15}, integer{1}});
+        v = {integer{35}, integer{77}, integer{-143}};
+        batch_gcd(out, v.data(), v.size(), 0);
+        REQUIRE(out == std::vector<integer>{integer{7}, integer{77}, integer{11}});
+
+        // Zeroes.
+        v = {integer{6}, integer{}, integer{-10}};
+        batch_gcd(out, v.data(), v.size());
+        REQUIRE(out == std::vector<integer>{integer{6}, integer{60}, integer{10}});
+        v = {integer{6}, integer{}, integer{-10}, integer{}};
+        batch_gcd(out, v.data(), v.size());
+        REQUIRE(out == std::vector<integer>{integer{6}, integer{}, integer{10}, integer{}});
+
+        // Random testing against the naive implementation.
+        detail::mpz_raii tmp;
+        std::uniform_int_distribution<unsigned> sdist(0, static_cast<unsigned>(S::value) + 1u), bdist(0, 1);
+        std::uniform_int_distribution<int> ndist(2, 40), pdist(0, 9);
+        const integer primes[] = {integer{3}, integer{5}, integer{7}, integer{11}, integer{13}};
+        for (int i = 0; i < ntries; ++i) {
+            v.clear();
+            const auto nvals = ndist(rng);
+            for (int j = 0; j < nvals; ++j) {
+                random_integer(tmp, sdist(rng), rng);
+                v.emplace_back(&tmp.m_mpz);
+                if (v.back().is_zero() && pdist(rng) != 0) {
+                    // Keep the zeroes rare.
+                    v.back() = 1;
+                }
+                // Introduce common factors.
+                const auto p = pdist(rng);
+                if (p < 5) {
+                    v.back() *= primes[p];
+                }
+                if (bdist(rng)) {
+                    v.back().neg();
+                }
+            }
+            const auto cmp = naive_batch_gcd(v);
+            for (auto nthreads : {1u, 3u, 0u}) {
+                batch_gcd(out, v.data(), v.size(), nthreads);
+                REQUIRE(out == cmp);
+            }
+        }
+    }
+};
+
+TEST_CASE("batch_gcd")
+{
+    tuple_for_each(sizes{}, batch_gcd_tester{});
+}
+
+struct range_tester {
+    template <typename S>
+    inline void operator()(const S &) const
+    {
+        using integer = integer<S::value>;
+
+        integer r{42};
+        std::vector<integer> v;
+
+        // Empty ranges.
+        REQUIRE(&gcd_range(r, v.data(), v.size()) == &r);
+        REQUIRE(r == 0);
+        REQUIRE(&lcm_range(r, v.data(), v.size()) == &r);
+        REQUIRE(r == 1);
+
+        // A few simple tests.
+        v = {integer{12}, integer{-18}, integer{30}};
+        REQUIRE(gcd_range(r, v.data(), v.size()) == 6);
+        REQUIRE(lcm_range(r, v.data(), v.size()) == 180);
+        v = {integer{}, integer{-5}};
+        REQUIRE(gcd_range(r, v.data(), v.size()) == 5);
+        REQUIRE(lcm_range(r, v.data(), v.size()) == 0);
+        v = {integer{}, integer{}};
+        REQUIRE(gcd_range(r, v.data(), v.size()) == 0);
+        REQUIRE(lcm_range(r, v.data(), v.size()) == 0);
+
+        // rop in the input range.
+        v = {integer{12}, integer{-18}, integer{30}};
+        REQUIRE(gcd_range(v[1], v.data(), v.size()) == 6);
+        v = {integer{12}, integer{-18}, integer{30}};
+        REQUIRE(lcm_range(v[2], v.data(), v.size()) == 180);
+
+        // Random testing against the sequential reduction.
+        detail::mpz_raii tmp;
+        std::uniform_int_distribution<unsigned> sdist(0, static_cast<unsigned>(S::value) + 1u), bdist(0, 1);
+        std::uniform_int_distribution<int> ndist(0, 40);
+        const integer factors[] = {integer{1}, integer{6}, integer{35}};
+        for (int i = 0; i < ntries; ++i) {
+            v.clear();
+            const auto nvals = ndist(rng);
+            const auto &f = factors[i % 3];
+            for (int j = 0; j < nvals; ++j) {
+                random_integer(tmp, sdist(rng), rng);
+                v.emplace_back(&tmp.m_mpz);
+                v.back() *= f;
+                if (bdist(rng)) {
+                    v.back().neg();
+                }
+            }
+            integer g, l{1};
+            for (const auto &n : v) {
+                gcd(g, g, n);
+                lcm(l, l, n);
+            }
+            for (auto nthreads : {1u, 3u, 0u}) {
+                REQUIRE(gcd_range(r, v.data(), v.size(), nthreads) == g);
+                REQUIRE(lcm_range(r, v.data(), v.size(), nthreads) == l);
+            }
+        }
+    }
+};
+
+TEST_CASE("gcd/lcm range")
+{
+    tuple_for_each(sizes{}, range_tester{});
+}
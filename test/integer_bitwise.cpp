@@ -9,9 +9,13 @@
 #include <array>
 #include <cstddef>
 #include <initializer_list>
+#include <limits>
 #include <random>
+#include <stdexcept>
+#include <string>
 #include <tuple>
 #include <type_traits>
+#include <utility>
 
 #include <gmp.h>
 
@@ -29,8 +33,8 @@ using namespace mppp;
 using namespace mppp_test;
 
 using sizes = std::tuple<std::integral_constant<std::size_t, 1>, std::integral_constant<std::size_t, 2>,
-                         std::integral_constant<std::size_t, 3>, std::integral_constant<std::size_t, 6>,
-                         std::integral_constant<std::size_t, 10>>;
+                         std::integral_constant<std::size_t, 3>, std::integral_constant<std::size_t, 4>,
+                         std::integral_constant<std::size_t, 6>, std::integral_constant<std::size_t, 10>>;
 
 // NOLINTNEXTLINE(cert-err58-cpp, cert-msc32-c, cert-msc51-cpp, cppcoreguidelines-avoid-non-const-global-variables)
 static std::mt19937 rng;
@@ -1791,6 +1795,28 @@ struct xor_tester {
             REQUIRE(n1 == integer{&m1.m_mpz});
             REQUIRE(n1 == (n3 ^ n2));
         }
+        // Return value overlapping with the operands, for all the sign combinations.
+        for (auto p : {std::make_pair(0, 25), std::make_pair(25, 0), std::make_pair(25, 6), std::make_pair(-25, 6),
+                       std::make_pair(25, -6), std::make_pair(-25, -6), std::make_pair(-25, 25),
+                       std::make_pair(25, 25)}) {
+            n2 = p.first;
+            n3 = p.second;
+            mpz_set(&m2.m_mpz, n2.get_mpz_view());
+            mpz_set(&m3.m_mpz, n3.get_mpz_view());
+            mpz_xor(&m1.m_mpz, &m2.m_mpz, &m3.m_mpz);
+            n1 = n2;
+            bitwise_xor(n1, n1, n3);
+            REQUIRE(n1 == integer{&m1.m_mpz});
+            n1 = n3;
+            bitwise_xor(n1, n2, n1);
+            REQUIRE(n1 == integer{&m1.m_mpz});
+            n1 = n2;
+            n1 ^= n3;
+            REQUIRE(n1 == integer{&m1.m_mpz});
+            n1 = n2;
+            bitwise_xor(n1, n1, n1);
+            REQUIRE(n1 == 0);
+        }
         // A couple of tests for the operators.
         REQUIRE((integer{} ^ 0) == 0);
         REQUIRE((0 ^ integer{}) == 0);
@@ -1800,6 +1826,12 @@ struct xor_tester {
         n1 = 25;
         n1 ^= -6;
         REQUIRE(n1 == -29);
+        n1 = 0;
+        n1 ^= 25;
+        REQUIRE(n1 == 25);
+        REQUIRE(n1.is_static());
+        n1 ^= n1;
+        REQUIRE(n1 == 0);
         int tmp_int = 25;
         tmp_int ^= integer{-6};
         REQUIRE(tmp_int == -29);
@@ -1829,3 +1861,210 @@ TEST_CASE("integer xor")
 {
     tuple_for_each(sizes{}, xor_tester{});
 }
+
+// Generate a random integer with x limbs, a random sign and
+// random storage type, setting m to the same value.
+template <typename Integer>
+static void random_bit_operand(Integer &n, detail::mpz_raii &m, unsigned x)
+{
+    std::uniform_int_distribution<int> sdist(0, 1);
+    random_integer(m, x, rng);
+    if (sdist(rng)) {
+        mpz_neg(&m.m_mpz, &m.m_mpz);
+    }
+    n = Integer{&m.m_mpz};
+    if (n.is_static() && sdist(rng)) {
+        n.promote();
+    }
+}
+
+struct popcount_hamdist_tester {
+    template <typename S>
+    inline void operator()(const S &) const
+    {
+        using integer = integer<S::value>;
+        REQUIRE(popcount(integer{}) == 0u);
+        REQUIRE(popcount(integer{1}) == 1u);
+        REQUIRE(popcount(integer{255}) == 8u);
+        REQUIRE(hamdist(integer{}, integer{}) == 0u);
+        REQUIRE(hamdist(integer{5}, integer{2}) == 3u);
+        REQUIRE(hamdist(integer{-1}, integer{-2}) == 1u);
+        REQUIRE_THROWS_PREDICATE(popcount(integer{-3}), std::domain_error, [](const std::domain_error &ex) {
+            return std::string(ex.what()) == "Cannot compute the population count of the negative number -3";
+        });
+        REQUIRE_THROWS_PREDICATE(hamdist(integer{3}, integer{-3}), std::domain_error,
+                                 [](const std::domain_error &ex) {
+                                     return std::string(ex.what())
+                                            == "Cannot compute the Hamming distance between the integers 3 and -3, "
+                                               "which have different signs";
+                                 });
+        REQUIRE_THROWS_AS(hamdist(integer{-3}, integer{0}), std::domain_error);
+
+        detail::mpz_raii m1, m2;
+        integer n1, n2;
+        for (unsigned x = 0; x <= 4u; ++x) {
+            for (unsigned y = 0; y <= 4u; ++y) {
+                for (int i = 0; i < ntries; ++i) {
+                    random_bit_operand(n1, m1, x);
+                    random_bit_operand(n2, m2, y);
+                    if (n1.sgn() >= 0) {
+                        REQUIRE(popcount(n1) == mpz_popcount(&m1.m_mpz));
+                    }
+                    if ((n1.sgn() == -1) == (n2.sgn() == -1)) {
+                        REQUIRE(hamdist(n1, n2) == mpz_hamdist(&m1.m_mpz, &m2.m_mpz));
+                    } else {
+                        REQUIRE_THROWS_AS(hamdist(n1, n2), std::domain_error);
+                    }
+                }
+            }
+        }
+    }
+};
+
+TEST_CASE("integer popcount hamdist")
+{
+    tuple_for_each(sizes{}, popcount_hamdist_tester{});
+}
+
+struct scan_tstbit_tester {
+    template <typename S>
+    inline void operator()(const S &) const
+    {
+        using integer = integer<S::value>;
+        const auto not_found = std::numeric_limits<::mp_bitcnt_t>::max();
+        REQUIRE(scan1(integer{}, 0) == not_found);
+        REQUIRE(scan0(integer{}, 0) == 0u);
+        REQUIRE(scan0(integer{}, 1000) == 1000u);
+        REQUIRE(scan1(integer{12}, 0) == 2u);
+        REQUIRE(scan1(integer{12}, 3) == 3u);
+        REQUIRE(scan1(integer{12}, 4) == not_found);
+        REQUIRE(scan0(integer{7}, 0) == 3u);
+        REQUIRE(scan0(integer{-1}, 0) == not_found);
+        REQUIRE(scan1(integer{-4}, 100) == 100u);
+        REQUIRE(!tstbit(integer{}, 0));
+        REQUIRE(tstbit(integer{4}, 2));
+        REQUIRE(!tstbit(integer{4}, 1000));
+        REQUIRE(tstbit(integer{-4}, 1000));
+        REQUIRE(!tstbit(integer{-4}, 1));
+
+        detail::mpz_raii m;
+        integer n;
+        std::uniform_int_distribution<::mp_bitcnt_t> bdist(0, 5u * GMP_NUMB_BITS);
+        for (unsigned x = 0; x <= 4u; ++x) {
+            for (int i = 0; i < ntries; ++i) {
+                random_bit_operand(n, m, x);
+                const auto idx = bdist(rng);
+                REQUIRE(scan0(n, idx) == mpz_scan0(&m.m_mpz, idx));
+                REQUIRE(scan1(n, idx) == mpz_scan1(&m.m_mpz, idx));
+                REQUIRE(tstbit(n, idx) == (mpz_tstbit(&m.m_mpz, idx) != 0));
+            }
+        }
+    }
+};
+
+TEST_CASE("integer scan tstbit")
+{
+    tuple_for_each(sizes{}, scan_tstbit_tester{});
+}
+
+struct setbit_tester {
+    template <typename S>
+    inline void operator()(const S &) const
+    {
+        using integer = integer<S::value>;
+        integer n;
+        REQUIRE(&setbit(n, 3) == &n);
+        REQUIRE(n == 8);
+        REQUIRE(&combit(n, 0) == &n);
+        REQUIRE(n == 9);
+        REQUIRE(&clrbit(n, 3) == &n);
+        REQUIRE(n == 1);
+        combit(n, 0);
+        REQUIRE(n == 0);
+        REQUIRE(n.is_static());
+        clrbit(n, 1000);
+        REQUIRE(n == 0);
+        REQUIRE(n.is_static());
+        setbit(n, S::value * GMP_NUMB_BITS);
+        REQUIRE(n == integer{1} << (S::value * GMP_NUMB_BITS));
+        REQUIRE(n.is_dynamic());
+        n = -8;
+        setbit(n, 0);
+        REQUIRE(n == -7);
+        clrbit(n, 3);
+        REQUIRE(n == -15);
+        REQUIRE(n.is_static());
+
+        detail::mpz_raii m;
+        std::uniform_int_distribution<::mp_bitcnt_t> bdist(0, 5u * GMP_NUMB_BITS);
+        std::uniform_int_distribution<int> odist(0, 2);
+        for (unsigned x = 0; x <= 4u; ++x) {
+            for (int i = 0; i < ntries; ++i) {
+                random_bit_operand(n, m, x);
+                // Perform a few operations in sequence.
+                for (int j = 0; j < 4; ++j) {
+                    const auto idx = bdist(rng);
+                    switch (odist(rng)) {
+                        case 0:
+                            setbit(n, idx);
+                            mpz_setbit(&m.m_mpz, idx);
+                            break;
+                        case 1:
+                            clrbit(n, idx);
+                            mpz_clrbit(&m.m_mpz, idx);
+                            break;
+                        default:
+                            combit(n, idx);
+                            mpz_combit(&m.m_mpz, idx);
+                    }
+                    REQUIRE(n == integer{&m.m_mpz});
+                    REQUIRE((lex_cast(n) == lex_cast(m)));
+                }
+            }
+        }
+    }
+};
+
+TEST_CASE("integer setbit clrbit combit")
+{
+    tuple_for_each(sizes{}, setbit_tester{});
+}
+
+struct extract_bits_tester {
+    template <typename S>
+    inline void operator()(const S &) const
+    {
+        using integer = integer<S::value>;
+        integer rop{42};
+        REQUIRE(&extract_bits(rop, integer{}, 0, 10) == &rop);
+        REQUIRE(rop == 0);
+        REQUIRE(extract_bits(rop, integer{0xf0}, 4, 2) == 3);
+        REQUIRE(extract_bits(rop, integer{0xf0}, 4, 0) == 0);
+        REQUIRE(extract_bits(rop, integer{0xf0}, 4, 1000) == 15);
+        REQUIRE(extract_bits(rop, integer{-1}, 100, 5) == 31);
+        REQUIRE(extract_bits(rop, integer{-16}, 2, 4) == 12);
+        REQUIRE(rop.is_static());
+
+        detail::mpz_raii m, tmp;
+        integer n;
+        std::uniform_int_distribution<::mp_bitcnt_t> bdist(0, 5u * GMP_NUMB_BITS);
+        for (unsigned x = 0; x <= 4u; ++x) {
+            for (int i = 0; i < ntries; ++i) {
+                random_bit_operand(n, m, x);
+                const auto begin = bdist(rng), len = bdist(rng);
+                mpz_fdiv_q_2exp(&tmp.m_mpz, &m.m_mpz, begin);
+                mpz_fdiv_r_2exp(&tmp.m_mpz, &tmp.m_mpz, len);
+                extract_bits(rop, n, begin, len);
+                REQUIRE((lex_cast(rop) == lex_cast(tmp)));
+                // Overlapping arguments.
+                extract_bits(n, n, begin, len);
+                REQUIRE((lex_cast(n) == lex_cast(tmp)));
+            }
+        }
+    }
+};
+
+TEST_CASE("integer extract_bits")
+{
+    tuple_for_each(sizes{}, extract_bits_tester{});
+}
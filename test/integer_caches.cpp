@@ -9,6 +9,7 @@
 #include <atomic>
 #include <cstddef>
 #include <random>
+#include <stdexcept>
 #include <thread>
 #include <tuple>
 #include <type_traits>
@@ -120,3 +121,74 @@ TEST_CASE("caches")
 {
     tuple_for_each(sizes{}, cache_tester{});
 }
+
+TEST_CASE("cache stats")
+{
+    using integer = integer<1>;
+    REQUIRE(get_integer_cache_max_size() == detail::mpz_alloc_cache::max_size);
+    REQUIRE(get_integer_cache_max_entries() == detail::mpz_alloc_cache::max_entries);
+    REQUIRE_THROWS_AS(set_integer_cache_max_size(detail::mpz_alloc_cache::max_size + 1u), std::invalid_argument);
+    REQUIRE_THROWS_AS(set_integer_cache_max_entries(detail::mpz_alloc_cache::max_entries + 1u),
+                      std::invalid_argument);
+
+    free_integer_caches();
+    auto s0 = get_thread_integer_cache_stats();
+    for (auto b : s0.bytes) {
+        REQUIRE(b == 0u);
+    }
+
+    // Create and destroy some dynamic integers with 2 limbs.
+    {
+        std::vector<integer> v(5, integer{1} << GMP_NUMB_BITS);
+    }
+    auto s1 = get_thread_integer_cache_stats();
+#if defined(MPPP_HAVE_THREAD_LOCAL)
+    REQUIRE(s1.bytes[1] == 5u * 2u * sizeof(::mp_limb_t));
+    REQUIRE(s1.misses > s0.misses);
+    {
+        std::vector<integer> v(5, integer{1} << GMP_NUMB_BITS);
+    }
+    auto s2 = get_thread_integer_cache_stats();
+    REQUIRE(s2.hits >= s1.hits + 5u);
+    REQUIRE(s2.bytes[1] == 5u * 2u * sizeof(::mp_limb_t));
+
+    // The aggregated stats include the current thread.
+    auto g = get_integer_cache_stats();
+    REQUIRE(g.hits >= s2.hits);
+    REQUIRE(g.bytes[1] >= s2.bytes[1]);
+
+    // Stats from another thread are retained after its exit.
+    std::thread t([]() {
+        for (int i = 0; i < 10; ++i) {
+            std::vector<integer> v(5, integer{1} << GMP_NUMB_BITS);
+        }
+    });
+    t.join();
+    auto g2 = get_integer_cache_stats();
+    REQUIRE(g2.hits >= g.hits + 45u);
+
+    // Lower the limits: the cache of the current thread is trimmed.
+    set_integer_cache_max_entries(3);
+    REQUIRE(get_integer_cache_max_entries() == 3u);
+    auto s3 = get_thread_integer_cache_stats();
+    REQUIRE(s3.bytes[1] == 3u * 2u * sizeof(::mp_limb_t));
+    REQUIRE(s3.evictions == s2.evictions + 2u);
+    {
+        std::vector<integer> v(5, integer{1} << GMP_NUMB_BITS);
+    }
+    REQUIRE(get_thread_integer_cache_stats().bytes[1] == 3u * 2u * sizeof(::mp_limb_t));
+    set_integer_cache_max_size(1);
+    REQUIRE(get_integer_cache_max_size() == 1u);
+    REQUIRE(get_thread_integer_cache_stats().bytes[1] == 0u);
+    {
+        std::vector<integer> v(5, integer{1} << GMP_NUMB_BITS);
+    }
+    REQUIRE(get_thread_integer_cache_stats().bytes[1] == 0u);
+#else
+    REQUIRE(s1.hits == 0u);
+#endif
+
+    set_integer_cache_max_size(detail::mpz_alloc_cache::max_size);
+    set_integer_cache_max_entries(detail::mpz_alloc_cache::max_entries);
+    free_integer_caches();
+}
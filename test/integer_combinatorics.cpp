@@ -0,0 +1,293 @@
+// Copyright 2016-2023 Francesco Biscani (bluescarni@gmail.com)
+//
+// This file is part of the mp++ library.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <cstddef>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include <gmp.h>
+
+#include <mp++/detail/gmp.hpp>
+#include <mp++/integer.hpp>
+#include <mp++/integer_combinatorics.hpp>
+
+#include "catch.hpp"
+#include "test_utils.hpp"
+
+static const int ntries = 200;
+
+// NOLINTNEXTLINE(google-build-using-namespace)
+using namespace mppp;
+// NOLINTNEXTLINE(google-build-using-namespace)
+using namespace mppp_test;
+
+using sizes = std::tuple<std::integral_constant<std::size_t, 1>, std::integral_constant<std::size_t, 2>,
+                         std::integral_constant<std::size_t, 3>, std::integral_constant<std::size_t, 6>>;
+
+// NOLINTNEXTLINE(cert-err58-cpp, cert-msc32-c, cert-msc51-cpp)
+static std::mt19937 rng;
+
+static const unsigned nthreads_list[] = {1u, 3u, 0u};
+
+// Naive reference implementations.
+template <std::size_t SSize>
+static integer<SSize> naive_double_fac(unsigned long n)
+{
+    integer<SSize> retval{1};
+    for (; n > 1u; n -= 2u) {
+        retval *= n;
+    }
+    return retval;
+}
+
+template <std::size_t SSize>
+static integer<SSize> naive_primorial(unsigned long n)
+{
+    integer<SSize> retval{1};
+    for (unsigned long p = 2; p <= n; ++p) {
+        bool prime = true;
+        for (unsigned long d = 2; d * d <= p; ++d) {
+            if (p % d == 0u) {
+                prime = false;
+                break;
+            }
+        }
+        if (prime) {
+            retval *= p;
+        }
+    }
+    return retval;
+}
+
+struct fac_tester {
+    template <typename S>
+    inline void operator()(const S &) const
+    {
+        using integer = integer<S::value>;
+        detail::mpz_raii m;
+        integer n;
+        std::uniform_int_distribution<unsigned long> dist(0, 5000);
+        for (auto nt : nthreads_list) {
+            for (unsigned long i : {0ul, 1ul, 2ul, 19ul, 20ul, 21ul, 22ul, 100ul, 100000ul}) {
+                mpz_fac_ui(&m.m_mpz, i);
+                REQUIRE(&fac_ui(n, i, nt) == &n);
+                REQUIRE((lex_cast(n) == lex_cast(m)));
+            }
+            for (int i = 0; i < ntries; ++i) {
+                const auto x = dist(rng);
+                mpz_fac_ui(&m.m_mpz, x);
+                fac_ui(n, x, nt);
+                REQUIRE((lex_cast(n) == lex_cast(m)));
+            }
+        }
+        // The single-threaded version on the small values.
+        for (unsigned long i = 0; i <= 25u; ++i) {
+            mpz_fac_ui(&m.m_mpz, i);
+            fac_ui(n, i);
+            REQUIRE((lex_cast(n) == lex_cast(m)));
+            if (i <= 20u && S::value * GMP_NUMB_BITS >= 64u) {
+                REQUIRE(n.is_static());
+            }
+        }
+        REQUIRE_THROWS_PREDICATE(fac_ui(n, 100000001ul, 0), std::invalid_argument,
+                                 [](const std::invalid_argument &ex) {
+                                     return std::string(ex.what())
+                                            == "The value 100000001 is too large to be used as input for the "
+                                               "factorial function (the maximum allowed value is 100000000)";
+                                 });
+    }
+};
+
+TEST_CASE("fac_ui mt")
+{
+    tuple_for_each(sizes{}, fac_tester{});
+}
+
+struct double_fac_tester {
+    template <typename S>
+    inline void operator()(const S &) const
+    {
+        using integer = integer<S::value>;
+        integer n;
+        for (unsigned long i = 0; i < 300u; ++i) {
+            const auto cmp = naive_double_fac<S::value>(i);
+            REQUIRE(&double_fac_ui(n, i) == &n);
+            REQUIRE(n == cmp);
+            for (auto nt : nthreads_list) {
+                REQUIRE(double_fac_ui(n, i, nt) == cmp);
+            }
+        }
+        for (unsigned long i : {20000ul, 20001ul}) {
+            const auto cmp = naive_double_fac<S::value>(i);
+            for (auto nt : nthreads_list) {
+                REQUIRE(double_fac_ui(n, i, nt) == cmp);
+            }
+        }
+        REQUIRE_THROWS_PREDICATE(double_fac_ui(n, 100000001ul), std::invalid_argument,
+                                 [](const std::invalid_argument &ex) {
+                                     return std::string(ex.what())
+                                            == "The value 100000001 is too large to be used as input for the "
+                                               "double factorial function (the maximum allowed value is 100000000)";
+                                 });
+    }
+};
+
+TEST_CASE("double_fac_ui")
+{
+    tuple_for_each(sizes{}, double_fac_tester{});
+}
+
+struct primorial_tester {
+    template <typename S>
+    inline void operator()(const S &) const
+    {
+        using integer = integer<S::value>;
+        integer n;
+        for (unsigned long i = 0; i < 300u; ++i) {
+            const auto cmp = naive_primorial<S::value>(i);
+            REQUIRE(&primorial_ui(n, i) == &n);
+            REQUIRE(n == cmp);
+            for (auto nt : nthreads_list) {
+                REQUIRE(primorial_ui(n, i, nt) == cmp);
+            }
+        }
+        const auto cmp = naive_primorial<S::value>(30000);
+        for (auto nt : nthreads_list) {
+            REQUIRE(primorial_ui(n, 30000, nt) == cmp);
+        }
+        REQUIRE_THROWS_PREDICATE(primorial_ui(n, 100000001ul), std::invalid_argument,
+                                 [](const std::invalid_argument &ex) {
+                                     return std::string(ex.what())
+                                            == "The value 100000001 is too large to be used as input for the "
+                                               "primorial function (the maximum allowed value is 100000000)";
+                                 });
+    }
+};
+
+TEST_CASE("primorial_ui")
+{
+    tuple_for_each(sizes{}, primorial_tester{});
+}
+
+struct bin_tester {
+    template <typename S>
+    inline void operator()(const S &) const
+    {
+        using integer = integer<S::value>;
+        detail::mpz_raii m;
+        integer n, rop;
+        std::uniform_int_distribution<long> ndist(-100, 3000);
+        std::uniform_int_distribution<unsigned long> kdist(0, 3100);
+        for (int i = 0; i < ntries; ++i) {
+            n = ndist(rng);
+            const auto k = kdist(rng);
+            mpz_bin_ui(&m.m_mpz, n.get_mpz_view(), k);
+            for (auto nt : nthreads_list) {
+                REQUIRE(&bin_ui(rop, n, k, nt) == &rop);
+                REQUIRE((lex_cast(rop) == lex_cast(m)));
+            }
+            // Aliasing.
+            auto n_copy(n);
+            bin_ui(n_copy, n_copy, k, 3);
+            REQUIRE((lex_cast(n_copy) == lex_cast(m)));
+        }
+        // Large arguments, for which the result fits in one limb
+        // or just barely overflows it.
+        std::uniform_int_distribution<unsigned long> k2dist(0, 40);
+        for (int i = 0; i < ntries; ++i) {
+            n = std::numeric_limits<unsigned long>::max() >> (i % 64);
+            const auto k = k2dist(rng);
+            mpz_bin_ui(&m.m_mpz, n.get_mpz_view(), k);
+            REQUIRE((lex_cast(bin_ui(n, k)) == lex_cast(m)));
+            n = static_cast<unsigned long>(i % 80);
+            mpz_bin_ui(&m.m_mpz, n.get_mpz_view(), k);
+            REQUIRE((lex_cast(bin_ui(n, k)) == lex_cast(m)));
+        }
+        // Large top argument with small bottom argument (or small
+        // difference between top and bottom arguments).
+        n = 100000000ul;
+        for (unsigned long k : {2ul, 3ul, 100ul, 99999990ul}) {
+            mpz_bin_ui(&m.m_mpz, n.get_mpz_view(), k);
+            for (auto nt : nthreads_list) {
+                REQUIRE((lex_cast(bin_ui(rop, n, k, nt)) == lex_cast(m)));
+            }
+        }
+        // Top argument outside the limit of the multi-threaded version.
+        n = 100000001ul;
+        mpz_bin_ui(&m.m_mpz, n.get_mpz_view(), 3);
+        REQUIRE((lex_cast(bin_ui(rop, n, 3, 0)) == lex_cast(m)));
+    }
+};
+
+TEST_CASE("bin_ui mt")
+{
+    tuple_for_each(sizes{}, bin_tester{});
+}
+
+struct multinomial_tester {
+    template <typename S>
+    inline void operator()(const S &) const
+    {
+        using integer = integer<S::value>;
+        integer rop{42};
+        std::vector<unsigned long> ks;
+        // The empty multinomial.
+        REQUIRE(&multinomial(rop, ks.data(), ks.size()) == &rop);
+        REQUIRE(rop == 1);
+        ks = {0, 0};
+        REQUIRE(multinomial(rop, ks.data(), ks.size()) == 1);
+        ks = {2, 1, 1};
+        REQUIRE(multinomial(rop, ks.data(), ks.size()) == 12);
+        // Random testing against the product of binomial coefficients.
+        std::uniform_int_distribution<unsigned long> kdist(0, 500);
+        std::uniform_int_distribution<int> ndist(1, 6);
+        for (int i = 0; i < ntries; ++i) {
+            ks.resize(static_cast<std::size_t>(ndist(rng)));
+            integer cmp{1}, sum;
+            for (auto &k : ks) {
+                k = kdist(rng);
+                sum += k;
+                cmp *= bin_ui(sum, k);
+            }
+            for (auto nt : nthreads_list) {
+                REQUIRE(multinomial(rop, ks.data(), ks.size(), nt) == cmp);
+            }
+        }
+        // One large bottom argument and small ones.
+        ks = {3, 99999990ul, 2, 0, 5};
+        {
+            integer cmp{1}, sum;
+            for (auto k : ks) {
+                sum += k;
+                cmp *= bin_ui(sum, k);
+            }
+            for (auto nt : nthreads_list) {
+                REQUIRE(multinomial(rop, ks.data(), ks.size(), nt) == cmp);
+            }
+        }
+        // Error handling.
+        ks = {std::numeric_limits<unsigned long>::max(), 1};
+        REQUIRE_THROWS_PREDICATE(
+            multinomial(rop, ks.data(), ks.size()), std::overflow_error, [](const std::overflow_error &ex) {
+                return std::string(ex.what())
+                       == "Overflow in the computation of the sum of the arguments of a multinomial coefficient";
+            });
+        ks = {100000000ul, 1};
+        REQUIRE_THROWS_AS(multinomial(rop, ks.data(), ks.size()), std::invalid_argument);
+    }
+};
+
+TEST_CASE("multinomial")
+{
+    tuple_for_each(sizes{}, multinomial_tester{});
+}
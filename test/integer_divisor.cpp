@@ -0,0 +1,207 @@
+// Copyright 2016-2023 Francesco Biscani (bluescarni@gmail.com)
+//
+// This file is part of the mp++ library.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <array>
+#include <cstddef>
+#include <random>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+
+#include <mp++/detail/gmp.hpp>
+#include <mp++/exceptions.hpp>
+#include <mp++/integer.hpp>
+#include <mp++/integer_divisor.hpp>
+
+#include "catch.hpp"
+#include "test_utils.hpp"
+
+// NOLINTNEXTLINE(google-build-using-namespace)
+using namespace mppp;
+// NOLINTNEXTLINE(google-build-using-namespace)
+using namespace mppp_test;
+
+using sizes = std::tuple<std::integral_constant<std::size_t, 1>, std::integral_constant<std::size_t, 2>,
+                         std::integral_constant<std::size_t, 3>, std::integral_constant<std::size_t, 6>,
+                         std::integral_constant<std::size_t, 10>>;
+
+static const int ntries = 1000;
+
+// NOLINTNEXTLINE(cert-err58-cpp, cert-msc32-c, cert-msc51-cpp, cppcoreguidelines-avoid-non-const-global-variables)
+static std::mt19937 rng;
+
+struct divisor_tester {
+    template <typename S>
+    void operator()(const S &) const
+    {
+        using Catch::Matchers::Message;
+        using integer = integer<S::value>;
+        using divisor = integer_divisor<S::value>;
+
+        REQUIRE_THROWS_MATCHES(divisor{integer{}}, zero_division_error, Message("Integer division by zero"));
+
+        // A few simple tests.
+        integer q, r;
+        const divisor d7{integer{-7}};
+        REQUIRE(d7.get() == -7);
+        tdiv_qr(q, r, integer{23}, d7);
+        REQUIRE(q == -3);
+        REQUIRE(r == 2);
+        tdiv_qr(q, r, integer{-23}, d7);
+        REQUIRE(q == 3);
+        REQUIRE(r == -2);
+        REQUIRE(tdiv_q(q, integer{5}, d7) == 0);
+        REQUIRE(integer{49} / d7 == -7);
+        REQUIRE(integer{50} % d7 == 1);
+        REQUIRE(integer{0} % d7 == 0);
+        REQUIRE(divexact(integer{-49}, d7) == 7);
+        q = 100;
+        q /= d7;
+        REQUIRE(q == -14);
+        q %= d7;
+        REQUIRE(q == 0);
+
+#if defined(MPPP_INTEGER_DIVISOR_HAVE_PREINV)
+        // Check that the precomputed reciprocal is used for static
+        // divisors with at most 2 limbs, for all static sizes.
+        {
+            ::mp_limb_t q1 = 0, r1 = 0;
+            REQUIRE(detail::integer_divisor_impl<S::value>::divrem_1(q1, r1, integer{-23}, d7));
+            REQUIRE(q1 == 3u);
+            REQUIRE(r1 == 2u);
+
+            std::array<::mp_limb_t, S::value> ql{};
+            std::array<::mp_limb_t, S::value < 2u ? 2u : S::value> rl{};
+            std::size_t qsize = 0, rsize = 0;
+            REQUIRE(
+                detail::integer_divisor_impl<S::value>::divrem(ql.data(), rl.data(), qsize, rsize, integer{50}, d7));
+            REQUIRE(qsize == 1u);
+            REQUIRE(ql[0] == 7u);
+            REQUIRE(rsize == 1u);
+            REQUIRE(rl[0] == 1u);
+
+            if (S::value >= 2u) {
+                // A 2-limb divisor.
+                const divisor d2{(integer{1} << GMP_NUMB_BITS) + 3};
+                REQUIRE(d2.get().size() == 2u);
+                auto n2 = (integer{1} << GMP_NUMB_BITS) * 5 + 17;
+                REQUIRE(detail::integer_divisor_impl<S::value>::divrem(ql.data(), rl.data(), qsize, rsize, n2, d2));
+                REQUIRE(qsize == 1u);
+                REQUIRE(ql[0] == 5u);
+                REQUIRE(rsize == 1u);
+                REQUIRE(rl[0] == 2u);
+            }
+        }
+#endif
+
+        REQUIRE_THROWS_MATCHES(tdiv_qr(q, q, integer{1}, d7), std::invalid_argument,
+                               Message("When performing a division with remainder, the quotient 'q' and the "
+                                       "remainder 'r' must be distinct objects"));
+
+        // Random testing.
+        integer n1, n2, n3, n4;
+        detail::mpz_raii tmp;
+        std::uniform_int_distribution<int> sdist(0, 1);
+        std::uniform_int_distribution<unsigned> shdist(0, GMP_NUMB_BITS - 1);
+        auto random_xy = [&](unsigned x, unsigned y) {
+            for (int i = 0; i < ntries; ++i) {
+                // NOTE: use random divisors with random
+                // normalisation shifts.
+                random_integer(tmp, y, rng, ::mp_limb_t(1) << shdist(rng));
+                n4 = &tmp.m_mpz;
+                if (n4.is_zero()) {
+                    n4 = 1;
+                }
+                if (sdist(rng)) {
+                    n4.neg();
+                }
+                if (n4.is_static() && sdist(rng)) {
+                    n4.promote();
+                }
+                const divisor d{n4};
+                REQUIRE(d.get() == n4);
+
+                random_integer(tmp, x, rng);
+                n3 = &tmp.m_mpz;
+                if (sdist(rng)) {
+                    n3.neg();
+                }
+                if (n3.is_static() && sdist(rng)) {
+                    n3.promote();
+                }
+                // NOLINTNEXTLINE(misc-redundant-expression)
+                if (sdist(rng) && sdist(rng) && sdist(rng)) {
+                    n1 = integer{};
+                    n2 = integer{};
+                    n1.promote();
+                }
+
+                tdiv_qr(n1, n2, n3, d);
+                REQUIRE(n1 == n3 / n4);
+                REQUIRE(n2 == n3 % n4);
+                if (n3.is_static() && n4.size() <= S::value) {
+                    REQUIRE(n1.is_static());
+                    REQUIRE(n2.is_static());
+                }
+                REQUIRE(tdiv_q(n1, n3, d) == n3 / n4);
+                REQUIRE(n3 / d == n3 / n4);
+                REQUIRE(n3 % d == n3 % n4);
+
+                // Exact division.
+                auto prod = n3 * n4;
+                REQUIRE(divexact(n1, prod, d) == n3);
+                REQUIRE(divexact(prod, d) == n3);
+
+                // Overlapping arguments.
+                auto n3_old(n3);
+                tdiv_qr(n3, n2, n3, d);
+                REQUIRE(n3 == n3_old / n4);
+                REQUIRE(n2 == n3_old % n4);
+                n3 = n3_old;
+                tdiv_qr(n1, n3, n3, d);
+                REQUIRE(n1 == n3_old / n4);
+                REQUIRE(n3 == n3_old % n4);
+                n3 = n3_old;
+                n3 /= d;
+                REQUIRE(n3 == n3_old / n4);
+                n3 = n3_old;
+                n3 %= d;
+                REQUIRE(n3 == n3_old % n4);
+                divexact(prod, prod, d);
+                REQUIRE(prod == n3_old);
+            }
+        };
+
+        for (unsigned y = 1; y <= 3u; ++y) {
+            for (unsigned x = 0; x <= S::value + 1u; ++x) {
+                random_xy(x, y);
+            }
+        }
+
+        // Maximal values.
+        for (unsigned y = 1; y <= 2u; ++y) {
+            max_integer(tmp, y);
+            n4 = &tmp.m_mpz;
+            const divisor d{n4};
+            for (unsigned x = 0; x <= S::value; ++x) {
+                max_integer(tmp, x);
+                n3 = &tmp.m_mpz;
+                tdiv_qr(n1, n2, n3, d);
+                REQUIRE(n1 == n3 / n4);
+                REQUIRE(n2 == n3 % n4);
+                REQUIRE((n3 - 1) / d == (n3 - 1) / n4);
+                REQUIRE((n3 - 1) % d == (n3 - 1) % n4);
+            }
+        }
+    }
+};
+
+TEST_CASE("integer_divisor")
+{
+    tuple_for_each(sizes{}, divisor_tester{});
+}
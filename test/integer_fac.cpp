@@ -66,6 +66,16 @@ struct fac_tester {
         fac_ui(n1, 10);
         REQUIRE((lex_cast(n1) == lex_cast(m1)));
         REQUIRE(n1.is_static());
+        // All the factorials up to beyond the static capacity. The results
+        // fitting in static storage must be static.
+        for (unsigned long x = 0; x <= 100u * S::value; ++x) {
+            mpz_fac_ui(&m1.m_mpz, x);
+            fac_ui(n1, x);
+            REQUIRE((lex_cast(n1) == lex_cast(m1)));
+            if (mpz_size(&m1.m_mpz) <= S::value) {
+                REQUIRE(n1.is_static());
+            }
+        }
         // Try the limit.
         mpz_fac_ui(&m1.m_mpz, 1000000ul);
         fac_ui(n1, 1000000ul);
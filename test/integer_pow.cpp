@@ -31,8 +31,8 @@ using namespace mppp;
 using namespace mppp_test;
 
 using sizes = std::tuple<std::integral_constant<std::size_t, 1>, std::integral_constant<std::size_t, 2>,
-                         std::integral_constant<std::size_t, 3>, std::integral_constant<std::size_t, 6>,
-                         std::integral_constant<std::size_t, 10>>;
+                         std::integral_constant<std::size_t, 3>, std::integral_constant<std::size_t, 4>,
+                         std::integral_constant<std::size_t, 6>, std::integral_constant<std::size_t, 10>>;
 
 // NOLINTNEXTLINE(cert-err58-cpp, cert-msc32-c, cert-msc51-cpp, cppcoreguidelines-avoid-non-const-global-variables)
 static std::mt19937 rng;
@@ -77,7 +77,36 @@ struct pow_tester {
                 pow_ui(n1, n2, ex);
                 REQUIRE((lex_cast(n1) == lex_cast(m1)));
                 REQUIRE((lex_cast(pow_ui(n2, ex)) == lex_cast(m1)));
+                if (n2.is_static() && mpz_size(&m1.m_mpz) <= S::value) {
+                    REQUIRE(n1.is_static());
+                }
+                // Compile-time exponents.
+                mpz_pow_ui(&m1.m_mpz, &m2.m_mpz, 0u);
+                REQUIRE((lex_cast(pow_ui(n1, n2, std::integral_constant<unsigned long, 0>{})) == lex_cast(m1)));
+                REQUIRE((lex_cast(pow_ui(n2, std::integral_constant<unsigned long, 0>{})) == lex_cast(m1)));
+                mpz_pow_ui(&m1.m_mpz, &m2.m_mpz, 1u);
+                REQUIRE((lex_cast(pow_ui(n1, n2, std::integral_constant<unsigned long, 1>{})) == lex_cast(m1)));
+                REQUIRE((lex_cast(pow_ui(n2, std::integral_constant<unsigned long, 1>{})) == lex_cast(m1)));
+                mpz_pow_ui(&m1.m_mpz, &m2.m_mpz, 2u);
+                REQUIRE((lex_cast(pow_ui(n1, n2, std::integral_constant<unsigned long, 2>{})) == lex_cast(m1)));
+                REQUIRE((lex_cast(pow_ui(n2, std::integral_constant<unsigned long, 2>{})) == lex_cast(m1)));
+                mpz_pow_ui(&m1.m_mpz, &m2.m_mpz, 3u);
+                REQUIRE((lex_cast(pow_ui(n1, n2, std::integral_constant<unsigned long, 3>{})) == lex_cast(m1)));
+                REQUIRE((lex_cast(pow_ui(n2, std::integral_constant<unsigned long, 3>{})) == lex_cast(m1)));
+                mpz_pow_ui(&m1.m_mpz, &m2.m_mpz, 7u);
+                REQUIRE((lex_cast(pow_ui(n1, n2, std::integral_constant<unsigned long, 7>{})) == lex_cast(m1)));
+                REQUIRE((lex_cast(pow_ui(n2, std::integral_constant<unsigned long, 7>{})) == lex_cast(m1)));
+                mpz_pow_ui(&m1.m_mpz, &m2.m_mpz, 18u);
+                REQUIRE((lex_cast(pow_ui(n1, n2, std::integral_constant<unsigned long, 18>{})) == lex_cast(m1)));
+                REQUIRE((lex_cast(pow_ui(n2, std::integral_constant<unsigned long, 18>{})) == lex_cast(m1)));
+                if (n2.is_static() && mpz_size(&m1.m_mpz) <= S::value) {
+                    REQUIRE(n1.is_static());
+                }
                 // Overlap.
+                auto n3(n2);
+                mpz_pow_ui(&m1.m_mpz, &m2.m_mpz, 5u);
+                pow_ui(n3, n3, std::integral_constant<unsigned long, 5>{});
+                REQUIRE((lex_cast(n3) == lex_cast(m1)));
                 mpz_pow_ui(&m2.m_mpz, &m2.m_mpz, ex);
                 pow_ui(n2, n2, ex);
                 REQUIRE((lex_cast(n2) == lex_cast(m2)));
@@ -90,6 +119,31 @@ struct pow_tester {
         random_xy(3);
         random_xy(4);
 
+        // Large exponents and bases of small magnitude.
+        REQUIRE(pow_ui(integer{}, std::numeric_limits<unsigned long>::max()) == 0);
+        REQUIRE(pow_ui(integer{1}, std::numeric_limits<unsigned long>::max()) == 1);
+        REQUIRE(pow_ui(integer{-1}, std::numeric_limits<unsigned long>::max()) == -1);
+        REQUIRE(pow_ui(integer{-1}, std::numeric_limits<unsigned long>::max() - 1u) == 1);
+        REQUIRE(pow_ui(integer{1}, std::numeric_limits<unsigned long>::max()).is_static());
+        REQUIRE(pow_ui(integer{-1}, std::integral_constant<unsigned long, std::numeric_limits<unsigned long>::max()>{})
+                == -1);
+
+        // Powers of two around the static storage boundary.
+        const auto max_bits = static_cast<unsigned long>(S::value * unsigned(GMP_NUMB_BITS));
+        n2 = 2;
+        pow_ui(n1, n2, max_bits - 1u);
+        REQUIRE(n1 == integer{1} << (max_bits - 1u));
+        REQUIRE(n1.is_static());
+        pow_ui(n1, n2, max_bits);
+        REQUIRE(n1 == integer{1} << max_bits);
+        REQUIRE(n1.is_dynamic());
+        n2 = -2;
+        pow_ui(n1, n2, max_bits - 1u);
+        REQUIRE(n1 == -(integer{1} << (max_bits - 1u)));
+        REQUIRE(n1.is_static());
+        REQUIRE(pow_ui(integer{-2}, std::integral_constant<unsigned long, 128>{}) == integer{1} << 128);
+        REQUIRE(pow_ui(integer{-2}, std::integral_constant<unsigned long, 129>{}) == -(integer{1} << 129));
+
         // Tests for the convenience pow() overloads.
         REQUIRE(pow(integer{0}, 0) == 1);
         REQUIRE(pow(integer{0}, false) == 1);
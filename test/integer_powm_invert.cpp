@@ -0,0 +1,160 @@
+// Copyright 2016-2023 Francesco Biscani (bluescarni@gmail.com)
+//
+// This file is part of the mp++ library.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <cstddef>
+#include <random>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+
+#include <mp++/detail/gmp.hpp>
+#include <mp++/exceptions.hpp>
+#include <mp++/integer.hpp>
+
+#include "catch.hpp"
+#include "test_utils.hpp"
+
+// NOLINTNEXTLINE(google-build-using-namespace)
+using namespace mppp;
+// NOLINTNEXTLINE(google-build-using-namespace)
+using namespace mppp_test;
+
+using sizes = std::tuple<std::integral_constant<std::size_t, 1>, std::integral_constant<std::size_t, 2>,
+                         std::integral_constant<std::size_t, 3>, std::integral_constant<std::size_t, 6>,
+                         std::integral_constant<std::size_t, 10>>;
+
+static const int ntries = 1000;
+
+// NOLINTNEXTLINE(cert-err58-cpp, cert-msc32-c, cert-msc51-cpp, cppcoreguidelines-avoid-non-const-global-variables)
+static std::mt19937 rng;
+
+struct powm_tester {
+    template <typename S>
+    void operator()(const S &) const
+    {
+        using Catch::Matchers::Message;
+        using integer = integer<S::value>;
+        integer ret;
+
+        // A few simple tests.
+        REQUIRE(powm(integer{2}, integer{10}, integer{1000}) == 24);
+        REQUIRE(powm(integer{-2}, integer{3}, integer{7}) == 6);
+        REQUIRE(powm(integer{-2}, integer{3}, integer{-7}) == 6);
+        REQUIRE(powm(integer{-2}, integer{2}, integer{7}) == 4);
+        REQUIRE(powm(integer{0}, integer{5}, integer{7}) == 0);
+        REQUIRE(powm(integer{0}, integer{0}, integer{7}) == 1);
+        REQUIRE(powm(integer{5}, integer{0}, integer{1}) == 0);
+        REQUIRE(powm(integer{5}, integer{3}, integer{-1}) == 0);
+        REQUIRE(powm(integer{3}, integer{-1}, integer{7}) == 5);
+        REQUIRE(powm(integer{3}, integer{-2}, integer{7}) == 4);
+        REQUIRE(powm(integer{3}, integer{-2}, integer{1}) == 0);
+
+        powm(ret, integer{3}, integer{4}, integer{5});
+        REQUIRE(ret == 1);
+        REQUIRE(ret.is_static());
+
+        REQUIRE_THROWS_MATCHES(powm(ret, integer{2}, integer{3}, integer{0}), zero_division_error,
+                               Message("Integer division by zero"));
+        REQUIRE_THROWS_MATCHES(powm(integer{2}, integer{-3}, integer{4}), std::domain_error,
+                               Message("Cannot compute the inverse of 2 modulo 4: the inverse does not exist"));
+
+        // Random testing.
+        integer n1, n2, n3, n4;
+        detail::mpz_raii tmp, cmp;
+        std::uniform_int_distribution<int> sdist(0, 1);
+        auto random_xyz = [&](unsigned x, unsigned y, unsigned z) {
+            for (int i = 0; i < ntries; ++i) {
+                random_integer(tmp, x, rng);
+                n2 = &tmp.m_mpz;
+                if (sdist(rng)) {
+                    n2.neg();
+                }
+                if (n2.is_static() && sdist(rng)) {
+                    n2.promote();
+                }
+
+                random_integer(tmp, y, rng);
+                n3 = &tmp.m_mpz;
+                if (n3.is_static() && sdist(rng)) {
+                    n3.promote();
+                }
+
+                random_integer(tmp, z, rng);
+                n4 = &tmp.m_mpz;
+                if (n4.is_zero()) {
+                    n4 = 1;
+                }
+                if (sdist(rng)) {
+                    n4.neg();
+                }
+                if (n4.is_static() && sdist(rng)) {
+                    n4.promote();
+                }
+                // NOLINTNEXTLINE(misc-redundant-expression)
+                if (sdist(rng) && sdist(rng) && sdist(rng)) {
+                    n1 = integer{};
+                }
+
+                mpz_powm(&cmp.m_mpz, n2.get_mpz_view(), n3.get_mpz_view(), n4.get_mpz_view());
+                powm(n1, n2, n3, n4);
+                REQUIRE(n1 == integer{&cmp.m_mpz});
+                REQUIRE(powm(n2, n3, n4) == n1);
+                if (n1.size() <= S::value) {
+                    // The result stays in static storage.
+                    REQUIRE(n1.is_static());
+                }
+
+                // Overlapping arguments.
+                auto n2_old(n2);
+                powm(n2, n2, n3, n4);
+                REQUIRE(n2 == n1);
+                n2 = n2_old;
+                auto n4_old(n4);
+                powm(n4, n2, n3, n4);
+                REQUIRE(n4 == n1);
+                n4 = n4_old;
+
+                // Inversion.
+                if (mpz_invert(&cmp.m_mpz, n2.get_mpz_view(), n4.get_mpz_view()) != 0) {
+                    invert(n1, n2, n4);
+                    if (abs(n4) != 1) {
+                        REQUIRE(n1 == integer{&cmp.m_mpz});
+                    } else {
+                        REQUIRE(n1 == 0);
+                    }
+                    REQUIRE(invert(n2, n4) == n1);
+                    REQUIRE((n1 * n2 - 1) % n4 == 0);
+
+                    // Negative exponents.
+                    REQUIRE(powm(n2, -n3, n4) == powm(invert(n2, n4), n3, n4));
+                } else {
+                    REQUIRE_THROWS_AS(invert(n2, n4), std::domain_error);
+                    if (n3 != 0) {
+                        REQUIRE_THROWS_AS(powm(n2, -n3, n4), std::domain_error);
+                    }
+                }
+            }
+        };
+
+        random_xyz(0, 1, 1);
+        random_xyz(1, 1, 1);
+        random_xyz(1, 2, 1);
+        random_xyz(2, 1, 1);
+        random_xyz(1, 1, 2);
+        random_xyz(2, 2, 2);
+        random_xyz(3, 1, 2);
+        random_xyz(2, 3, 3);
+        random_xyz(4, 2, 4);
+        random_xyz(12, 1, 11);
+    }
+};
+
+TEST_CASE("powm invert")
+{
+    tuple_for_each(sizes{}, powm_tester{});
+}
@@ -0,0 +1,158 @@
+// Copyright 2016-2023 Francesco Biscani (bluescarni@gmail.com)
+//
+// This file is part of the mp++ library.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <cstddef>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include <gmp.h>
+
+#include <mp++/detail/gmp.hpp>
+#include <mp++/integer.hpp>
+#include <mp++/integer_primes.hpp>
+
+#include "catch.hpp"
+#include "test_utils.hpp"
+
+static const int ntries = 300;
+
+// NOLINTNEXTLINE(google-build-using-namespace)
+using namespace mppp;
+// NOLINTNEXTLINE(google-build-using-namespace)
+using namespace mppp_test;
+
+using sizes = std::tuple<std::integral_constant<std::size_t, 1>, std::integral_constant<std::size_t, 2>,
+                         std::integral_constant<std::size_t, 3>, std::integral_constant<std::size_t, 6>>;
+
+// NOLINTNEXTLINE(cert-err58-cpp, cert-msc32-c, cert-msc51-cpp)
+static std::mt19937 rng;
+
+struct batch_tester {
+    template <typename S>
+    inline void operator()(const S &) const
+    {
+        using integer = integer<S::value>;
+        std::vector<integer> v;
+        std::vector<int> out{42};
+
+        batch_probab_prime_p(out, v.data(), v.size());
+        REQUIRE(out.empty());
+
+        // Random testing against mpz_probab_prime_p().
+        detail::mpz_raii tmp;
+        std::uniform_int_distribution<unsigned> sdist(0, static_cast<unsigned>(S::value) + 1u);
+        std::uniform_int_distribution<int> ndist(0, 100);
+        for (int i = 0; i < ntries; ++i) {
+            v.clear();
+            const auto nvals = ndist(rng);
+            for (int j = 0; j < nvals; ++j) {
+                random_integer(tmp, sdist(rng), rng);
+                v.emplace_back(&tmp.m_mpz);
+                if (j % 2 == 0) {
+                    // Make sure we have a decent amount of primes.
+                    v.back().nextprime();
+                }
+            }
+            for (auto nthreads : {1u, 3u, 0u}) {
+                batch_probab_prime_p(out, v.data(), v.size(), 25, nthreads);
+                REQUIRE(out.size() == v.size());
+                for (decltype(v.size()) j = 0; j < v.size(); ++j) {
+                    REQUIRE((out[j] != 0) == (mpz_probab_prime_p(v[j].get_mpz_view(), 25) != 0));
+                }
+            }
+        }
+
+        // Error handling.
+        v = {integer{3}, integer{-4}, integer{5}};
+        REQUIRE_THROWS_PREDICATE(batch_probab_prime_p(out, v.data(), v.size(), 25, 3), std::invalid_argument,
+                                 [](const std::invalid_argument &ex) {
+                                     return std::string(ex.what())
+                                            == "Cannot run primality tests on the negative number -4";
+                                 });
+        REQUIRE_THROWS_AS(batch_probab_prime_p(out, v.data(), v.size(), 0), std::invalid_argument);
+    }
+};
+
+TEST_CASE("batch_probab_prime_p")
+{
+    tuple_for_each(sizes{}, batch_tester{});
+}
+
+// Compute the primes in [begin, end) with mpz_nextprime().
+static std::vector<unsigned long long> nextprime_primes(unsigned long long begin, unsigned long long end)
+{
+    std::vector<unsigned long long> retval;
+    integer<2> n{begin};
+    if (n != 0) {
+        --n;
+    }
+    while (true) {
+        n.nextprime();
+        if (n >= end) {
+            break;
+        }
+        retval.push_back(static_cast<unsigned long long>(n));
+    }
+    return retval;
+}
+
+static std::vector<unsigned long long> range_primes(unsigned long long begin, unsigned long long end)
+{
+    std::vector<unsigned long long> retval;
+    for (auto p : prime_range(begin, end)) {
+        retval.push_back(p);
+    }
+    return retval;
+}
+
+TEST_CASE("prime_range")
+{
+    // Empty ranges.
+    REQUIRE(range_primes(0, 0).empty());
+    REQUIRE(range_primes(10, 3).empty());
+    REQUIRE(range_primes(0, 2).empty());
+    REQUIRE(range_primes(24, 29).empty());
+    REQUIRE(prime_range(5, 5).begin() == prime_range::end());
+
+    // Small ranges.
+    REQUIRE(range_primes(0, 3) == std::vector<unsigned long long>{2});
+    REQUIRE(range_primes(2, 4) == std::vector<unsigned long long>{2, 3});
+    REQUIRE(range_primes(3, 4) == std::vector<unsigned long long>{3});
+    REQUIRE(range_primes(0, 30) == std::vector<unsigned long long>{2, 3, 5, 7, 11, 13, 17, 19, 23, 29});
+    REQUIRE(range_primes(24, 30) == std::vector<unsigned long long>{29});
+
+    // Count the primes below 10**7, spanning multiple segments.
+    std::size_t count = 0;
+    prime_range pr(0, 10000000ull);
+    for (auto it = pr.begin(); it != prime_range::end(); ++it) {
+        ++count;
+    }
+    REQUIRE(count == 664579u);
+
+    // Random ranges against nextprime().
+    std::uniform_int_distribution<unsigned long long> bdist(0, 100000000ull), ldist(0, 2000);
+    for (int i = 0; i < ntries; ++i) {
+        const auto b = bdist(rng), e = b + ldist(rng);
+        REQUIRE(range_primes(b, e) == nextprime_primes(b, e));
+    }
+
+    // Large ranges, where the sieve is not complete.
+    const auto max = std::numeric_limits<unsigned long long>::max();
+    for (auto b : {1000000000000000ull, max / 3u, max - 3000u}) {
+        REQUIRE(range_primes(b, b + 3000u) == nextprime_primes(b, b + 3000u));
+    }
+    REQUIRE(range_primes(max - 100u, max)
+            == std::vector<unsigned long long>{18446744073709551521ull, 18446744073709551533ull,
+                                               18446744073709551557ull});
+    REQUIRE(range_primes(max - 58u, max) == std::vector<unsigned long long>{18446744073709551557ull});
+}
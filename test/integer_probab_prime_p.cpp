@@ -7,6 +7,7 @@
 // with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
 
 #include <cstddef>
+#include <random>
 #include <stdexcept>
 #include <string>
 #include <tuple>
@@ -28,6 +29,9 @@ using sizes = std::tuple<std::integral_constant<std::size_t, 1>, std::integral_c
                          std::integral_constant<std::size_t, 3>, std::integral_constant<std::size_t, 6>,
                          std::integral_constant<std::size_t, 10>>;
 
+// NOLINTNEXTLINE(cert-err58-cpp, cert-msc32-c, cert-msc51-cpp, cppcoreguidelines-avoid-non-const-global-variables)
+static std::mt19937 rng;
+
 struct probab_prime_p_tester {
     template <typename S>
     inline void operator()(const S &) const
@@ -49,6 +53,41 @@ struct probab_prime_p_tester {
         REQUIRE((probab_prime_p(integer{17}) != 0));
         REQUIRE((probab_prime_p(integer{49979687ll}) != 0));
         REQUIRE((probab_prime_p(integer{128}) == 0));
+        // Single-limb values, for which the test is deterministic.
+        // Start with a few strong pseudoprimes to base 2, Lucas pseudoprimes
+        // and perfect squares.
+        for (unsigned long long x : {2047ull, 3277ull, 4033ull, 4681ull, 8321ull, 5459ull, 5777ull, 10877ull, 3481ull,
+                                     3215031751ull, 2152302898747ull, 3474749660383ull, 341550071728321ull,
+                                     4294967297ull, 12327121ull, 3825123056546413051ull}) {
+            if (x > GMP_NUMB_MAX) {
+                continue;
+            }
+            n1 = integer{x};
+            REQUIRE(n1.probab_prime_p() == 0);
+            n1.promote();
+            REQUIRE(n1.probab_prime_p() == 0);
+        }
+        for (unsigned long long x : {3571ull, 4294967291ull, 2305843009213693951ull, 18446744073709551557ull}) {
+            if (x > GMP_NUMB_MAX) {
+                continue;
+            }
+            n1 = integer{x};
+            REQUIRE(n1.probab_prime_p() != 0);
+            n1.promote();
+            REQUIRE(n1.probab_prime_p() != 0);
+        }
+        // Random testing.
+        std::uniform_int_distribution<::mp_limb_t> ldist(0, GMP_NUMB_MAX);
+        std::uniform_int_distribution<unsigned> shdist(0, GMP_NUMB_BITS - 1);
+        for (int i = 0; i < 10000; ++i) {
+            const auto x = ldist(rng) >> shdist(rng);
+            n1 = integer{x};
+            if (i % 2 == 0 && n1.is_static()) {
+                n1.promote();
+            }
+            mpz_set(&m1.m_mpz, n1.get_mpz_view());
+            REQUIRE((n1.probab_prime_p() != 0) == (mpz_probab_prime_p(&m1.m_mpz, 25) != 0));
+        }
         // Test errors.
         REQUIRE_THROWS_PREDICATE(probab_prime_p(n1, 0), std::invalid_argument, [](const std::invalid_argument &ex) {
             return std::string(ex.what())
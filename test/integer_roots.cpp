@@ -289,9 +289,52 @@ struct sqrtrem_tester {
     }
 };
 
+// Test the optimised implementations for 1 and 2 limbs
+// on the squares and their neighbours.
+struct small_sqrt_tester {
+    template <typename S>
+    inline void operator()(const S &) const
+    {
+        using integer = integer<S::value>;
+        detail::mpz_raii m1, m2, m3;
+        integer n1, n2, n3;
+        std::uniform_int_distribution<::mp_limb_t> ldist(1, GMP_NUMB_MAX);
+        std::uniform_int_distribution<unsigned> bdist(1, GMP_NUMB_BITS);
+        for (int i = 0; i < ntries; ++i) {
+            // Nonzero root with a random number of bits.
+            auto s = ldist(rng) >> (GMP_NUMB_BITS - bdist(rng));
+            s = s == 0u ? 1u : s;
+            const auto sq = integer{s} * s;
+            for (const auto &n : {sq - 1, sq, sq + 1, sq + 2 * integer{s}, sq + 2 * integer{s} + 1}) {
+                n3 = n;
+                mpz_set(&m3.m_mpz, n3.get_mpz_view());
+                mpz_sqrtrem(&m1.m_mpz, &m2.m_mpz, &m3.m_mpz);
+                REQUIRE((lex_cast(sqrt(n3)) == lex_cast(m1)));
+                sqrtrem(n1, n2, n3);
+                REQUIRE((lex_cast(n1) == lex_cast(m1)));
+                REQUIRE((lex_cast(n2) == lex_cast(m2)));
+                REQUIRE(perfect_square_p(n3) == (mpz_perfect_square_p(&m3.m_mpz) != 0));
+            }
+        }
+        // The largest values.
+        n3 = GMP_NUMB_MAX;
+        REQUIRE(sqrt(n3) == GMP_NUMB_MAX >> (GMP_NUMB_BITS / 2));
+        REQUIRE(!perfect_square_p(n3));
+        n3 = (integer{1} << (2 * GMP_NUMB_BITS)) - 1;
+        sqrtrem(n1, n2, n3);
+        REQUIRE(n1 == GMP_NUMB_MAX);
+        REQUIRE(n2 == 2 * integer{GMP_NUMB_MAX});
+        REQUIRE(!perfect_square_p(n3));
+        n3 = integer{GMP_NUMB_MAX} * GMP_NUMB_MAX;
+        REQUIRE(sqrt(n3) == GMP_NUMB_MAX);
+        REQUIRE(perfect_square_p(n3));
+    }
+};
+
 TEST_CASE("sqrtrem")
 {
     tuple_for_each(sizes{}, sqrtrem_tester{});
+    tuple_for_each(sizes{}, small_sqrt_tester{});
 
     // Test proper zeroing of the upper limbs.
     using int_t = integer<2>;
@@ -418,6 +461,41 @@ struct root_tester {
         REQUIRE(!root(rop, integer{-30}, 3));
         REQUIRE(rop == -3);
 
+        // Random testing on values with at most one limb.
+        detail::mpz_raii m1, m2;
+        integer n, rem;
+        std::uniform_int_distribution<::mp_limb_t> ldist(0, GMP_NUMB_MAX);
+        std::uniform_int_distribution<unsigned> bdist(1, GMP_NUMB_BITS);
+        std::uniform_int_distribution<unsigned long> mdist(1, GMP_NUMB_BITS + 2u);
+        std::uniform_int_distribution<int> sdist(0, 1);
+        for (int i = 0; i < ntries; ++i) {
+            const auto m = mdist(rng);
+            n = ldist(rng) >> (GMP_NUMB_BITS - bdist(rng));
+            if (m % 2u == 1u && sdist(rng)) {
+                n.neg();
+            }
+            mpz_set(&m1.m_mpz, n.get_mpz_view());
+            const auto exact = mpz_root(&m2.m_mpz, &m1.m_mpz, m) != 0;
+            REQUIRE(root(rop, n, m) == exact);
+            REQUIRE((lex_cast(rop) == lex_cast(m2)));
+            mpz_rootrem(&m2.m_mpz, &m1.m_mpz, n.get_mpz_view(), m);
+            rootrem(rop, rem, n, m);
+            REQUIRE((lex_cast(rop) == lex_cast(m2)));
+            REQUIRE((lex_cast(rem) == lex_cast(m1)));
+            // Exact powers and their neighbours.
+            if (m > 1u && !n.is_zero()) {
+                const auto r = root(n, m);
+                const auto p = pow(r, m);
+                REQUIRE(root(rop, p, m));
+                REQUIRE(rop == r);
+                if (p.sgn() == 1) {
+                    // NOTE: r**m - 1 is an m-th power only if r is 1.
+                    REQUIRE(root(rop, p - 1, m) == (r == 1));
+                    REQUIRE(rop == r - 1);
+                }
+            }
+        }
+
         // Error checking.
         REQUIRE_THROWS_PREDICATE(root(integer{8}, 0), std::domain_error, [](const std::domain_error &ex) {
             return std::string(ex.what()) == "Cannot compute the integer m-th root of an integer if m is zero";
@@ -479,6 +557,19 @@ struct rootrem_tester {
         rootrem(rop, rem, integer{-30}, 3);
         REQUIRE(rop == -3);
         REQUIRE(rem == -3);
+        // Overlapping arguments.
+        rop = -30;
+        rootrem(rop, rem, rop, 3);
+        REQUIRE(rop == -3);
+        REQUIRE(rem == -3);
+        rem = 30;
+        rootrem(rop, rem, rem, 3);
+        REQUIRE(rop == 3);
+        REQUIRE(rem == 3);
+        rop = integer{1} << (GMP_NUMB_BITS - 1);
+        rootrem(rop, rem, rop, GMP_NUMB_BITS - 1);
+        REQUIRE(rop == 2);
+        REQUIRE(rem == 0);
 
         // Error checking.
         REQUIRE_THROWS_PREDICATE(rootrem(rop, rem, integer{8}, 0), std::domain_error, [](const std::domain_error &ex) {
@@ -518,6 +609,30 @@ struct perfect_power_p_tester {
         REQUIRE(!perfect_power_p(integer{-16}));
         REQUIRE(perfect_power_p(integer{27}));
         REQUIRE(perfect_power_p(integer{-27}));
+
+        // Random testing on values with at most one limb.
+        detail::mpz_raii m;
+        integer n;
+        std::uniform_int_distribution<::mp_limb_t> ldist(0, GMP_NUMB_MAX);
+        std::uniform_int_distribution<unsigned> bdist(1, GMP_NUMB_BITS);
+        std::uniform_int_distribution<int> sdist(0, 1);
+        for (int i = 0; i < ntries; ++i) {
+            n = ldist(rng) >> (GMP_NUMB_BITS - bdist(rng));
+            if (sdist(rng)) {
+                n.neg();
+            }
+            mpz_set(&m.m_mpz, n.get_mpz_view());
+            REQUIRE(perfect_power_p(n) == (mpz_perfect_power_p(&m.m_mpz) != 0));
+        }
+        // All the powers of small bases fitting in a limb, and their neighbours.
+        for (unsigned long b = 2; b < 40u; ++b) {
+            for (n = b; n.size() == 1u; n *= b) {
+                for (const auto &x : {n - 1, n, n + 1, -n, -n + 1}) {
+                    mpz_set(&m.m_mpz, x.get_mpz_view());
+                    REQUIRE(perfect_power_p(x) == (mpz_perfect_power_p(&m.m_mpz) != 0));
+                }
+            }
+        }
     }
 };
 
@@ -0,0 +1,234 @@
+// Copyright 2016-2023 Francesco Biscani (bluescarni@gmail.com)
+//
+// This file is part of the mp++ library.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <cstddef>
+#include <random>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include <mp++/config.hpp>
+#include <mp++/detail/gmp.hpp>
+#include <mp++/exceptions.hpp>
+#include <mp++/integer.hpp>
+
+#include "catch.hpp"
+#include "test_utils.hpp"
+
+// NOLINTNEXTLINE(google-build-using-namespace)
+using namespace mppp;
+// NOLINTNEXTLINE(google-build-using-namespace)
+using namespace mppp_test;
+
+using sizes = std::tuple<std::integral_constant<std::size_t, 1>, std::integral_constant<std::size_t, 2>,
+                         std::integral_constant<std::size_t, 3>, std::integral_constant<std::size_t, 6>,
+                         std::integral_constant<std::size_t, 10>>;
+
+static const int ntries = 1000;
+
+// NOLINTNEXTLINE(cert-err58-cpp, cert-msc32-c, cert-msc51-cpp, cppcoreguidelines-avoid-non-const-global-variables)
+static std::mt19937 rng;
+
+// Helper to produce an rvalue copy of x.
+template <typename T>
+static T copy(const T &x)
+{
+    return x;
+}
+
+// Check that the rvalue overloads of the binary operators produce
+// the same results as the lvalue ones.
+template <typename T, typename U>
+static void check_rvalue_ops(const T &a, const U &b)
+{
+    REQUIRE(copy(a) + b == a + b);
+    REQUIRE(a + copy(b) == a + b);
+    REQUIRE(copy(a) + copy(b) == a + b);
+    REQUIRE(copy(a) - b == a - b);
+    REQUIRE(a - copy(b) == a - b);
+    REQUIRE(copy(a) - copy(b) == a - b);
+    REQUIRE(copy(a) * b == a * b);
+    REQUIRE(a * copy(b) == a * b);
+    REQUIRE(copy(a) * copy(b) == a * b);
+    REQUIRE((copy(a) | b) == (a | b));
+    REQUIRE((a | copy(b)) == (a | b));
+    REQUIRE((copy(a) | copy(b)) == (a | b));
+    REQUIRE((copy(a) & b) == (a & b));
+    REQUIRE((a & copy(b)) == (a & b));
+    REQUIRE((copy(a) & copy(b)) == (a & b));
+    REQUIRE((copy(a) ^ b) == (a ^ b));
+    REQUIRE((a ^ copy(b)) == (a ^ b));
+    REQUIRE((copy(a) ^ copy(b)) == (a ^ b));
+    if (b != 0) {
+        REQUIRE(copy(a) / b == a / b);
+        REQUIRE(a / copy(b) == a / b);
+        REQUIRE(copy(a) / copy(b) == a / b);
+        REQUIRE(copy(a) % b == a % b);
+        REQUIRE(a % copy(b) == a % b);
+        REQUIRE(copy(a) % copy(b) == a % b);
+    }
+}
+
+struct rvalue_tester {
+    template <typename S>
+    void operator()(const S &) const
+    {
+        using Catch::Matchers::Message;
+        using integer = integer<S::value>;
+
+        // Return types.
+        REQUIRE(std::is_same<integer, decltype(integer{} + integer{})>::value);
+        REQUIRE(std::is_same<integer, decltype(1 - integer{})>::value);
+        REQUIRE(std::is_same<integer, decltype(integer{} * 1ull)>::value);
+        REQUIRE(std::is_same<integer, decltype(integer{} % integer{})>::value);
+        REQUIRE(std::is_same<integer, decltype(integer{} << 1)>::value);
+        REQUIRE(std::is_same<integer, decltype(-integer{})>::value);
+        REQUIRE(std::is_same<integer, decltype(~integer{})>::value);
+        REQUIRE(std::is_same<double, decltype(integer{} + 1.)>::value);
+
+        // Division by zero.
+        REQUIRE_THROWS_MATCHES(integer{1} / integer{}, zero_division_error, Message("Integer division by zero"));
+        REQUIRE_THROWS_MATCHES(1 / integer{}, zero_division_error, Message("Integer division by zero"));
+        REQUIRE_THROWS_MATCHES(integer{1} % 0, zero_division_error, Message("Integer division by zero"));
+        REQUIRE_THROWS_MATCHES(1 % integer{}, zero_division_error, Message("Integer division by zero"));
+        REQUIRE_THROWS_MATCHES(integer{1} % integer{}, zero_division_error, Message("Integer division by zero"));
+
+        // A few simple tests.
+        REQUIRE(3 - integer{10} == -7);
+        REQUIRE(100 / integer{-7} == -14);
+        REQUIRE(-100 % integer{7} == -2);
+        REQUIRE(integer{-100} % integer{7} == -2);
+        REQUIRE(-integer{5} == -5);
+        REQUIRE(+integer{5} == 5);
+        REQUIRE(~integer{5} == -6);
+        REQUIRE((integer{5} << 2) == 20);
+        REQUIRE((integer{-20} >> 2) == -5);
+
+        // Aliasing.
+        integer n{42};
+        REQUIRE(n - std::move(n) == 0);
+        n = 42;
+        REQUIRE(std::move(n) / n == 1);
+        n = 42;
+        REQUIRE(n % std::move(n) == 0);
+
+        // Random testing.
+        integer n1, n2;
+        detail::mpz_raii tmp;
+        std::uniform_int_distribution<int> sdist(0, 1), idist(-100, 100);
+        auto random_xy = [&](unsigned x, unsigned y) {
+            for (int i = 0; i < ntries; ++i) {
+                random_integer(tmp, x, rng);
+                n1 = &tmp.m_mpz;
+                if (sdist(rng)) {
+                    n1.neg();
+                }
+                if (n1.is_static() && sdist(rng)) {
+                    n1.promote();
+                }
+                random_integer(tmp, y, rng);
+                n2 = &tmp.m_mpz;
+                if (sdist(rng)) {
+                    n2.neg();
+                }
+                if (n2.is_static() && sdist(rng)) {
+                    n2.promote();
+                }
+
+                check_rvalue_ops(n1, n2);
+                const auto m = idist(rng);
+                check_rvalue_ops(n1, m);
+                check_rvalue_ops(m, n1);
+                check_rvalue_ops(n1, static_cast<unsigned long long>(m + 100));
+                check_rvalue_ops(static_cast<long long>(m), n1);
+
+                REQUIRE(-copy(n1) == -n1);
+                REQUIRE(~copy(n1) == ~n1);
+                const auto s = static_cast<unsigned>(m + 100);
+                REQUIRE((copy(n1) << s) == (n1 << s));
+                REQUIRE((copy(n1) >> s) == (n1 >> s));
+            }
+        };
+
+        for (unsigned x = 0; x <= S::value + 1u; ++x) {
+            for (unsigned y = 0; y <= S::value + 1u; ++y) {
+                random_xy(x, y);
+            }
+        }
+    }
+};
+
+TEST_CASE("rvalue ops")
+{
+    tuple_for_each(sizes{}, rvalue_tester{});
+}
+
+TEST_CASE("rvalue storage reuse")
+{
+    using int_t = integer<1>;
+
+    const auto old_max_entries = get_integer_cache_max_entries();
+    set_integer_cache_max_entries(0);
+
+    const gmp_alloc_counter alloc_counter;
+
+    {
+        // Dynamic operands with enough spare capacity: the result
+        // is computed in the storage of the first rvalue operand.
+        int_t a{integer_bitcnt_t(2048)}, b{integer_bitcnt_t(2048)};
+        a = int_t{1} << 1000;
+        b = (int_t{1} << 900) + 1;
+        REQUIRE(!a.is_static());
+        REQUIRE(!b.is_static());
+        const auto a_ptr = a.get_mpz_t()->_mp_d, b_ptr = b.get_mpz_t()->_mp_d;
+        const int_t a_copy{a}, b_copy{b};
+        const auto r_cmp = (((((a_copy + b_copy - 1) * 3 / 7 % b_copy) | 5) & b_copy) ^ 42);
+        const auto r2_cmp = -(12 - (5 / (a_copy / b_copy)));
+        const auto r3_cmp = ~((a_copy % r2_cmp) << 10 >> 3);
+
+        const auto c0 = alloc_counter.count();
+        auto r = ((((std::move(a) + b_copy - 1) * 3 / 7 % b_copy) | 5) & b_copy) ^ 42;
+        // Rvalue on the right.
+        auto r2 = -(12 - (5 / (a_copy / std::move(b))));
+        const auto r2_ptr = r2.get_mpz_t()->_mp_d;
+        auto r3 = ~((a_copy % std::move(r2)) << 10 >> 3);
+        REQUIRE(alloc_counter.count() == c0);
+
+        REQUIRE(r.get_mpz_t()->_mp_d == a_ptr);
+        REQUIRE(r == r_cmp);
+        REQUIRE(r2_ptr == b_ptr);
+        REQUIRE(r3.get_mpz_t()->_mp_d == b_ptr);
+        REQUIRE(r3 == r3_cmp);
+    }
+
+    {
+        // Chained arithmetic: the additions reuse the storage of the products.
+        int_t a{1}, b{1}, c{1}, d{1}, e{1};
+        a <<= 3000;
+        b <<= 3000;
+        c <<= 3000;
+        d <<= 3000;
+        e <<= 3000;
+
+        auto c0 = alloc_counter.count();
+        const auto ab = a * b;
+        const auto cd = c * d;
+        const auto s1 = ab + cd;
+        const auto s2 = s1 + e;
+        const auto n_lvalue = alloc_counter.count() - c0;
+
+        c0 = alloc_counter.count();
+        const auto s3 = a * b + c * d + e;
+        const auto n_rvalue = alloc_counter.count() - c0;
+
+        REQUIRE(s2 == s3);
+        REQUIRE(n_rvalue < n_lvalue);
+    }
+
+    set_integer_cache_max_entries(old_max_entries);
+}
@@ -0,0 +1,169 @@
+// Copyright 2016-2023 Francesco Biscani (bluescarni@gmail.com)
+//
+// This file is part of the mp++ library.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <random>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include <gmp.h>
+
+#include <mp++/detail/gmp.hpp>
+#include <mp++/integer.hpp>
+#include <mp++/integer_batch.hpp>
+
+#include "catch.hpp"
+#include "test_utils.hpp"
+
+static const int ntries = 1000;
+
+// NOLINTNEXTLINE(google-build-using-namespace)
+using namespace mppp;
+// NOLINTNEXTLINE(google-build-using-namespace)
+using namespace mppp_test;
+
+using sizes = std::tuple<std::integral_constant<std::size_t, 1>, std::integral_constant<std::size_t, 2>,
+                         std::integral_constant<std::size_t, 3>, std::integral_constant<std::size_t, 6>>;
+
+// NOLINTNEXTLINE(cert-err58-cpp, cert-msc32-c, cert-msc51-cpp)
+static std::mt19937 rng;
+
+static const fp_rounding rnd_list[]
+    = {fp_rounding::nearest, fp_rounding::toward_zero, fp_rounding::upward, fp_rounding::downward};
+
+// Check to_double() against the reference implementation.
+template <std::size_t SSize>
+static void check_to_double(const integer<SSize> &n)
+{
+    detail::mpq_raii q;
+    mpq_set_z(&q.m_mpq, n.get_mpz_view());
+    for (auto rnd : rnd_list) {
+        const auto ref = n.is_zero() ? 0. : ref_to_double(&q.m_mpq, rnd);
+        REQUIRE(to_double(n, rnd) == ref);
+    }
+}
+
+struct to_double_tester {
+    template <typename S>
+    inline void operator()(const S &) const
+    {
+        using integer = integer<S::value>;
+        detail::mpz_raii tmp;
+
+        // Simple values.
+        for (auto rnd : rnd_list) {
+            REQUIRE(to_double(integer{}, rnd) == 0.);
+            REQUIRE(!std::signbit(to_double(integer{}, rnd)));
+            REQUIRE(to_double(integer{1}, rnd) == 1.);
+            REQUIRE(to_double(integer{-42}, rnd) == -42.);
+        }
+        REQUIRE(to_double(integer{123}) == 123.);
+
+        // Values around powers of two, testing the ties.
+        for (unsigned e = 57; e < 1030u; e += 7u) {
+            const auto p = integer{1} << e;
+            for (int d = -5; d <= 5; ++d) {
+                if (e < 1024u) {
+                    check_to_double(p + d);
+                    check_to_double(-(p + d));
+                    // Exact ties: 2**e + 2**(e - 53) * (2 * k + 1).
+                    const auto t = p + (integer{2 * d + 11} << (e - 53u));
+                    check_to_double(t);
+                    check_to_double(t + 1);
+                    check_to_double(t - 1);
+                    check_to_double(-t);
+                }
+            }
+        }
+
+        // Overflow.
+        const auto big = integer{1} << 1024;
+        REQUIRE(to_double(big) == std::numeric_limits<double>::infinity());
+        REQUIRE(to_double(-big) == -std::numeric_limits<double>::infinity());
+        REQUIRE(to_double(big, fp_rounding::toward_zero) == std::numeric_limits<double>::max());
+        REQUIRE(to_double(big, fp_rounding::upward) == std::numeric_limits<double>::infinity());
+        REQUIRE(to_double(big, fp_rounding::downward) == std::numeric_limits<double>::max());
+        REQUIRE(to_double(-big, fp_rounding::upward) == -std::numeric_limits<double>::max());
+        REQUIRE(to_double(-big, fp_rounding::downward) == -std::numeric_limits<double>::infinity());
+        // The largest finite value and the midpoint between it and 2**1024.
+        const auto dmax = big - (integer{1} << 971);
+        check_to_double(dmax);
+        REQUIRE(to_double(dmax + (integer{1} << 969)) == std::numeric_limits<double>::max());
+        REQUIRE(to_double(dmax + (integer{1} << 970)) == std::numeric_limits<double>::infinity());
+        REQUIRE(to_double(dmax + (integer{1} << 970) - 1) == std::numeric_limits<double>::max());
+        REQUIRE(to_double(dmax + (integer{1} << 970), fp_rounding::toward_zero) == std::numeric_limits<double>::max());
+        REQUIRE(to_double(integer{1} << 5000, fp_rounding::upward) == std::numeric_limits<double>::infinity());
+
+        // Random testing.
+        std::uniform_int_distribution<unsigned> sdist(0, static_cast<unsigned>(S::value) + 1u), bdist(0, 1);
+        std::uniform_int_distribution<unsigned> shdist(0, GMP_NUMB_BITS * 2u);
+        for (int i = 0; i < ntries; ++i) {
+            random_integer(tmp, sdist(rng), rng);
+            integer n{&tmp.m_mpz};
+            n >>= shdist(rng);
+            if (bdist(rng)) {
+                n.neg();
+            }
+            check_to_double(n);
+            if (bdist(rng)) {
+                n.promote();
+                check_to_double(n);
+            }
+            // The conversion operators must produce the same result as before.
+            if (n.size() > 1u) {
+                REQUIRE(static_cast<double>(n) == mpz_get_d(n.get_mpz_view()));
+                REQUIRE(static_cast<float>(n) == static_cast<float>(mpz_get_d(n.get_mpz_view())));
+            }
+        }
+    }
+};
+
+TEST_CASE("integer to_double")
+{
+    tuple_for_each(sizes{}, to_double_tester{});
+}
+
+struct batch_to_double_tester {
+    template <typename S>
+    inline void operator()(const S &) const
+    {
+        using integer = integer<S::value>;
+        std::vector<integer> v;
+        std::vector<double> out{42.};
+
+        batch_to_double(out, v.data(), v.size());
+        REQUIRE(out.empty());
+
+        detail::mpz_raii tmp;
+        std::uniform_int_distribution<unsigned> sdist(0, static_cast<unsigned>(S::value) + 1u), bdist(0, 1);
+        for (int i = 0; i < ntries; ++i) {
+            random_integer(tmp, sdist(rng), rng);
+            v.emplace_back(&tmp.m_mpz);
+            if (bdist(rng)) {
+                v.back().neg();
+            }
+        }
+        for (auto rnd : rnd_list) {
+            for (auto nthreads : {1u, 3u, 0u}) {
+                batch_to_double(out, v.data(), v.size(), rnd, nthreads);
+                REQUIRE(out.size() == v.size());
+                for (decltype(v.size()) j = 0; j < v.size(); ++j) {
+                    REQUIRE(out[j] == to_double(v[j], rnd));
+                }
+            }
+        }
+    }
+};
+
+TEST_CASE("integer batch_to_double")
+{
+    tuple_for_each(sizes{}, batch_to_double_tester{});
+}
@@ -0,0 +1,234 @@
+// Copyright 2016-2023 Francesco Biscani (bluescarni@gmail.com)
+//
+// This file is part of the mp++ library.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <cstddef>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include <mp++/detail/gmp.hpp>
+#include <mp++/integer.hpp>
+#include <mp++/integer_vector.hpp>
+
+#include "catch.hpp"
+#include "test_utils.hpp"
+
+// NOLINTNEXTLINE(google-build-using-namespace)
+using namespace mppp;
+// NOLINTNEXTLINE(google-build-using-namespace)
+using namespace mppp_test;
+
+using sizes = std::tuple<std::integral_constant<std::size_t, 1>, std::integral_constant<std::size_t, 2>,
+                         std::integral_constant<std::size_t, 3>, std::integral_constant<std::size_t, 6>>;
+
+// NOLINTNEXTLINE(cert-err58-cpp, cert-msc32-c, cert-msc51-cpp)
+static std::mt19937 rng;
+
+struct basic_tester {
+    template <typename S>
+    inline void operator()(const S &) const
+    {
+        using integer = integer<S::value>;
+        using ivec = integer_vector<S::value>;
+        REQUIRE(ivec::ssize == S::value);
+        ivec v0;
+        REQUIRE(v0.empty());
+        REQUIRE(v0.size() == 0u);
+        ivec v1(5);
+        REQUIRE(v1.size() == 5u);
+        for (std::size_t i = 0; i < v1.size(); ++i) {
+            REQUIRE(v1.get(i).is_zero());
+            REQUIRE(v1.is_static(i));
+        }
+        ivec v2(3, integer{-42});
+        REQUIRE(v2.to_vector() == std::vector<integer>(3, integer{-42}));
+        // Large values are stored in dynamic storage.
+        const auto big = integer{1} << (GMP_NUMB_BITS * S::value + 10u);
+        ivec v3{integer{1}, big, -big, integer{-3}};
+        REQUIRE(v3.size() == 4u);
+        REQUIRE(v3.is_static(0));
+        REQUIRE(!v3.is_static(1));
+        REQUIRE(!v3.is_static(2));
+        REQUIRE(v3.get(1) == big);
+        REQUIRE(v3.get(2) == -big);
+        REQUIRE(v3.get(3) == -3);
+        // Overwrite dynamic with static and vice versa.
+        v3.set(1, integer{5});
+        REQUIRE(v3.is_static(1));
+        REQUIRE(v3.get(1) == 5);
+        v3.set(0, big + 1);
+        REQUIRE(!v3.is_static(0));
+        REQUIRE(v3.get(0) == big + 1);
+        v3.set(0, big + 2);
+        REQUIRE(v3.get(0) == big + 2);
+        v3.push_back(big * 2);
+        REQUIRE(v3.get(4) == big * 2);
+        // Copy and move.
+        auto v4(v3);
+        REQUIRE(v4.to_vector() == v3.to_vector());
+        auto v5(std::move(v4));
+        REQUIRE(v5.to_vector() == v3.to_vector());
+        // Resizing.
+        v5.resize(2);
+        REQUIRE(v5.size() == 2u);
+        REQUIRE(v5.get(0) == big + 2);
+        v5.resize(4);
+        REQUIRE(v5.get(2).is_zero());
+        REQUIRE(v5.get(3).is_zero());
+        v5.set(3, -big);
+        REQUIRE(v5.get(3) == -big);
+        v5.clear();
+        REQUIRE(v5.empty());
+        // Range ctor.
+        const std::vector<integer> vec{integer{1}, integer{2}, big};
+        ivec v6(vec.begin(), vec.end());
+        REQUIRE(v6.to_vector() == vec);
+        const std::vector<int> ivec_src{1, -2, 3};
+        ivec v7(ivec_src.begin(), ivec_src.end());
+        REQUIRE(v7.to_vector() == std::vector<integer>{integer{1}, integer{-2}, integer{3}});
+        // Two arguments of the same non-iterator type select the size/value ctor.
+        ivec v8(3, 5);
+        REQUIRE(v8.size() == 3u);
+        REQUIRE(v8.get(2) == 5);
+        REQUIRE(!std::is_constructible<ivec, std::string, std::string>::value);
+        // Errors.
+        REQUIRE_THROWS_AS(v6.get(3), std::out_of_range);
+        REQUIRE_THROWS_AS(v6.set(3, integer{}), std::out_of_range);
+        REQUIRE_THROWS_AS(v6.is_static(3), std::out_of_range);
+        ivec out;
+        REQUIRE_THROWS_AS(add(out, v6, v3), std::invalid_argument);
+        REQUIRE_THROWS_AS(sub(out, v6, v3), std::invalid_argument);
+        REQUIRE_THROWS_AS(mul(out, v6, v3), std::invalid_argument);
+        REQUIRE_THROWS_AS(addmul(out, v6, v6), std::invalid_argument);
+        REQUIRE_THROWS_AS(dot(v6, v3), std::invalid_argument);
+    }
+};
+
+TEST_CASE("integer_vector basic")
+{
+    tuple_for_each(sizes{}, basic_tester{});
+}
+
+struct arith_tester {
+    template <typename S>
+    inline void operator()(const S &) const
+    {
+        using integer = integer<S::value>;
+        using ivec = integer_vector<S::value>;
+        detail::mpz_raii tmp;
+        std::uniform_int_distribution<int> sdist(0, 1);
+        // Operands with a number of limbs up to SSize + 1, so that
+        // we test both overflows and dynamic elements.
+        std::uniform_int_distribution<unsigned> ldist(0, S::value + 1u);
+        // NOTE: shrink the top limb every once in a while, so that the products
+        // of multi-limb operands do not always overflow.
+        std::uniform_int_distribution<unsigned> ddist(0, 60);
+        auto random_int = [&]() {
+            random_integer(tmp, ldist(rng), rng, sdist(rng) ? 1u : (::mp_limb_t(1) << ddist(rng)));
+            integer retval{&tmp.m_mpz};
+            if (sdist(rng)) {
+                retval.neg();
+            }
+            return retval;
+        };
+        for (std::size_t n : {0, 1, 2, 17, 100}) {
+            std::vector<integer> va, vb, vc;
+            for (std::size_t i = 0; i < n; ++i) {
+                va.push_back(random_int());
+                vb.push_back(random_int());
+                vc.push_back(random_int());
+            }
+            const ivec a(va.begin(), va.end()), b(vb.begin(), vb.end());
+            ivec r(vc.begin(), vc.end());
+
+            std::vector<integer> cmp(n);
+            integer d;
+            for (std::size_t i = 0; i < n; ++i) {
+                cmp[i] = vc[i] + va[i] * vb[i];
+                d += va[i] * vb[i];
+            }
+            addmul(r, a, b);
+            REQUIRE(r.to_vector() == cmp);
+            REQUIRE(dot(a, b) == d);
+
+            for (std::size_t i = 0; i < n; ++i) {
+                cmp[i] = va[i] + vb[i];
+            }
+            add(r, a, b);
+            REQUIRE(r.to_vector() == cmp);
+
+            for (std::size_t i = 0; i < n; ++i) {
+                cmp[i] = va[i] - vb[i];
+            }
+            sub(r, a, b);
+            REQUIRE(r.to_vector() == cmp);
+
+            for (std::size_t i = 0; i < n; ++i) {
+                cmp[i] = va[i] * vb[i];
+            }
+            mul(r, a, b);
+            REQUIRE(r.to_vector() == cmp);
+
+            // Aliasing.
+            auto r2 = a;
+            add(r2, r2, r2);
+            for (std::size_t i = 0; i < n; ++i) {
+                cmp[i] = va[i] * 2;
+            }
+            REQUIRE(r2.to_vector() == cmp);
+            mul(r2, a, r2);
+            for (std::size_t i = 0; i < n; ++i) {
+                cmp[i] = va[i] * va[i] * 2;
+            }
+            REQUIRE(r2.to_vector() == cmp);
+            addmul(r2, r2, r2);
+            for (std::size_t i = 0; i < n; ++i) {
+                cmp[i] += cmp[i] * cmp[i];
+            }
+            REQUIRE(r2.to_vector() == cmp);
+        }
+        // Overflow at the boundary of the static storage.
+        const auto max = (integer{1} << (GMP_NUMB_BITS * S::value)) - 1;
+        const ivec a{max, -max, max, integer{}}, b{integer{1}, integer{-1}, -max, max};
+        ivec r;
+        add(r, a, b);
+        REQUIRE(r.to_vector() == std::vector<integer>{max + 1, -max - 1, integer{}, max});
+        REQUIRE(!r.is_static(0));
+        REQUIRE(!r.is_static(1));
+        REQUIRE(r.is_static(2));
+        mul(r, a, b);
+        REQUIRE(r.to_vector() == std::vector<integer>{max, max, -max * max, integer{}});
+        REQUIRE(dot(a, b) == max + max - max * max);
+        // Dot products of static values close to the maximum, so that the accumulators
+        // overflow repeatedly. Check against a scalar addmul() loop.
+        std::uniform_int_distribution<unsigned> odist(0, 1000);
+        for (std::size_t n : {1, 100, 1000}) {
+            std::vector<integer> vc, ve;
+            for (std::size_t i = 0; i < n; ++i) {
+                vc.push_back(sdist(rng) ? max - odist(rng) : -max + odist(rng));
+                ve.push_back(sdist(rng) ? max - odist(rng) : -max + odist(rng));
+            }
+            const ivec c(vc.begin(), vc.end()), e(ve.begin(), ve.end());
+            integer d_ce, d_cc;
+            for (std::size_t i = 0; i < n; ++i) {
+                addmul(d_ce, vc[i], ve[i]);
+                addmul(d_cc, vc[i], vc[i]);
+            }
+            REQUIRE(dot(c, e) == d_ce);
+            REQUIRE(dot(c, c) == d_cc);
+        }
+    }
+};
+
+TEST_CASE("integer_vector arith")
+{
+    tuple_for_each(sizes{}, arith_tester{});
+}
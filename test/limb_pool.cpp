@@ -0,0 +1,148 @@
+// Copyright 2016-2023 Francesco Biscani (bluescarni@gmail.com)
+//
+// This file is part of the mp++ library.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <mp++/config.hpp>
+#include <mp++/integer.hpp>
+#include <mp++/limb_pool.hpp>
+
+#include "catch.hpp"
+#include "test_utils.hpp"
+
+// NOLINTNEXTLINE(google-build-using-namespace)
+using namespace mppp;
+// NOLINTNEXTLINE(google-build-using-namespace)
+using namespace mppp_test;
+
+using int_t = integer<1>;
+
+TEST_CASE("limb_pool")
+{
+    REQUIRE(!limb_pool_installed());
+    REQUIRE(get_limb_pool_config().max_class_limbs == 4096u);
+    REQUIRE(get_limb_pool_stats().thread_hits == 0u);
+    trim_limb_pool();
+
+    // Invalid configurations.
+    limb_pool_config cfg;
+    cfg.max_class_limbs = 0;
+    REQUIRE_THROWS_AS(install_limb_pool(cfg), std::invalid_argument);
+    cfg.max_class_limbs = 100;
+    REQUIRE_THROWS_AS(install_limb_pool(cfg), std::invalid_argument);
+    cfg.max_class_limbs = 64;
+    cfg.magazine_entries = 0;
+    REQUIRE_THROWS_AS(install_limb_pool(cfg), std::invalid_argument);
+    REQUIRE(!limb_pool_installed());
+
+    cfg.magazine_entries = 8;
+    cfg.magazine_bytes = 1024;
+    cfg.depot_magazines = 4;
+    install_limb_pool(cfg);
+    REQUIRE(limb_pool_installed());
+    REQUIRE(get_limb_pool_config().max_class_limbs == 64u);
+    REQUIRE(get_limb_pool_config().magazine_entries == 8u);
+    REQUIRE_THROWS_AS(install_limb_pool(cfg), std::runtime_error);
+
+    // Allocations and deallocations in the same thread.
+    const auto big = int_t{1} << 1000;
+    {
+        std::vector<int_t> v;
+        for (int i = 0; i < 100; ++i) {
+            v.push_back(big + i);
+        }
+        for (int i = 0; i < 100; ++i) {
+            REQUIRE(v[static_cast<std::size_t>(i)] == big + i);
+        }
+    }
+    free_integer_caches();
+    {
+        std::vector<int_t> v;
+        for (int i = 0; i < 10; ++i) {
+            v.push_back(big * i);
+        }
+    }
+    REQUIRE(get_limb_pool_stats().thread_hits > 0u);
+
+    // Growth via reallocation, within the pool and beyond.
+    int_t n{1};
+    n.promote();
+    for (int i = 0; i < 10000; ++i) {
+        n <<= 1;
+        n += 1;
+    }
+    REQUIRE(n == (int_t{1} << 10001) - 1);
+    REQUIRE(get_limb_pool_stats().oversize > 0u);
+
+    // Producer/consumer: the integers are created in one thread
+    // and destroyed in another.
+    std::mutex m;
+    std::atomic<bool> flag{true};
+    std::deque<std::vector<int_t>> queue;
+    auto producer = [&]() {
+        for (int j = 0; j < 100; ++j) {
+            std::vector<int_t> v;
+            for (int i = 0; i < 100; ++i) {
+                v.push_back(big + i * j);
+            }
+            std::lock_guard<std::mutex> lock(m);
+            queue.push_back(std::move(v));
+        }
+    };
+    auto consumer = [&]() {
+        int count = 0;
+        while (count < 100) {
+            std::vector<int_t> v;
+            {
+                std::lock_guard<std::mutex> lock(m);
+                if (queue.empty()) {
+                    continue;
+                }
+                v = std::move(queue.front());
+                queue.pop_front();
+            }
+            if (v[10] != big + 10 * count) {
+                flag.store(false);
+            }
+            ++count;
+            free_integer_caches();
+        }
+    };
+    std::thread t0(producer), t1(consumer);
+    t0.join();
+    t1.join();
+    REQUIRE(flag.load());
+    // The arrays freed by the consumer thread have been moved into the depot.
+    REQUIRE(get_limb_pool_stats().evictions > 0u);
+    REQUIRE(get_limb_pool_stats().depot_bytes > 0u);
+    {
+        std::vector<int_t> v;
+        for (int i = 0; i < 100; ++i) {
+            v.push_back(big - i);
+        }
+        REQUIRE(v[50] == big - 50);
+    }
+    REQUIRE(get_limb_pool_stats().depot_hits > 0u);
+
+    trim_limb_pool();
+    REQUIRE(get_limb_pool_stats().depot_bytes == 0u);
+
+    // Check that the pool keeps on working after trimming.
+    std::vector<int_t> v;
+    for (int i = 0; i < 100; ++i) {
+        v.push_back(big - i);
+    }
+    REQUIRE(v[50] == big - 50);
+}
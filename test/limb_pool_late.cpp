@@ -0,0 +1,39 @@
+// Copyright 2016-2023 Francesco Biscani (bluescarni@gmail.com)
+//
+// This file is part of the mp++ library.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <stdexcept>
+#include <thread>
+
+#include <mp++/config.hpp>
+#include <mp++/integer.hpp>
+#include <mp++/limb_pool.hpp>
+
+#include "catch.hpp"
+
+// NOLINTNEXTLINE(google-build-using-namespace)
+using namespace mppp;
+
+using int_t = integer<1>;
+
+TEST_CASE("limb_pool late installation")
+{
+#if defined(MPPP_HAVE_THREAD_LOCAL)
+    // A dynamic integer created and destroyed in another thread:
+    // its array may be sitting in the allocation cache of the thread
+    // (or it may have been freed via the old allocator), thus the
+    // installation must be refused.
+    std::thread t([]() {
+        int_t n{1};
+        n.promote();
+        n <<= 1000;
+    });
+    t.join();
+    REQUIRE_THROWS_AS(install_limb_pool(), std::runtime_error);
+    REQUIRE(!limb_pool_installed());
+#endif
+}
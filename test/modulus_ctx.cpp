@@ -0,0 +1,183 @@
+// Copyright 2016-2023 Francesco Biscani (bluescarni@gmail.com)
+//
+// This file is part of the mp++ library.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <cstddef>
+#include <random>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+
+#include <mp++/detail/gmp.hpp>
+#include <mp++/exceptions.hpp>
+#include <mp++/integer.hpp>
+#include <mp++/modulus_ctx.hpp>
+
+#include "catch.hpp"
+#include "test_utils.hpp"
+
+// NOLINTNEXTLINE(google-build-using-namespace)
+using namespace mppp;
+// NOLINTNEXTLINE(google-build-using-namespace)
+using namespace mppp_test;
+
+using sizes = std::tuple<std::integral_constant<std::size_t, 1>, std::integral_constant<std::size_t, 2>,
+                         std::integral_constant<std::size_t, 3>, std::integral_constant<std::size_t, 4>,
+                         std::integral_constant<std::size_t, 6>>;
+
+static const int ntries = 500;
+
+// NOLINTNEXTLINE(cert-err58-cpp, cert-msc32-c, cert-msc51-cpp, cppcoreguidelines-avoid-non-const-global-variables)
+static std::mt19937 rng;
+
+struct modulus_ctx_tester {
+    template <typename S>
+    void operator()(const S &) const
+    {
+        using Catch::Matchers::Message;
+        using integer = integer<S::value>;
+        using ctx_t = modulus_ctx<S::value>;
+
+        REQUIRE_THROWS_MATCHES(ctx_t{integer{}}, zero_division_error, Message("Integer division by zero"));
+
+        // A few simple tests.
+        ctx_t c7{integer{-7}};
+        REQUIRE(c7.get_mod() == 7);
+        REQUIRE(c7.get_mod().is_static());
+        REQUIRE(c7.reduce(integer{-1}) == 6);
+        REQUIRE(c7.reduce(integer{15}) == 1);
+        REQUIRE(c7.mulm(integer{3}, integer{-4}) == 2);
+        REQUIRE(c7.sqrm(integer{-3}) == 2);
+        REQUIRE(c7.powm(integer{3}, integer{0}) == 1);
+        REQUIRE(c7.powm(integer{3}, integer{6}) == 1);
+        REQUIRE(c7.powm(integer{-2}, integer{3}) == 6);
+        REQUIRE(c7.powm(integer{3}, integer{-1}) == 5);
+        REQUIRE_THROWS_AS(ctx_t{integer{4}}.powm(integer{2}, integer{-1}), std::domain_error);
+
+        ctx_t c1{integer{1}};
+        REQUIRE(c1.powm(integer{3}, integer{0}) == 0);
+        REQUIRE(c1.powm(integer{3}, integer{5}) == 0);
+        REQUIRE(c1.mulm(integer{3}, integer{5}) == 0);
+
+        // Check which reduction strategy is employed.
+        if (detail::integer_have_dlimb_mul::value) {
+            REQUIRE(c7.is_montgomery());
+            REQUIRE(c1.is_montgomery());
+        }
+        REQUIRE(!ctx_t{integer{8}}.is_montgomery());
+
+        // Random testing.
+        integer n1, n2, n3, n4;
+        detail::mpz_raii tmp, cmp;
+        std::uniform_int_distribution<int> sdist(0, 1);
+        auto random_xyz = [&](unsigned x, unsigned y, unsigned z) {
+            for (int i = 0; i < ntries; ++i) {
+                random_integer(tmp, z, rng);
+                n4 = &tmp.m_mpz;
+                if (sdist(rng) && n4.even_p()) {
+                    // Make the modulus odd more often, so that
+                    // the Montgomery kernels are exercised.
+                    ++n4;
+                }
+                if (n4.is_zero()) {
+                    n4 = 1;
+                }
+                if (sdist(rng)) {
+                    n4.neg();
+                }
+                if (n4.is_static() && sdist(rng)) {
+                    n4.promote();
+                }
+                const ctx_t ctx{n4};
+                REQUIRE(ctx.get_mod() == abs(n4));
+                if (n4.size() <= S::value) {
+                    REQUIRE(ctx.get_mod().is_static());
+                }
+
+                random_integer(tmp, x, rng);
+                n2 = &tmp.m_mpz;
+                if (sdist(rng)) {
+                    n2.neg();
+                }
+                if (n2.is_static() && sdist(rng)) {
+                    n2.promote();
+                }
+
+                random_integer(tmp, y, rng);
+                n3 = &tmp.m_mpz;
+                if (sdist(rng)) {
+                    n3.neg();
+                }
+                if (n3.is_static() && sdist(rng)) {
+                    n3.promote();
+                }
+                // NOLINTNEXTLINE(misc-redundant-expression)
+                if (sdist(rng) && sdist(rng) && sdist(rng)) {
+                    n1 = integer{};
+                    n1.promote();
+                }
+
+                // Reduction.
+                mpz_mod(&cmp.m_mpz, n2.get_mpz_view(), n4.get_mpz_view());
+                ctx.reduce(n1, n2);
+                REQUIRE(n1 == integer{&cmp.m_mpz});
+
+                // Multiplication.
+                mpz_mul(&cmp.m_mpz, n2.get_mpz_view(), n3.get_mpz_view());
+                mpz_mod(&cmp.m_mpz, &cmp.m_mpz, n4.get_mpz_view());
+                ctx.mulm(n1, n2, n3);
+                REQUIRE(n1 == integer{&cmp.m_mpz});
+                if (n4.size() <= S::value) {
+                    REQUIRE(n1.is_static());
+                }
+                REQUIRE(ctx.mulm(n3, n2) == n1);
+                auto n2_old(n2);
+                ctx.mulm(n2, n2, n3);
+                REQUIRE(n2 == n1);
+                n2 = n2_old;
+
+                // Squaring.
+                mpz_mul(&cmp.m_mpz, n2.get_mpz_view(), n2.get_mpz_view());
+                mpz_mod(&cmp.m_mpz, &cmp.m_mpz, n4.get_mpz_view());
+                REQUIRE(ctx.sqrm(n2) == integer{&cmp.m_mpz});
+
+                // Exponentiation.
+                const auto e = abs(n3);
+                mpz_powm(&cmp.m_mpz, n2.get_mpz_view(), e.get_mpz_view(), n4.get_mpz_view());
+                ctx.powm(n1, n2, e);
+                REQUIRE(n1 == integer{&cmp.m_mpz});
+                REQUIRE(powm(n2, e, n4) == n1);
+                ctx.powm(n2, n2, e);
+                REQUIRE(n2 == n1);
+                n2 = n2_old;
+
+                // Negative exponents.
+                if (n3.sgn() < 0 && mpz_invert(&cmp.m_mpz, n2.get_mpz_view(), n4.get_mpz_view()) != 0) {
+                    REQUIRE(ctx.powm(n2, n3) == powm(n2, n3, n4));
+                }
+            }
+        };
+
+        random_xyz(0, 1, 1);
+        random_xyz(1, 1, 1);
+        random_xyz(2, 2, 1);
+        random_xyz(1, 1, 2);
+        random_xyz(2, 2, 2);
+        random_xyz(3, 2, 2);
+        random_xyz(3, 2, 3);
+        random_xyz(4, 1, 3);
+        random_xyz(4, 2, 4);
+        random_xyz(8, 1, 4);
+        random_xyz(5, 1, 5);
+        random_xyz(7, 2, 7);
+    }
+};
+
+TEST_CASE("modulus_ctx")
+{
+    tuple_for_each(sizes{}, modulus_ctx_tester{});
+}
@@ -130,4 +130,17 @@ PYBIND11_MODULE(pybind11_test_01, m)
 #endif
 
     m.def("test_zero_division_error", []() { return mppp::integer<1>{1} / 0; });
+
+    m.def("test_batch_list_conversion", [](const pybind11::handle &h) {
+        std::vector<mppp::integer<1>> v;
+        mppp_pybind11::py_to_integers(v, h);
+        return mppp_pybind11::integers_to_py_list(v.data(), v.size());
+    });
+    m.def("test_batch_tuple_conversion", [](const pybind11::handle &h) {
+        // NOTE: start from a vector containing dynamic values,
+        // whose storage will be re-used.
+        std::vector<mppp::integer<2>> v(10, mppp::integer<2>{1} << 1000);
+        mppp_pybind11::py_to_integers(v, h);
+        return mppp_pybind11::integers_to_py_tuple(v.data(), v.size());
+    });
 }
@@ -369,6 +369,41 @@ class Test01(unittest.TestCase):
             self.assertRaises(TypeError, lambda: p.test_unordered_map_conversion(
                 {'a': mpc(1), 'b': 2}))
 
+    def test_int_conversions(self):
+        import random
+        import pybind11_test_01 as p
+
+        rng = random.Random(42)
+
+        # Values around the boundaries of the Python digits and of the limbs.
+        vals = [0]
+        for nbits in [15, 30, 32, 60, 63, 64, 90, 120, 128, 129, 192, 1000]:
+            for v in [2**nbits - 1, 2**nbits, 2**nbits + 1]:
+                vals += [v, -v]
+        # Random values, including very large ones.
+        for nbits in [10, 100, 1000, 10000, 100000]:
+            for _ in range(20):
+                v = rng.getrandbits(nbits)
+                vals += [v, -v]
+
+        for v in vals:
+            self.assertEqual(p.test_int1_conversion(v), v)
+            self.assertEqual(p.test_int2_conversion(v), v)
+
+        # Batch conversions.
+        self.assertEqual(p.test_batch_list_conversion([]), [])
+        self.assertEqual(p.test_batch_list_conversion(()), [])
+        self.assertEqual(p.test_batch_list_conversion(vals), vals)
+        self.assertEqual(p.test_batch_list_conversion(tuple(vals)), vals)
+        self.assertEqual(p.test_batch_tuple_conversion(vals), tuple(vals))
+        self.assertEqual(p.test_batch_tuple_conversion([1, -2]), (1, -2))
+        self.assertEqual(p.test_batch_tuple_conversion(()), ())
+        self.assertRaises(TypeError, lambda: p.test_batch_list_conversion(1))
+        self.assertRaises(
+            TypeError, lambda: p.test_batch_list_conversion(iter([1, 2])))
+        self.assertRaises(
+            TypeError, lambda: p.test_batch_list_conversion([1, 2, 3.5]))
+
     def test_exceptions(self):
         import pybind11_test_01 as p
 
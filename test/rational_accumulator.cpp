@@ -0,0 +1,176 @@
+// Copyright 2016-2023 Francesco Biscani (bluescarni@gmail.com)
+//
+// This file is part of the mp++ library.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <cstddef>
+#include <random>
+#include <tuple>
+#include <type_traits>
+
+#include <mp++/config.hpp>
+#include <mp++/integer.hpp>
+#include <mp++/rational.hpp>
+#include <mp++/rational_accumulator.hpp>
+
+#include "catch.hpp"
+#include "test_utils.hpp"
+
+// NOLINTNEXTLINE(google-build-using-namespace)
+using namespace mppp;
+// NOLINTNEXTLINE(google-build-using-namespace)
+using namespace mppp_test;
+
+using sizes = std::tuple<std::integral_constant<std::size_t, 1>, std::integral_constant<std::size_t, 2>,
+                         std::integral_constant<std::size_t, 3>, std::integral_constant<std::size_t, 6>,
+                         std::integral_constant<std::size_t, 10>>;
+
+static const int ntries = 1000;
+
+// NOLINTNEXTLINE(cert-err58-cpp, cert-msc32-c, cert-msc51-cpp, cppcoreguidelines-avoid-non-const-global-variables)
+static std::mt19937 rng;
+
+struct accumulator_tester {
+    template <typename S>
+    void operator()(const S &) const
+    {
+        using integer = integer<S::value>;
+        using rational = rational<S::value>;
+        using acc_t = rational_accumulator<S::value>;
+
+        // A few simple tests.
+        acc_t acc;
+        REQUIRE(acc.get() == 0);
+        REQUIRE(acc.get_den() == 1);
+        acc += rational{1, 2};
+        acc += rational{1, 3};
+        acc += rational{1, 6};
+        REQUIRE(acc.get() == 1);
+        REQUIRE(acc.get().get_den() == 1);
+        acc -= 2;
+        REQUIRE(acc.get() == -1);
+        acc += integer{3};
+        REQUIRE(acc.get() == 2);
+        acc *= rational{3, 4};
+        REQUIRE(acc.get() == rational{3, 2});
+        acc *= -2;
+        REQUIRE(acc.get() == -3);
+        acc -= rational{1, 4};
+        REQUIRE(acc.get() == rational{-13, 4});
+        acc *= integer{};
+        REQUIRE(acc.get() == 0);
+        REQUIRE(acc.get_den() == 1);
+        acc += rational{5, 7};
+        acc *= rational{};
+        REQUIRE(acc.get() == 0);
+        REQUIRE(acc.get_den() == 1);
+        REQUIRE(acc_t{rational{-3, 9}}.get() == rational{-1, 3});
+
+        // The internal state is not canonical until canonicalise() is called.
+        acc_t acc2;
+        acc2 += rational{1, 4};
+        acc2 += rational{1, 4};
+        REQUIRE(acc2.get_den() == 4);
+        REQUIRE(acc2.get() == rational{1, 2});
+        acc2.canonicalise();
+        REQUIRE(acc2.get_num() == 1);
+        REQUIRE(acc2.get_den() == 2);
+
+        // Random testing against the eager arithmetic.
+        detail::mpz_raii tmp;
+        std::uniform_int_distribution<int> sdist(0, 1), opdist(0, 5), idist(-100, 100);
+        std::uniform_int_distribution<unsigned> ldist(0, S::value + 1u);
+        auto random_rational = [&](rational &r, unsigned x) {
+            random_integer(tmp, x, rng);
+            r._get_num() = &tmp.m_mpz;
+            random_integer(tmp, x, rng);
+            r._get_den() = &tmp.m_mpz;
+            if (r.get_den().is_zero()) {
+                r._get_den() = 1;
+            }
+            if (sdist(rng)) {
+                r._get_num().neg();
+            }
+            r.canonicalise();
+        };
+
+        rational q, eager;
+        integer n;
+        for (int j = 0; j < 10; ++j) {
+            acc_t a;
+            eager = 0;
+            for (int i = 0; i < ntries; ++i) {
+                random_rational(q, ldist(rng));
+                random_integer(tmp, ldist(rng), rng);
+                n = &tmp.m_mpz;
+                const auto m = idist(rng);
+                switch (opdist(rng)) {
+                    case 0:
+                        a += q;
+                        eager += q;
+                        break;
+                    case 1:
+                        a -= q;
+                        eager -= q;
+                        break;
+                    case 2:
+                        a += n;
+                        eager += n;
+                        break;
+                    case 3:
+                        a -= m;
+                        eager -= m;
+                        break;
+                    case 4:
+                        // NOTE: multiply rarely, in order to avoid
+                        // runaway growth.
+                        if (i % 50 == 0) {
+                            a *= q;
+                            eager *= q;
+                        }
+                        break;
+                    default:
+                        if (i % 50 == 0) {
+                            a *= m;
+                            eager *= m;
+                        }
+                }
+                REQUIRE(a.get_den().sgn() > 0);
+                if (i % 100 == 0) {
+                    REQUIRE(a.get() == eager);
+                }
+            }
+            REQUIRE(a.get() == eager);
+            a.canonicalise();
+            REQUIRE(a.get_num() == eager.get_num());
+            REQUIRE(a.get_den() == eager.get_den());
+        }
+
+        // Many rationals with small denominators.
+        acc_t a;
+        eager = 0;
+        std::uniform_int_distribution<int> ddist(1, 100);
+        for (int i = 0; i < ntries * 10; ++i) {
+            q = rational{idist(rng), ddist(rng)};
+            a += q;
+            eager += q;
+        }
+        REQUIRE(a.get() == eager);
+        // The harmonic numbers.
+        a = acc_t{};
+        eager = 0;
+        for (int i = 1; i < 2000; ++i) {
+            a += rational{1, i};
+            eager += rational{1, i};
+        }
+        REQUIRE(a.get() == eager);
+    }
+};
+
+TEST_CASE("rational_accumulator")
+{
+    tuple_for_each(sizes{}, accumulator_tester{});
+}
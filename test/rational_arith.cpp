@@ -11,6 +11,7 @@
 #include <stdexcept>
 #include <tuple>
 #include <type_traits>
+#include <vector>
 
 #include <gmp.h>
 
@@ -727,3 +728,64 @@ TEST_CASE("div")
 {
     tuple_for_each(sizes{}, div_tester{});
 }
+
+struct single_limb_tester {
+    template <typename S>
+    inline void operator()(const S &) const
+    {
+        using rational = rational<S::value>;
+        // Operands with single-limb nums and dens, including values
+        // for which the cross products and the sums overflow a limb.
+        const ::mp_limb_t max = GMP_NUMB_MAX;
+        const ::mp_limb_t limbs[] = {1u, 2u, 3u, 6u, 7u, 12u, max, max - 1u, max / 2u, max / 3u, max - 2u};
+        std::vector<rational> v{rational{}};
+        for (const auto &n : limbs) {
+            for (const auto &d : limbs) {
+                v.emplace_back(integer<S::value>{&n, 1}, integer<S::value>{&d, 1});
+                v.emplace_back(-v.back());
+            }
+        }
+        detail::mpq_raii m1, m2, m3;
+        rational r;
+        for (const auto &q1 : v) {
+            REQUIRE(q1.get_num().is_static());
+            REQUIRE(q1.get_den().is_static());
+            const auto v1 = detail::get_mpq_view(q1);
+            mpq_set(&m1.m_mpq, &v1);
+            for (const auto &q2 : v) {
+                const auto v2 = detail::get_mpq_view(q2);
+                mpq_set(&m2.m_mpq, &v2);
+                mpq_add(&m3.m_mpq, &m1.m_mpq, &m2.m_mpq);
+                REQUIRE((lex_cast(add(r, q1, q2)) == lex_cast(m3)));
+                mpq_sub(&m3.m_mpq, &m1.m_mpq, &m2.m_mpq);
+                REQUIRE((lex_cast(sub(r, q1, q2)) == lex_cast(m3)));
+                mpq_mul(&m3.m_mpq, &m1.m_mpq, &m2.m_mpq);
+                REQUIRE((lex_cast(mul(r, q1, q2)) == lex_cast(m3)));
+                if (!q2.is_zero()) {
+                    mpq_div(&m3.m_mpq, &m1.m_mpq, &m2.m_mpq);
+                    REQUIRE((lex_cast(div(r, q1, q2)) == lex_cast(m3)));
+                }
+                const auto c = mpq_cmp(&m1.m_mpq, &m2.m_mpq);
+                REQUIRE((cmp(q1, q2) < 0) == (c < 0));
+                REQUIRE((cmp(q1, q2) > 0) == (c > 0));
+                REQUIRE((q1 < q2) == (c < 0));
+                // Overlapping arguments.
+                r = q1;
+                REQUIRE((lex_cast(add(r, r, q2)) == lex_cast(q1 + q2)));
+                r = q2;
+                REQUIRE((lex_cast(sub(r, q1, r)) == lex_cast(q1 - q2)));
+                r = q1;
+                REQUIRE((lex_cast(mul(r, q2, r)) == lex_cast(q2 * q1)));
+                if (!q2.is_zero()) {
+                    r = q2;
+                    REQUIRE((lex_cast(div(r, q1, r)) == lex_cast(q1 / q2)));
+                }
+            }
+        }
+    }
+};
+
+TEST_CASE("single limb")
+{
+    tuple_for_each(sizes{}, single_limb_tester{});
+}
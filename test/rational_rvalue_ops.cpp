@@ -0,0 +1,196 @@
+// Copyright 2016-2023 Francesco Biscani (bluescarni@gmail.com)
+//
+// This file is part of the mp++ library.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <cstddef>
+#include <random>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include <mp++/config.hpp>
+#include <mp++/detail/gmp.hpp>
+#include <mp++/exceptions.hpp>
+#include <mp++/integer.hpp>
+#include <mp++/rational.hpp>
+
+#include "catch.hpp"
+#include "test_utils.hpp"
+
+// NOLINTNEXTLINE(google-build-using-namespace)
+using namespace mppp;
+// NOLINTNEXTLINE(google-build-using-namespace)
+using namespace mppp_test;
+
+using sizes = std::tuple<std::integral_constant<std::size_t, 1>, std::integral_constant<std::size_t, 2>,
+                         std::integral_constant<std::size_t, 3>, std::integral_constant<std::size_t, 6>,
+                         std::integral_constant<std::size_t, 10>>;
+
+static const int ntries = 1000;
+
+// NOLINTNEXTLINE(cert-err58-cpp, cert-msc32-c, cert-msc51-cpp, cppcoreguidelines-avoid-non-const-global-variables)
+static std::mt19937 rng;
+
+// Helper to produce an rvalue copy of x.
+template <typename T>
+static T copy(const T &x)
+{
+    return x;
+}
+
+// Check that the rvalue overloads of the binary operators produce
+// the same results as the lvalue ones.
+template <typename T, typename U>
+static void check_rvalue_ops(const T &a, const U &b)
+{
+    REQUIRE(copy(a) + b == a + b);
+    REQUIRE(a + copy(b) == a + b);
+    REQUIRE(copy(a) + copy(b) == a + b);
+    REQUIRE(copy(a) - b == a - b);
+    REQUIRE(a - copy(b) == a - b);
+    REQUIRE(copy(a) - copy(b) == a - b);
+    REQUIRE(copy(a) * b == a * b);
+    REQUIRE(a * copy(b) == a * b);
+    REQUIRE(copy(a) * copy(b) == a * b);
+    if (b != 0) {
+        REQUIRE(copy(a) / b == a / b);
+        REQUIRE(a / copy(b) == a / b);
+        REQUIRE(copy(a) / copy(b) == a / b);
+    }
+}
+
+struct rvalue_tester {
+    template <typename S>
+    void operator()(const S &) const
+    {
+        using Catch::Matchers::Message;
+        using integer = integer<S::value>;
+        using rational = rational<S::value>;
+
+        // Return types.
+        REQUIRE(std::is_same<rational, decltype(rational{} + rational{})>::value);
+        REQUIRE(std::is_same<rational, decltype(1 - rational{})>::value);
+        REQUIRE(std::is_same<rational, decltype(rational{} * integer{})>::value);
+        REQUIRE(std::is_same<rational, decltype(integer{} / rational{1})>::value);
+        REQUIRE(std::is_same<rational, decltype(-rational{})>::value);
+        REQUIRE(std::is_same<double, decltype(rational{} + 1.)>::value);
+
+        // Division by zero.
+        REQUIRE_THROWS_MATCHES(rational{1} / rational{}, zero_division_error,
+                               Message("Zero divisor in rational division"));
+        REQUIRE_THROWS_MATCHES(rational{1} / integer{}, zero_division_error,
+                               Message("Zero divisor in rational division"));
+        REQUIRE_THROWS_MATCHES(1 / rational{}, zero_division_error, Message("Zero divisor in rational division"));
+        REQUIRE_THROWS_MATCHES(integer{1} / rational{}, zero_division_error,
+                               Message("Zero divisor in rational division"));
+
+        // A few simple tests.
+        REQUIRE(3 - rational{1, 2} == rational{5, 2});
+        REQUIRE(integer{3} / rational{2, 5} == rational{15, 2});
+        REQUIRE(-6 / rational{4, 3} == rational{-9, 2});
+        REQUIRE(0 / rational{4, 3} == 0);
+        REQUIRE(rational{1, 2} / rational{-1, 4} == -2);
+        REQUIRE(-rational{1, 2} == rational{-1, 2});
+        REQUIRE(+rational{1, 2} == rational{1, 2});
+
+        // Aliasing.
+        rational q{3, 4};
+        REQUIRE(q - std::move(q) == 0);
+        q = rational{3, 4};
+        REQUIRE(std::move(q) / q == 1);
+        q = rational{3, 4};
+        REQUIRE(q / std::move(q) == 1);
+
+        // Random testing.
+        rational q1, q2;
+        integer n;
+        detail::mpz_raii tmp;
+        std::uniform_int_distribution<int> sdist(0, 1), idist(-100, 100);
+        auto random_rational = [&](rational &r, unsigned x) {
+            random_integer(tmp, x, rng);
+            r._get_num() = &tmp.m_mpz;
+            random_integer(tmp, x, rng);
+            r._get_den() = &tmp.m_mpz;
+            if (r.get_den().is_zero()) {
+                r._get_den() = 1;
+            }
+            if (sdist(rng)) {
+                r._get_num().neg();
+            }
+            r.canonicalise();
+        };
+        auto random_xy = [&](unsigned x, unsigned y) {
+            for (int i = 0; i < ntries; ++i) {
+                random_rational(q1, x);
+                random_rational(q2, y);
+                random_integer(tmp, y, rng);
+                n = &tmp.m_mpz;
+                if (sdist(rng)) {
+                    n.neg();
+                }
+
+                check_rvalue_ops(q1, q2);
+                check_rvalue_ops(q1, n);
+                check_rvalue_ops(n, q1);
+                const auto m = idist(rng);
+                check_rvalue_ops(q1, m);
+                check_rvalue_ops(m, q1);
+                check_rvalue_ops(static_cast<unsigned long long>(m + 100), q1);
+
+                REQUIRE(-copy(q1) == -q1);
+            }
+        };
+
+        for (unsigned x = 0; x <= S::value + 1u; ++x) {
+            for (unsigned y = 0; y <= S::value + 1u; ++y) {
+                random_xy(x, y);
+            }
+        }
+    }
+};
+
+TEST_CASE("rvalue ops")
+{
+    tuple_for_each(sizes{}, rvalue_tester{});
+}
+
+TEST_CASE("rvalue storage reuse")
+{
+    using rat_t = rational<1>;
+    using int_t = integer<1>;
+
+    const auto old_max_entries = get_integer_cache_max_entries();
+    set_integer_cache_max_entries(0);
+
+    const gmp_alloc_counter alloc_counter;
+
+    {
+        // Dynamic numerator with enough spare capacity: the result
+        // is computed in the storage of the rvalue operand.
+        rat_t a;
+        a._get_num() = int_t{integer_bitcnt_t(2048)};
+        a._get_num() = (int_t{1} << 1000) + 1;
+        REQUIRE(!a.get_num().is_static());
+        const auto ptr = a._get_num().get_mpz_t()->_mp_d;
+        const rat_t a_copy{a};
+        const auto r_cmp = -((a_copy + 1 - 2) * 3 * int_t{5});
+        const auto r2_cmp = 3 - (int_t{2} * r_cmp);
+
+        const auto c0 = alloc_counter.count();
+        auto r = -((std::move(a) + 1 - 2) * 3 * int_t{5});
+        const auto r_ptr = r._get_num().get_mpz_t()->_mp_d;
+        // Rvalue on the right.
+        auto r2 = 3 - (int_t{2} * std::move(r));
+        REQUIRE(alloc_counter.count() == c0);
+
+        REQUIRE(r_ptr == ptr);
+        REQUIRE(r2._get_num().get_mpz_t()->_mp_d == ptr);
+        REQUIRE(r2 == r2_cmp);
+    }
+
+    set_integer_cache_max_entries(old_max_entries);
+}
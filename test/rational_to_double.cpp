@@ -0,0 +1,192 @@
+// Copyright 2016-2023 Francesco Biscani (bluescarni@gmail.com)
+//
+// This file is part of the mp++ library.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <random>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include <gmp.h>
+
+#include <mp++/detail/gmp.hpp>
+#include <mp++/integer.hpp>
+#include <mp++/rational.hpp>
+
+#include "catch.hpp"
+#include "test_utils.hpp"
+
+static const int ntries = 1000;
+
+// NOLINTNEXTLINE(google-build-using-namespace)
+using namespace mppp;
+// NOLINTNEXTLINE(google-build-using-namespace)
+using namespace mppp_test;
+
+using sizes = std::tuple<std::integral_constant<std::size_t, 1>, std::integral_constant<std::size_t, 2>,
+                         std::integral_constant<std::size_t, 3>, std::integral_constant<std::size_t, 6>>;
+
+// NOLINTNEXTLINE(cert-err58-cpp, cert-msc32-c, cert-msc51-cpp)
+static std::mt19937 rng;
+
+static const fp_rounding rnd_list[]
+    = {fp_rounding::nearest, fp_rounding::toward_zero, fp_rounding::upward, fp_rounding::downward};
+
+// Check to_double() against the reference implementation.
+template <std::size_t SSize>
+static void check_to_double(const rational<SSize> &q)
+{
+    const auto v = detail::get_mpq_view(q);
+    for (auto rnd : rnd_list) {
+        const auto ref = q.is_zero() ? 0. : ref_to_double(&v, rnd);
+        REQUIRE(to_double(q, rnd) == ref);
+    }
+}
+
+struct to_double_tester {
+    template <typename S>
+    inline void operator()(const S &) const
+    {
+        using rational = rational<S::value>;
+        using integer = integer<S::value>;
+        detail::mpq_raii tmp;
+
+        // Simple values.
+        for (auto rnd : rnd_list) {
+            REQUIRE(to_double(rational{}, rnd) == 0.);
+            REQUIRE(to_double(rational{1, 2}, rnd) == .5);
+            REQUIRE(to_double(rational{-3, 4}, rnd) == -.75);
+            REQUIRE(to_double(rational{-42}, rnd) == -42.);
+        }
+        REQUIRE(to_double(rational{1, 3}) == 1. / 3.);
+        REQUIRE(to_double(rational{2, 3}) == 2. / 3.);
+        REQUIRE(to_double(rational{1, 3}, fp_rounding::downward) == 1. / 3.);
+        REQUIRE(to_double(rational{1, 3}, fp_rounding::upward) == std::nextafter(1. / 3., 1.));
+        REQUIRE(to_double(rational{-1, 3}, fp_rounding::upward) == -1. / 3.);
+        REQUIRE(to_double(rational{-1, 3}, fp_rounding::downward) == -std::nextafter(1. / 3., 1.));
+        REQUIRE(to_double(rational{-1, 3}, fp_rounding::toward_zero) == -1. / 3.);
+
+        // Small numerators and denominators, including the extremes of a single limb.
+        const auto lmax = GMP_NUMB_MASK;
+        for (auto n : {1u, 2u, 3u, 7u, 10u, 255u}) {
+            for (auto d : {1u, 3u, 5u, 7u, 10u, 11u, 13u, 1000u}) {
+                check_to_double(rational{n, d});
+                check_to_double(rational{-integer{n}, integer{d}});
+            }
+        }
+        check_to_double(rational{integer{1}, integer{lmax}});
+        check_to_double(rational{integer{lmax}, integer{3}});
+        check_to_double(rational{integer{lmax - 1u}, integer{lmax}});
+        check_to_double(rational{-integer{lmax}, integer{lmax - 1u}});
+        // The conversion operator must truncate.
+        REQUIRE(static_cast<double>(rational{1, 3}) == to_double(rational{1, 3}, fp_rounding::toward_zero));
+        REQUIRE(static_cast<double>(rational{-2, 3}) == to_double(rational{-2, 3}, fp_rounding::toward_zero));
+
+        // Subnormal values and underflow.
+        const auto dmin = std::numeric_limits<double>::denorm_min();
+        REQUIRE(to_double(rational{integer{1}, integer{1} << 1074}) == dmin);
+        REQUIRE(to_double(rational{integer{3}, integer{1} << 1076}) == dmin);
+        REQUIRE(to_double(rational{integer{1}, integer{1} << 1075}) == 0.);
+        REQUIRE(to_double(rational{integer{3}, integer{1} << 1075}) == 2 * dmin);
+        REQUIRE(to_double(rational{integer{1}, integer{1} << 2000}) == 0.);
+        REQUIRE(to_double(rational{integer{1}, integer{1} << 2000}, fp_rounding::upward) == dmin);
+        REQUIRE(to_double(rational{integer{-1}, integer{1} << 2000}, fp_rounding::downward) == -dmin);
+        REQUIRE(to_double(rational{integer{-1}, integer{1} << 2000}, fp_rounding::upward) == 0.);
+        REQUIRE(std::signbit(to_double(rational{integer{-1}, integer{1} << 2000}, fp_rounding::upward)));
+        for (unsigned e = 1000; e < 1100u; ++e) {
+            check_to_double(rational{integer{7}, (integer{1} << e) + 1});
+            check_to_double(rational{integer{-5}, (integer{1} << e) - 1});
+        }
+
+        // Overflow.
+        REQUIRE(to_double(rational{integer{1} << 1100, 3}) == std::numeric_limits<double>::infinity());
+        REQUIRE(to_double(rational{-(integer{1} << 1100), 3}, fp_rounding::toward_zero)
+                == -std::numeric_limits<double>::max());
+
+        // Random testing.
+        std::uniform_int_distribution<unsigned> sdist(0, static_cast<unsigned>(S::value) + 1u), bdist(0, 1);
+        for (int i = 0; i < ntries; ++i) {
+            random_rational(tmp, sdist(rng), rng);
+            rational q{&tmp.m_mpq};
+            if (bdist(rng)) {
+                q.neg();
+            }
+            check_to_double(q);
+            if (bdist(rng)) {
+                q._get_num().promote();
+                check_to_double(q);
+            }
+            // The conversion operators must produce the same result as before.
+            const auto v = detail::get_mpq_view(q);
+            REQUIRE(static_cast<double>(q) == mpq_get_d(&v));
+            REQUIRE(static_cast<float>(q) == static_cast<float>(mpq_get_d(&v)));
+        }
+        // Random testing with small numerators and denominators.
+        std::uniform_int_distribution<unsigned> shdist(0, GMP_NUMB_BITS - 1u);
+        for (int i = 0; i < ntries; ++i) {
+            random_rational(tmp, 1, rng);
+            mpz_tdiv_q_2exp(mpq_numref(&tmp.m_mpq), mpq_numref(&tmp.m_mpq), shdist(rng));
+            mpz_tdiv_q_2exp(mpq_denref(&tmp.m_mpq), mpq_denref(&tmp.m_mpq), shdist(rng));
+            if (mpz_sgn(mpq_denref(&tmp.m_mpq)) == 0) {
+                mpz_set_ui(mpq_denref(&tmp.m_mpq), 1u);
+            }
+            mpq_canonicalize(&tmp.m_mpq);
+            rational q{&tmp.m_mpq};
+            if (bdist(rng)) {
+                q.neg();
+            }
+            check_to_double(q);
+            const auto v = detail::get_mpq_view(q);
+            REQUIRE(static_cast<double>(q) == mpq_get_d(&v));
+        }
+    }
+};
+
+TEST_CASE("rational to_double")
+{
+    tuple_for_each(sizes{}, to_double_tester{});
+}
+
+struct batch_to_double_tester {
+    template <typename S>
+    inline void operator()(const S &) const
+    {
+        using rational = rational<S::value>;
+        std::vector<rational> v;
+        std::vector<double> out{42.};
+
+        batch_to_double(out, v.data(), v.size());
+        REQUIRE(out.empty());
+
+        detail::mpq_raii tmp;
+        std::uniform_int_distribution<unsigned> sdist(0, static_cast<unsigned>(S::value) + 1u), bdist(0, 1);
+        for (int i = 0; i < ntries; ++i) {
+            random_rational(tmp, sdist(rng), rng);
+            v.emplace_back(&tmp.m_mpq);
+            if (bdist(rng)) {
+                v.back().neg();
+            }
+        }
+        for (auto rnd : rnd_list) {
+            for (auto nthreads : {1u, 3u, 0u}) {
+                batch_to_double(out, v.data(), v.size(), rnd, nthreads);
+                REQUIRE(out.size() == v.size());
+                for (decltype(v.size()) j = 0; j < v.size(); ++j) {
+                    REQUIRE(out[j] == to_double(v[j], rnd));
+                }
+            }
+        }
+    }
+};
+
+TEST_CASE("rational batch_to_double")
+{
+    tuple_for_each(sizes{}, batch_to_double_tester{});
+}
@@ -0,0 +1,80 @@
+// Copyright 2016-2023 Francesco Biscani (bluescarni@gmail.com)
+//
+// This file is part of the mp++ library.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <mp++/config.hpp>
+
+#include <cstddef>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <mp++/detail/gmp.hpp>
+#include <mp++/detail/mpfr.hpp>
+#include <mp++/real.hpp>
+
+#include "catch.hpp"
+#include "test_utils.hpp"
+
+// NOLINTNEXTLINE(google-build-using-namespace)
+using namespace mppp;
+// NOLINTNEXTLINE(google-build-using-namespace)
+using namespace mppp_test;
+
+TEST_CASE("real caches")
+{
+    const gmp_alloc_counter alloc_counter;
+
+    const real a{1, 113}, b{2, 113};
+    // Warm up the cache.
+    for (int i = 0; i < 10; ++i) {
+        real c = a * b;
+        c += a;
+        REQUIRE(c == 3);
+    }
+    const auto c0 = alloc_counter.count();
+    for (int i = 0; i < 100; ++i) {
+        real c = a * b;
+        c += a;
+        REQUIRE(c == 3);
+    }
+#if defined(MPPP_HAVE_THREAD_LOCAL)
+    REQUIRE(alloc_counter.count() == c0);
+#endif
+
+    // Reuse with a different precision, but the same number of limbs.
+    {
+        real tmp{0, 113};
+    }
+    {
+        real tmp{real_kind::nan, 100};
+        REQUIRE(tmp.get_prec() == 100);
+        REQUIRE(tmp.nan_p());
+        tmp = 1.5;
+        REQUIRE(tmp == 1.5);
+    }
+    // Values with a large precision are not cached.
+    {
+        std::vector<real> v(100, real{1, 10000});
+        REQUIRE(v[50] == 1);
+    }
+    // Vectors of reals, destroyed in another thread.
+    std::vector<real> v(1000, real{42, 64});
+    std::thread t([&v]() {
+        auto w = std::move(v);
+        w.clear();
+        free_real_caches();
+    });
+    t.join();
+    std::vector<real> v2(100, real{-1, 64});
+    for (const auto &x : v2) {
+        REQUIRE(x == -1);
+        REQUIRE(x.get_prec() == 64);
+    }
+    free_real_caches();
+    free_real_caches();
+}
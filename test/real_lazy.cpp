@@ -0,0 +1,132 @@
+// Copyright 2016-2023 Francesco Biscani (bluescarni@gmail.com)
+//
+// This file is part of the mp++ library.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <mp++/config.hpp>
+
+#include <initializer_list>
+#include <type_traits>
+#include <utility>
+
+#include <mp++/lazy.hpp>
+#include <mp++/real.hpp>
+
+#if defined(MPPP_WITH_MPC)
+#include <mp++/complex.hpp>
+#endif
+
+#include "catch.hpp"
+
+// NOLINTNEXTLINE(google-build-using-namespace)
+using namespace mppp;
+
+template <typename T>
+static T horner(const T &x, bool move)
+{
+    T a[7] = {T{1.}, T{2.}, T{3.}, T{4.}, T{5.}, T{6.}, T{7.}};
+
+    if (move) {
+        return (((((lazy(std::move(a[6])) * x + a[5]) * x + a[4]) * x + a[3]) * x + a[2]) * x + a[1]) * x + a[0];
+    } else {
+        return (((((lazy(a[6]) * x + a[5]) * x + a[4]) * x + a[3]) * x + a[2]) * x + a[1]) * x + a[0];
+    }
+}
+
+TEST_CASE("real lazy")
+{
+    const real x{1.5}, y{2}, z{3}, w{5};
+
+    // Leaves.
+    REQUIRE(real{lazy(x)} == x);
+    REQUIRE(real{lazy(real{42})} == 42);
+
+    // Basic operations.
+    REQUIRE(real{lazy(x) + y} == 3.5);
+    REQUIRE(real{x - lazy(y)} == -.5);
+    REQUIRE(real{lazy(x) * lazy(y)} == 3);
+    REQUIRE(real{lazy(z) / x} == 2);
+
+    // Fused operations.
+    REQUIRE(std::is_same<decltype(lazy(x) * y + z),
+                         detail::lazy_expr<detail::lazy_fma, detail::lazy_cref<real>, detail::lazy_cref<real>,
+                                           detail::lazy_cref<real>>>::value);
+    REQUIRE(real{lazy(x) * y + z} == 6);
+    REQUIRE(real{z + lazy(x) * y} == 6);
+    REQUIRE(real{lazy(x) * y - z} == 0);
+    REQUIRE(real{z - lazy(x) * y} == 0);
+    REQUIRE(real{lazy(x) * y + lazy(z) * w} == 18);
+    REQUIRE(real{lazy(x) * y - lazy(z) * w} == -12);
+
+    // The fma is computed with a single rounding.
+    const real eps = real{1, 60} / (1ll << 40);
+    const real a{1 + eps, 60}, b{1 - eps, 60};
+    REQUIRE(real{lazy(a) * b - real{1, 60}} == fma(a, b, real{-1, 60}));
+    REQUIRE(real{lazy(a) * b - real{1, 60}} != a * b - 1);
+
+    // Nested expressions.
+    REQUIRE(real{(lazy(x) + y) * (lazy(z) - w)} == -7);
+    REQUIRE(real{(lazy(x) + y) / (lazy(z) - w) + (lazy(w) - x) * (lazy(y) + z)} == -1.75 + 17.5);
+    REQUIRE(real{(lazy(real{1.5}) + y) * (lazy(z) - real{5}) + real{2} * (real{3} - lazy(real{4}))} == -9);
+    REQUIRE(real{lazy(real{2}) - (real{3} - lazy(real{1})) * (real{4} + lazy(real{1}))} == -8);
+
+    // Lvalue expressions.
+    const auto e = lazy(x) * y;
+    REQUIRE(real{e} == 3);
+    REQUIRE(real{e + z} == 6);
+    REQUIRE(real{e} == 3);
+
+    // Precision.
+    REQUIRE(real{lazy(real{1, 10}) + real{2, 100}}.get_prec() == 100);
+    REQUIRE(real{lazy(real{1, 100}) * real{2, 10} + real{3, 20}}.get_prec() == 100);
+
+    // Rvalue storage is reused.
+    real r0{7, 100};
+    const auto ptr0 = r0.get_mpfr_t()->_mpfr_d;
+    real res = lazy(std::move(r0)) * real{2, 100} + z;
+    REQUIRE(res == 17);
+    REQUIRE(res.get_mpfr_t()->_mpfr_d == ptr0);
+
+    real r1{3, 100};
+    const auto ptr1 = r1.get_mpfr_t()->_mpfr_d;
+    res = (z + lazy(std::move(r1))) * (lazy(x) - y);
+    REQUIRE(res == -3);
+    REQUIRE(res.get_mpfr_t()->_mpfr_d == ptr1);
+
+    // The Horner scheme.
+    for (auto move : {false, true}) {
+        const real arg{42.};
+        const auto ret = horner(arg, move);
+        REQUIRE(ret == ((((((7 * arg + 6) * arg + 5) * arg + 4) * arg + 3) * arg + 2) * arg + 1));
+    }
+}
+
+#if defined(MPPP_WITH_MPC)
+
+TEST_CASE("complex lazy")
+{
+    const complex x{1, 2}, y{3, -1}, z{-2, 5}, w{4, 4};
+
+    REQUIRE(complex{lazy(x) + y} == x + y);
+    REQUIRE(complex{lazy(x) - y} == x - y);
+    REQUIRE(complex{lazy(x) * y} == x * y);
+    REQUIRE(complex{lazy(x) / y} == x / y);
+    REQUIRE(complex{lazy(x) * y + z} == fma(x, y, z));
+    REQUIRE(complex{z + lazy(x) * y} == fma(x, y, z));
+    REQUIRE(complex{lazy(x) * y - z} == x * y - z);
+    REQUIRE(complex{z - lazy(x) * y} == z - x * y);
+    REQUIRE(complex{lazy(x) * y + lazy(z) * w} == x * y + z * w);
+    REQUIRE(complex{lazy(x) * y - lazy(z) * w} == x * y - z * w);
+    REQUIRE(complex{(lazy(x) + y) * (lazy(z) - w)} == (x + y) * (z - w));
+
+    complex c0{1, 1, complex_prec_t(100)};
+    const auto ptr = c0.get_mpc_t()->re->_mpfr_d;
+    complex res = lazy(std::move(c0)) * complex{2, 0, complex_prec_t(100)} + x;
+    REQUIRE(res == complex{3, 4});
+    REQUIRE(res.get_mpc_t()->re->_mpfr_d == ptr);
+}
+
+#endif
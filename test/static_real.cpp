@@ -0,0 +1,227 @@
+// Copyright 2016-2023 Francesco Biscani (bluescarni@gmail.com)
+//
+// This file is part of the mp++ library.
+//
+// This Source Code Form is subject to the terms of the Mozilla
+// Public License v. 2.0. If a copy of the MPL was not distributed
+// with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <climits>
+#include <cstddef>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <mp++/config.hpp>
+#include <mp++/detail/gmp.hpp>
+#include <mp++/integer.hpp>
+#include <mp++/rational.hpp>
+#include <mp++/real.hpp>
+#include <mp++/static_real.hpp>
+
+#include "catch.hpp"
+#include "test_utils.hpp"
+
+// NOLINTNEXTLINE(google-build-using-namespace)
+using namespace mppp;
+// NOLINTNEXTLINE(google-build-using-namespace)
+using namespace mppp_test;
+
+using sr113 = static_real<113>;
+using sr64 = static_real<64>;
+
+TEST_CASE("static_real basic")
+{
+    REQUIRE(sr113::get_prec() == 113);
+    REQUIRE(sr113::nlimbs * sizeof(::mp_limb_t) * CHAR_BIT >= 113u);
+    REQUIRE(sr64::get_prec() == 64);
+
+    sr113 a;
+    REQUIRE(a.zero_p());
+    REQUIRE(!a.signbit());
+    REQUIRE(mpfr_get_prec(a.get_mpfr_t()) == 113);
+
+    // Construction.
+    REQUIRE(sr113{42} == 42);
+    REQUIRE(sr113{-42ll} == -42);
+    REQUIRE(sr113{1.5} == 1.5);
+    REQUIRE(sr113{1.5f} == 1.5);
+    REQUIRE(sr113{true} == 1);
+    REQUIRE(sr113{integer<1>{123}} == 123);
+    REQUIRE(sr113{rational<1>{1, 2}} == 0.5);
+    REQUIRE(sr113{"1.25"} == 1.25);
+    REQUIRE(sr113{std::string("-ff"), 16} == -255);
+    REQUIRE(sr113{real{3, 200}} == 3);
+    REQUIRE(sr113{sr64{7}} == 7);
+    REQUIRE_THROWS_AS(sr113{"hello"}, std::invalid_argument);
+    REQUIRE_THROWS_AS(sr113("1", 1), std::invalid_argument);
+
+    // Large integral values.
+    REQUIRE(sr113{std::numeric_limits<unsigned long long>::max()} == std::numeric_limits<unsigned long long>::max());
+    REQUIRE(sr113{std::numeric_limits<long long>::min()} == std::numeric_limits<long long>::min());
+#if defined(MPPP_HAVE_GCC_INT128)
+    const auto big = static_cast<__int128_t>(1) << 100;
+    REQUIRE(sr113{big} == big);
+#endif
+
+    // Rounding to the target precision.
+    const static_real<10> r10{1025};
+    REQUIRE(r10 == 1024);
+    REQUIRE(static_real<10>{1} + 1024 == 1024);
+
+    // Copy/move semantics.
+    sr113 b{1.5};
+    auto c(b);
+    REQUIRE(c == 1.5);
+    REQUIRE(c.get_mpfr_t()->_mpfr_d != b.get_mpfr_t()->_mpfr_d);
+    auto d(std::move(c));
+    REQUIRE(d == 1.5);
+    c = 3;
+    REQUIRE(c == 3);
+    d = c;
+    REQUIRE(d == 3);
+    c = 4;
+    REQUIRE(d == 3);
+    d = std::move(c);
+    REQUIRE(d == 4);
+    // NOTE: self assignment.
+    d = *&d;
+    REQUIRE(d == 4);
+
+    // Special values.
+    sr113 n{std::numeric_limits<double>::quiet_NaN()};
+    REQUIRE(n.nan_p());
+    REQUIRE(n != n);
+    REQUIRE(!(n == n));
+    REQUIRE(!(n < 1));
+    REQUIRE_THROWS_AS(n.sgn(), std::domain_error);
+    const sr113 inf{std::numeric_limits<double>::infinity()};
+    REQUIRE(inf.inf_p());
+    REQUIRE(!inf.number_p());
+    REQUIRE(inf.sgn() == 1);
+    REQUIRE((-inf).signbit());
+
+    // Conversions.
+    REQUIRE(static_cast<double>(sr113{1.5}) == 1.5);
+    REQUIRE(static_cast<float>(sr113{1.5}) == 1.5f);
+    REQUIRE(static_cast<long double>(sr113{-1.5}) == -1.5l);
+    REQUIRE(static_cast<int>(sr113{-3}) == -3);
+    REQUIRE(static_cast<integer<1>>(sr113{10}) == 10);
+    REQUIRE(static_cast<rational<1>>(sr113{0.5}) == rational<1>{1, 2});
+    const auto r = static_cast<real>(sr113{2});
+    REQUIRE(r == 2);
+    REQUIRE(r.get_prec() == 113);
+    REQUIRE(sr113{2}.to_string() == real{2, 113}.to_string());
+    std::ostringstream oss;
+    oss << sr113{2};
+    REQUIRE(oss.str() == real{2, 113}.to_string());
+}
+
+TEST_CASE("static_real arith")
+{
+    const sr113 a{3}, b{4};
+
+    REQUIRE(std::is_same<decltype(a + b), sr113>::value);
+    REQUIRE(a + b == 7);
+    REQUIRE(a - b == -1);
+    REQUIRE(a * b == 12);
+    REQUIRE(b / a == sr113{4} / sr113{3});
+    REQUIRE(-a == -3);
+    REQUIRE(+a == 3);
+    REQUIRE(abs(-a) == 3);
+    REQUIRE(sqrt(b) == 2);
+    REQUIRE(fma(a, b, a) == 15);
+
+    // With C++ arithmetic types.
+    REQUIRE(std::is_same<decltype(a + 1), sr113>::value);
+    REQUIRE(std::is_same<decltype(1. + a), sr113>::value);
+    REQUIRE(a + 1 == 4);
+    REQUIRE(1 - a == -2);
+    REQUIRE(a * 2.5 == 7.5);
+    REQUIRE(6.f / a == 2);
+    REQUIRE(a + std::numeric_limits<unsigned long long>::max()
+            == sr113{std::numeric_limits<unsigned long long>::max()} + 3);
+    // The arithmetic operand is converted exactly before the operation.
+    REQUIRE(static_real<10>{0} + 1025 == 1024);
+    REQUIRE(static_real<10>{-1} + 1025 == 1024);
+
+    // In-place operators.
+    sr113 c{1};
+    c += a;
+    REQUIRE(c == 4);
+    c -= 1;
+    REQUIRE(c == 3);
+    c *= 2.;
+    REQUIRE(c == 6);
+    c /= real{3};
+    REQUIRE(c == 2);
+
+    // Comparisons.
+    REQUIRE(a < b);
+    REQUIRE(a <= b);
+    REQUIRE(b > a);
+    REQUIRE(b >= a);
+    REQUIRE(a != b);
+    REQUIRE(a == 3);
+    REQUIRE(3 == a);
+    REQUIRE(a < 3.5);
+    REQUIRE(2 < a);
+    REQUIRE(a == real{3});
+    REQUIRE(real{4} > a);
+}
+
+TEST_CASE("static_real real interop")
+{
+    const sr113 a{3};
+
+    // The result of a mixed operation has the largest precision.
+    const real r{2, 200};
+    REQUIRE(std::is_same<decltype(a + r), real>::value);
+    REQUIRE(a + r == 5);
+    REQUIRE((a + r).get_prec() == 200);
+    REQUIRE((r - a).get_prec() == 200);
+    REQUIRE((a * real{2, 10}).get_prec() == 113);
+    REQUIRE(a / real{2, 10} == 1.5);
+
+    // Stealing from real rvalues.
+    real tmp{2, 200};
+    const auto ptr = tmp.get_mpfr_t()->_mpfr_d;
+    auto res = std::move(tmp) * a;
+    REQUIRE(res == 6);
+    REQUIRE(res.get_mpfr_t()->_mpfr_d == ptr);
+
+    // In-place operators on real.
+    real s{1, 64};
+    s += a;
+    REQUIRE(s == 4);
+    REQUIRE(s.get_prec() == 113);
+    s *= a;
+    REQUIRE(s == 12);
+    s -= a;
+    REQUIRE(s == 9);
+    s /= a;
+    REQUIRE(s == 3);
+}
+
+TEST_CASE("static_real allocations")
+{
+    const gmp_alloc_counter alloc_counter;
+
+    const auto c0 = alloc_counter.count();
+    {
+        std::vector<sr113> v(1000, sr113{1});
+        for (std::size_t i = 1; i < v.size(); ++i) {
+            v[i] = v[i - 1] * 2 + v[i - 1] / 3;
+            v[i] += 1;
+        }
+        REQUIRE(v[1] > 3);
+        REQUIRE(v[1] < 4);
+        auto w = v;
+        REQUIRE(w == v);
+    }
+    REQUIRE(alloc_counter.count() == c0);
+}
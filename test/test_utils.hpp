@@ -12,7 +12,9 @@
 #ifndef MPPP_TEST_UTILS_HPP
 #define MPPP_TEST_UTILS_HPP
 
+#include <atomic>
 #include <cassert>
+#include <cmath>
 #include <cstddef>
 #include <cstdint>
 #include <gmp.h>
@@ -223,6 +225,63 @@ inline void max_integer(mppp::detail::mpz_raii &m, unsigned n)
     }
 }
 
+// Conversion of the nonzero rational q to double with the rounding mode rnd,
+// computed from the truncated result of mpq_get_d(). The absolute value
+// of q must be less than 2**1024.
+inline double ref_to_double(const ::mpq_t q, mppp::fp_rounding rnd)
+{
+    assert(mpq_sgn(q) != 0);
+    MPPP_MAYBE_TLS mppp::detail::mpq_raii aq, tmp, mid;
+    const bool neg = mpq_sgn(q) < 0;
+    mpq_abs(&aq.m_mpq, q);
+    // The two candidates lo and hi.
+    const auto lo = mpq_get_d(&aq.m_mpq);
+    mpq_set_d(&tmp.m_mpq, lo);
+    if (mpq_equal(&tmp.m_mpq, &aq.m_mpq)) {
+        return neg ? -lo : lo;
+    }
+    const auto hi = std::nextafter(lo, std::numeric_limits<double>::infinity());
+    double ret;
+    switch (rnd) {
+        case mppp::fp_rounding::nearest: {
+            // Compute the midpoint between lo and hi. If hi is infinity, the midpoint
+            // is halfway between the largest finite value and 2**1024.
+            if (std::isinf(hi)) {
+                mpq_set_ui(&mid.m_mpq, 1u, 1u);
+                mpz_mul_2exp(mpq_numref(&mid.m_mpq), mpq_numref(&mid.m_mpq), 1024u);
+            } else {
+                mpq_set_d(&mid.m_mpq, hi);
+            }
+            mpq_add(&mid.m_mpq, &mid.m_mpq, &tmp.m_mpq);
+            mpz_mul_2exp(mpq_denref(&mid.m_mpq), mpq_denref(&mid.m_mpq), 1u);
+            mpq_canonicalize(&mid.m_mpq);
+            const auto c = mpq_cmp(&aq.m_mpq, &mid.m_mpq);
+            if (c == 0) {
+                // Ties to even.
+                int e;
+                const auto m = std::frexp(lo, &e);
+                ret = std::fmod(std::ldexp(m, std::numeric_limits<double>::digits), 2.) == 0. ? lo : hi;
+                if (lo < std::numeric_limits<double>::min()) {
+                    // Subnormal lo: check the parity of the multiple of the smallest subnormal.
+                    ret = std::fmod(lo / std::numeric_limits<double>::denorm_min(), 2.) == 0. ? lo : hi;
+                }
+            } else {
+                ret = c < 0 ? lo : hi;
+            }
+            break;
+        }
+        case mppp::fp_rounding::toward_zero:
+            ret = lo;
+            break;
+        case mppp::fp_rounding::upward:
+            ret = neg ? lo : hi;
+            break;
+        default:
+            ret = neg ? hi : lo;
+    }
+    return neg ? -ret : ret;
+}
+
 // Uniform int distribution wrapper, from min to max value for type T.
 template <typename T, typename = void>
 struct integral_minmax_dist {
@@ -281,6 +340,69 @@ struct integral_minmax_dist<__int128_t, void> : integral_minmax_dist<__uint128_t
 };
 
 #endif
+
+// RAII helper which, for the duration of its lifetime, replaces GMP's
+// allocation and reallocation functions with versions counting the number
+// of calls. The previous memory functions are restored on destruction.
+class gmp_alloc_counter
+{
+public:
+    gmp_alloc_counter()
+    {
+        ::mp_get_memory_functions(&old_alloc(), &old_realloc(), &old_free());
+        ::mp_set_memory_functions(counting_alloc, counting_realloc, old_free());
+    }
+    gmp_alloc_counter(const gmp_alloc_counter &) = delete;
+    gmp_alloc_counter(gmp_alloc_counter &&) = delete;
+    gmp_alloc_counter &operator=(const gmp_alloc_counter &) = delete;
+    gmp_alloc_counter &operator=(gmp_alloc_counter &&) = delete;
+    ~gmp_alloc_counter()
+    {
+        ::mp_set_memory_functions(old_alloc(), old_realloc(), old_free());
+    }
+    // Total number of (re)allocations performed so far.
+    static unsigned long count()
+    {
+        return counter().load();
+    }
+
+private:
+    using alloc_t = void *(*)(std::size_t);
+    using realloc_t = void *(*)(void *, std::size_t, std::size_t);
+    using free_t = void (*)(void *, std::size_t);
+
+    static std::atomic<unsigned long> &counter()
+    {
+        static std::atomic<unsigned long> c{0};
+        return c;
+    }
+    static alloc_t &old_alloc()
+    {
+        static alloc_t f = nullptr;
+        return f;
+    }
+    static realloc_t &old_realloc()
+    {
+        static realloc_t f = nullptr;
+        return f;
+    }
+    static free_t &old_free()
+    {
+        static free_t f = nullptr;
+        return f;
+    }
+    static void *counting_alloc(std::size_t n)
+    {
+        ++counter();
+        return old_alloc()(n);
+    }
+    static void *counting_realloc(void *p, std::size_t old_n, std::size_t new_n)
+    {
+        ++counter();
+        return old_realloc()(p, old_n, new_n);
+    }
+};
+
 } // namespace mppp_test
 
 // A macro for checking that an expression throws a specific exception object satisfying a predicate.